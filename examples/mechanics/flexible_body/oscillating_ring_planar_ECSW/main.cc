@@ -0,0 +1,80 @@
+#include "system.h"
+#include <mbsim/integrators/integrators.h>
+
+#include <boost/timer.hpp>
+
+#include <hdf5serie/vectorserie.h>
+#include <fmatvec/fmatvec.h>
+#include <iostream>
+
+using namespace MBSim;
+using namespace std;
+using namespace fmatvec;
+using namespace H5;
+
+int main (int argc, char* argv[]) {
+
+  string nameFullSystem = "MBS_Full";
+  string nameReducedSystem = "MBS_Krylov";
+  string nameHyperReducedSystem = "MBS_Krylov_ECSW";
+  System *sys;
+  //ThetaTimeSteppingIntegrator *integrator;
+  TimeSteppingIntegrator *integrator;
+
+  double tEnd = 3e-2;
+  double dtFull = 1e-4;
+  double dtRed = 1.e0*dtFull;
+  double dtPlot = dtRed;
+
+  {
+    //Run Full Simulation
+    sys = new System(nameFullSystem);
+    sys->setStopIfNoConvergence(true,true);
+    sys->initialize();
+
+//    integrator = new ThetaTimeSteppingIntegrator;
+    integrator = new TimeSteppingIntegrator;
+    integrator->setEndTime(tEnd);
+    integrator->setStepSize(dtFull);
+    integrator->setPlotStepSize(dtPlot);
+
+    boost::timer timer;
+    timer.restart();
+    integrator->integrate(*sys);
+    double calctime = timer.elapsed();
+
+    sys->writez("z0.h5");
+
+    cout << "Finished full Simulation after calculation time [s] : " << calctime << endl;
+
+    delete sys;
+    delete integrator;
+  }
+
+  for (bool hyperReduction : {false, true}) {
+    //Run Reduced Simulation without and with hyper-reduction
+    sys = new System(hyperReduction ? nameHyperReducedSystem : nameReducedSystem);
+    sys->reduce(nameFullSystem + ".mbsh5", hyperReduction);
+    sys->setStopIfNoConvergence(true,true);
+    sys->initialize();
+
+    integrator = new TimeSteppingIntegrator;
+    integrator->setEndTime(tEnd);
+    integrator->setStepSize(dtRed);
+    integrator->setPlotStepSize(dtPlot);
+
+    boost::timer timer;
+    timer.restart();
+    integrator->integrate(*sys);
+    double calctime = timer.elapsed();
+
+    cout << "Finished " << (hyperReduction ? "hyper-reduced" : "reduced") << " Simulation after calculation time [s] : " << calctime << endl;
+
+    delete sys;
+    delete integrator;
+  }
+
+  return 0;
+
+}
+
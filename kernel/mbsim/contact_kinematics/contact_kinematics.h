@@ -24,6 +24,7 @@
 #include "fmatvec/fmatvec.h"
 #include "fmatvec/atom.h"
 #include <vector>
+#include <limits>
 
 namespace MBSim {
 
@@ -94,6 +95,13 @@ namespace MBSim {
        * \param i index of the contact that should be updated
        */
       virtual void updatewb(SingleContact &contact, int i=0);
+
+      /**
+       * \brief estimate of the time until the contours touch if their current velocities are kept
+       * \param dt time horizon
+       * \return time of impact in [0,dt] or infinity if no impact is predicted within dt (default: no estimate available)
+       */
+      virtual double evalTimeOfImpact(double dt) { return std::numeric_limits<double>::infinity(); }
       
       /** 
        * \brief treats ordering of contours
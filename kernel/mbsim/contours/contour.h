@@ -62,6 +62,11 @@ namespace MBSim {
 
       virtual ContourFrame* createContourFrame(const std::string &name="P") { return nullptr; }
 
+      /**
+       * \brief invalidate values depending on the positions only (e.g. during the solution of constraints)
+       */
+      virtual void resetPositionsUpToDate() { }
+
       const std::vector<double>& getEtaNodes() const { return etaNodes; }
       const std::vector<double>& getXiNodes() const { return xiNodes; }
 
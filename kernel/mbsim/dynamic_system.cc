@@ -1647,6 +1647,20 @@ namespace MBSim {
       i->resetUpToDate();
   }
 
+  void DynamicSystem::resetForcesUpToDate() {
+    for (auto & i : dynamicsystem)
+      i->resetForcesUpToDate();
+    for (auto & i : object)
+      i->resetForcesUpToDate();
+    for (auto & i : link)
+      i->resetForcesUpToDate();
+    // constraints only depend on the state
+    for (auto & i : observer)
+      i->resetUpToDate();
+    for (auto & i : inverseKineticsLink)
+      i->resetUpToDate();
+  }
+
   const fmatvec::Mat& DynamicSystem::getT(bool check) const {
     assert((not check) or (not ds->getUpdateT()));
     return T;
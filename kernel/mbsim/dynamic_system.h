@@ -109,6 +109,7 @@ namespace MBSim {
       void setx(const fmatvec::Vec& x_) { x = x_; }
       void setjsv(const fmatvec::VecInt& jsv_) { jsv = jsv_; }
       void setInternalState(const fmatvec::Vec& internalState) { curis = internalState; nextis = internalState; }
+      const fmatvec::Vec& getInternalState() const { return curis; }
       virtual H5::GroupBase *getPlotGroup() { return plotGroup; }
       std::shared_ptr<OpenMBV::Group> getOpenMBVGrp() override { return openMBVGrp; }
       std::shared_ptr<OpenMBV::Group> getFramesOpenMBVGrp() override { return framesOpenMBVGrp; }
@@ -304,6 +305,7 @@ namespace MBSim {
       const std::vector<Frame*>& getFrames() const { return frame; }
       const std::vector<Contour*>& getContours() const { return contour; }
       const std::vector<Link*>& getSetValuedLinks() const { return linkSetValued; }
+      const std::vector<Link*>& getLinksWithStopVector() const { return linkWithStopVector; }
 
       /**
        * \brief references to positions of dynamic system parent
@@ -782,6 +784,7 @@ namespace MBSim {
       void checkRoot();
 
       void resetUpToDate() override;
+      virtual void resetForcesUpToDate();
 
       void updateStateTable();
 
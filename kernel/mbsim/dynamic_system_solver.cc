@@ -40,6 +40,7 @@
 #include <hdf5serie/simpledataset.h>
 #include <limits>
 #include <csignal>
+#include <cstring>
 
 #include "openmbvcppinterface/group.h"
 
@@ -1696,6 +1697,77 @@ namespace MBSim {
     curisParent = nextisParent;
   }
 
+  namespace {
+    template<class T>
+    char* writeSnapshot(char *p, const T *v, int n) {
+      if (n) memcpy(p, v, n*sizeof(T));
+      return p + n*sizeof(T);
+    }
+
+    template<class T>
+    const char* readSnapshot(const char *p, T *v, int n) {
+      if (n) memcpy(v, p, n*sizeof(T));
+      return p + n*sizeof(T);
+    }
+  }
+
+  size_t DynamicSystemSolver::getSnapshotSize() const {
+    size_t size = (1 + zParent.size() + curisParent.size() + nextisParent.size() + laParent.size() + LaParent.size() + rFactorParent.size())*sizeof(double);
+    size += (jsvParent.size() + 1)*sizeof(int);
+    for (auto & i : linkWithStopVector)
+      size += i->getActiveFlagsSize()*sizeof(unsigned int);
+    return size;
+  }
+
+  void DynamicSystemSolver::getSnapshot(char *snapshot) const {
+    char *p = writeSnapshot(snapshot, &t, 1);
+    p = writeSnapshot(p, zParent(), zParent.size());
+    p = writeSnapshot(p, curisParent(), curisParent.size());
+    p = writeSnapshot(p, nextisParent(), nextisParent.size());
+    p = writeSnapshot(p, laParent(), laParent.size());
+    p = writeSnapshot(p, LaParent(), LaParent.size());
+    p = writeSnapshot(p, rFactorParent(), rFactorParent.size());
+    p = writeSnapshot(p, jsvParent(), jsvParent.size());
+    p = writeSnapshot(p, &rootID, 1);
+    for (auto & i : linkWithStopVector) {
+      i->getActiveFlags(reinterpret_cast<unsigned int*>(p));
+      p += i->getActiveFlagsSize()*sizeof(unsigned int);
+    }
+  }
+
+  void DynamicSystemSolver::setSnapshot(const char *snapshot) {
+    const char *p = readSnapshot(snapshot, &t, 1);
+    p = readSnapshot(p, zParent(), zParent.size());
+    p = readSnapshot(p, curisParent(), curisParent.size());
+    p = readSnapshot(p, nextisParent(), nextisParent.size());
+    p = readSnapshot(p, laParent(), laParent.size());
+    p = readSnapshot(p, LaParent(), LaParent.size());
+    p = readSnapshot(p, rFactorParent(), rFactorParent.size());
+    p = readSnapshot(p, jsvParent(), jsvParent.size());
+    p = readSnapshot(p, &rootID, 1);
+    for (auto & i : linkWithStopVector) {
+      i->setActiveFlags(reinterpret_cast<const unsigned int*>(p));
+      p += i->getActiveFlagsSize()*sizeof(unsigned int);
+    }
+
+    // the sizes of the active links must match the restored activity flags (the same as at the end of shift)
+    setUpActiveLinks();
+    calcgSize(0);
+    updategRef(gParent);
+    calcgdSize(3);
+    updategdRef(gdParent);
+    calclaSize(3);
+    calcrFactorSize(3);
+    updateJrlaRef(JrlaParent[0]);
+    updateWRef(WParent[0]);
+    updateVRef(VParent[0]);
+    updatelaRef(laParent);
+    updateLaRef(LaParent);
+    updatewbRef(wbParent);
+    updaterFactorRef(rFactorParent);
+    resetUpToDate();
+  }
+
   void DynamicSystemSolver::resetUpToDate() {
     updT = true;
     updh[0] = true;
@@ -1727,6 +1799,29 @@ namespace MBSim {
     Group::resetUpToDate();
   }
 
+  void DynamicSystemSolver::resetForcesUpToDate() {
+    if(kinematicsDependOnSignals) {
+      resetUpToDate();
+      return;
+    }
+    updh[0] = true;
+    updh[1] = true;
+    updr[0] = true;
+    updr[1] = true;
+    updJrla[0] = true;
+    updJrla[1] = true;
+    updrdt = true;
+    updbc = true;
+    updbi = true;
+    updsv = true;
+    updzd = true;
+    updla = true;
+    updLa = true;
+    upddu = true;
+    upddx = true;
+    Group::resetForcesUpToDate();
+  }
+
   const Vec& DynamicSystemSolver::evalzd() {
     if(updzd) {
       useSmoothSolver = true;
@@ -1735,7 +1830,30 @@ namespace MBSim {
     return zd;
   }
 
+  const Vec& DynamicSystemSolver::evalzd(const vector<Element*> &elements) {
+    if(updzd) {
+      useSmoothSolver = true;
+      for(auto & i : elements) {
+        if(auto *o = dynamic_cast<Object*>(i)) {
+          o->updateqd();
+          o->updateud();
+        }
+        else if(auto *l = dynamic_cast<Link*>(i))
+          l->updatexd();
+        else if(auto *ds = dynamic_cast<DynamicSystem*>(i))
+          ds->updatezd();
+        else
+          throwError("(DynamicSystemSolver::evalzd): the state derivative of "+i->getPath()+" can not be evaluated separately");
+      }
+    }
+    return zd;
+  }
+
   void DynamicSystemSolver::plot() {
+    if(plotFunction) {
+      plotFunction();
+      return;
+    }
     useSmoothSolver = not(useConstraintSolverForPlot);
     if (inverseKinetics) updatelaInverseKinetics();
     Group::plot();
@@ -1761,6 +1879,15 @@ namespace MBSim {
     return sv;
   }
 
+  const Vec& DynamicSystemSolver::evalsv(const vector<Link*> &lnk) {
+    if(updsv) {
+      useSmoothSolver = false;
+      for(auto & i : lnk)
+        i->updateStopVector();
+    }
+    return sv;
+  }
+
   const Vec& DynamicSystemSolver::evalz0() {
     initz();
     return z;
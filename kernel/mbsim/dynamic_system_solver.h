@@ -26,6 +26,7 @@
 #include "mbsim/environment.h"
 
 #include <atomic>
+#include <functional>
 
 namespace MBSim {
 
@@ -245,11 +246,23 @@ namespace MBSim {
       const fmatvec::Vec& evaldu() { if(upddu) updatedu(); return du; }
       const fmatvec::Vec& evaldx() { if(upddx) updatedx(); return dx; }
       const fmatvec::Vec& evalzd();
+      /**
+       * \brief evaluates the state derivative of the given objects, links and dynamic systems only
+       *
+       * The other entries of zd are not updated and zd is not marked as up to date (used for multirate integration).
+       */
+      const fmatvec::Vec& evalzd(const std::vector<Element*> &elements);
       const fmatvec::SqrMat& evalG() { if(updG) updateG(); return G; }
       const fmatvec::SparseMat& evalGs() { if(updG) updateG(); return Gs; }
       const fmatvec::Vec& evalbc() { if(updbc) updatebc(); return bc; }
       const fmatvec::Vec& evalbi() { if(updbi) updatebi(); return bi; }
       const fmatvec::Vec& evalsv();
+      /**
+       * \brief evaluates the stop vector entries of the given links only
+       *
+       * The other entries of the stop vector are not updated and the stop vector is not marked as up to date.
+       */
+      const fmatvec::Vec& evalsv(const std::vector<Link*> &lnk);
       const fmatvec::Vec& evalz0();
       const fmatvec::Vec& evalla() { if(updla) updatela(); return la; }
       const fmatvec::Vec& evalLa() { if(updLa) updateLa(); return La; }
@@ -267,6 +280,7 @@ namespace MBSim {
 //      fmatvec::Vec& getLaParent() { return LaParent; }
 //      const fmatvec::Vec& getgParent() const { return gParent; }
       fmatvec::Vec& getgParent() { return gParent; }
+      fmatvec::Vec& getwbParent() { return wbParent; }
 //      const fmatvec::Vec& getgdParent() const { return gdParent; }
       fmatvec::Vec& getgdParent() { return gdParent; }
       fmatvec::Vec& getresParent() { return resParent; }
@@ -548,6 +562,17 @@ namespace MBSim {
 
       void resetUpToDate() override;
 
+      /**
+       * \brief reset all quantities which may depend on the inputs of the system (e.g. extern signals)
+       *
+       * Quantities depending only on time and state (kinematics, mass matrix, Jacobians, gap functions) stay
+       * valid. If the kinematics depend on signals (see setKinematicsDependOnSignals) this is a full reset.
+       */
+      void resetForcesUpToDate() override;
+
+      void setKinematicsDependOnSignals(bool kinematicsDependOnSignals_) { kinematicsDependOnSignals = kinematicsDependOnSignals_; }
+      bool getKinematicsDependOnSignals() const { return kinematicsDependOnSignals; }
+
       bool getUpdateT() { return updT; }
       bool getUpdateM() { return updM; }
       bool getUpdateLLM() { return updLLM; }
@@ -619,8 +644,34 @@ namespace MBSim {
 
       void updateInternalState();
 
+      /**
+       * \return size in bytes of a snapshot of the system state
+       *
+       * A snapshot contains everything needed to continue the simulation from the current point: time, state,
+       * internal state, contact forces and impulses, relaxation factors, the boolean stop vector and the activity
+       * flags of all links. The size is constant after the initialisation of the system.
+       */
+      size_t getSnapshotSize() const;
+
+      /**
+       * \brief write a snapshot of the system state to snapshot (getSnapshotSize() bytes)
+       */
+      void getSnapshot(char *snapshot) const;
+
+      /**
+       * \brief restore the system state from snapshot, which was written by getSnapshot
+       */
+      void setSnapshot(const char *snapshot);
+
       void plot() override;
 
+      /**
+       * \brief replace the plot output by the given function; an empty function restores the plot output
+       *
+       * Used by integrators which propagate the system several times (e.g. parareal) to record the plot states.
+       */
+      void setPlotFunction(std::function<void()> plotFunction_) { plotFunction = std::move(plotFunction_); }
+
       void addEnvironment(Environment* env);
 
       /** Get the Environment of type Env.
@@ -955,6 +1006,10 @@ namespace MBSim {
 
       bool firstPlot { true };
 
+      std::function<void()> plotFunction;
+
+      bool kinematicsDependOnSignals { false };
+
       std::unique_ptr<MultiDimNewtonMethod> nonlinearConstraintNewtonSolver;
       std::unique_ptr<ConstraintResiduum> constraintResiduum;
       std::unique_ptr<ConstraintJacobian> constraintJacobian;
@@ -156,6 +156,10 @@ namespace MBSim {
     updGA = true;
   }
 
+  void Frame::resetAccelerationsUpToDate() {
+    updAcc = true;
+  }
+
   void Frame::createPlotGroup() {
     plotGroup=parent->getFramesPlotGroup()->createChildObject<H5::Group>(name)();
     plotGroup->createChildAttribute<H5::SimpleAttribute<string>>("Description")()->write("Object of class: "+boost::core::demangle(typeid(*this).name()));
@@ -127,6 +127,7 @@ namespace MBSim {
       virtual void resetVelocitiesUpToDate();
       virtual void resetJacobiansUpToDate();
       virtual void resetGyroscopicAccelerationsUpToDate();
+      virtual void resetAccelerationsUpToDate();
       virtual void updatePositions() { parent->updatePositions(this); updPos = false; }
       virtual void updateVelocities() { parent->updateVelocities(this); updVel = false; }
       virtual void updateAccelerations() { parent->updateAccelerations(this); updAcc = false; }
@@ -25,6 +25,7 @@
 #include <mbsim/utils/eps.h>
 #include "fortran/fortran_wrapper.h"
 #include "daspk_integrator.h"
+#include "sparse_linear_solver.h"
 #include <time.h>
 
 #ifndef NO_ISO_14882
@@ -205,6 +206,8 @@ namespace MBSim {
 
     debugInit();
 
+    SparseLinearSolverScope sparse(sparseLinearSolver);
+
     calcSize();
     Rq = RangeV(0,system->getqSize()-1);
     Ru = RangeV(system->getqSize(),system->getqSize()+system->getuSize()-1);
@@ -330,24 +333,13 @@ namespace MBSim {
           getSystem()->resetUpToDate();
           shift = signChangedWRTsvLast(getSystem()->evalsv());
           // if a root exists in the current step ...
-          double dt = work(6);
           if(shift) {
             // ... search the first root and set step.second to this time
-            while(dt>dtRoot) {
-              dt/=2;
-              double tCheck = tRoot-dt;
-              curTimeAndState = tCheck;
+            tRoot = findRoot(t-work(6), t, [&](double tCheck) {
               DDATRP(&t, &tCheck, system->getState()(), yd(), &neq, &iWork(7), &work(lphi), &work(38));
               getSystem()->setTime(tCheck);
-              getSystem()->resetUpToDate();
-              if(signChangedWRTsvLast(getSystem()->evalsv()))
-                tRoot = tCheck;
-            }
-            if(curTimeAndState != tRoot) {
-              curTimeAndState = tRoot;
-              DDATRP(&t, &tRoot, system->getState()(), yd(), &neq, &iWork(7), &work(lphi), &work(38));
-              getSystem()->setTime(tRoot);
-            }
+            });
+            curTimeAndState = tRoot;
             getSystem()->resetUpToDate();
             auto &sv = getSystem()->evalsv();
             auto &jsv = getSystem()->getjsv();
@@ -459,6 +451,7 @@ namespace MBSim {
     msg(Info)<<"nrStepsRejected: "<<iWork(13)<<endl;
     msg(Info)<<"nrNonlinConvFailures: "<<iWork(14)<<endl;
     msg(Info)<<"nrLinConvFailures: "<<iWork(15)<<endl;
+    sparse.msgStatistics();
   }
 
   void DASPKIntegrator::calcSize() {
@@ -502,6 +495,8 @@ namespace MBSim {
     if(e) setExcludeAlgebraicVariablesFromErrorTest(E(e)->getText<bool>());
     e=E(element)->getFirstElementChildNamed(MBSIM%"numericalJacobian");
     if(e) setNumericalJacobian(E(e)->getText<bool>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"sparseLinearSolver");
+    if(e) setSparseLinearSolver(E(e)->getText<bool>());
   }
 
 }
@@ -66,6 +66,8 @@ namespace MBSim {
       /** exclude algebraic variables from error test **/
       bool excludeAlgebraicVariables{true};
       bool numericalJacobian{false};
+      /** sparse LU decomposition of the iteration matrix **/
+      bool sparseLinearSolver{false};
 
       int neq;
 
@@ -84,6 +86,7 @@ namespace MBSim {
       void setFormalism(Formalism formalism_) { formalism = formalism_; }
       void setExcludeAlgebraicVariablesFromErrorTest(bool excludeAlgebraicVariables_) { excludeAlgebraicVariables = excludeAlgebraicVariables_; }
       void setNumericalJacobian(bool numericalJacobian_) { numericalJacobian = numericalJacobian_; }
+      void setSparseLinearSolver(bool sparseLinearSolver_) { sparseLinearSolver = sparseLinearSolver_; }
 
       using Integrator::integrate;
       void integrate();
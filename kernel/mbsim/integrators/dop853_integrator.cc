@@ -38,6 +38,20 @@ using namespace xercesc;
 
 namespace MBSim {
 
+  namespace {
+    // dense output of all components at once; the same as CONTD8 for icomp(i)=i but without the search for the component
+    void contd8(double t, double told, double tnew, const double *con, int nd, double *z) {
+      double h = tnew-told;
+      double s = h!=0 ? (t-told)/h : 0;
+      double s1 = 1-s;
+      const double *c0=con, *c1=con+nd, *c2=con+2*nd, *c3=con+3*nd, *c4=con+4*nd, *c5=con+5*nd, *c6=con+6*nd, *c7=con+7*nd;
+      for(int i=0; i<nd; i++) {
+        double conpar = c4[i]+s*(c5[i]+s1*(c6[i]+s*c7[i]));
+        z[i] = c0[i]+s*(c1[i]+s1*(c2[i]+s*(c3[i]+s1*conpar)));
+      }
+    }
+  }
+
   MBSIM_OBJECTFACTORY_REGISTERCLASS(MBSIM, DOP853Integrator)
 
   void DOP853Integrator::fzdot(int* zSize, double* t, double* z_, double* zd_, double* rpar, int* ipar) {
@@ -76,24 +90,11 @@ namespace MBSim {
         // if a root exists in the current step ...
         if(self->shift) {
           // ... search the first root and set step.second to this time
-          double dt = *t-*told;
-          while(dt>self->dtRoot) {
-            dt/=2;
-            double tCheck = tRoot-dt;
+          tRoot = self->findRoot(*told, *t, [&](double tCheck) {
             self->getSystem()->setTime(tCheck);
-            curTimeAndState = tCheck;
-            for(int i=1; i<=*n; i++)
-              self->getSystem()->getState()(i-1) = CONTD8(&i,&tCheck,con,icomp,nd);
-            self->getSystem()->resetUpToDate();
-            if(self->signChangedWRTsvLast(self->getSystem()->evalsv()))
-              tRoot = tCheck;
-          }
-          if(curTimeAndState != tRoot) {
-            curTimeAndState = tRoot;
-            self->getSystem()->setTime(tRoot);
-            for(int i=1; i<=*n; i++)
-              self->getSystem()->getState()(i-1) = CONTD8(&i,&tRoot,con,icomp,nd);
-          }
+            contd8(tCheck, *told, *t, con, *nd, self->getSystem()->getState()());
+          });
+          curTimeAndState = tRoot;
           self->getSystem()->resetUpToDate();
           auto &sv = self->getSystem()->evalsv();
           auto &jsv = self->getSystem()->getjsv();
@@ -106,8 +107,7 @@ namespace MBSim {
         if(curTimeAndState != self->tPlot) {
           curTimeAndState = self->tPlot;
           self->getSystem()->setTime(self->tPlot);
-          for(int i=1; i<=*n; i++)
-            self->getSystem()->getState()(i-1) = CONTD8(&i,&self->tPlot,con,icomp,nd);
+          contd8(self->tPlot, *told, *t, con, *nd, self->getSystem()->getState()());
         }
         self->getSystem()->resetUpToDate();
         self->getSystem()->plot();
@@ -127,8 +127,7 @@ namespace MBSim {
         // shift the system
         if(curTimeAndState != tRoot) {
           self->getSystem()->setTime(tRoot);
-          for(int i=1; i<=*n; i++)
-            self->getSystem()->getState()(i-1) = CONTD8(&i,&tRoot,con,icomp,nd);
+          contd8(tRoot, *told, *t, con, *nd, self->getSystem()->getState()());
         }
         if(self->plotOnRoot) {
           self->getSystem()->resetUpToDate();
@@ -38,6 +38,18 @@ using namespace xercesc;
 
 namespace MBSim {
 
+  namespace {
+    // dense output of all components at once; the same as CONTD5 for icomp(i)=i but without the search for the component
+    void contd5(double t, double told, double tnew, const double *con, int nd, double *z) {
+      double h = tnew-told;
+      double theta = h!=0 ? (t-told)/h : 0;
+      double theta1 = 1-theta;
+      const double *c0=con, *c1=con+nd, *c2=con+2*nd, *c3=con+3*nd, *c4=con+4*nd;
+      for(int i=0; i<nd; i++)
+        z[i] = c0[i]+theta*(c1[i]+theta1*(c2[i]+theta*(c3[i]+theta1*c4[i])));
+    }
+  }
+
   MBSIM_OBJECTFACTORY_REGISTERCLASS(MBSIM, DOPRI5Integrator)
 
   void DOPRI5Integrator::fzdot(int* zSize, double* t, double* z_, double* zd_, double* rpar, int* ipar) {
@@ -76,24 +88,11 @@ namespace MBSim {
         // if a root exists in the current step ...
         if(self->shift) {
           // ... search the first root and set step.second to this time
-          double dt = *t-*told;
-          while(dt>self->dtRoot) {
-            dt/=2;
-            double tCheck = tRoot-dt;
+          tRoot = self->findRoot(*told, *t, [&](double tCheck) {
             self->getSystem()->setTime(tCheck);
-            curTimeAndState = tCheck;
-            for(int i=1; i<=*n; i++)
-              self->getSystem()->getState()(i-1) = CONTD5(&i,&tCheck,con,icomp,nd);
-            self->getSystem()->resetUpToDate();
-            if(self->signChangedWRTsvLast(self->getSystem()->evalsv()))
-              tRoot = tCheck;
-          }
-          if(curTimeAndState != tRoot) {
-            curTimeAndState = tRoot;
-            self->getSystem()->setTime(tRoot);
-            for(int i=1; i<=*n; i++)
-              self->getSystem()->getState()(i-1) = CONTD5(&i,&tRoot,con,icomp,nd);
-          }
+            contd5(tCheck, *told, *t, con, *nd, self->getSystem()->getState()());
+          });
+          curTimeAndState = tRoot;
           self->getSystem()->resetUpToDate();
           auto &sv = self->getSystem()->evalsv();
           auto &jsv = self->getSystem()->getjsv();
@@ -106,8 +105,7 @@ namespace MBSim {
         if(curTimeAndState != self->tPlot) {
           curTimeAndState = self->tPlot;
           self->getSystem()->setTime(self->tPlot);
-          for(int i=1; i<=*n; i++)
-            self->getSystem()->getState()(i-1) = CONTD5(&i,&self->tPlot,con,icomp,nd);
+          contd5(self->tPlot, *told, *t, con, *nd, self->getSystem()->getState()());
         }
         self->getSystem()->resetUpToDate();
         self->getSystem()->plot();
@@ -127,8 +125,7 @@ namespace MBSim {
         // shift the system
         if(curTimeAndState != tRoot) {
           self->getSystem()->setTime(tRoot);
-          for(int i=1; i<=*n; i++)
-            self->getSystem()->getState()(i-1) = CONTD5(&i,&tRoot,con,icomp,nd);
+          contd5(tRoot, *told, *t, con, *nd, self->getSystem()->getState()());
         }
         if(self->plotOnRoot) {
           self->getSystem()->resetUpToDate();
@@ -0,0 +1,390 @@
+/* Copyright (C) 2004-2009 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h>
+#include <mbsim/dynamic_system_solver.h>
+#include <mbsim/utils/eps.h>
+#include "ensemble_dopri5_integrator.h"
+#include <cmath>
+#include <ctime>
+
+#ifndef NO_ISO_14882
+using namespace std;
+#endif
+
+using namespace fmatvec;
+using namespace MBSim;
+using namespace MBXMLUtils;
+using namespace xercesc;
+
+namespace MBSim {
+
+  MBSIM_OBJECTFACTORY_REGISTERCLASS(MBSIM, EnsembleDOPRI5Integrator)
+
+  namespace {
+    // Butcher tableau of Dormand and Prince
+    const double c2=1./5, c3=3./10, c4=4./5, c5=8./9;
+    const double a21=1./5;
+    const double a31=3./40, a32=9./40;
+    const double a41=44./45, a42=-56./15, a43=32./9;
+    const double a51=19372./6561, a52=-25360./2187, a53=64448./6561, a54=-212./729;
+    const double a61=9017./3168, a62=-355./33, a63=46732./5247, a64=49./176, a65=-5103./18656;
+    const double a71=35./384, a73=500./1113, a74=125./192, a75=-2187./6784, a76=11./84;
+    // error estimate
+    const double e1=71./57600, e3=-71./16695, e4=71./1920, e5=-17253./339200, e6=22./525, e7=-1./40;
+    // dense output
+    const double d1=-12715105075./11282082432, d3=87487479700./32700410799, d4=-10690763975./1880347072,
+                 d5=701980252875./199316789632, d6=-1453857185./822651844, d7=69997945./29380423;
+  }
+
+  void EnsembleDOPRI5Integrator::denseOutput(int k, double t, double h, double tt, double *z) {
+    int n = Z.cols();
+    double s = (tt-t)/h;
+    double s1 = 1-s;
+    for(int i=0; i<n; i++) {
+      double dz = Z1(k,i)-Z(k,i);
+      double bspl = h*K1(k,i)-dz;
+      double r4 = dz-h*K7(k,i)-bspl;
+      double r5 = h*(d1*K1(k,i)+d3*K3(k,i)+d4*K4(k,i)+d5*K5(k,i)+d6*K6(k,i)+d7*K7(k,i));
+      z[i] = Z(k,i)+s*(dz+s1*(bspl+s*(r4+s1*r5)));
+    }
+  }
+
+  void EnsembleDOPRI5Integrator::plot(double t, double h, double tr) {
+    loadMember(plotMember);
+    while(tPlot<=tr+epsroot) {
+      system->setTime(tPlot);
+      denseOutput(plotMember, t, h, tPlot, system->getState()());
+      system->resetUpToDate();
+      system->plot();
+      tPlot += dtPlot;
+    }
+  }
+
+  void EnsembleDOPRI5Integrator::loadMember(int k) {
+    if(discrete and loaded!=k)
+      system->setSnapshot(S[k].data());
+    loaded = k;
+  }
+
+  void EnsembleDOPRI5Integrator::evalzd(double t, const Mat &Z_, Mat &ZD) {
+    int n = Z_.cols();
+    for(int k=0; k<Z_.rows(); k++) {
+      loadMember(k);
+      system->setTime(t);
+      Vec &z = system->getState();
+      for(int i=0; i<n; i++)
+        z(i) = Z_(k,i);
+      system->resetUpToDate();
+      const Vec &zd = system->evalzd();
+      for(int i=0; i<n; i++)
+        ZD(k,i) = zd(i);
+    }
+    nrRHS++;
+  }
+
+  void EnsembleDOPRI5Integrator::integrate() {
+    debugInit();
+
+    int n = system->getzSize();
+    if(not n)
+      throwError("(EnsembleDOPRI5Integrator::integrate): dimension of the system must be at least 1");
+    if(dtPlot<=0)
+      throwError("(EnsembleDOPRI5Integrator::integrate): plot step size must be positive");
+
+    if(Z0.rows()) {
+      if(Z0.cols() != n)
+        throwError("(EnsembleDOPRI5Integrator::integrate): number of columns of the initial states does not match, must be " + to_string(n));
+      Z <<= Z0;
+    }
+    else {
+      Z.resize(1,n,NONINIT);
+      Vec z;
+      if(z0.size()) {
+        if(z0.size() != n+system->getisSize())
+          throwError("(EnsembleDOPRI5Integrator::integrate): size of z0 does not match, must be " + to_string(n+system->getisSize()));
+        z <<= z0(RangeV(0,n-1));
+        system->setInternalState(z0(RangeV(n,z0.size()-1)));
+      }
+      else
+        z <<= system->evalz0();
+      for(int i=0; i<n; i++)
+        Z(0,i) = z(i);
+    }
+    int m = Z.rows();
+    if(plotMember<0 or plotMember>=m)
+      throwError("(EnsembleDOPRI5Integrator::integrate): plot member must be in [0," + to_string(m-1) + "]");
+    msg(Info)<<"Ensemble integration of "<<m<<" members."<<endl;
+
+    auto setMemberState = [this, n](double tt, const Mat &A, int k) {
+      system->setTime(tt);
+      Vec &z = system->getState();
+      for(int i=0; i<n; i++)
+        z(i) = A(k,i);
+      system->resetUpToDate();
+    };
+    auto getMemberState = [this, n](Mat &A, int k) {
+      const Vec &z = system->getState();
+      for(int i=0; i<n; i++)
+        A(k,i) = z(i);
+    };
+
+    // Each member starts with the discrete state of the system and computes its own initial condition. Without stop
+    // vector and internal states, the members differ only by the continuous state and no snapshots are needed.
+    double t = tStart;
+    int svSize = system->getsvSize();
+    discrete = svSize or system->getisSize();
+    bool perMember = discrete or gMax>=0 or gdMax>=0;
+    vector<char> S0;
+    if(discrete) {
+      system->setTime(t);
+      S0.resize(system->getSnapshotSize());
+      system->getSnapshot(S0.data());
+      S.assign(m, S0);
+      SvLast.assign(m, Vec());
+    }
+    loaded = -1;
+    for(int k=0; k<m; k++) {
+      if(discrete)
+        system->setSnapshot(S0.data());
+      setMemberState(t, Z, k);
+      system->computeInitialCondition();
+      getMemberState(Z, k); // computeInitialCondition may change the state
+      if(svSize)
+        SvLast[k] <<= system->evalsv();
+      if(discrete)
+        system->getSnapshot(S[k].data());
+      loaded = k;
+    }
+
+    // structure of arrays: all stage updates are contiguous loops over the ensemble
+    for(auto *A : {&Z1, &Zs, &K1, &K2, &K3, &K4, &K5, &K6, &K7})
+      A->resize(m,n,NONINIT);
+    const int N = m*n;
+    double *z = Z(), *z1 = Z1(), *zs = Zs();
+    double *k1 = K1(), *k2 = K2(), *k3 = K3(), *k4 = K4(), *k5 = K5(), *k6 = K6(), *k7 = K7();
+    Vec errMember(m, NONINIT);
+
+    nrRHS = 0;
+    evalzd(t, Z, K1);
+
+    // plot of the initial state
+    tPlot = t;
+    loadMember(plotMember);
+    setMemberState(t, Z, plotMember);
+    system->plot();
+    tPlot += dtPlot;
+
+    auto sk = [this](double zi, double zj) { return aTol+rTol*max(fabs(zi),fabs(zj)); };
+
+    double hMax = dtMax>0 ? dtMax : tEnd-tStart;
+    double h = dt0;
+    if(h<=0) {
+      double dnf = 0, dny = 0;
+      for(int i=0; i<N; i++) {
+        double s = sk(z[i],z[i]);
+        dnf += k1[i]*k1[i]/(s*s);
+        dny += z[i]*z[i]/(s*s);
+      }
+      h = dnf<=1e-10 or dny<=1e-10 ? 1e-6 : 0.01*sqrt(dny/dnf);
+    }
+    h = min(h, hMax);
+
+    int nrSteps = 0, nrRejected = 0, nrRoots = 0;
+    double s0 = clock();
+    while(t<tEnd-epsroot) {
+      if(nrSteps>=maxSteps)
+        throwError("(EnsembleDOPRI5Integrator::integrate): maximum number of steps reached at t = " + to_string(t));
+      if(t+1.01*h>=tEnd)
+        h = tEnd-t;
+      if(stepSizeLimitByTimeOfImpact and svSize) {
+        // the step ends at the earliest predicted impact of all members, so that the root is found in a short step
+        for(int k=0; k<m; k++) {
+          loadMember(k);
+          setMemberState(t, Z, k);
+          h = min(h, evalTimeOfImpact(h));
+        }
+      }
+
+      for(int i=0; i<N; i++) zs[i] = z[i]+h*a21*k1[i];
+      evalzd(t+c2*h, Zs, K2);
+      for(int i=0; i<N; i++) zs[i] = z[i]+h*(a31*k1[i]+a32*k2[i]);
+      evalzd(t+c3*h, Zs, K3);
+      for(int i=0; i<N; i++) zs[i] = z[i]+h*(a41*k1[i]+a42*k2[i]+a43*k3[i]);
+      evalzd(t+c4*h, Zs, K4);
+      for(int i=0; i<N; i++) zs[i] = z[i]+h*(a51*k1[i]+a52*k2[i]+a53*k3[i]+a54*k4[i]);
+      evalzd(t+c5*h, Zs, K5);
+      for(int i=0; i<N; i++) zs[i] = z[i]+h*(a61*k1[i]+a62*k2[i]+a63*k3[i]+a64*k4[i]+a65*k5[i]);
+      evalzd(t+h, Zs, K6);
+      for(int i=0; i<N; i++) z1[i] = z[i]+h*(a71*k1[i]+a73*k3[i]+a74*k4[i]+a75*k5[i]+a76*k6[i]);
+      evalzd(t+h, Z1, K7);
+
+      // RMS error of each member; the step size is controlled by the largest one, hence the tolerances hold for every
+      // member and not only on average over the ensemble
+      errMember.init(0);
+      for(int i=0; i<N; i++) {
+        double e = h*(e1*k1[i]+e3*k3[i]+e4*k4[i]+e5*k5[i]+e6*k6[i]+e7*k7[i])/sk(z[i],z1[i]);
+        errMember(i%m) += e*e;
+      }
+      double err = 0;
+      for(int k=0; k<m; k++)
+        err = max(err, sqrt(errMember(k)/n));
+      double fac = min(10., max(0.2, 0.9*pow(max(err,1e-10),-0.2)));
+      nrSteps++;
+
+      if(err<=1) {
+        // root-finding: the step of all members is truncated at the earliest root of any member
+        double tr = t+h;
+        bool root = false;
+        if(svSize) {
+          for(int k=0; k<m; k++) {
+            loadMember(k);
+            setMemberState(t+h, Z1, k);
+            svLast <<= SvLast[k];
+            if(signChangedWRTsvLast(system->evalsv())) {
+              root = true;
+              tr = min(tr, findRoot(t, t+h, [this, k, t, h](double tt) {
+                system->setTime(tt);
+                denseOutput(k, t, h, tt, system->getState()());
+              }));
+            }
+          }
+        }
+
+        plot(t, h, tr);
+
+        bool fsal = not root;
+        if(perMember) {
+          for(int k=0; k<m; k++) {
+            loadMember(k);
+            if(root) {
+              system->setTime(tr);
+              denseOutput(k, t, h, tr, system->getState()());
+              system->resetUpToDate();
+            }
+            else
+              setMemberState(tr, Z1, k);
+            bool shiftMember = false;
+            if(root) {
+              const Vec &sv = system->evalsv();
+              auto &jsv = system->getjsv();
+              for(int i=0; i<sv.size(); i++) {
+                jsv(i) = SvLast[k](i)*sv(i)<0;
+                if(jsv(i))
+                  shiftMember = true;
+              }
+            }
+            if(shiftMember) {
+              nrRoots++;
+              if(plotOnRoot and k==plotMember) {
+                system->resetUpToDate();
+                system->plot();
+              }
+              system->resetUpToDate();
+              system->shift();
+              if(plotOnRoot and k==plotMember) {
+                system->resetUpToDate();
+                system->plot();
+              }
+            }
+            else {
+              // check drift
+              bool projVel = true;
+              if(gMax>=0 and system->positionDriftCompensationNeeded(gMax)) { // project both, first positions and then velocities
+                system->projectGeneralizedPositions(3);
+                system->projectGeneralizedVelocities(3);
+                projVel = false;
+                fsal = false;
+              }
+              if(gdMax>=0 and projVel) {
+                system->resetUpToDate();
+                if(system->velocityDriftCompensationNeeded(gdMax)) { // project velicities
+                  system->projectGeneralizedVelocities(3);
+                  fsal = false;
+                }
+              }
+              system->updateStopVectorParameters();
+            }
+            system->updateInternalState();
+            if(svSize) {
+              system->resetUpToDate();
+              SvLast[k] <<= system->evalsv();
+            }
+            getMemberState(Z, k);
+            if(discrete)
+              system->getSnapshot(S[k].data());
+          }
+        }
+        else {
+          for(int i=0; i<N; i++)
+            z[i] = z1[i];
+        }
+        t = tr;
+        // first same as last does not hold if a member is shifted or projected
+        if(fsal) {
+          for(int i=0; i<N; i++)
+            k1[i] = k7[i];
+        }
+        else
+          evalzd(t, Z, K1);
+        h = min(h*fac, hMax);
+        if(msgAct(Status)) msg(Status)<<"   t = "<<t<<",\tdt = "<<h<<flush;
+      }
+      else {
+        nrRejected++;
+        h *= min(1., fac);
+      }
+      if(h<=epsroot*max(1.,fabs(t)))
+        throwError("(EnsembleDOPRI5Integrator::integrate): step size too small at t = " + to_string(t));
+    }
+    double time = (clock()-s0)/CLOCKS_PER_SEC;
+
+    // the system is left at the final state of the plotted member
+    loadMember(plotMember);
+    setMemberState(t, Z, plotMember);
+
+    msg(Info)<<"nrRHS (ensemble): "<<nrRHS<<endl;
+    msg(Info)<<"nrSteps: "<<nrSteps<<endl;
+    msg(Info)<<"nrStepsAccepted: "<<nrSteps-nrRejected<<endl;
+    msg(Info)<<"nrStepsRejected: "<<nrRejected<<endl;
+    if(svSize)
+      msg(Info)<<"nrShifts (all members): "<<nrRoots<<endl;
+    msg(Info)<<"Time used for integration: "<<time<<" s"<<endl;
+  }
+
+  void EnsembleDOPRI5Integrator::initializeUsingXML(DOMElement *element) {
+    RootFindingIntegrator::initializeUsingXML(element);
+    DOMElement *e;
+    e=E(element)->getFirstElementChildNamed(MBSIM%"initialStates");
+    if(e) setInitialStates(E(e)->getText<Mat>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"absoluteToleranceScalar");
+    if(e) setAbsoluteTolerance(E(e)->getText<double>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"relativeToleranceScalar");
+    if(e) setRelativeTolerance(E(e)->getText<double>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"initialStepSize");
+    if(e) setInitialStepSize(E(e)->getText<double>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"maximumStepSize");
+    if(e) setMaximumStepSize(E(e)->getText<double>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"stepLimit");
+    if(e) setStepLimit(E(e)->getText<int>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"plotMember");
+    if(e) setPlotMember(E(e)->getText<int>());
+  }
+
+}
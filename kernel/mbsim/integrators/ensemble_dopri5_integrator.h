@@ -0,0 +1,101 @@
+/* Copyright (C) 2004-2009 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _ENSEMBLE_DOPRI5_INTEGRATOR_H_
+#define _ENSEMBLE_DOPRI5_INTEGRATOR_H_
+
+#include "root_finding_integrator.h"
+#include <vector>
+
+namespace MBSim {
+
+  /** \brief Explicit Runge-Kutta method of order 5(4) (Dormand and Prince) for an ensemble of initial states
+   *
+   * All members of the ensemble are integrated in lockstep with a common step size, which is controlled by the
+   * largest (RMS) error of the members. The states and stage values are stored as structure of arrays (row k is the
+   * member k), hence the Runge-Kutta updates are contiguous loops over the whole ensemble. The right hand sides are
+   * evaluated member by member.
+   * Systems with a stop vector or internal states are supported: each member keeps its own discrete state (active
+   * sets, internal states) as snapshot of the system. An accepted step is truncated at the earliest root of all
+   * members, which is found by the dense output; then each member with a root is shifted.
+   * The trajectory of one member is plotted by the dense output of order 4; the final states of all members are
+   * available by getStates().
+   */
+  class EnsembleDOPRI5Integrator : public RootFindingIntegrator {
+    public:
+      ~EnsembleDOPRI5Integrator() override = default;
+
+      void setInitialStates(const fmatvec::Mat &Z0_) { Z0 <<= Z0_; }
+      void setAbsoluteTolerance(double aTol_) { aTol = aTol_; }
+      void setRelativeTolerance(double rTol_) { rTol = rTol_; }
+      void setInitialStepSize(double dt0_) { dt0 = dt0_; }
+      void setMaximumStepSize(double dtMax_) { dtMax = dtMax_; }
+      void setStepLimit(int maxSteps_) { maxSteps = maxSteps_; }
+      void setPlotMember(int plotMember_) { plotMember = plotMember_; }
+
+      //! states of all members at the end of the integration (row k is the member k)
+      const fmatvec::Mat& getStates() const { return Z; }
+
+      using Integrator::integrate;
+      void integrate() override;
+
+      void initializeUsingXML(xercesc::DOMElement *element) override;
+
+    private:
+      //! state of the member k at time tt in the step [t,t+h] by the dense output
+      void denseOutput(int k, double t, double h, double tt, double *z);
+
+      //! plot the member plotMember at all plot times up to tr by the dense output of the step [t,t+h]
+      void plot(double t, double h, double tr);
+
+      //! load the discrete state of the member k into the system
+      void loadMember(int k);
+
+      //! evaluate the state derivatives of all members at time t
+      void evalzd(double t, const fmatvec::Mat &Z_, fmatvec::Mat &ZD);
+
+      /** initial states (row k is the member k); if not given, the ensemble consists of the initial state of the system */
+      fmatvec::Mat Z0;
+      /** absolute tolerance */
+      double aTol{1e-6};
+      /** relative tolerance */
+      double rTol{1e-6};
+      /** step size for the first step */
+      double dt0{0};
+      /** maximal step size */
+      double dtMax{0};
+      /** maximum number of steps */
+      int maxSteps{std::numeric_limits<int>::max()};
+      /** member of the ensemble which is plotted */
+      int plotMember{0};
+
+      double tPlot{0};
+      fmatvec::Mat Z, Z1, Zs, K1, K2, K3, K4, K5, K6, K7;
+      /** each member has a discrete state (snapshot of the system and stop vector at the last step) */
+      bool discrete{false};
+      std::vector<std::vector<char>> S;
+      std::vector<fmatvec::Vec> SvLast;
+      /** member whose discrete state is loaded into the system */
+      int loaded{-1};
+      int nrRHS{0};
+  };
+
+}
+
+#endif
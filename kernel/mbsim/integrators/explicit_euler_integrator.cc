@@ -21,6 +21,7 @@
 #include <mbsim/dynamic_system_solver.h>
 #include "explicit_euler_integrator.h"
 #include <ctime>
+#include <cstring>
 
 #ifndef NO_ISO_14882
 using namespace std;
@@ -93,6 +94,34 @@ namespace MBSim {
   void ExplicitEulerIntegrator::postIntegrate() {
   }
 
+  namespace {
+    struct ExplicitEulerIntegratorSnapshot {
+      double tPlot;
+      int step;
+      int integrationSteps;
+    };
+  }
+
+  size_t ExplicitEulerIntegrator::getSnapshotSize() const {
+    return sizeof(ExplicitEulerIntegratorSnapshot);
+  }
+
+  void ExplicitEulerIntegrator::getSnapshot(char *snapshot) const {
+    ExplicitEulerIntegratorSnapshot s;
+    s.tPlot = tPlot;
+    s.step = step;
+    s.integrationSteps = integrationSteps;
+    memcpy(snapshot, &s, sizeof(s));
+  }
+
+  void ExplicitEulerIntegrator::setSnapshot(const char *snapshot) {
+    ExplicitEulerIntegratorSnapshot s;
+    memcpy(&s, snapshot, sizeof(s));
+    tPlot = s.tPlot;
+    step = s.step;
+    integrationSteps = s.integrationSteps;
+  }
+
   void ExplicitEulerIntegrator::integrate() {
     preIntegrate();
     subIntegrate(tEnd);
@@ -35,6 +35,9 @@ namespace MBSim {
       void preIntegrate() override;
       void subIntegrate(double tStop) override;
       void postIntegrate() override;
+      size_t getSnapshotSize() const override;
+      void getSnapshot(char *snapshot) const override;
+      void setSnapshot(const char *snapshot) override;
 
       /* INHERITED INTERFACE OF INTEGRATOR */
       using Integrator::integrate;
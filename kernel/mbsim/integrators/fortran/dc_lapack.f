@@ -20,7 +20,7 @@ C ---  B=IDENTITY, JACOBIAN A FULL MATRIX
          END DO
          E1(J,J)=E1(J,J)+FAC1
       END DO
-      CALL DGETRF (N,N,E1,LDE1,IP1,IER)
+      CALL MBDGETRF(N,N,E1,LDE1,IP1,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -44,7 +44,7 @@ C ---  B=IDENTITY, JACOBIAN A FULL MATRIX, SECOND ORDER
             E1(I,J)=E1(I,J)-SUM
          END DO
       END DO
-      CALL DGETRF (NM1,NM1,E1,LDE1,IP1,IER)
+      CALL MBDGETRF(NM1,NM1,E1,LDE1,IP1,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -96,7 +96,7 @@ C ---  B IS A BANDED MATRIX, JACOBIAN A FULL MATRIX
             E1(I,J)=E1(I,J)+FAC1*FMAS(I-J+MBDIAG,J)
          END DO
       END DO
-      CALL DGETRF (N,N,E1,LDE1,IP1,IER)
+      CALL MBDGETRF(N,N,E1,LDE1,IP1,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -155,7 +155,7 @@ C ---  B IS A FULL MATRIX, JACOBIAN A FULL MATRIX
             E1(I,J)=FMAS(I,J)*FAC1-FJAC(I,J)
          END DO
       END DO
-      CALL DGETRF (N,N,E1,LDE1,IP1,IER)
+      CALL MBDGETRF(N,N,E1,LDE1,IP1,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -215,7 +215,7 @@ C ---  B=IDENTITY, JACOBIAN A FULL MATRIX
          END DO
          E2R(J,J)=E2R(J,J)+DCMPLX(ALPHN,BETAN)
       END DO
-      CALL ZGETRF (N,N,E2R,LDE1,IP2,IER)
+      CALL MBZGETRF(N,N,E2R,LDE1,IP2,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -239,7 +239,7 @@ C ---  B=IDENTITY, JACOBIAN A FULL MATRIX, SECOND ORDER
             E2R(I,J)=E2R(I,J)-ZSUM
          END DO
       END DO
-      CALL ZGETRF (NM1,NM1,E2R,LDE1,IP2,IER)
+      CALL MBZGETRF(NM1,NM1,E2R,LDE1,IP2,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -292,7 +292,7 @@ C ---  B IS A BANDED MATRIX, JACOBIAN A FULL MATRIX
             E2R(I,J)=E2R(I,J)+DCMPLX(ALPHN,BETAN)*FMAS(I-J+MBDIAG,J)
          END DO
       END DO
-      CALL ZGETRF (N,N,E2R,LDE1,IP2,IER)
+      CALL MBZGETRF(N,N,E2R,LDE1,IP2,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -351,7 +351,7 @@ C ---  B IS A FULL MATRIX, JACOBIAN A FULL MATRIX
             E2R(I,J)=DCMPLX(ALPHN,BETAN)*FMAS(I,J)-FJAC(I,J)
          END DO
       END DO
-      CALL ZGETRF (N,N,E2R,LDE1,IP2,IER)
+      CALL MBZGETRF(N,N,E2R,LDE1,IP2,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -407,7 +407,7 @@ C ---  B=IDENTITY, JACOBIAN A FULL MATRIX
       DO I=1,N
          Z1(I)=Z1(I)-F1(I)*FAC1
       END DO
-      CALL DGETRS ('No transpose',N,1,E1,LDE1,IP1,Z1,N,IER)
+      CALL MBDGETRS(N,1,E1,LDE1,IP1,Z1,N,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -430,7 +430,7 @@ C ---  B=IDENTITY, JACOBIAN A FULL MATRIX, SECOND ORDER
             END DO
          END DO
       END DO
-      CALL DGETRS ('No transpose',NM1,1,E1,LDE1,IP1,Z1(M1+1),NM1,IER)
+      CALL MBDGETRS(NM1,1,E1,LDE1,IP1,Z1(M1+1),NM1,IER)
  49   CONTINUE
       DO I=M1,1,-1
          Z1(I)=(Z1(I)+Z1(M2+I))/FAC1
@@ -482,7 +482,7 @@ C ---  B IS A BANDED MATRIX, JACOBIAN A FULL MATRIX
          END DO
          Z1(I)=Z1(I)+S1*FAC1
       END DO
-      CALL DGETRS ('No transpose',N,1,E1,LDE1,IP1,Z1,N,IER)
+      CALL MBDGETRS(N,1,E1,LDE1,IP1,Z1,N,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -528,7 +528,7 @@ C ---  B IS A FULL MATRIX, JACOBIAN A FULL MATRIX
          END DO
          Z1(I)=Z1(I)+S1*FAC1
       END DO
-      CALL DGETRS ('No transpose',N,1,E1,LDE1,IP1,Z1,N,IER)
+      CALL MBDGETRS(N,1,E1,LDE1,IP1,Z1,N,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -597,7 +597,7 @@ C ---  B=IDENTITY, JACOBIAN A FULL MATRIX
          Z2(2*I-1)=Z2(I)
          Z2(2*I)=CONT(I)
       END DO
-      CALL ZGETRS ('No transpose',N,1,E2R,LDE1,IP2,Z2,N,IER)
+      CALL MBZGETRS(N,1,E2R,LDE1,IP2,Z2,N,IER)
       DO I=1,N
          CONT(I)=Z2(2*I)
          Z2(I)=Z2(2*I-1)
@@ -639,7 +639,7 @@ C ---  B=IDENTITY, JACOBIAN A FULL MATRIX, SECOND ORDER
          Z2(2*I-1)=Z2(I)
          Z2(2*I)=CONT(I)
       END DO
-      CALL ZGETRS ('No transpose',NM1,1,E2R,LDE1,IP2,Z2(2*M1+1),NM1,IER)
+      CALL MBZGETRS(NM1,1,E2R,LDE1,IP2,Z2(2*M1+1),NM1,IER)
  49   CONTINUE
       DO I=M1+1,N
          CONT(I)=Z2(2*I)
@@ -737,7 +737,7 @@ C ---  B IS A BANDED MATRIX, JACOBIAN A FULL MATRIX
          Z2(2*I-1)=Z2(I)
          Z2(2*I)=CONT(I)
       END DO
-      CALL ZGETRS ('No transpose',N,1,E2R,LDE1,IP2,Z2,N,IER)
+      CALL MBZGETRS(N,1,E2R,LDE1,IP2,Z2,N,IER)
       DO I=1,N
          CONT(I)=Z2(2*I)
          Z2(I)=Z2(2*I-1)
@@ -821,7 +821,7 @@ C ---  B IS A FULL MATRIX, JACOBIAN A FULL MATRIX
          Z2(2*I-1)=Z2(I)
          Z2(2*I)=CONT(I)
       END DO
-      CALL ZGETRS ('No transpose',N,1,E2R,LDE1,IP2,Z2,N,IER)
+      CALL MBZGETRS(N,1,E2R,LDE1,IP2,Z2,N,IER)
       DO I=1,N
          CONT(I)=Z2(2*I)
          Z2(I)=Z2(2*I-1)
@@ -907,8 +907,8 @@ C ---  B=IDENTITY, JACOBIAN A FULL MATRIX
          Z2(2*I-1)=Z2(I)
          Z2(2*I)=CONT(I)
       END DO
-      CALL DGETRS ('No transpose',N,1,E1,LDE1,IP1,Z1,N,IER)
-      CALL ZGETRS ('No transpose',N,1,E2R,LDE1,IP2,Z2,N,IER)
+      CALL MBDGETRS(N,1,E1,LDE1,IP1,Z1,N,IER)
+      CALL MBZGETRS(N,1,E2R,LDE1,IP2,Z2,N,IER)
       DO I=1,N
          CONT(I)=Z2(2*I)
          Z2(I)=Z2(2*I-1)
@@ -954,8 +954,8 @@ C ---  B=IDENTITY, JACOBIAN A FULL MATRIX, SECOND ORDER
          Z2(2*I-1)=Z2(I)
          Z2(2*I)=CONT(I)
       END DO
-      CALL DGETRS ('No transpose',NM1,1,E1,LDE1,IP1,Z1(M1+1),NM1,IER)
-      CALL ZGETRS ('No transpose',NM1,1,E2R,LDE1,IP2,Z2(2*M1+1),NM1,IER)
+      CALL MBDGETRS(NM1,1,E1,LDE1,IP1,Z1(M1+1),NM1,IER)
+      CALL MBZGETRS(NM1,1,E2R,LDE1,IP2,Z2(2*M1+1),NM1,IER)
  49   CONTINUE
       DO I=M1+1,N
          CONT(I)=Z2(2*I)
@@ -1067,8 +1067,8 @@ C ---  B IS A BANDED MATRIX, JACOBIAN A FULL MATRIX
          Z2(2*I-1)=Z2(I)
          Z2(2*I)=CONT(I)
       END DO
-      CALL DGETRS ('No transpose',N,1,E1,LDE1,IP1,Z1,N,IER)
-      CALL ZGETRS ('No transpose',N,1,E2R,LDE1,IP2,Z2,N,IER)
+      CALL MBDGETRS(N,1,E1,LDE1,IP1,Z1,N,IER)
+      CALL MBZGETRS(N,1,E2R,LDE1,IP2,Z2,N,IER)
       DO I=1,N
          CONT(I)=Z2(2*I)
          Z2(I)=Z2(2*I-1)
@@ -1167,8 +1167,8 @@ C ---  B IS A FULL MATRIX, JACOBIAN A FULL MATRIX
          Z2(2*I-1)=Z2(I)
          Z2(2*I)=CONT(I)
       END DO
-      CALL DGETRS ('No transpose',N,1,E1,LDE1,IP1,Z1,N,IER)
-      CALL ZGETRS ('No transpose',N,1,E2R,LDE1,IP2,Z2,N,IER)
+      CALL MBDGETRS(N,1,E1,LDE1,IP1,Z1,N,IER)
+      CALL MBZGETRS(N,1,E2R,LDE1,IP2,Z2,N,IER)
       DO I=1,N
          CONT(I)=Z2(2*I)
          Z2(I)=Z2(2*I-1)
@@ -1252,7 +1252,7 @@ C ------  B=IDENTITY, JACOBIAN A FULL MATRIX
          F2(I)=HEE1*Z1(I)+HEE2*Z2(I)+HEE3*Z3(I)
          CONT(I)=F2(I)+Y0(I)
       END DO
-      CALL DGETRS ('No transpose',N,1,E1,LDE1,IP1,CONT,LDE1,IER)
+      CALL MBDGETRS(N,1,E1,LDE1,IP1,CONT,LDE1,IER)
       GOTO 77
 C
   11  CONTINUE
@@ -1272,7 +1272,7 @@ C ------  B=IDENTITY, JACOBIAN A FULL MATRIX, SECOND ORDER
             END DO
          END DO
       END DO
-      CALL DGETRS ('No transpose',NM1,1,E1,LDE1,IP1,CONT(M1+1),NM1,IER)
+      CALL MBDGETRS(NM1,1,E1,LDE1,IP1,CONT(M1+1),NM1,IER)
       DO I=M1,1,-1
          CONT(I)=(CONT(I)+CONT(M2+I))/FAC1
       END DO
@@ -1324,7 +1324,7 @@ C ------  B IS A BANDED MATRIX, JACOBIAN A FULL MATRIX
          F2(I)=SUM
          CONT(I)=SUM+Y0(I)
       END DO
-      CALL DGETRS ('No transpose',N,1,E1,LDE1,IP1,CONT,LDE1,IER)
+      CALL MBDGETRS(N,1,E1,LDE1,IP1,CONT,LDE1,IER)
       GOTO 77
 C
   13  CONTINUE
@@ -1396,7 +1396,7 @@ C ------  B IS A FULL MATRIX, JACOBIAN A FULL MATRIX
          F2(I)=SUM
          CONT(I)=SUM+Y0(I)
       END DO
-      CALL DGETRS ('No transpose',N,1,E1,LDE1,IP1,CONT,LDE1,IER)
+      CALL MBDGETRS(N,1,E1,LDE1,IP1,CONT,LDE1,IER)
       GOTO 77
 C
   15  CONTINUE
@@ -1451,7 +1451,7 @@ C
           GOTO (31,32,31,32,31,32,55,55,55,55,41,42,41,42,41), IJOB
 C ------ FULL MATRIX OPTION
  31      CONTINUE
-          CALL DGETRS('No transpose',N,1,E1,LDE1,IP1,CONT,N,IER)
+          CALL MBDGETRS(N,1,E1,LDE1,IP1,CONT,N,IER)
           GOTO 88
 C ------ FULL MATRIX OPTION, SECOND ORDER
  41      CONTINUE
@@ -1465,7 +1465,7 @@ C ------ FULL MATRIX OPTION, SECOND ORDER
                END DO
             END DO
          END DO
-         CALL DGETRS ('No transpose',NM1,1,E1,LDE1,IP1,
+         CALL MBDGETRS(NM1,1,E1,LDE1,IP1,
      &                 CONT(M1+1),NM1,IER)
          DO I=M1,1,-1
             CONT(I)=(CONT(I)+CONT(M2+I))/FAC1
@@ -1535,7 +1535,7 @@ C ------  B=IDENTITY, JACOBIAN A FULL MATRIX
          FF(I+N)=SUM/H
          CONT(I)=FF(I+N)+Y0(I)
       END DO
-      CALL DGETRS ('No transpose',N,1,E1,LDE1,IP1,CONT,LDE1,IER)
+      CALL MBDGETRS(N,1,E1,LDE1,IP1,CONT,LDE1,IER)
       GOTO 77
 C
   11  CONTINUE
@@ -1559,7 +1559,7 @@ C ------  B=IDENTITY, JACOBIAN A FULL MATRIX, SECOND ORDER
             END DO
          END DO
       END DO
-      CALL DGETRS ('No transpose',NM1,1,E1,LDE1,IP1,CONT(M1+1),NM1,IER)
+      CALL MBDGETRS(NM1,1,E1,LDE1,IP1,CONT(M1+1),NM1,IER)
       DO I=M1,1,-1
          CONT(I)=(CONT(I)+CONT(M2+I))/FAC1
       END DO
@@ -1623,7 +1623,7 @@ C ------  B IS A BANDED MATRIX, JACOBIAN A FULL MATRIX
          FF(I+N)=SUM
          CONT(I)=SUM+Y0(I)
       END DO
-      CALL DGETRS ('No transpose',N,1,E1,LDE1,IP1,CONT,LDE1,IER)
+      CALL MBDGETRS(N,1,E1,LDE1,IP1,CONT,LDE1,IER)
       GOTO 77
 C
   13  CONTINUE
@@ -1719,7 +1719,7 @@ C ------  B IS A FULL MATRIX, JACOBIAN A FULL MATRIX
          FF(I+N)=SUM
          CONT(I)=SUM+Y0(I)
       END DO
-      CALL DGETRS ('No transpose',N,1,E1,LDE1,IP1,CONT,LDE1,IER)
+      CALL MBDGETRS(N,1,E1,LDE1,IP1,CONT,LDE1,IER)
       GOTO 77
 C
   15  CONTINUE
@@ -1782,7 +1782,7 @@ C
           GOTO (31,32,31,32,31,32,33,55,55,55,41,42,41,42,41), IJOB
 C ------ FULL MATRIX OPTION
  31      CONTINUE
-          CALL DGETRS('No transpose',N,1,E1,LDE1,IP1,CONT,N,IER)
+          CALL MBDGETRS(N,1,E1,LDE1,IP1,CONT,N,IER)
           GOTO 88
 C ------ FULL MATRIX OPTION, SECOND ORDER
  41      CONTINUE
@@ -1796,7 +1796,7 @@ C ------ FULL MATRIX OPTION, SECOND ORDER
                END DO
             END DO
          END DO
-         CALL DGETRS ('No transpose',NM1,1,E1,LDE1,IP1,
+         CALL MBDGETRS(NM1,1,E1,LDE1,IP1,
      &                 CONT(M1+1),NM1,IER)
          DO I=M1,1,-1
             CONT(I)=(CONT(I)+CONT(M2+I))/FAC1
@@ -1877,7 +1877,7 @@ C ---  B=IDENTITY, JACOBIAN A FULL MATRIX
             AK(I)=AK(I)+YNEW(I)
          END DO
       END IF
-      CALL DGETRS ('No transpose',N,1,E,LDE,IP,AK,N,IER)
+      CALL MBDGETRS(N,1,E,LDE,IP,AK,N,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -1901,7 +1901,7 @@ C ---  B=IDENTITY, JACOBIAN A FULL MATRIX, SECOND ORDER
             END DO
          END DO
       END DO
-      CALL DGETRS ('No transpose',NM1,1,E,LDE,IP,AK(M1+1),NM1,IER)
+      CALL MBDGETRS(NM1,1,E,LDE,IP,AK(M1+1),NM1,IER)
       DO I=M1,1,-1
          AK(I)=(AK(I)+AK(M2+I))/FAC1
       END DO
@@ -1960,7 +1960,7 @@ C ---  B IS A BANDED MATRIX, JACOBIAN A FULL MATRIX
          AK(I)=AK(I)+SUM
       END DO
       END IF
-      CALL DGETRS ('No transpose',N,1,E,LDE,IP,AK,N,IER)
+      CALL MBDGETRS(N,1,E,LDE,IP,AK,N,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -2012,7 +2012,7 @@ C ---  B IS A FULL MATRIX, JACOBIAN A FULL MATRIX
          AK(I)=AK(I)+SUM
       END DO
       END IF
-      CALL DGETRS ('No transpose',N,1,E,LDE,IP,AK,N,IER)
+      CALL MBDGETRS(N,1,E,LDE,IP,AK,N,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -2058,7 +2058,7 @@ C -----------------------------------------------------------
 C
    1  CONTINUE
 C ---  B=IDENTITY, JACOBIAN A FULL MATRIX
-      CALL DGETRS ('No transpose',N,1,E,LDE,IP,DEL,N,IER)
+      CALL MBDGETRS(N,1,E,LDE,IP,DEL,N,IER)
       RETURN
 C
 C -----------------------------------------------------------
@@ -2077,7 +2077,7 @@ C ---  B=IDENTITY, JACOBIAN A FULL MATRIX, SECOND ORDER
             END DO
          END DO
       END DO
-      CALL DGETRS ('No transpose',NM1,1,E,LDE,IP,DEL(M1+1),NM1,IER)
+      CALL MBDGETRS(NM1,1,E,LDE,IP,DEL(M1+1),NM1,IER)
       DO I=M1,1,-1
          DEL(I)=(DEL(I)+DEL(M2+I))/FAC1
       END DO
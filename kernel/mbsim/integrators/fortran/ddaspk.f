@@ -4536,7 +4536,7 @@ C
 C
 C     Do dense-matrix LU decomposition on J.
 C
-230      CALL DGEFA(WM,NEQ,NEQ,IWM(LIPVT),IER)
+230      CALL MBDGEFA(WM,NEQ,NEQ,IWM(LIPVT),IER)
       RETURN
 C
 C
@@ -4641,7 +4641,7 @@ C
 C
 C     Dense matrix.
 C
-100   CALL DGESL(WM,NEQ,NEQ,IWM(LIPVT),DELTA,0)
+100   CALL MBDGESL(WM,NEQ,NEQ,IWM(LIPVT),DELTA,0)
       RETURN
 C
 C     Dummy section for MTYPE=3.
@@ -124,6 +124,25 @@ void PHEM56(int*,int*,int*,int*,void(*)(int*,int*,int*,int*,int*,int*,int*,int*,
 #define POL4 FC_FUNC(pol4,POL4)
 double POL4(int*,int*,int*,int*,int*,int*,double*,double*);
 
+// linear algebra of the iteration matrices called by the Fortran codes (see sparse_linear_solver.cc)
+#define MBDGETRF FC_FUNC(mbdgetrf,MBDGETRF)
+void MBDGETRF(int*,int*,double*,int*,int*,int*);
+
+#define MBDGETRS FC_FUNC(mbdgetrs,MBDGETRS)
+void MBDGETRS(int*,int*,double*,int*,int*,double*,int*,int*);
+
+#define MBZGETRF FC_FUNC(mbzgetrf,MBZGETRF)
+void MBZGETRF(int*,int*,double*,int*,int*,int*);
+
+#define MBZGETRS FC_FUNC(mbzgetrs,MBZGETRS)
+void MBZGETRS(int*,int*,double*,int*,int*,double*,int*,int*);
+
+#define MBDGEFA FC_FUNC(mbdgefa,MBDGEFA)
+void MBDGEFA(double*,int*,int*,int*,int*);
+
+#define MBDGESL FC_FUNC(mbdgesl,MBDGESL)
+void MBDGESL(double*,int*,int*,int*,double*,int*);
+
 // END: Define as extern "C" if using a C++ compiler
 #ifdef __cplusplus
 }
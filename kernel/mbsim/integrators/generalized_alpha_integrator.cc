@@ -0,0 +1,539 @@
+/* Copyright (C) 2004-2009 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h>
+#include <mbsim/dynamic_system_solver.h>
+#include <mbsim/utils/eps.h>
+#include <mbsim/links/contact.h>
+#include "generalized_alpha_integrator.h"
+#include <ctime>
+#include <cstring>
+
+#ifndef NO_ISO_14882
+using namespace std;
+#endif
+
+using namespace fmatvec;
+using namespace MBSim;
+using namespace MBXMLUtils;
+using namespace xercesc;
+
+namespace MBSim {
+
+  MBSIM_OBJECTFACTORY_REGISTERCLASS(MBSIM, GeneralizedAlphaIntegrator)
+
+  void GeneralizedAlphaIntegrator::reinit() {
+    // the bilateral position constraints (e.g. joints and closed contacts in normal direction) are treated on position
+    // level (index 3), all other constraints (e.g. sticking friction) on velocity level (index 2)
+    system->calcgdSize(3); // IH
+    system->updategdRef(system->getgdParent());
+    system->calcgSize(2); // IB
+    system->updategRef(system->getgParent());
+    laPos.clear();
+    gPos.clear();
+    laVel.clear();
+    gdVel.clear();
+    auto addRows = [this](const Link *l) {
+      if(not l->getlaSize())
+        return;
+      // the first gSize entries of la belong to the position constraints; la and gd have the same structure
+      if(l->getgSize()>l->getlaSize() or l->getgdSize()!=l->getlaSize())
+        throwError("(GeneralizedAlphaIntegrator::integrate): the constraints of "+l->getPath()+" (size of la "+to_string(l->getlaSize())+
+                   ", g "+to_string(l->getgSize())+", gd "+to_string(l->getgdSize())+") can not be handled");
+      for(int i=0; i<l->getgSize(); i++) {
+        laPos.push_back(l->getlaInd()+i);
+        gPos.push_back(l->getgInd()+i);
+      }
+      for(int i=l->getgSize(); i<l->getlaSize(); i++) {
+        laVel.push_back(l->getlaInd()+i);
+        gdVel.push_back(l->getgdInd()+i);
+      }
+    };
+    for(auto &l : system->getLinks()) {
+      if(auto *c = dynamic_cast<Contact*>(l)) {
+        for(auto &sc : c->getSubcontacts())
+          addRows(&sc);
+      }
+      else
+        addRows(l);
+    }
+    if(int(laPos.size()+laVel.size())!=system->getlaSize())
+      throwError("(GeneralizedAlphaIntegrator::integrate): the constraints of the system can not be assigned to position or velocity level");
+
+    int nu = system->getuSize();
+    int nx = system->getxSize();
+    int nla = system->getlaSize();
+    Rdu = RangeV(0,nu-1);
+    Ryx = RangeV(nu,nu+nx-1);
+    Rla = RangeV(nu+nx,nu+nx+nla-1);
+
+    // consistent accelerations and constraint forces
+    system->resetUpToDate();
+    la <<= system->evalla();
+    const Vec &zd = system->evalzd();
+    du <<= zd(Ru);
+    a <<= du;
+    xd <<= zd(Rx);
+
+    y.resize(nu+nx+nla,NONINIT);
+    JUpToDate = false;
+    patternUpToDate = false;
+  }
+
+  void GeneralizedAlphaIntegrator::setState(const Vec &y) {
+    a1 = aPred + betap*y(Rdu);
+    system->setTime(t+h);
+    Vec &zs = system->getState();
+    zs.set(Rq, z(Rq) + h*T*(z(Ru) + (h*(0.5-beta))*a + (h*beta)*a1));
+    zs.set(Ru, z(Ru) + (h*(1-gamma))*a + (h*gamma)*a1);
+    zs.set(Rx, y(Ryx));
+    system->resetUpToDate();
+    system->setla(y(Rla));
+    system->setUpdatela(false);
+  }
+
+  void GeneralizedAlphaIntegrator::residual(const Vec &y, Vec &r) {
+    setState(y);
+    // the equations of motion are not multiplied by the inverse mass matrix; hence, the rows of du couple only the
+    // entries which are coupled by M, the elements and the links (sparse iteration matrix)
+    r.set(Rdu, system->evalM()*y(Rdu) - system->evalh() - system->evalr());
+    if(system->getxSize()) {
+      const Vec &zd = system->evalzd();
+      r.set(Ryx, y(Ryx) - z(Rx) - h*(gamma*zd(Rx) + (1-gamma)*xd));
+    }
+    // g and gd are scaled by the derivative of q and u with respect to du to get a well conditioned iteration matrix
+    if(not laPos.empty()) {
+      const Vec &g = system->evalg();
+      for(size_t i=0; i<laPos.size(); i++)
+        r(Rla.start()+laPos[i]) = g(gPos[i])/(betap*beta*h*h);
+    }
+    if(not laVel.empty()) {
+      const Vec &gd = system->evalgd();
+      for(size_t i=0; i<laVel.size(); i++)
+        r(Rla.start()+laVel[i]) = gd(gdVel[i])/(betap*gamma*h);
+    }
+  }
+
+  void GeneralizedAlphaIntegrator::colourPattern() {
+    // greedy colouring: the columns of one colour have no common row and are perturbed by one residual evaluation
+    int nc = pattern.size();
+    vector<vector<int>> rowCols(y.size());
+    for(int c=0; c<nc; c++)
+      for(int r : pattern[c])
+        rowCols[r].push_back(c);
+    vector<int> colour(nc,-1), forbidden;
+    colours.clear();
+    for(int c=0; c<nc; c++) {
+      for(int r : pattern[c])
+        for(int c2 : rowCols[r])
+          if(colour[c2]>=0)
+            forbidden[colour[c2]] = c;
+      size_t k = 0;
+      while(k<colours.size() and forbidden[k]==c)
+        k++;
+      if(k==colours.size()) {
+        colours.emplace_back();
+        forbidden.push_back(-1);
+      }
+      colour[c] = k;
+      colours[k].push_back(c);
+    }
+  }
+
+  void GeneralizedAlphaIntegrator::computeIterationMatrix(const Vec &y) {
+    nrJac++;
+    int n = y.size();
+    int nc = Rla.start(); // columns of du and x
+    Vec r0(n,NONINIT), r1(n,NONINIT);
+    residual(y, r0);
+
+    // finite differences for the columns of du (including the stiffness and damping of the elements) and x
+    Vec yp = y;
+    auto perturb = [&yp, &y](int c) { yp(c) = y(c) + sqrt(macheps*max(1.e-5,fabs(y(c)))); };
+    patternDetected = not patternUpToDate;
+    if(patternDetected) {
+      // the nonzero pattern is detected by one residual per column: after events and if the Newton iteration fails with
+      // a coloured iteration matrix (e.g. a regularized contact closed and couples further entries)
+      pattern.assign(nc, vector<int>());
+      values.assign(nc, vector<double>());
+      for(int c=0; c<nc; ++c) {
+        perturb(c);
+        residual(yp, r1);
+        for(int r=0; r<n; ++r) {
+          if(r1(r)!=r0(r) or r==c) {
+            pattern[c].push_back(r);
+            values[c].push_back((r1(r)-r0(r))/(yp(c)-y(c)));
+          }
+        }
+        yp(c) = y(c);
+      }
+      colourPattern();
+      patternUpToDate = true;
+      nrPattern++;
+    }
+    else {
+      // coloured finite differences: one residual per colour
+      for(auto &cols : colours) {
+        for(int c : cols)
+          perturb(c);
+        residual(yp, r1);
+        for(int c : cols) {
+          for(size_t k=0; k<pattern[c].size(); k++)
+            values[c][k] = (r1(pattern[c][k])-r0(pattern[c][k]))/(yp(c)-y(c));
+          yp(c) = y(c);
+        }
+      }
+    }
+
+    // compressed column storage; the columns for la are given analytically by -Jrla (only the rows of du)
+    Jp.resize(n+1);
+    Ji.clear();
+    Jx.clear();
+    for(int c=0; c<nc; c++) {
+      Jp[c] = Ji.size();
+      Ji.insert(Ji.end(), pattern[c].begin(), pattern[c].end());
+      Jx.insert(Jx.end(), values[c].begin(), values[c].end());
+    }
+    if(system->getlaSize()) {
+      setState(y);
+      const Mat &Jrla = system->evalJrla();
+      for(int c=nc; c<n; c++) {
+        Jp[c] = Ji.size();
+        for(int r=0; r<system->getuSize(); r++) {
+          if(Jrla(r,c-nc)!=0) {
+            Ji.push_back(r);
+            Jx.push_back(-Jrla(r,c-nc));
+          }
+        }
+      }
+    }
+    Jp[n] = Ji.size();
+
+    // the symbolic analysis is kept as long as the nonzero pattern does not change
+    if(JLU.factorize(n, Jp, Ji, Jx))
+      throwError("(GeneralizedAlphaIntegrator::integrate): iteration matrix is singular at t = " + to_string(t));
+    JUpToDate = true;
+  }
+
+  bool GeneralizedAlphaIntegrator::step() {
+    aPred = (alf*du - alm*a)/(1-alm);
+    Vec r(y.size(),NONINIT);
+    // with an old iteration matrix the step is repeated with a new one if the Newton iteration fails; with a new
+    // coloured iteration matrix it is repeated with a new nonzero pattern
+    for(int attempt=0; attempt<3; attempt++) {
+      y.set(Rdu, du);
+      y.set(Ryx, z(Rx) + h*xd);
+      y.set(Rla, la);
+      bool newJ = not JUpToDate;
+      if(newJ)
+        computeIterationMatrix(y);
+      double errOld = 0;
+      for(int iter=0; iter<maxIter; iter++) {
+        nrNewton++;
+        residual(y, r);
+        Vec dy = r;
+        JLU.solve(dy());
+        y -= dy;
+        double err = 0;
+        for(int i=0; i<y.size(); i++)
+          err = max(err, fabs(dy(i))/(1+fabs(y(i))));
+        double rate = iter>0 ? err/errOld : 0;
+        if(err<=tol) {
+          if(rate>jacobianRecomputation)
+            JUpToDate = false;
+          return true;
+        }
+        if(iter>0 and rate>=1)
+          break;
+        errOld = err;
+      }
+      if(newJ) {
+        if(patternDetected)
+          return false;
+        patternUpToDate = false;
+      }
+      JUpToDate = false;
+    }
+    return false;
+  }
+
+  void GeneralizedAlphaIntegrator::interpolate(double tCheck) {
+    double s = h>0 ? (tCheck-t)/h : 0;
+    system->setTime(tCheck);
+    system->getState() = z + s*(z1-z);
+  }
+
+  void GeneralizedAlphaIntegrator::preIntegrate() {
+    debugInit();
+
+    if(dt<=0)
+      throwError("(GeneralizedAlphaIntegrator::integrate): step size must be positive");
+    if(rho<0 or rho>1)
+      throwError("(GeneralizedAlphaIntegrator::integrate): spectral radius must be in [0,1]");
+
+    if(method==generalizedAlpha) {
+      alm = (2*rho-1)/(rho+1);
+      alf = rho/(rho+1);
+    }
+    else if(method==HHT) {
+      if(rho<0.5)
+        throwError("(GeneralizedAlphaIntegrator::integrate): spectral radius must be in [0.5,1] for HHT");
+      alm = 0;
+      alf = (1-rho)/(1+rho);
+    }
+    else
+      throwError("(GeneralizedAlphaIntegrator::integrate): method unknown");
+    gamma = 0.5+alf-alm;
+    beta = 0.25*(gamma+0.5)*(gamma+0.5);
+    betap = (1-alf)/(1-alm);
+
+    Rq = RangeV(0,system->getqSize()-1);
+    Ru = RangeV(system->getqSize(),system->getqSize()+system->getuSize()-1);
+    Rx = RangeV(system->getqSize()+system->getuSize(),system->getzSize()-1);
+
+    t = tStart;
+    system->setTime(t);
+    if(z0.size()) {
+      if(z0.size() != system->getzSize()+system->getisSize())
+        throwError("(GeneralizedAlphaIntegrator::integrate): size of z0 does not match, must be " + to_string(system->getzSize()+system->getisSize()));
+      system->setState(z0(RangeV(0,system->getzSize()-1)));
+      system->setInternalState(z0(RangeV(system->getzSize(),z0.size()-1)));
+    }
+    else
+      system->evalz0();
+
+    system->resetUpToDate();
+    system->computeInitialCondition();
+    system->plot();
+    svLast <<= system->evalsv();
+    z <<= system->getState(); // needed, as computeInitialCondition may change the state
+    z1.resize(z.size(),NONINIT);
+    reinit();
+
+    h = dt;
+    tPlot = t + dtPlot;
+    integrationSteps = 0;
+    nrJac = 0;
+    nrPattern = 0;
+    nrNewton = 0;
+
+    s0 = clock();
+    time = 0;
+  }
+
+  void GeneralizedAlphaIntegrator::subIntegrate(double tStop) {
+    while(t<tStop-epsroot) {
+      integrationSteps++;
+      double hNew = min(dt, tStop-t);
+      if(stepSizeLimitByTimeOfImpact and system->getsvSize()) {
+        // the step ends at the earliest predicted impact, so that the root is found in a short step
+        system->setTime(t);
+        system->setState(z);
+        system->resetUpToDate();
+        hNew = min(hNew, evalTimeOfImpact(hNew));
+      }
+      if(hNew!=h) {
+        h = hNew;
+        JUpToDate = false; // the iteration matrix depends on the step size
+      }
+
+      system->setTime(t);
+      system->setState(z);
+      system->resetUpToDate();
+      T <<= system->evalT();
+
+      if(not step())
+        throwError("(GeneralizedAlphaIntegrator::subIntegrate): Newton iteration did not converge at t = " + to_string(t));
+      setState(y);
+      Vec xd1 = system->evalzd()(Rx);
+      z1 = system->getState();
+      la1 <<= y(Rla);
+
+      double t1 = t + h;
+      double curTimeAndState = t1;
+      double tRoot = t1;
+
+      // root-finding
+      if(system->getsvSize()) {
+        shift = signChangedWRTsvLast(system->evalsv());
+        // if a root exists in the current step ...
+        if(shift) {
+          // ... search the first root and set step.second to this time
+          tRoot = findRoot(t, t1, [this](double tCheck) {
+            interpolate(tCheck);
+          });
+          curTimeAndState = tRoot;
+          system->resetUpToDate();
+          auto &sv = system->evalsv();
+          auto &jsv = system->getjsv();
+          for(int i=0; i<sv.size(); ++i)
+            jsv(i)=svLast(i)*sv(i)<0;
+        }
+      }
+
+      while(tRoot >= tPlot) {
+        if(curTimeAndState != tPlot) {
+          curTimeAndState = tPlot;
+          interpolate(tPlot);
+        }
+        system->resetUpToDate();
+        system->setla(la + ((tPlot-t)/h)*(la1-la));
+        system->setUpdatela(false);
+        system->plot();
+        if(msgAct(Status))
+          msg(Status) << "   t = " <<  tPlot << ",\tdt = "<< h << flush;
+
+        system->updateInternalState();
+
+        double s1 = clock();
+        time += (s1-s0)/CLOCKS_PER_SEC;
+        s0 = s1;
+
+        tPlot += dtPlot;
+      }
+
+      bool init = false;
+      if(shift) {
+        // shift the system
+        if(curTimeAndState != tRoot)
+          interpolate(tRoot);
+        if(plotOnRoot) {
+          system->resetUpToDate();
+          system->plot();
+        }
+        system->resetUpToDate();
+        system->shift();
+        if(plotOnRoot) {
+          system->resetUpToDate();
+          system->plot();
+        }
+        init = true;
+      }
+      else {
+        du = y(Rdu);
+        a = a1;
+        xd = xd1;
+        la = la1;
+        if(curTimeAndState != t1) {
+          system->setTime(t1);
+          system->setState(z1);
+        }
+        // check drift
+        bool projVel = true;
+        if(gMax>=0) {
+          system->resetUpToDate();
+          if(system->positionDriftCompensationNeeded(gMax)) { // project both, first positions and then velocities
+            system->projectGeneralizedPositions(3);
+            system->projectGeneralizedVelocities(3);
+            projVel = false;
+            init = true;
+          }
+        }
+        if(gdMax>=0 and projVel) {
+          system->resetUpToDate();
+          if(system->velocityDriftCompensationNeeded(gdMax)) { // project velicities
+            system->projectGeneralizedVelocities(3);
+            init = true;
+          }
+        }
+        system->updateStopVectorParameters();
+      }
+      // after a shift or a projection the integration is restarted with consistent accelerations
+      if(init)
+        reinit();
+
+      system->updateInternalState();
+      system->resetUpToDate();
+      svLast = system->evalsv();
+      t = system->getTime();
+      z = system->getState();
+    }
+  }
+
+  void GeneralizedAlphaIntegrator::postIntegrate() {
+    msg(Info)<<"nrSteps: "<<integrationSteps<<endl;
+    msg(Info)<<"nrJac: "<<nrJac<<" (nonzero pattern detections: "<<nrPattern<<", colours: "<<colours.size()<<")"<<endl;
+    msg(Info)<<"nrNewtonIterations: "<<nrNewton<<endl;
+  }
+
+  namespace {
+    struct GeneralizedAlphaIntegratorSnapshot {
+      double t;
+      double tPlot;
+      int integrationSteps;
+    };
+  }
+
+  size_t GeneralizedAlphaIntegrator::getSnapshotSize() const {
+    return sizeof(GeneralizedAlphaIntegratorSnapshot) + svLast.size()*sizeof(double);
+  }
+
+  void GeneralizedAlphaIntegrator::getSnapshot(char *snapshot) const {
+    GeneralizedAlphaIntegratorSnapshot s;
+    s.t = t;
+    s.tPlot = tPlot;
+    s.integrationSteps = integrationSteps;
+    memcpy(snapshot, &s, sizeof(s));
+    if(svLast.size())
+      memcpy(snapshot+sizeof(s), svLast(), svLast.size()*sizeof(double));
+  }
+
+  void GeneralizedAlphaIntegrator::setSnapshot(const char *snapshot) {
+    GeneralizedAlphaIntegratorSnapshot s;
+    memcpy(&s, snapshot, sizeof(s));
+    t = s.t;
+    tPlot = s.tPlot;
+    integrationSteps = s.integrationSteps;
+    if(svLast.size())
+      memcpy(svLast(), snapshot+sizeof(s), svLast.size()*sizeof(double));
+    // the state is taken from the system, which must be restored before; the integration is restarted
+    z = system->getState();
+    reinit();
+  }
+
+  void GeneralizedAlphaIntegrator::integrate() {
+    preIntegrate();
+    subIntegrate(tEnd);
+    postIntegrate();
+  }
+
+  void GeneralizedAlphaIntegrator::initializeUsingXML(DOMElement *element) {
+    RootFindingIntegrator::initializeUsingXML(element);
+    DOMElement *e;
+    e=E(element)->getFirstElementChildNamed(MBSIM%"stepSize");
+    if(e) setStepSize(E(e)->getText<double>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"method");
+    if(e) {
+      auto methodStr = E(e)->getText<string>();
+      methodStr = methodStr.substr(1, methodStr.size()-2);
+      if(methodStr=="generalizedAlpha") method=generalizedAlpha;
+      else if(methodStr=="HHT") method=HHT;
+      else method=unknownMethod;
+    }
+    e=E(element)->getFirstElementChildNamed(MBSIM%"spectralRadius");
+    if(e) setSpectralRadius(E(e)->getText<double>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"maximumNumberOfNewtonIterations");
+    if(e) setMaximumNumberOfNewtonIterations(E(e)->getText<int>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"newtonIterationTolerance");
+    if(e) setNewtonIterationTolerance(E(e)->getText<double>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"jacobianRecomputation");
+    if(e) setJacobianRecomputation(E(e)->getText<double>());
+  }
+
+}
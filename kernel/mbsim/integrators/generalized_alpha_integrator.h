@@ -0,0 +1,150 @@
+/* Copyright (C) 2004-2009 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _GENERALIZED_ALPHA_INTEGRATOR_H_
+#define _GENERALIZED_ALPHA_INTEGRATOR_H_
+
+#include "root_finding_integrator.h"
+#include "mbsim/numerics/sparse_lu.h"
+
+namespace MBSim {
+
+  /** \brief Generalized-alpha integrator for index 3 mechanical DAEs.
+   *
+   * Second order scheme of Chung and Hulbert (or Hilber, Hughes and Taylor) in the formulation of Arnold and Bruels
+   * acting directly on q, u and la: per step the accelerations du, the link states x and the constraint forces la are
+   * the unknowns of a Newton iteration for M du = h + W la, g(q) = 0. The link states x are integrated by the implicit
+   * theta method with theta = gamma. The numerical damping is set by the spectral radius at infinity.
+   * The iteration matrix is reused across steps and only recomputed after events or if the Newton iteration converges
+   * slowly.
+   * Closed contacts are handled as bilateral constraints; impacts and changes of the contact status are found by the
+   * stop vector and handled by the constraint solvers of the system (shift). Position constraints (joints, closed
+   * contacts in normal direction) enter on position level, all other constraints (e.g. sticking friction) on velocity
+   * level.
+   * The equations of motion are not multiplied by the inverse mass matrix, hence the iteration matrix is as sparse as M,
+   * the element couplings and W. The columns of la are given analytically (-Jrla). The stiffness and damping of the
+   * elements are not available analytically, hence the columns of du and x are computed by coloured finite
+   * differences: the nonzero pattern is detected by one residual per column after events (and if the Newton iteration
+   * fails with a coloured iteration matrix), afterwards one residual per colour is needed. The iteration matrix is
+   * assembled in compressed column storage and factorised by a sparse LU decomposition.
+   */
+  class GeneralizedAlphaIntegrator : public RootFindingIntegrator {
+    public:
+      enum Method {
+        generalizedAlpha=0,
+        HHT,
+        unknownMethod
+      };
+
+      /**
+       * \brief destructor
+       */
+      ~GeneralizedAlphaIntegrator() override = default;
+
+      void preIntegrate() override;
+      void subIntegrate(double tStop) override;
+      void postIntegrate() override;
+      size_t getSnapshotSize() const override;
+      void getSnapshot(char *snapshot) const override;
+      void setSnapshot(const char *snapshot) override;
+
+      /* INHERITED INTERFACE OF INTEGRATOR */
+      using Integrator::integrate;
+      void integrate() override;
+      void initializeUsingXML(xercesc::DOMElement *element) override;
+      /***************************************************/
+
+      /* GETTER / SETTER */
+      void setStepSize(double dt_) { dt = dt_; }
+      void setMethod(Method method_) { method = method_; }
+      void setSpectralRadius(double rho_) { rho = rho_; }
+      void setMaximumNumberOfNewtonIterations(int maxIter_) { maxIter = maxIter_; }
+      void setNewtonIterationTolerance(double tol_) { tol = tol_; }
+      void setJacobianRecomputation(double value) { jacobianRecomputation = value; }
+      /***************************************************/
+
+    private:
+      //! set the constraint sizes and consistent accelerations and constraint forces of the current state
+      void reinit();
+      //! set time and state of the system for the Newton unknowns y = [du, x, la] of the current step
+      void setState(const fmatvec::Vec &y);
+      //! residual of the Newton unknowns y = [du, x, la] of the current step
+      void residual(const fmatvec::Vec &y, fmatvec::Vec &r);
+      //! iteration matrix at the Newton unknowns y
+      void computeIterationMatrix(const fmatvec::Vec &y);
+      //! colouring of the columns of du and x by their nonzero pattern
+      void colourPattern();
+      //! one Newton iteration for the step t -> t+h; returns false if the iteration does not converge
+      bool step();
+      //! set time and state of the system by the linear interpolation of the last step
+      void interpolate(double tCheck);
+
+      /**
+       * \brief step size
+       */
+      double dt{1e-3};
+
+      /**
+       * \brief method (generalized-alpha of Chung and Hulbert or HHT)
+       */
+      Method method{generalizedAlpha};
+
+      /**
+       * \brief spectral radius at infinity (numerical damping)
+       */
+      double rho{0.8};
+
+      /**
+       * \brief maximum number of Newton iterations per step
+       */
+      int maxIter{10};
+
+      /**
+       * \brief tolerance of the Newton iteration
+       */
+      double tol{1e-8};
+
+      /**
+       * \brief the iteration matrix is recomputed if the convergence rate of the Newton iteration exceeds this value
+       */
+      double jacobianRecomputation{0.5};
+
+      double alm, alf, gamma, beta, betap;
+      double t, h, tPlot;
+      int integrationSteps, nrJac, nrPattern, nrNewton;
+      double s0, time;
+      fmatvec::RangeV Rq, Ru, Rx, Rdu, Ryx, Rla;
+      fmatvec::Vec z, z1, du, a, a1, xd, la, la1, y, aPred;
+      fmatvec::Mat T;
+      SparseLU JLU;
+      // iteration matrix in compressed column storage
+      std::vector<int> Jp, Ji;
+      std::vector<double> Jx;
+      // rows and values of the nonzero entries of the columns of du and x and the columns of each colour
+      std::vector<std::vector<int>> pattern, colours;
+      std::vector<std::vector<double>> values;
+      bool patternUpToDate{false}, patternDetected{false};
+      // rows of la on position level (g) and on velocity level (gd)
+      std::vector<int> laPos, gPos, laVel, gdVel;
+      bool JUpToDate{false};
+  };
+
+}
+
+#endif
@@ -21,6 +21,7 @@
 #include "hets2_integrator.h"
 #include <mbsim/dynamic_system_solver.h>
 #include <ctime>
+#include <cstring>
 
 #ifndef NO_ISO_14882
 using namespace std;
@@ -183,6 +184,47 @@ namespace MBSim {
     msg(Info).flush();
   }
 
+  namespace {
+    struct HETS2IntegratorSnapshot {
+      double tPlot;
+      double dtInfo;
+      int integrationSteps;
+      int integrationStepsConstraint;
+      int integrationStepsImpact;
+      int maxIter;
+      int sumIter;
+    };
+  }
+
+  size_t HETS2Integrator::getSnapshotSize() const {
+    return sizeof(HETS2IntegratorSnapshot);
+  }
+
+  void HETS2Integrator::getSnapshot(char *snapshot) const {
+    HETS2IntegratorSnapshot s;
+    s.tPlot = tPlot;
+    s.dtInfo = dtInfo;
+    s.integrationSteps = integrationSteps;
+    s.integrationStepsConstraint = integrationStepsConstraint;
+    s.integrationStepsImpact = integrationStepsImpact;
+    s.maxIter = maxIter;
+    s.sumIter = sumIter;
+    memcpy(snapshot, &s, sizeof(s));
+  }
+
+  void HETS2Integrator::setSnapshot(const char *snapshot) {
+    HETS2IntegratorSnapshot s;
+    memcpy(&s, snapshot, sizeof(s));
+    tPlot = s.tPlot;
+    dtInfo = s.dtInfo;
+    integrationSteps = s.integrationSteps;
+    integrationStepsConstraint = s.integrationStepsConstraint;
+    integrationStepsImpact = s.integrationStepsImpact;
+    maxIter = s.maxIter;
+    sumIter = s.sumIter;
+    resize();
+  }
+
   void HETS2Integrator::integrate() {
     system->setUseConstraintSolverForPlot(true);
     preIntegrate();
@@ -203,20 +245,23 @@ namespace MBSim {
     bool impact = system->detectImpact();
 
     // adapt size of constraint system on velocity level
-    if (system->gActiveChanged()) {
-      system->calcgdSize(2); // contacts which stay closed
-      system->calclaSize(2); // contacts which stay closed
-      system->calcrFactorSize(2); // contacts which stay closed
-
-      system->updateWRef(system->getWParent(0));
-      system->updateVRef(system->getVParent(0));
-      system->updatelaRef(system->getlaParent());
-      system->updateLaRef(system->getLaParent());
-      system->updategdRef(system->getgdParent());
-      system->updaterFactorRef(system->getrFactorParent());
-    }
+    if (system->gActiveChanged())
+      resize();
 
     return impact; 
   }
 
+  void HETS2Integrator::resize() {
+    system->calcgdSize(2); // contacts which stay closed
+    system->calclaSize(2); // contacts which stay closed
+    system->calcrFactorSize(2); // contacts which stay closed
+
+    system->updateWRef(system->getWParent(0));
+    system->updateVRef(system->getVParent(0));
+    system->updatelaRef(system->getlaParent());
+    system->updateLaRef(system->getLaParent());
+    system->updategdRef(system->getgdParent());
+    system->updaterFactorRef(system->getrFactorParent());
+  }
+
 }
@@ -65,6 +65,10 @@ namespace MBSim {
        */
       void postIntegrate() override;
 
+      size_t getSnapshotSize() const override;
+      void getSnapshot(char *snapshot) const override;
+      void setSnapshot(const char *snapshot) override;
+
       /* INHERITED INTERFACE OF INTEGRATOR */
       using Integrator::integrate;
       void integrate() override;
@@ -86,6 +90,11 @@ namespace MBSim {
        */
       bool evaluateStage();
 
+      /**
+       * \brief adapt the size of the constraint system on velocity level to the active set
+       */
+      void resize();
+
       /**
        * \brief step size for non-impulsive periods, and impulsive periods, and last used
        */
@@ -21,7 +21,9 @@
 #include <mbsim/dynamic_system_solver.h>
 #include "implicit_euler_integrator.h"
 #include "mbsim/utils/nonlinear_algebra.h"
+#include "mbsim/utils/eps.h"
 #include <ctime>
+#include <cstring>
 
 #ifndef NO_ISO_14882
 using namespace std;
@@ -51,6 +53,58 @@ namespace MBSim {
     return ux - zk(RangeV(sys->getqSize(),sys->getzSize()-1)) - sys->evalzd()(RangeV(sys->getqSize(),sys->getzSize()-1))*dt;
   }
 
+  void ImplicitEulerIntegrator::computeJacobian(const Vec &x_) {
+    Vec x = x_;
+    Vec f = (*res)(x);
+    SqrMat J(x.size(),NONINIT);
+    for(int j=0; j<x.size(); j++) {
+      double xj = x(j);
+      double dx = sqrt(macheps*max(1.e-5,fabs(xj)));
+      x(j) += dx;
+      J.set(j, ((*res)(x)-f)/dx);
+      x(j) = xj;
+    }
+    ipiv.resize(x.size(),NONINIT);
+    JLU <<= facLU(J,ipiv);
+    JacCounter++;
+    jacAge = 0;
+  }
+
+  Vec ImplicitEulerIntegrator::solveSimplifiedNewton(const Vec &x0_) {
+    Vec x0 = x0_; // x0_ may refer to the state of the system, which is changed by the residuum
+    const double tol = 1e-10; // as MultiDimNewtonMethod
+    const int maxIter = 300;
+    bool fresh = jacAge<0 or jacAge>=maxJacAge;
+    if(fresh)
+      computeJacobian(x0);
+    else
+      reuses++;
+    jacAge++;
+    while(true) {
+      Vec x = x0;
+      Vec f = (*res)(x);
+      double nrmOld = 0;
+      for(int i=0; i<maxIter; i++) {
+        if(nrmInf(f)<=tol)
+          return x;
+        Vec dx = slvLUFac(JLU,f,ipiv);
+        x -= dx;
+        double nrm = nrmInf(dx);
+        // the convergence rate degrades: the iteration matrix of former steps is not accurate enough
+        if(not fresh and i>0 and nrm>jacobianRecomputation*nrmOld)
+          break;
+        nrmOld = nrm;
+        f = (*res)(x);
+      }
+      if(fresh)
+        throwError("(ImplicitEulerIntegrator::subIntegrate): computation of new state failed!");
+      rejectedReuses++;
+      computeJacobian(x0);
+      jacAge = 1;
+      fresh = true;
+    }
+  }
+
   void ImplicitEulerIntegrator::preIntegrate() {
     debugInit();
     assert(dtPlot >= dt);
@@ -84,6 +138,10 @@ namespace MBSim {
     
     step = 0;
     integrationSteps = 0;
+    jacAge = -1;
+    JacCounter = 0;
+    reuses = 0;
+    rejectedReuses = 0;
     
     s0 = clock();
     time = 0;
@@ -92,6 +150,7 @@ namespace MBSim {
   void ImplicitEulerIntegrator::subIntegrate(double tStop) {
     MultiDimNewtonMethod newton(res);
     // newton.setLinearAlgebra(1);
+    auto solve = [this, &newton](const Vec &x) { return simplifiedNewton ? solveSimplifiedNewton(x) : newton.solve(x); };
     while(system->getTime()<tStop) { // time loop
       res->setState(system->getState());
       integrationSteps++;
@@ -110,12 +169,12 @@ namespace MBSim {
       if(reduced) {
         Vec qOld;
         qOld = system->getq();
-        system->getState().set(RangeV(system->getqSize(),system->getzSize()-1), newton.solve(system->getState()(RangeV(system->getqSize(),system->getzSize()-1))));
+        system->getState().set(RangeV(system->getqSize(),system->getzSize()-1), solve(system->getState()(RangeV(system->getqSize(),system->getzSize()-1))));
         system->getq() = qOld + system->getu()*dt;
       }
       else
-        system->getState() = newton.solve(system->getState());
-      if(newton.getInfo() != 0)
+        system->getState() = solve(system->getState());
+      if(not simplifiedNewton and newton.getInfo() != 0)
         throwError("(ImplicitEulerIntegrator::subIntegrate): computation of new state failed!");
 
       system->updateInternalState();
@@ -124,6 +183,41 @@ namespace MBSim {
 
   void ImplicitEulerIntegrator::postIntegrate() {
     delete res;
+    if(simplifiedNewton) {
+      msg(Info) << "Integration steps: " << integrationSteps << endl;
+      msg(Info) << "Computed iteration matrices (JacCounter): " << JacCounter << endl;
+      msg(Info) << "Reuses of iteration matrices: " << reuses << endl;
+      msg(Info) << "Rejected reuses of iteration matrices: " << rejectedReuses << endl;
+    }
+  }
+
+  namespace {
+    struct ImplicitEulerIntegratorSnapshot {
+      double tPlot;
+      int step;
+      int integrationSteps;
+    };
+  }
+
+  size_t ImplicitEulerIntegrator::getSnapshotSize() const {
+    return sizeof(ImplicitEulerIntegratorSnapshot);
+  }
+
+  void ImplicitEulerIntegrator::getSnapshot(char *snapshot) const {
+    ImplicitEulerIntegratorSnapshot s;
+    s.tPlot = tPlot;
+    s.step = step;
+    s.integrationSteps = integrationSteps;
+    memcpy(snapshot, &s, sizeof(s));
+  }
+
+  void ImplicitEulerIntegrator::setSnapshot(const char *snapshot) {
+    ImplicitEulerIntegratorSnapshot s;
+    memcpy(&s, snapshot, sizeof(s));
+    tPlot = s.tPlot;
+    step = s.step;
+    integrationSteps = s.integrationSteps;
+    jacAge = -1; // the state of the system may have changed
   }
 
   void ImplicitEulerIntegrator::integrate() {
@@ -139,6 +233,12 @@ namespace MBSim {
     if(e) setStepSize(E(e)->getText<double>());
     e=E(element)->getFirstElementChildNamed(MBSIM%"reducedForm");
     if(e) setReducedForm((E(e)->getText<bool>()));
+    e=E(element)->getFirstElementChildNamed(MBSIM%"simplifiedNewton");
+    if(e) setSimplifiedNewton((E(e)->getText<bool>()));
+    e=E(element)->getFirstElementChildNamed(MBSIM%"maximumJacobianAge");
+    if(e) setMaximumJacobianAge(E(e)->getText<int>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"jacobianRecomputation");
+    if(e) setJacobianRecomputation(E(e)->getText<double>());
   }
 
 }
@@ -59,6 +59,9 @@ namespace MBSim {
       void preIntegrate() override;
       void subIntegrate(double tStop) override;
       void postIntegrate() override;
+      size_t getSnapshotSize() const override;
+      void getSnapshot(char *snapshot) const override;
+      void setSnapshot(const char *snapshot) override;
 
       /* INHERITED INTERFACE OF INTEGRATOR */
       using Integrator::integrate;
@@ -69,9 +72,17 @@ namespace MBSim {
       /* GETTER / SETTER */
       void setStepSize(double dt_) {dt = dt_;}
       void setReducedForm(bool reduced_) { reduced = reduced_; }
+      void setSimplifiedNewton(bool simplifiedNewton_) { simplifiedNewton = simplifiedNewton_; }
+      void setMaximumJacobianAge(int maxJacAge_) { maxJacAge = maxJacAge_; }
+      void setJacobianRecomputation(double value) { jacobianRecomputation = value; }
       /***************************************************/
 
     private:
+      //! compute and factorise the iteration matrix at x by finite differences
+      void computeJacobian(const fmatvec::Vec &x);
+      //! simplified Newton iteration with the iteration matrix of former steps
+      fmatvec::Vec solveSimplifiedNewton(const fmatvec::Vec &x0);
+
       /**
        * \brief step size
        */
@@ -80,6 +91,20 @@ namespace MBSim {
       /** reduced form **/
       bool reduced{false};
 
+      /** keep the factorised iteration matrix across steps (simplified Newton iteration) **/
+      bool simplifiedNewton{false};
+
+      /** maximum number of steps an iteration matrix is used for **/
+      int maxJacAge{20};
+
+      /** the iteration matrix is recomputed if the convergence rate of the simplified Newton iteration exceeds this value **/
+      double jacobianRecomputation{0.5};
+
+      fmatvec::SqrMat JLU;
+      fmatvec::VecInt ipiv;
+      int jacAge{-1};
+      int JacCounter{0}, reuses{0}, rejectedReuses{0};
+
       double tPlot;
       int iter, step, integrationSteps;
       double s0, time;
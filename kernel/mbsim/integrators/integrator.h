@@ -80,6 +80,14 @@ namespace MBSim {
       virtual void subIntegrate(double tStop) { throwError("subIntegrate is not defined"); }
       virtual void postIntegrate() { throwError("postIntegrate is not defined"); }
 
+      /*! Size in bytes of the state of an integration started by preIntegrate (step counters, plot time, ...).
+       * Together with DynamicSystemSolver::getSnapshot this allows to roll back subIntegrate.
+       */
+      virtual size_t getSnapshotSize() const { throwError("getSnapshotSize is not defined"); }
+      virtual void getSnapshot(char *snapshot) const { throwError("getSnapshot is not defined"); }
+      //! Restore the integrator state; must be called after the system state is restored.
+      virtual void setSnapshot(const char *snapshot) { throwError("setSnapshot is not defined"); }
+
       /*! 
        * \brief initialize integrator
        * \param XML description
@@ -23,16 +23,21 @@
 #include "lsode_integrator.h"
 #include "rksuite_integrator.h"
 #include "dopri5_integrator.h"
+#include "ensemble_dopri5_integrator.h"
 #include "dop853_integrator.h"
 #include "odex_integrator.h"
 #include "radau5_integrator.h"
 #include "time_stepping_integrator.h"
 #include "theta_time_stepping_integrator.h"
+#include "nonsmooth_generalized_alpha_integrator.h"
 #include "time_stepping_ssc_integrator.h"
 //#include "auto_time_stepping_ssc_integrator.h"
 #include "hets2_integrator.h"
 #include "explicit_euler_integrator.h"
 #include "implicit_euler_integrator.h"
+#include "generalized_alpha_integrator.h"
+#include "multirate_integrator.h"
+#include "parareal_integrator.h"
 #include "quasi_static_integrator.h"
 //#include "daspk_integrator.h"
 
@@ -225,24 +225,13 @@ namespace MBSim {
           getSystem()->resetUpToDate();
           shift = signChangedWRTsvLast(getSystem()->evalsv());
           // if a root exists in the current step ...
-          double dt = rWork(10);
           if(shift) {
             // ... search the first root and set step.second to this time
-            while(dt>dtRoot) {
-              dt/=2;
-              double tCheck = tRoot-dt;
-              curTimeAndState = tCheck;
+            tRoot = findRoot(t-rWork(10), t, [&](double tCheck) {
               DINTDY(&tCheck, &zero, &rWork(20), neq, system->getState()(), &iflag);
               getSystem()->setTime(tCheck);
-              getSystem()->resetUpToDate();
-              if(signChangedWRTsvLast(getSystem()->evalsv()))
-                tRoot = tCheck;
-            }
-            if(curTimeAndState != tRoot) {
-              curTimeAndState = tRoot;
-              DINTDY(&tRoot, &zero, &rWork(20), neq, system->getState()(), &iflag);
-              getSystem()->setTime(tRoot);
-            }
+            });
+            curTimeAndState = tRoot;
             getSystem()->resetUpToDate();
             auto &sv = getSystem()->evalsv();
             auto &jsv = getSystem()->getjsv();
@@ -0,0 +1,386 @@
+/* Copyright (C) 2004-2009 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h>
+#include <mbsim/dynamic_system_solver.h>
+#include <mbsim/objects/object.h>
+#include <mbsim/links/link.h>
+#include <mbsim/utils/eps.h>
+#include "multirate_integrator.h"
+#include <algorithm>
+#include <ctime>
+#include <cstring>
+
+#ifndef NO_ISO_14882
+using namespace std;
+#endif
+
+using namespace fmatvec;
+using namespace MBSim;
+using namespace MBXMLUtils;
+using namespace xercesc;
+
+namespace MBSim {
+
+  MBSIM_OBJECTFACTORY_REGISTERCLASS(MBSIM, MultirateIntegrator)
+
+  void MultirateIntegrator::preIntegrate() {
+    debugInit();
+
+    if(dt<=0)
+      throwError("(MultirateIntegrator::integrate): step size must be positive");
+    if(nSub<1)
+      throwError("(MultirateIntegrator::integrate): number of substeps must be at least 1");
+
+    partitionState();
+    msg(Info)<<"Multirate integration with "<<slowInd.size()<<" slow and "<<fastInd.size()<<" fast states."<<endl;
+
+    t = tStart;
+    system->setTime(t);
+    if(z0.size()) {
+      if(z0.size() != system->getzSize()+system->getisSize())
+        throwError("(MultirateIntegrator::integrate): size of z0 does not match, must be " + to_string(system->getzSize()+system->getisSize()));
+      system->setState(z0(RangeV(0,system->getzSize()-1)));
+      system->setInternalState(z0(RangeV(system->getzSize(),z0.size()-1)));
+    }
+    else
+      system->evalz0();
+
+    system->resetUpToDate();
+    system->computeInitialCondition();
+    system->plot();
+    svLast <<= system->evalsv();
+    z <<= system->getState(); // needed, as computeInitialCondition may change the state
+    z1.resize(z.size(),NONINIT);
+    zFast.resize(fastInd.size(),nSub+1,NONINIT);
+    if(linearlyImplicit) {
+      Jff.resize(fastInd.size(),NONINIT);
+      LU.resize(fastInd.size(),NONINIT);
+      ipiv.resize(fastInd.size(),NONINIT);
+    }
+
+    tPlot = t + dtPlot;
+    integrationSteps = 0;
+
+    s0 = clock();
+    time = 0;
+  }
+
+  void MultirateIntegrator::partitionState() {
+    // The hierarchy of the system is reorganized during its initialization: all objects and links are moved to the
+    // dynamic system solver and renamed, hence getByPath can not resolve the paths of the model any longer. But each
+    // element keeps its path before the reorganization (Element::getPath), which is used here. A dynamic system is
+    // resolved by all objects and links below its path.
+    int nq = system->getqSize();
+    int nu = system->getuSize();
+    auto addRange = [this](int start, int size) {
+      for(int i=start; i<start+size; i++)
+        fastInd.push_back(i);
+    };
+    fastElement.clear();
+    fastInd.clear();
+    for(auto & path : fastElementPath) {
+      string absPath = path.substr(0,1)=="/" ? path : "/"+path;
+      auto matches = [&absPath](const Element *e) {
+        string p = e->getPath();
+        return p==absPath or p.compare(0, absPath.size()+1, absPath+"/")==0;
+      };
+      bool found = false;
+      for(auto & o : system->getObjects()) {
+        if(matches(o)) {
+          addRange(o->getqInd(), o->getqSize());
+          addRange(nq+o->getuInd(), o->getuSize());
+          fastElement.push_back(o);
+          found = true;
+        }
+      }
+      for(auto & l : system->getLinks()) {
+        if(matches(l)) {
+          if(l->getxSize()) {
+            addRange(nq+nu+l->getxInd(), l->getxSize());
+            fastElement.push_back(l);
+          }
+          found = true;
+        }
+      }
+      if(not found)
+        throwError("(MultirateIntegrator::integrate): fast element "+path+" is not an object, a link or a dynamic system containing objects or links");
+    }
+    sort(fastElement.begin(), fastElement.end());
+    fastElement.erase(unique(fastElement.begin(), fastElement.end()), fastElement.end());
+    sort(fastInd.begin(), fastInd.end());
+    fastInd.erase(unique(fastInd.begin(), fastInd.end()), fastInd.end());
+    slowInd.clear();
+    for(int i=0, j=0; i<system->getzSize(); i++) {
+      if(j<(int)fastInd.size() and fastInd[j]==i)
+        j++;
+      else
+        slowInd.push_back(i);
+    }
+  }
+
+  void MultirateIntegrator::updateFastJacobian() {
+    // forward differences of the fast state derivative at the start of the macro step (zd is up to date there)
+    Vec zdf0(fastInd.size(),NONINIT);
+    const Vec &zd0 = system->evalzd();
+    for(size_t i=0; i<fastInd.size(); i++)
+      zdf0(i) = zd0(fastInd[i]);
+    Vec &zs = system->getState();
+    Vec col(fastInd.size(),NONINIT);
+    for(size_t j=0; j<fastInd.size(); j++) {
+      double zSafe = zs(fastInd[j]);
+      double delta = epsroot*(1+fabs(zSafe));
+      zs(fastInd[j]) = zSafe + delta;
+      system->resetUpToDate();
+      const Vec &zd = system->evalzd(fastElement);
+      for(size_t i=0; i<fastInd.size(); i++)
+        col(i) = (zd(fastInd[i])-zdf0(i))/delta;
+      Jff.set(j, col);
+      zs(fastInd[j]) = zSafe;
+    }
+    system->resetUpToDate();
+  }
+
+  void MultirateIntegrator::interpolate(double tCheck) {
+    double s = H>0 ? (tCheck-t)/H : 0;
+    system->setTime(tCheck);
+    Vec &zs = system->getState();
+    for(int i : slowInd)
+      zs(i) = z(i) + s*(z1(i)-z(i));
+    int k = min(int(s*nSub), nSub-1);
+    double r = s*nSub-k;
+    for(size_t j=0; j<fastInd.size(); j++)
+      zs(fastInd[j]) = zFast(j,k) + r*(zFast(j,k+1)-zFast(j,k));
+  }
+
+  void MultirateIntegrator::subIntegrate(double tStop) {
+    Vec zd0(z.size(),NONINIT), hrSum(system->getuSize(),NONINIT), udMean;
+    int qSize = system->getqSize(), uSize = system->getuSize();
+    while(t<tStop-epsroot) {
+      integrationSteps++;
+      H = min(dt, tStop-t);
+      double h = H/nSub;
+
+      system->setTime(t);
+      system->setState(z);
+      system->resetUpToDate();
+      zd0 = system->evalzd();
+      if(conservative) {
+        LLM0 <<= system->evalLLM();
+        hrSum = system->evalh() + system->evalr();
+      }
+      for(size_t j=0; j<fastInd.size(); j++)
+        zFast(j,0) = z(fastInd[j]);
+      if(linearlyImplicit and fastInd.size()) {
+        updateFastJacobian();
+        LU <<= facLU(SqrMat(fastInd.size(),Eye()) - h*Jff, ipiv);
+      }
+
+      // sub steps of the fast states; the slow states are extrapolated with the derivative of the macro start
+      Vec dzFast(fastInd.size(),NONINIT);
+      for(int k=0; k<nSub; k++) {
+        const Vec *zd = &zd0;
+        if(k>0) {
+          system->setTime(t+k*h);
+          Vec &zs = system->getState();
+          for(int i : slowInd)
+            zs(i) = z(i) + k*h*zd0(i);
+          for(size_t j=0; j<fastInd.size(); j++)
+            zs(fastInd[j]) = zFast(j,k);
+          system->resetUpToDate();
+          zd = &system->evalzd(fastElement);
+          // the forces of all links are evaluated for the fast objects anyway; hence, the forces which the coupling
+          // links apply to the slow objects during the sub steps are accumulated without further evaluations
+          if(conservative)
+            hrSum += system->evalh() + system->evalr();
+        }
+        for(size_t j=0; j<fastInd.size(); j++)
+          dzFast(j) = h*(*zd)(fastInd[j]);
+        if(linearlyImplicit and fastInd.size())
+          dzFast = slvLUFac(LU, dzFast, ipiv);
+        for(size_t j=0; j<fastInd.size(); j++)
+          zFast(j,k+1) = zFast(j,k) + dzFast(j);
+      }
+
+      // macro step of the slow states; with conservative coupling the slow velocities are integrated with the mean
+      // force of the sub steps, i.e. with the same impulse of the coupling links as the fast velocities
+      if(conservative)
+        udMean <<= slvLLFac(LLM0, (1./nSub)*hrSum);
+      for(int i : slowInd) {
+        if(conservative and i>=qSize and i<qSize+uSize)
+          z1(i) = z(i) + H*udMean(i-qSize);
+        else
+          z1(i) = z(i) + H*zd0(i);
+      }
+      for(size_t j=0; j<fastInd.size(); j++)
+        z1(fastInd[j]) = zFast(j,nSub);
+
+      double t1 = t + H;
+      double curTimeAndState = t1;
+      double tRoot = t1;
+      system->setTime(t1);
+      system->setState(z1);
+      system->resetUpToDate();
+
+      // root-finding
+      if(system->getsvSize()) {
+        shift = signChangedWRTsvLast(system->evalsv());
+        // if a root exists in the current step ...
+        if(shift) {
+          // ... search the first root and set step.second to this time
+          tRoot = findRoot(t, t1, [this](double tCheck) {
+            interpolate(tCheck);
+          });
+          curTimeAndState = tRoot;
+          system->resetUpToDate();
+          auto &sv = system->evalsv();
+          auto &jsv = system->getjsv();
+          for(int i=0; i<sv.size(); ++i)
+            jsv(i)=svLast(i)*sv(i)<0;
+        }
+      }
+
+      while(tRoot >= tPlot) {
+        if(curTimeAndState != tPlot) {
+          curTimeAndState = tPlot;
+          interpolate(tPlot);
+        }
+        system->resetUpToDate();
+        system->plot();
+        if(msgAct(Status))
+          msg(Status) << "   t = " <<  tPlot << ",\tdt = "<< H << flush;
+
+        system->updateInternalState();
+
+        double s1 = clock();
+        time += (s1-s0)/CLOCKS_PER_SEC;
+        s0 = s1;
+
+        tPlot += dtPlot;
+      }
+
+      if(shift) {
+        // shift the system
+        if(curTimeAndState != tRoot)
+          interpolate(tRoot);
+        if(plotOnRoot) {
+          system->resetUpToDate();
+          system->plot();
+        }
+        system->resetUpToDate();
+        system->shift();
+        if(plotOnRoot) {
+          system->resetUpToDate();
+          system->plot();
+        }
+      }
+      else {
+        if(curTimeAndState != t1) {
+          system->setTime(t1);
+          system->setState(z1);
+        }
+        // check drift
+        bool projVel = true;
+        if(gMax>=0) {
+          system->resetUpToDate();
+          if(system->positionDriftCompensationNeeded(gMax)) { // project both, first positions and then velocities
+            system->projectGeneralizedPositions(3);
+            system->projectGeneralizedVelocities(3);
+            projVel = false;
+          }
+        }
+        if(gdMax>=0 and projVel) {
+          system->resetUpToDate();
+          if(system->velocityDriftCompensationNeeded(gdMax)) // project velicities
+            system->projectGeneralizedVelocities(3);
+        }
+        system->updateStopVectorParameters();
+      }
+
+      system->updateInternalState();
+      system->resetUpToDate();
+      svLast = system->evalsv();
+      t = system->getTime();
+      z = system->getState();
+    }
+  }
+
+  void MultirateIntegrator::postIntegrate() {
+    msg(Info)<<"nrMacroSteps: "<<integrationSteps<<endl;
+  }
+
+  namespace {
+    struct MultirateIntegratorSnapshot {
+      double t;
+      double tPlot;
+      int integrationSteps;
+    };
+  }
+
+  size_t MultirateIntegrator::getSnapshotSize() const {
+    return sizeof(MultirateIntegratorSnapshot) + svLast.size()*sizeof(double);
+  }
+
+  void MultirateIntegrator::getSnapshot(char *snapshot) const {
+    MultirateIntegratorSnapshot s;
+    s.t = t;
+    s.tPlot = tPlot;
+    s.integrationSteps = integrationSteps;
+    memcpy(snapshot, &s, sizeof(s));
+    if(svLast.size())
+      memcpy(snapshot+sizeof(s), svLast(), svLast.size()*sizeof(double));
+  }
+
+  void MultirateIntegrator::setSnapshot(const char *snapshot) {
+    MultirateIntegratorSnapshot s;
+    memcpy(&s, snapshot, sizeof(s));
+    t = s.t;
+    tPlot = s.tPlot;
+    integrationSteps = s.integrationSteps;
+    if(svLast.size())
+      memcpy(svLast(), snapshot+sizeof(s), svLast.size()*sizeof(double));
+    // the state is taken from the system, which must be restored before
+    z = system->getState();
+  }
+
+  void MultirateIntegrator::integrate() {
+    preIntegrate();
+    subIntegrate(tEnd);
+    postIntegrate();
+  }
+
+  void MultirateIntegrator::initializeUsingXML(DOMElement *element) {
+    RootFindingIntegrator::initializeUsingXML(element);
+    DOMElement *e;
+    e=E(element)->getFirstElementChildNamed(MBSIM%"stepSize");
+    if(e) setStepSize(E(e)->getText<double>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"numberOfSubsteps");
+    if(e) setNumberOfSubsteps(E(e)->getText<int>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"fastElement");
+    while(e && E(e)->getTagName()==MBSIM%"fastElement") {
+      addFastElement(E(e)->getAttribute("ref"));
+      e=e->getNextElementSibling();
+    }
+    e=E(element)->getFirstElementChildNamed(MBSIM%"conservativeCoupling");
+    if(e) setConservativeCoupling(E(e)->getText<bool>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"linearlyImplicitSubsteps");
+    if(e) setLinearlyImplicitSubsteps(E(e)->getText<bool>());
+  }
+
+}
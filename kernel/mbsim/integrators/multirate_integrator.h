@@ -0,0 +1,119 @@
+/* Copyright (C) 2004-2009 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _MULTIRATE_INTEGRATOR_H_
+#define _MULTIRATE_INTEGRATOR_H_
+
+#include "root_finding_integrator.h"
+
+namespace MBSim {
+
+  class Element;
+
+  /** \brief Explicit multirate integrator with two rate classes.
+   *
+   * The states of the fast elements (objects, links or dynamic systems) are integrated with numberOfSubsteps
+   * explicit or linearly implicit Euler steps per macro step; all other states are integrated with one explicit Euler
+   * step of the macro step size. During the sub steps the slow states are interpolated linearly and only the state
+   * derivative of the fast elements is evaluated (slowest first).
+   * The linearly implicit sub steps solve (I-h*J)*dz=h*f with the Jacobian J of the fast states, which is computed by
+   * finite differences once per macro step.
+   * With conservative coupling the slow velocities are integrated with the mean of the generalized forces (h and r)
+   * of the sub steps instead of the forces of the macro start. These forces are evaluated for the fast objects in each
+   * sub step anyway, hence the coupling links apply the same impulse to both rate classes without further evaluations
+   * of the slow partition; only one additional solve with the mass matrix of the macro start per macro step is needed.
+   * Roots of the stop vector are searched on the piecewise linear interpolation of the macro step.
+   */
+  class MultirateIntegrator : public RootFindingIntegrator {
+    public:
+      /**
+       * \brief destructor
+       */
+      ~MultirateIntegrator() override = default;
+
+      void preIntegrate() override;
+      void subIntegrate(double tStop) override;
+      void postIntegrate() override;
+      size_t getSnapshotSize() const override;
+      void getSnapshot(char *snapshot) const override;
+      void setSnapshot(const char *snapshot) override;
+
+      /* INHERITED INTERFACE OF INTEGRATOR */
+      using Integrator::integrate;
+      void integrate() override;
+      void initializeUsingXML(xercesc::DOMElement *element) override;
+      /***************************************************/
+
+      /* GETTER / SETTER */
+      void setStepSize(double dt_) { dt = dt_; }
+      void setNumberOfSubsteps(int nSub_) { nSub = nSub_; }
+      //! Add a fast element given by its path relative to the dynamic system solver.
+      //! The path refers to the hierarchy of the model before the reorganization during the initialization.
+      void addFastElement(const std::string &path) { fastElementPath.push_back(path); }
+      void setConservativeCoupling(bool conservative_) { conservative = conservative_; }
+      void setLinearlyImplicitSubsteps(bool linearlyImplicit_) { linearlyImplicit = linearlyImplicit_; }
+      /***************************************************/
+
+    private:
+      //! set time and state of the system by the interpolation of the last macro step
+      void interpolate(double tCheck);
+
+      //! resolve the fast elements by their paths and build the partition of the state
+      void partitionState();
+
+      //! Jacobian of the fast state derivative with respect to the fast states at the current time and state
+      void updateFastJacobian();
+
+      /**
+       * \brief macro step size
+       */
+      double dt{1e-3};
+
+      /**
+       * \brief number of sub steps of the fast states per macro step
+       */
+      int nSub{10};
+
+      /**
+       * \brief integrate the slow velocities with the mean generalized forces of the sub steps
+       */
+      bool conservative{false};
+
+      /**
+       * \brief linearly implicit instead of explicit sub steps of the fast states
+       */
+      bool linearlyImplicit{false};
+
+      std::vector<std::string> fastElementPath;
+      std::vector<Element*> fastElement;
+      std::vector<int> fastInd, slowInd;
+
+      double t, H, tPlot;
+      int integrationSteps;
+      double s0, time;
+      fmatvec::Vec z, z1;
+      fmatvec::Mat zFast; // fast states at the sub steps (columns)
+      fmatvec::SqrMat Jff, LU; // Jacobian of the fast states and LU decomposition of I-h*Jff
+      fmatvec::SymMat LLM0; // Cholesky decomposition of the mass matrix at the macro start
+      fmatvec::VecInt ipiv;
+  };
+
+}
+
+#endif
@@ -0,0 +1,361 @@
+/* Copyright (C) 2004-2009 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h>
+#include <mbsim/dynamic_system_solver.h>
+#include <mbsim/utils/eps.h>
+#include <mbsim/links/contact.h>
+#include <mbsim/links/single_contact.h>
+#include <mbsim/constitutive_laws/unilateral_constraint.h>
+#include "nonsmooth_generalized_alpha_integrator.h"
+#include <ctime>
+#include <cstring>
+
+#ifndef NO_ISO_14882
+using namespace std;
+#endif
+
+using namespace fmatvec;
+using namespace MBSim;
+using namespace MBXMLUtils;
+using namespace xercesc;
+
+namespace MBSim {
+
+  MBSIM_OBJECTFACTORY_REGISTERCLASS(MBSIM, NonsmoothGeneralizedAlphaIntegrator)
+
+  void NonsmoothGeneralizedAlphaIntegrator::preIntegrate() {
+    debugInit();
+
+    if(dt<=0)
+      throwError("(NonsmoothGeneralizedAlphaIntegrator::integrate): step size must be positive");
+    if(rho<0 or rho>1)
+      throwError("(NonsmoothGeneralizedAlphaIntegrator::integrate): spectral radius must be in [0,1]");
+
+    alm = (2*rho-1)/(rho+1);
+    alf = rho/(rho+1);
+    gamma = 0.5+alf-alm;
+    beta = 0.25*(gamma+0.5)*(gamma+0.5);
+    betap = (1-alf)/(1-alm);
+
+    system->setTime(tStart);
+    tPlot = tStart;
+
+    system->setStepSize(dt);
+
+    if(z0.size()) {
+      if(z0.size() != system->getzSize()+system->getisSize())
+        throwError("(NonsmoothGeneralizedAlphaIntegrator::integrate): size of z0 does not match, must be " + to_string(system->getzSize()+system->getisSize()));
+      system->setState(z0(RangeV(0,system->getzSize()-1)));
+      system->setInternalState(z0(RangeV(system->getzSize(),z0.size()-1)));
+    }
+    else
+      system->evalz0();
+
+    system->checkActive(1);
+    if (system->gActiveChanged()) resize();
+
+    // Perform a projection of generalized positions at time t=0
+    if(system->getInitialProjection())
+      system->projectGeneralizedPositions(3,true);
+
+    // smooth accelerations with the constraint forces of the joints and closed contacts on acceleration level
+    system->resetUpToDate();
+    resizeSmooth();
+    if(system->getgSize()) {
+      const Mat &W = system->evalW();
+      SqrMat G = SqrMat(W.T()*slvLLFac(system->evalLLM(),W));
+      Vec la = slvLS(G,-(W.T()*slvLLFac(system->evalLLM(),system->evalh())+system->evalwb()));
+      ud <<= slvLLFac(system->evalLLM(),system->evalh()+W*la);
+    }
+    else
+      ud <<= slvLLFac(system->evalLLM(),system->evalh());
+    a <<= ud;
+    resize();
+
+    s0 = clock();
+  }
+
+  void NonsmoothGeneralizedAlphaIntegrator::subIntegrate(double tStop) {
+    while(system->getTime()<tStop) { // time loop
+      integrationSteps++;
+      output.beginStep(system);
+
+      // smooth part: generalized-alpha step with the constraint forces of the joints and closed contacts
+      Vec q0 = system->getq();
+      Vec u0 = system->getu();
+      Vec dx = system->evaldx();
+      Mat T = system->evalT();
+
+      Vec hOld = system->evalh();
+      Mat dhdq(system->gethSize(),system->getqSize(),NONINIT);
+      for (int i=0; i<system->getqSize(); i++) {
+        double qtmp = system->getq()(i);
+        system->getq()(i) += epsroot;
+        system->resetUpToDate();
+        dhdq.set(i, (system->evalh()-hOld)/epsroot);
+        system->getq()(i) = qtmp;
+      }
+      Mat dhdu(system->gethSize(),system->getuSize(),NONINIT);
+      for (int i=0; i<system->getuSize(); i++) {
+        double utmp = system->getu()(i);
+        system->getu()(i) += epsroot;
+        system->resetUpToDate();
+        dhdu.set(i, (system->evalh()-hOld)/epsroot);
+        system->getu()(i) = utmp;
+      }
+      system->resetUpToDate();
+
+      // the joints and the contacts which are closed at the beginning of the step are constraints on position level;
+      // their constraint forces la are unknowns of the Newton iteration besides the smooth accelerations
+      resizeSmooth();
+      int nu = system->getuSize();
+      int ng = system->getgSize();
+      Mat W0 = system->evalW();
+      VecInt unilateral = evalUnilateralConstraints();
+
+      // a_{n+1} = aPred + betap*ud_{n+1}; q_{n+1} and u_{n+1} depend linearly on ud_{n+1}
+      double cq = dt*dt*beta*betap;
+      double cu = dt*gamma*betap;
+      Vec aPred = (alf*ud - alm*a)/(1-alm);
+      Vec qPred = q0 + T*(u0 + (dt*(0.5-beta))*a + (dt*beta)*aPred)*dt;
+      Vec uPred = u0 + (dt*(1-gamma))*a + (dt*gamma)*aPred;
+      SqrMat Jw = SqrMat(system->evalM() - cu*dhdu - cq*dhdq*T);
+
+      system->getTime() += dt;
+      Vec w = ud;
+      Vec la(ng);
+      VecInt released(ng);
+      for(int pass=0; pass<=ng; pass++) {
+        // iteration matrix [M-cu*dh/du-cq*dh/dq*T, -W; W^T, 0] with the constraint directions at the beginning of the
+        // step; the constraint equations are g(q_{n+1})/cq=0 and la=0 for released contacts
+        SqrMat J(nu+ng);
+        J.set(RangeV(0,nu-1),RangeV(0,nu-1),Jw);
+        for(int i=0; i<ng; i++) {
+          if(released(i))
+            J(nu+i,nu+i) = 1;
+          else {
+            for(int j=0; j<nu; j++) {
+              J(j,nu+i) = -W0(j,i);
+              J(nu+i,j) = W0(j,i);
+            }
+          }
+        }
+        VecInt ipiv(nu+ng);
+        SqrMat luJ = SqrMat(facLU(J,ipiv));
+
+        bool converged = false;
+        for(int iter=0; iter<maxNewtonIter; iter++) {
+          system->getq() = qPred + cq*(T*w);
+          system->getu() = uPred + cu*w;
+          system->resetUpToDate();
+          Vec res(nu+ng,NONINIT);
+          if(ng) {
+            res.set(RangeV(0,nu-1),system->evalM()*w-system->evalh()-system->evalW()*la);
+            const Vec &g = system->evalg();
+            for(int i=0; i<ng; i++)
+              res(nu+i) = released(i) ? la(i) : g(i)/cq;
+          }
+          else
+            res = system->evalM()*w-system->evalh();
+          Vec dwla = slvLUFac(luJ,res,ipiv);
+          Vec dw = dwla(RangeV(0,nu-1));
+          w -= dw;
+          if(ng)
+            la -= dwla(RangeV(nu,nu+ng-1));
+          sumNewtonIter++;
+          if(nrmInf(dw)<=tol*(1+nrmInf(w))) {
+            converged = true;
+            break;
+          }
+        }
+        if(not converged)
+          throwError("(NonsmoothGeneralizedAlphaIntegrator::subIntegrate): Newton iteration did not converge at t = " + to_string(system->getTime()));
+
+        // unilateral contacts with a tensile constraint force are released and the iteration is repeated
+        bool changed = false;
+        for(int i=0; i<ng; i++) {
+          if(unilateral(i) and not released(i) and la(i)<0) {
+            released(i) = 1;
+            changed = true;
+          }
+        }
+        if(not changed)
+          break;
+      }
+      a = aPred + betap*w;
+      ud = w;
+      system->getq() = qPred + cq*(T*w);
+      system->getu() = uPred + cu*w;
+      system->resetUpToDate();
+      resize();
+
+      // nonsmooth part: impulses on velocity level
+      system->checkActive(1);
+      if (system->gActiveChanged()) resize();
+
+      if(gMax>=0 and system->positionDriftCompensationNeeded(gMax))
+        system->projectGeneralizedPositions(3);
+
+      system->getbi(false) <<= system->evalgd();
+      system->setUpdatebi(false);
+
+      system->getu() += slvLLFac(system->evalLLM(),system->evalrdt());
+      system->getx() += dx;
+
+      system->resetUpToDate();
+
+      if(system->getIterI()>maxIter) maxIter = system->getIterI();
+      sumIter += system->getIterI();
+
+      if(output.endStep(system, system->getLa(false)/dt, tPlot, dtPlot)) {
+        double s1 = clock();
+        time += (s1-s0)/CLOCKS_PER_SEC;
+        s0 = s1;
+        if(msgAct(Status)) msg(Status) << "   t = " << system->getTime() << ",\tdt = "<< dt << ",\titer = "<<setw(5)<<setiosflags(ios::left) << system->getIterI() <<  flush;
+      }
+
+      system->updateInternalState();
+    }
+  }
+
+  void NonsmoothGeneralizedAlphaIntegrator::postIntegrate() {
+    msg(Info) << endl << endl << "******************************" << endl;
+    msg(Info) << "INTEGRATION SUMMARY: " << endl;
+    msg(Info) << "End time [s]: " << tEnd << endl;
+    msg(Info) << "Integration time [s]: " << time << endl;
+    msg(Info) << "Integration steps: " << integrationSteps << endl;
+    msg(Info) << "Average number of Newton iterations: " << double(sumNewtonIter)/integrationSteps << endl;
+    msg(Info) << "Maximum number of iterations: " << maxIter << endl;
+    msg(Info) << "Average number of iterations: " << double(sumIter)/integrationSteps << endl;
+    msg(Info) << "******************************" << endl;
+    msg(Info).flush();
+  }
+
+  namespace {
+    struct NonsmoothGeneralizedAlphaIntegratorSnapshot {
+      double tPlot;
+      int integrationSteps;
+      int sumNewtonIter;
+      int maxIter;
+      int sumIter;
+    };
+  }
+
+  size_t NonsmoothGeneralizedAlphaIntegrator::getSnapshotSize() const {
+    return sizeof(NonsmoothGeneralizedAlphaIntegratorSnapshot) + (ud.size()+a.size())*sizeof(double);
+  }
+
+  void NonsmoothGeneralizedAlphaIntegrator::getSnapshot(char *snapshot) const {
+    NonsmoothGeneralizedAlphaIntegratorSnapshot s;
+    s.tPlot = tPlot;
+    s.integrationSteps = integrationSteps;
+    s.sumNewtonIter = sumNewtonIter;
+    s.maxIter = maxIter;
+    s.sumIter = sumIter;
+    memcpy(snapshot, &s, sizeof(s));
+    snapshot += sizeof(s);
+    // the smooth accelerations are part of the state of the method
+    if(ud.size()) {
+      memcpy(snapshot, ud(), ud.size()*sizeof(double));
+      memcpy(snapshot+ud.size()*sizeof(double), a(), a.size()*sizeof(double));
+    }
+  }
+
+  void NonsmoothGeneralizedAlphaIntegrator::setSnapshot(const char *snapshot) {
+    NonsmoothGeneralizedAlphaIntegratorSnapshot s;
+    memcpy(&s, snapshot, sizeof(s));
+    tPlot = s.tPlot;
+    integrationSteps = s.integrationSteps;
+    sumNewtonIter = s.sumNewtonIter;
+    maxIter = s.maxIter;
+    sumIter = s.sumIter;
+    snapshot += sizeof(s);
+    if(ud.size()) {
+      memcpy(ud(), snapshot, ud.size()*sizeof(double));
+      memcpy(a(), snapshot+ud.size()*sizeof(double), a.size()*sizeof(double));
+    }
+    resize();
+  }
+
+  void NonsmoothGeneralizedAlphaIntegrator::integrate() {
+    preIntegrate();
+    subIntegrate(tEnd);
+    postIntegrate();
+  }
+
+  void NonsmoothGeneralizedAlphaIntegrator::initializeUsingXML(DOMElement *element) {
+    Integrator::initializeUsingXML(element);
+    DOMElement *e;
+    e=E(element)->getFirstElementChildNamed(MBSIM%"stepSize");
+    if(e) setStepSize(E(e)->getText<double>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"spectralRadius");
+    if(e) setSpectralRadius(E(e)->getText<double>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"maximumNumberOfNewtonIterations");
+    if(e) setMaximumNumberOfNewtonIterations(E(e)->getText<int>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"newtonIterationTolerance");
+    if(e) setNewtonIterationTolerance(E(e)->getText<double>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"toleranceForPositionConstraints");
+    if(e) setToleranceForPositionConstraints(E(e)->getText<double>());
+  }
+
+  void NonsmoothGeneralizedAlphaIntegrator::resizeSmooth() {
+    system->calcgSize(1); // closed contacts
+    system->calclaSize(4); // closed contacts (normal direction only, as g)
+    system->updategRef(system->getgParent());
+    system->updateWRef(system->getWParent(0));
+    system->updatewbRef(system->getwbParent());
+    system->updatelaRef(system->getlaParent());
+  }
+
+  VecInt NonsmoothGeneralizedAlphaIntegrator::evalUnilateralConstraints() {
+    VecInt unilateral(system->getgSize());
+    for(auto *l : system->getSetValuedLinks()) {
+      GeneralizedForceLaw *fcl = nullptr;
+      if(auto *contact = dynamic_cast<Contact*>(l))
+        fcl = contact->getNormalForceLaw();
+      else if(auto *contact = dynamic_cast<SingleContact*>(l))
+        fcl = contact->getNormalForceLaw();
+      if(dynamic_cast<UnilateralConstraint*>(fcl)) {
+        for(int i=l->getgInd(); i<l->getgInd()+l->getgSize(); i++)
+          unilateral(i) = 1;
+      }
+    }
+    return unilateral;
+  }
+
+  void NonsmoothGeneralizedAlphaIntegrator::resize() {
+    system->calcgSize(0); // all contacts
+    system->updategRef(system->getgParent());
+    system->calcgdSize(2); // contacts which stay closed
+    system->calclaSize(2); // contacts which stay closed
+    system->calcrFactorSize(2); // contacts which stay closed
+
+    system->updateWRef(system->getWParent(0));
+    system->updateVRef(system->getVParent(0));
+    system->updatewbRef(system->getwbParent());
+    system->updatelaRef(system->getlaParent());
+    system->updateLaRef(system->getLaParent());
+    system->updategdRef(system->getgdParent());
+    if (system->getImpactSolver() == DynamicSystemSolver::rootfinding)
+      system->updateresRef(system->getresParent());
+    system->updaterFactorRef(system->getrFactorParent());
+  }
+
+}
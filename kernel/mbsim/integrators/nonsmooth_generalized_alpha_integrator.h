@@ -0,0 +1,134 @@
+/* Copyright (C) 2004-2009 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _NONSMOOTH_GENERALIZED_ALPHA_INTEGRATOR_H_
+#define _NONSMOOTH_GENERALIZED_ALPHA_INTEGRATOR_H_
+
+#include "integrator.h"
+#include "time_stepping_output.h"
+
+namespace MBSim {
+
+  /**
+   * \brief nonsmooth generalized-alpha time-stepping integrator
+   *
+   * Each step is split into a smooth and a nonsmooth part (Chen, Bruls and Cardona):
+   * - the smooth motion is integrated by the generalized-alpha method of Chung and Hulbert; the joints and the contacts
+   *   which are closed at the beginning of the step are constraints on position level, g(q_{n+1})=0. The smooth
+   *   accelerations and the constraint forces are the unknowns of a Newton iteration with finite difference
+   *   derivatives of h; unilateral contacts with a tensile constraint force are released;
+   * - impacts and status changes (closing contacts, stick-slip transitions, friction of closed contacts) are impulses
+   *   on velocity level, which are computed by the constraint solvers of the system as in the TimeSteppingIntegrator;
+   *   the position drift of closing contacts is removed by a projection.
+   *
+   * Since the accelerations of the generalized-alpha method contain the smooth part including the constraint forces,
+   * the scheme is of second order in smooth phases with joints and persistently closed contacts (the link states x are
+   * integrated by the explicit Euler method) and keeps the robustness of the impulse based time-stepping schemes at
+   * impacts. The plotted constraint forces of the links are the impulses of the nonsmooth part divided by the step
+   * size; the smooth constraint forces are part of the accelerations.
+   */
+  class NonsmoothGeneralizedAlphaIntegrator : public Integrator {
+    public:
+      /**
+       * \brief destructor
+       */
+      ~NonsmoothGeneralizedAlphaIntegrator() override = default;
+
+      void preIntegrate() override;
+      void subIntegrate(double tStop) override;
+      void postIntegrate() override;
+      size_t getSnapshotSize() const override;
+      void getSnapshot(char *snapshot) const override;
+      void setSnapshot(const char *snapshot) override;
+
+      /* INHERITED INTERFACE OF INTEGRATOR */
+      using Integrator::integrate;
+      void integrate() override;
+      void initializeUsingXML(xercesc::DOMElement *element) override;
+      /***************************************************/
+
+      /* GETTER / SETTER */
+      void setStepSize(double dt_) { dt = dt_; }
+      void setSpectralRadius(double rho_) { rho = rho_; }
+      void setMaximumNumberOfNewtonIterations(int maxNewtonIter_) { maxNewtonIter = maxNewtonIter_; }
+      void setNewtonIterationTolerance(double tol_) { tol = tol_; }
+      void setToleranceForPositionConstraints(double gMax_) { gMax = gMax_; }
+      /***************************************************/
+
+    private:
+      //! sizes of the active sets of the nonsmooth part
+      void resize();
+
+      //! sizes of the position constraints of the smooth part (joints and closed contacts)
+      void resizeSmooth();
+
+      //! flags of the position constraints of the smooth part which belong to unilateral contacts
+      fmatvec::VecInt evalUnilateralConstraints();
+
+      /**
+       * \brief step size
+       */
+      double dt{1e-3};
+
+      /**
+       * \brief spectral radius at infinity (numerical damping)
+       */
+      double rho{0.8};
+
+      /**
+       * \brief maximum number of Newton iterations for the smooth accelerations
+       */
+      int maxNewtonIter{5};
+
+      /**
+       * \brief tolerance of the Newton iteration
+       */
+      double tol{1e-8};
+
+      /** tolerance for position constraints */
+      double gMax{1e-8};
+
+      double alm{0}, alf{0}, gamma{0}, beta{0}, betap{0};
+
+      /**
+       * \brief smooth accelerations and generalized-alpha accelerations
+       */
+      fmatvec::Vec ud, a;
+
+      /**
+       * \brief plot time
+       */
+      double tPlot{0};
+
+      /**
+       * \brief counters of integration steps, Newton iterations and iterations of the constraint solver
+       */
+      int integrationSteps{0}, sumNewtonIter{0}, maxIter{0}, sumIter{0};
+
+      /**
+       * \brief computing time counter
+       */
+      double s0{0}, time{0};
+
+      TimeSteppingOutput output;
+  };
+
+}
+
+#endif
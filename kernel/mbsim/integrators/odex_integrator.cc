@@ -65,24 +65,12 @@ namespace MBSim {
       // if a root exists in the current step ...
       if(self->shift) {
         // ... search the first root and set step.second to this time
-        double dt = *t-*told;
-        while(dt>self->dtRoot) {
-          dt/=2;
-          double tCheck = tRoot-dt;
+        tRoot = self->findRoot(*told, *t, [&](double tCheck) {
           self->getSystem()->setTime(tCheck);
-          curTimeAndState = tCheck;
           for(int i=1; i<=*n; i++)
             self->getSystem()->getState()(i-1) = CONTEX(&i,&tCheck,con,ncon,icomp,nd);
-          self->getSystem()->resetUpToDate();
-          if(self->signChangedWRTsvLast(self->getSystem()->evalsv()))
-            tRoot = tCheck;
-        }
-        if(curTimeAndState != tRoot) {
-          curTimeAndState = tRoot;
-          self->getSystem()->setTime(tRoot);
-          for(int i=1; i<=*n; i++)
-            self->getSystem()->getState()(i-1) = CONTEX(&i,&tRoot,con,ncon,icomp,nd);
-        }
+        });
+        curTimeAndState = tRoot;
         self->getSystem()->resetUpToDate();
         auto &sv = self->getSystem()->evalsv();
         auto &jsv = self->getSystem()->getjsv();
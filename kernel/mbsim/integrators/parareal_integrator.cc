@@ -0,0 +1,306 @@
+/* Copyright (C) 2004-2009 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h>
+#include <mbsim/dynamic_system_solver.h>
+#include <mbsim/utils/eps.h>
+#include <mbsim/objectfactory.h>
+#include "parareal_integrator.h"
+#include <mbsim/utils/fork_utils.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <thread>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#ifndef NO_ISO_14882
+using namespace std;
+#endif
+
+using namespace fmatvec;
+using namespace MBSim;
+using namespace MBXMLUtils;
+using namespace xercesc;
+
+namespace MBSim {
+
+  MBSIM_OBJECTFACTORY_REGISTERCLASS(MBSIM, PararealIntegrator)
+
+  namespace {
+    double wallTime() {
+      return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+#ifndef _WIN32
+    struct SliceHeader {
+      int ok;
+      double time;
+      size_t plotSize;
+    };
+#endif
+  }
+
+  void PararealIntegrator::propagate(Integrator *integrator, const vector<char> &start, double t0, double t1, double dtPlot_, vector<char> &end, vector<char> *plot) {
+    system->setSnapshot(start.data());
+    Vec zStart(system->getzSize()+system->getisSize(), NONINIT);
+    zStart.set(RangeV(0,system->getzSize()-1), system->getState());
+    if(system->getisSize())
+      zStart.set(RangeV(system->getzSize(),zStart.size()-1), system->getInternalState());
+
+    // record the plot states instead of writing them
+    if(plot) {
+      plot->clear();
+      system->setPlotFunction([this, plot]() {
+        size_t n = plot->size();
+        plot->resize(n+system->getSnapshotSize());
+        system->getSnapshot(plot->data()+n);
+      });
+    }
+    else
+      system->setPlotFunction([]() {});
+
+    integrator->setSystem(system);
+    integrator->setStartTime(t0);
+    integrator->setEndTime(t1);
+    integrator->setPlotStepSize(dtPlot_);
+    integrator->setInitialState(zStart);
+    try {
+      integrator->integrate();
+    }
+    catch(...) {
+      system->setPlotFunction(nullptr);
+      throw;
+    }
+    system->setPlotFunction(nullptr);
+
+    system->setTime(t1);
+    end.resize(system->getSnapshotSize());
+    system->getSnapshot(end.data());
+  }
+
+  void PararealIntegrator::checkFork() {
+    // an OpenMP thread pool (e.g. of the contact kernels) is created on the first parallel region; set OMP_NUM_THREADS=1
+    // to avoid it. Propagating the slices one after the other would be slower than the fine integrator alone.
+    if(not ForkUtils::isAvailable())
+      throwError("(PararealIntegrator::integrate): the slices are propagated in forked processes, which is not available on this platform");
+    if(not ForkUtils::isSingleThreaded())
+      throwError("(PararealIntegrator::integrate): the process has more than one thread (e.g. an OpenMP thread pool) and can not be forked; run with OMP_NUM_THREADS=1");
+  }
+
+  void PararealIntegrator::propagateFine(const vector<vector<char>> &U, int first, vector<Slice> &F) {
+    int N = T.size()-1;
+    checkFork();
+#ifndef _WIN32
+    // Each slice is propagated in a forked process, which is an independent copy of the system (see ForkUtils): the
+    // plot output is recorded by propagate and written by this process.
+    ForkUtils::flushBeforeFork();
+    size_t snapshotSize = system->getSnapshotSize();
+    vector<pid_t> pid(N, -1);
+    vector<int> fd(N, -1);
+    for(int n=first; n<N; n++) {
+      int p[2];
+      if(pipe(p)!=0)
+        throwError("(PararealIntegrator::integrate): cannot create pipe");
+      pid[n] = fork();
+      if(pid[n]<0)
+        throwError("(PararealIntegrator::integrate): cannot fork");
+      if(pid[n]==0) {
+        close(p[0]);
+        SliceHeader h{1, 0, 0};
+        Slice s;
+        double s0 = wallTime();
+        try {
+          propagate(fine.get(), U[n], T[n], T[n+1], dtPlot, s.end, &s.plot);
+        }
+        catch(const exception &ex) {
+          msg(Error)<<"(PararealIntegrator::integrate): slice "<<n<<" failed: "<<ex.what()<<endl;
+          h.ok = 0;
+        }
+        catch(...) {
+          h.ok = 0;
+        }
+        h.time = wallTime()-s0;
+        h.plotSize = s.plot.size();
+        bool ok = ForkUtils::writeAll(p[1], reinterpret_cast<const char*>(&h), sizeof(h));
+        if(ok and h.ok)
+          ok = ForkUtils::writeAll(p[1], s.end.data(), snapshotSize) and ForkUtils::writeAll(p[1], s.plot.data(), s.plot.size());
+        close(p[1]);
+        _exit(ok and h.ok ? 0 : 1);
+      }
+      close(p[1]);
+      fd[n] = p[0];
+    }
+
+    bool ok = true;
+    for(int n=first; n<N; n++) {
+      SliceHeader h{0, 0, 0};
+      if(ok and ForkUtils::readAll(fd[n], reinterpret_cast<char*>(&h), sizeof(h)) and h.ok) {
+        F[n].end.resize(snapshotSize);
+        F[n].plot.resize(h.plotSize);
+        F[n].time = h.time;
+        ok = ForkUtils::readAll(fd[n], F[n].end.data(), snapshotSize) and ForkUtils::readAll(fd[n], F[n].plot.data(), h.plotSize);
+      }
+      else
+        ok = false;
+      close(fd[n]);
+      int status;
+      waitpid(pid[n], &status, 0);
+      ok = ok and WIFEXITED(status) and WEXITSTATUS(status)==0;
+    }
+    if(not ok)
+      throwError("(PararealIntegrator::integrate): fine propagation failed");
+#endif
+  }
+
+  void PararealIntegrator::integrate() {
+    debugInit();
+
+    if(not coarse or not fine)
+      throwError("(PararealIntegrator::integrate): coarse and fine integrator must be given");
+    if(dtPlot<=0)
+      throwError("(PararealIntegrator::integrate): plot step size must be positive");
+
+    checkFork();
+
+    double s0 = wallTime();
+
+    // slice boundaries at multiples of the plot step size; hence, the plot times of all slices are on the global grid
+    int N = nSlices>0 ? nSlices : max(1u, thread::hardware_concurrency());
+    T.clear();
+    T.push_back(tStart);
+    for(int n=1; n<N; n++) {
+      double Tn = tStart + round(n*(tEnd-tStart)/N/dtPlot)*dtPlot;
+      if(Tn>T.back()+epsroot and Tn<tEnd-epsroot)
+        T.push_back(Tn);
+    }
+    T.push_back(tEnd);
+    N = T.size()-1;
+    int K = maxIter>0 ? min(maxIter, N) : N;
+    msg(Info)<<"Parareal integration with "<<N<<" slices."<<endl;
+
+    // initial state
+    system->setTime(tStart);
+    if(z0.size()) {
+      if(z0.size() != system->getzSize()+system->getisSize())
+        throwError("(PararealIntegrator::integrate): size of z0 does not match, must be " + to_string(system->getzSize()+system->getisSize()));
+      system->setState(z0(RangeV(0,system->getzSize()-1)));
+      system->setInternalState(z0(RangeV(system->getzSize(),z0.size()-1)));
+    }
+    else
+      system->evalz0();
+    system->resetUpToDate();
+
+    vector<vector<char>> U(N+1, vector<char>(system->getSnapshotSize())), G(N);
+    system->getSnapshot(U[0].data());
+
+    // coarse prediction
+    for(int n=0; n<N; n++)
+      propagate(coarse.get(), U[n], T[n], T[n+1], T[n+1]-T[n], U[n+1], nullptr);
+    G.assign(U.begin()+1, U.end());
+
+    vector<Slice> F(N);
+    double tFineSequential = 0;
+    int k = 0;
+    double change;
+    Vec zOld;
+    while(true) {
+      propagateFine(U, k, F);
+      if(k==0)
+        for(auto &s : F)
+          tFineSequential += s.time;
+
+      // the slice k starts with the exact state; the correction of the following slices is done sequentially
+      change = 0;
+      vector<char> Gnew;
+      auto update = [this, &change, &zOld](vector<char> &Un, const vector<char> &Unew) {
+        system->setSnapshot(Un.data());
+        zOld = system->getState();
+        system->setSnapshot(Unew.data());
+        const Vec &zNew = system->getState();
+        for(int i=0; i<zNew.size(); i++)
+          change = max(change, fabs(zNew(i)-zOld(i))/(1+fabs(zOld(i))));
+        Un = Unew;
+      };
+      update(U[k+1], F[k].end);
+      for(int n=k+1; n<N; n++) {
+        propagate(coarse.get(), U[n], T[n], T[n+1], T[n+1]-T[n], Gnew, nullptr);
+        // U_{n+1} = G(U_n) + F(U_n^old) - G(U_n^old); all other parts of the state are taken from the fine propagator
+        system->setSnapshot(G[n].data());
+        zOld = system->getState();
+        system->setSnapshot(Gnew.data());
+        Vec zG = system->getState();
+        system->setSnapshot(F[n].end.data());
+        system->getState() += zG - zOld;
+        vector<char> Unew(system->getSnapshotSize());
+        system->getSnapshot(Unew.data());
+        update(U[n+1], Unew);
+        G[n] = move(Gnew);
+      }
+      k++;
+      msg(Info)<<"Parareal iteration "<<k<<": relative change of the slice boundary states "<<change<<endl;
+      if(change<=tol or k>=K)
+        break;
+    }
+    if(change<=tol)
+      msg(Info)<<"Parareal converged after "<<k<<" iterations."<<endl;
+    else
+      msg(Warn)<<"Parareal not converged after "<<k<<" iterations."<<endl;
+
+    // write the plot states of the fine propagators; the end of a slice is the start of the next slice
+    double tLast = -numeric_limits<double>::max();
+    for(int n=0; n<N; n++) {
+      size_t size = system->getSnapshotSize();
+      for(size_t p=0; p+size<=F[n].plot.size(); p+=size) {
+        system->setSnapshot(F[n].plot.data()+p);
+        if(system->getTime()<=tLast+epsroot)
+          continue;
+        tLast = system->getTime();
+        system->resetUpToDate();
+        system->plot();
+      }
+    }
+    system->setSnapshot(U[N].data());
+
+    double time = wallTime()-s0;
+    msg(Info)<<"Time used for integration: "<<time<<" s (sequential fine integration: "<<tFineSequential<<" s, speed-up: "
+             <<tFineSequential/time<<")"<<endl;
+  }
+
+  void PararealIntegrator::initializeUsingXML(DOMElement *element) {
+    Integrator::initializeUsingXML(element);
+    DOMElement *e;
+    e=E(element)->getFirstElementChildNamed(MBSIM%"coarseIntegrator");
+    setCoarseIntegrator(ObjectFactory::createAndInit<Integrator>(e->getFirstElementChild()));
+    e=E(element)->getFirstElementChildNamed(MBSIM%"fineIntegrator");
+    setFineIntegrator(ObjectFactory::createAndInit<Integrator>(e->getFirstElementChild()));
+    e=E(element)->getFirstElementChildNamed(MBSIM%"numberOfSlices");
+    if(e) setNumberOfSlices(E(e)->getText<int>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"maximumNumberOfIterations");
+    if(e) setMaximumNumberOfIterations(E(e)->getText<int>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"tolerance");
+    if(e) setTolerance(E(e)->getText<double>());
+  }
+
+}
@@ -0,0 +1,102 @@
+/* Copyright (C) 2004-2009 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _PARAREAL_INTEGRATOR_H_
+#define _PARAREAL_INTEGRATOR_H_
+
+#include "integrator.h"
+#include <memory>
+#include <vector>
+
+namespace MBSim {
+
+  /** \brief Parallel-in-time integrator (parareal).
+   *
+   * The time interval is split into slices. A cheap coarse integrator predicts the states at the slice boundaries
+   * sequentially, the accurate fine integrator propagates all slices concurrently. The boundary states are corrected
+   * by U_{n+1} = G(U_n) + F(U_n^old) - G(U_n^old) until the relative change of all boundary states is below the
+   * tolerance. The slices are at most numberOfSlices iterations apart from the sequential fine solution.
+   *
+   * The fine propagators run in forked processes, which are independent copies of the initialised system. The
+   * children never access the open HDF5 and OpenMBV files: the plot states of the fine propagators are recorded and
+   * written by this process after the last iteration. A fork requires a single threaded process; otherwise (e.g. an
+   * OpenMP thread pool exists, use OMP_NUM_THREADS=1) and on Windows the integration stops with an error, since
+   * propagating the slices one after the other is slower than the fine integrator alone.
+   */
+  class PararealIntegrator : public Integrator {
+    public:
+      /**
+       * \brief destructor
+       */
+      ~PararealIntegrator() override = default;
+
+      /* INHERITED INTERFACE OF INTEGRATOR */
+      using Integrator::integrate;
+      void integrate() override;
+      void initializeUsingXML(xercesc::DOMElement *element) override;
+      /***************************************************/
+
+      /* GETTER / SETTER */
+      void setCoarseIntegrator(Integrator *coarse_) { coarse.reset(coarse_); }
+      void setFineIntegrator(Integrator *fine_) { fine.reset(fine_); }
+      void setNumberOfSlices(int nSlices_) { nSlices = nSlices_; }
+      void setMaximumNumberOfIterations(int maxIter_) { maxIter = maxIter_; }
+      void setTolerance(double tol_) { tol = tol_; }
+      /***************************************************/
+
+    private:
+      //! result of the fine propagation of one slice
+      struct Slice {
+        std::vector<char> end; // snapshot at the end of the slice
+        std::vector<char> plot; // snapshots at the plot times
+        double time{0}; // wall time of the propagation
+      };
+
+      //! propagate the system from the snapshot start over [t0,t1] with the given integrator
+      void propagate(Integrator *integrator, const std::vector<char> &start, double t0, double t1, double dtPlot_, std::vector<char> &end, std::vector<char> *plot);
+
+      //! propagate the slices first to nSlices-1 with the fine integrator concurrently
+      void propagateFine(const std::vector<std::vector<char>> &U, int first, std::vector<Slice> &F);
+
+      //! throw if the process can not be forked
+      void checkFork();
+
+      std::unique_ptr<Integrator> coarse, fine;
+
+      /**
+       * \brief number of time slices; 0 means the number of hardware threads
+       */
+      int nSlices{0};
+
+      /**
+       * \brief maximum number of parareal iterations; 0 means nSlices (the sequential fine solution)
+       */
+      int maxIter{0};
+
+      /**
+       * \brief tolerance for the relative change of the slice boundary states
+       */
+      double tol{1e-6};
+
+      std::vector<double> T;
+  };
+
+}
+
+#endif
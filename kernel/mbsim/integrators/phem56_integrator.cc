@@ -171,26 +171,13 @@ namespace MBSim {
         // if a root exists in the current step ...
         if(self->shift) {
           // ... search the first root and set step.second to this time
-          double dt = t-told;
-          while(dt>self->dtRoot) {
-            dt/=2;
-            double tCheck = tRoot-dt;
+          tRoot = self->findRoot(told, t, [&](double tCheck) {
             self->getSystem()->setTime(tCheck);
-            curTimeAndState = tCheck;
             int first = true;
             for(int i=1; i<=self->system->getzSize(); i++)
               self->getSystem()->getState()(i-1) = POL4(&i,&first,nq,nv,nu,lrdo,&tCheck,dowk);
-            self->getSystem()->resetUpToDate();
-            if(self->signChangedWRTsvLast(self->getSystem()->evalsv()))
-              tRoot = tCheck;
-          }
-          if(curTimeAndState != tRoot) {
-            curTimeAndState = tRoot;
-            self->getSystem()->setTime(tRoot);
-            int first = true;
-            for(int i=1; i<=self->system->getzSize(); i++)
-              self->getSystem()->getState()(i-1) = POL4(&i,&first,nq,nv,nu,lrdo,&tRoot,dowk);
-          }
+          });
+          curTimeAndState = tRoot;
           self->getSystem()->resetUpToDate();
           auto &sv = self->getSystem()->evalsv();
           auto &jsv = self->getSystem()->getjsv();
@@ -23,6 +23,7 @@
 #include <mbsim/utils/nonlinear_algebra.h>
 #include <mbsim/numerics/nonlinear_algebra/multi_dimensional_newton_method.h>
 #include <ctime>
+#include <cstring>
 
 #ifndef NO_ISO_14882
 using namespace std;
@@ -182,6 +183,51 @@ namespace MBSim {
     delete jac;
   }
 
+  namespace {
+    struct QuasiStaticIntegratorSnapshot {
+      double t;
+      double tPlot;
+      int iter;
+      int step;
+      int integrationSteps;
+      int maxIter;
+      int sumIter;
+    };
+  }
+
+  // the state of the integrator is its own state vector z (the system state is part of the system snapshot)
+  size_t QuasiStaticIntegrator::getSnapshotSize() const {
+    return sizeof(QuasiStaticIntegratorSnapshot) + z.size()*sizeof(double);
+  }
+
+  void QuasiStaticIntegrator::getSnapshot(char *snapshot) const {
+    QuasiStaticIntegratorSnapshot s;
+    s.t = t;
+    s.tPlot = tPlot;
+    s.iter = iter;
+    s.step = step;
+    s.integrationSteps = integrationSteps;
+    s.maxIter = maxIter;
+    s.sumIter = sumIter;
+    memcpy(snapshot, &s, sizeof(s));
+    if(z.size())
+      memcpy(snapshot+sizeof(s), z(), z.size()*sizeof(double));
+  }
+
+  void QuasiStaticIntegrator::setSnapshot(const char *snapshot) {
+    QuasiStaticIntegratorSnapshot s;
+    memcpy(&s, snapshot, sizeof(s));
+    t = s.t;
+    tPlot = s.tPlot;
+    iter = s.iter;
+    step = s.step;
+    integrationSteps = s.integrationSteps;
+    maxIter = s.maxIter;
+    sumIter = s.sumIter;
+    if(z.size())
+      memcpy(z(), snapshot+sizeof(s), z.size()*sizeof(double));
+  }
+
   void QuasiStaticIntegrator::postIntegrate() {
     msg(Info) << endl << endl << "******************************" << endl;
     msg(Info) << "INTEGRATION SUMMARY: " << endl;
@@ -114,6 +114,10 @@ namespace MBSim {
       void subIntegrate(double tStop) override;
       void postIntegrate() override;
 
+      size_t getSnapshotSize() const override;
+      void getSnapshot(char *snapshot) const override;
+      void setSnapshot(const char *snapshot) override;
+
       /* INHERITED INTERFACE OF INTEGRATOR */
       using Integrator::integrate;
       void integrate() override;
@@ -25,6 +25,7 @@
 #include <mbsim/utils/eps.h>
 #include "fortran/fortran_wrapper.h"
 #include "radau5_integrator.h"
+#include "sparse_linear_solver.h"
 #include <ctime>
 
 #ifndef NO_ISO_14882
@@ -263,24 +264,12 @@ namespace MBSim {
         // if a root exists in the current step ...
         if(self->shift) {
           // ... search the first root and set step.second to this time
-          double dt = *t-*told;
-          while(dt>self->dtRoot) {
-            dt/=2;
-            double tCheck = tRoot-dt;
+          tRoot = self->findRoot(*told, *t, [&](double tCheck) {
             self->getSystem()->setTime(tCheck);
-            curTimeAndState = tCheck;
             for(int i=1; i<=self->system->getzSize(); i++)
               self->getSystem()->getState()(i-1) = CONTR5(&i,&tCheck,cont,lrc);
-            self->getSystem()->resetUpToDate();
-            if(self->signChangedWRTsvLast(self->getSystem()->evalsv()))
-              tRoot = tCheck;
-          }
-          if(curTimeAndState != tRoot) {
-            curTimeAndState = tRoot;
-            self->getSystem()->setTime(tRoot);
-            for(int i=1; i<=self->system->getzSize(); i++)
-              self->getSystem()->getState()(i-1) = CONTR5(&i,&tRoot,cont,lrc);
-          }
+          });
+          curTimeAndState = tRoot;
           self->getSystem()->resetUpToDate();
           auto &sv = self->getSystem()->evalsv();
           auto &jsv = self->getSystem()->getjsv();
@@ -392,6 +381,8 @@ namespace MBSim {
 
     debugInit();
 
+    SparseLinearSolverScope sparse(sparseLinearSolver);
+
     calcSize();
     Rq = RangeV(0,system->getqSize()-1);
     Ru = RangeV(system->getqSize(),system->getqSize()+system->getuSize()-1);
@@ -535,6 +526,7 @@ namespace MBSim {
     msg(Info)<<"nrStepsRejected (excluding first step): "<<iWork[17]<<endl;
     msg(Info)<<"nrLUdecom: "<<iWork[18]<<endl;
     msg(Info)<<"nrForwardBackwardSubs: "<<iWork[19]<<endl;
+    sparse.msgStatistics();
   }
 
   void RADAU5Integrator::calcSize() {
@@ -649,6 +641,8 @@ namespace MBSim {
     if(e) setStepSizeSaftyFactor((E(e)->getText<double>()));
     e=E(element)->getFirstElementChildNamed(MBSIM%"numericalJacobian");
     if(e) setNumericalJacobian(E(e)->getText<bool>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"sparseLinearSolver");
+    if(e) setSparseLinearSolver(E(e)->getText<bool>());
   }
 
 }
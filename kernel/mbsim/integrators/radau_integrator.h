@@ -99,6 +99,8 @@ namespace MBSim {
       StepSizeControl stepSizeControl { StepSizeControl::ModPred };
       double stepSizeSaftyFactor { 0.9 };
       bool numericalJacobian{ false };
+      /** sparse LU decomposition of the iteration matrix **/
+      bool sparseLinearSolver{ false };
 
       std::exception_ptr exception;
 
@@ -121,6 +123,7 @@ namespace MBSim {
       void setStepSizeControl(StepSizeControl ssc) { stepSizeControl = ssc; }
       void setStepSizeSaftyFactor(double fac) { stepSizeSaftyFactor = fac; }
       void setNumericalJacobian(bool numericalJacobian_) { numericalJacobian = numericalJacobian_; }
+      void setSparseLinearSolver(bool sparseLinearSolver_) { sparseLinearSolver = sparseLinearSolver_; }
 
       using Integrator::integrate;
       void integrate() override;
@@ -142,26 +142,14 @@ namespace MBSim {
           getSystem()->resetUpToDate();
           shift = signChangedWRTsvLast(getSystem()->evalsv());
           // if a root exists in the current step ...
-          double dt = dtLast;
           if(shift) {
             // ... search the first root and set step.second to this time
-            while(dt>dtRoot) {
-              dt/=2;
-              double tCheck = tRoot-dt;
-              curTimeAndState = tCheck;
+            tRoot = findRoot(t-dtLast, t, [&](double tCheck) {
               INTRP(&tCheck,&request,&n,zWant(),zdWant(),fzdot,work,workint,&lenint);
               getSystem()->setTime(tCheck);
               getSystem()->setState(zWant);
-              getSystem()->resetUpToDate();
-              if(signChangedWRTsvLast(getSystem()->evalsv()))
-                tRoot = tCheck;
-            }
-            if(curTimeAndState != tRoot) {
-              curTimeAndState = tRoot;
-              INTRP(&tRoot,&request,&n,zWant(),zdWant(),fzdot,work,workint,&lenint);
-              getSystem()->setTime(tRoot);
-              getSystem()->setState(zWant);
-            }
+            });
+            curTimeAndState = tRoot;
             getSystem()->resetUpToDate();
             auto &sv = getSystem()->evalsv();
             auto &jsv = getSystem()->getjsv();
@@ -73,6 +73,8 @@ namespace MBSim {
       bool reduced{false};
       /** autonomous system **/
       bool autonom{false};
+      /** sparse LU decomposition of the iteration matrix **/
+      bool sparseLinearSolver{false};
 
       int neq, mlJac, muJac;
       fmatvec::VecInt iWork;
@@ -91,6 +93,7 @@ namespace MBSim {
       void setFormalism(Formalism formalism_) { formalism = formalism_; }
       void setReducedForm(bool reduced_) { reduced = reduced_; }
       void setAutonomousSystem(bool autonom_) { autonom = autonom_; }
+      void setSparseLinearSolver(bool sparseLinearSolver_) { sparseLinearSolver = sparseLinearSolver_; }
 
       using Integrator::integrate;
       void integrate() override;
@@ -22,6 +22,10 @@
 
 #include <config.h>
 #include "root_finding_integrator.h"
+#include <mbsim/dynamic_system_solver.h>
+#include <mbsim/links/link.h>
+#include <mbsim/links/contact.h>
+#include <limits>
 
 #ifndef NO_ISO_14882
 using namespace std;
@@ -41,6 +45,108 @@ namespace MBSim {
     return false;
   }
 
+  double RootFindingIntegrator::findRoot(double tl, double tr, const function<void(double)> &setState) {
+    // entries with a sign change and the corresponding links
+    vector<Link*> lnk;
+    vector<int> ind;
+    const Vec &svr = system->evalsv();
+    for(auto & l : system->getLinksWithStopVector()) {
+      bool changed = false;
+      for(int i=l->getsvInd(); i<l->getsvInd()+l->getsvSize(); i++) {
+        if(svLast(i)*svr(i)<0) {
+          ind.push_back(i);
+          changed = true;
+        }
+      }
+      if(changed)
+        lnk.push_back(l);
+    }
+    Vec gl(ind.size(),NONINIT), gr(ind.size(),NONINIT), gm(ind.size(),NONINIT);
+    for(size_t k=0; k<ind.size(); k++) {
+      gl(k) = svLast(ind[k]);
+      gr(k) = svr(ind[k]);
+    }
+
+    double tSet = tr;
+
+    // the estimated time of impact at tl is the first trial point; the contacts predict it from the velocities at tl
+    double tGuess = -1;
+    if(rootFindingByTimeOfImpact) {
+      setState(tl);
+      tSet = tl;
+      system->resetUpToDate();
+      double toi = evalTimeOfImpact(tr-tl);
+      if(tl+toi<tr-dtRoot/2)
+        tGuess = tl+toi;
+    }
+
+    double alpha = 1;
+    int side = 0;
+    while(tr-tl>dtRoot) {
+      // the entry with the relative largest value at tr is expected to have the first root
+      int kmax = -1;
+      double fracmax = 0;
+      for(int k=0; k<gl.size(); k++) {
+        if(gl(k)*gr(k)<0) {
+          double frac = fabs(gr(k)/(gr(k)-gl(k)));
+          if(frac>fracmax) {
+            fracmax = frac;
+            kmax = k;
+          }
+        }
+      }
+      double tm = kmax>=0 ? tr-(tr-tl)*gr(kmax)/(gr(kmax)-alpha*gl(kmax)) : (tl+tr)/2;
+      if(tGuess>tl) {
+        tm = tGuess;
+        tGuess = -1;
+      }
+      tm = min(max(tm,tl+dtRoot/2),tr-dtRoot/2);
+
+      setState(tm);
+      tSet = tm;
+      system->resetUpToDate();
+      const Vec &sv = system->evalsv(lnk);
+      bool changed = false;
+      for(size_t k=0; k<ind.size(); k++) {
+        gm(k) = sv(ind[k]);
+        if(gl(k)*gm(k)<0)
+          changed = true;
+      }
+
+      // Illinois: the function value of an endpoint which is kept twice is halved
+      int sideNew = changed ? 1 : 2;
+      if(sideNew==side)
+        alpha = side==1 ? alpha/2 : alpha*2;
+      else
+        alpha = 1;
+      side = sideNew;
+      if(changed) {
+        tr = tm;
+        gr = gm;
+      }
+      else {
+        tl = tm;
+        gl = gm;
+      }
+    }
+    if(tSet!=tr)
+      setState(tr);
+    return tr;
+  }
+
+  double RootFindingIntegrator::evalTimeOfImpact(double dt) {
+    double toi = numeric_limits<double>::infinity();
+    for(auto & l : system->getLinksWithStopVector()) {
+      auto *contact = dynamic_cast<Contact*>(l);
+      if(contact) {
+        double toiContact = contact->evalTimeOfImpact(dt);
+        if(toiContact>dtRoot)
+          toi = min(toi, toiContact);
+      }
+    }
+    return toi;
+  }
+
   void RootFindingIntegrator::initializeUsingXML(DOMElement *element) {
     Integrator::initializeUsingXML(element);
     DOMElement *e;
@@ -52,6 +158,10 @@ namespace MBSim {
     if(e) setRootFindingAccuracy(E(e)->getText<double>());
     e=E(element)->getFirstElementChildNamed(MBSIM%"plotOnRoot");
     if(e) setPlotOnRoot(E(e)->getText<bool>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"stepSizeLimitByTimeOfImpact");
+    if(e) setStepSizeLimitByTimeOfImpact(E(e)->getText<bool>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"rootFindingByTimeOfImpact");
+    if(e) setRootFindingByTimeOfImpact(E(e)->getText<bool>());
   }
 
 }
@@ -24,6 +24,7 @@
 #define _ROOT_FINDING_INTEGRATOR_H_
 
 #include "integrator.h"
+#include <functional>
 
 namespace MBSim {
 
@@ -36,12 +37,39 @@ namespace MBSim {
       // Helper function to check if svLast and svStepEnd has a sign change in any element.
       bool signChangedWRTsvLast(const fmatvec::Vec &svStepEnd) const;
 
+      /**
+       * \brief search the first root of the stop vector in the step ]tl,tr]
+       *
+       * The Illinois variant of the regula falsi is applied to the dense output of the integrator. During the
+       * iteration only the stop vector entries of the links with a sign change between svLast and the stop vector
+       * at tr are evaluated. The stop vector at tr must be up to date when calling this function.
+       * \param tl time of svLast
+       * \param tr end of the step
+       * \param setState sets time and state of the system by the dense output at the given time
+       * \return time right of the first root within the root-finding accuracy; time and state of the system are set to this time
+       */
+      double findRoot(double tl, double tr, const std::function<void(double)> &setState);
+
+      /**
+       * \brief earliest estimated time of impact of all contacts with a stop vector within the horizon dt
+       *
+       * Closed contacts (time of impact zero) are skipped. The state of the system must be up to date.
+       * \return time of impact in ]0,dt] or infinity (see Contact::evalTimeOfImpact)
+       */
+      double evalTimeOfImpact(double dt);
+
       /** root-finding accuracy */
       double dtRoot{1e-10};
 
       /** plot on root */
       bool plotOnRoot{false};
 
+      /** limit the step size by the estimated time of impact of the contacts */
+      bool stepSizeLimitByTimeOfImpact{false};
+
+      /** use the estimated time of impact of the contacts as first trial point of the root finding */
+      bool rootFindingByTimeOfImpact{false};
+
        /** tolerance for position constraints */
       double gMax{-1};
       /** tolerance for velocity constraints */
@@ -58,6 +86,12 @@ namespace MBSim {
       //! Define wether to trigger a plot before and after each found root.
       void setPlotOnRoot(bool b) { plotOnRoot = b; }
 
+      //! Limit the step size by the estimated time of impact of the contacts (only integrators with own step size control).
+      void setStepSizeLimitByTimeOfImpact(bool b) { stepSizeLimitByTimeOfImpact = b; }
+
+      //! Use the estimated time of impact of the contacts as first trial point of the root finding (all integrators).
+      void setRootFindingByTimeOfImpact(bool b) { rootFindingByTimeOfImpact = b; }
+
       //! Set the maximum allowed position drift.
       void setToleranceForPositionConstraints(double gMax_) { gMax = gMax_; }
 
@@ -25,6 +25,7 @@
 #include <mbsim/utils/eps.h>
 #include "fortran/fortran_wrapper.h"
 #include "seulex_integrator.h"
+#include "sparse_linear_solver.h"
 #include <ctime>
 
 #ifndef NO_ISO_14882
@@ -93,24 +94,12 @@ namespace MBSim {
       // if a root exists in the current step ...
       if(self->shift) {
         // ... search the first root and set step.second to this time
-        double dt = *t-*told;
-        while(dt>self->dtRoot) {
-          dt/=2;
-          double tCheck = tRoot-dt;
+        tRoot = self->findRoot(*told, *t, [&](double tCheck) {
           self->getSystem()->setTime(tCheck);
-          curTimeAndState = tCheck;
           for(int i=1; i<=self->system->getzSize(); i++)
             self->getSystem()->getState()(i-1) = CONTSX(&i,&tCheck,rc,lrc,ic,lic);
-          self->getSystem()->resetUpToDate();
-          if(self->signChangedWRTsvLast(self->getSystem()->evalsv()))
-            tRoot = tCheck;
-        }
-        if(curTimeAndState != tRoot) {
-          curTimeAndState = tRoot;
-          self->getSystem()->setTime(tRoot);
-          for(int i=1; i<=self->system->getzSize(); i++)
-            self->getSystem()->getState()(i-1) = CONTSX(&i,&tRoot,rc,lrc,ic,lic);
-        }
+        });
+        curTimeAndState = tRoot;
         self->getSystem()->resetUpToDate();
         auto &sv = self->getSystem()->evalsv();
         auto &jsv = self->getSystem()->getjsv();
@@ -212,6 +201,8 @@ namespace MBSim {
 
     debugInit();
 
+    SparseLinearSolverScope sparse(sparseLinearSolver);
+
     calcSize();
 
     if(not neq)
@@ -316,6 +307,8 @@ namespace MBSim {
           y(i) = 0;
       }
     }
+
+    sparse.msgStatistics();
   }
 
   void SEULEXIntegrator::calcSize() {
@@ -369,6 +362,8 @@ namespace MBSim {
     if(e) setReducedForm((E(e)->getText<bool>()));
     e=E(element)->getFirstElementChildNamed(MBSIM%"autonomousSystem");
     if(e) setAutonomousSystem((E(e)->getText<bool>()));
+    e=E(element)->getFirstElementChildNamed(MBSIM%"sparseLinearSolver");
+    if(e) setSparseLinearSolver(E(e)->getText<bool>());
   }
 
 }
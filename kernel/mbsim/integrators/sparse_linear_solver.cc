@@ -0,0 +1,232 @@
+/* Copyright (C) 2004-2015 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h>
+#include "sparse_linear_solver.h"
+#include "fortran/fortran_wrapper.h"
+#include "mbsim/numerics/sparse_lu.h"
+#include <fmatvec/atom.h>
+#include <chrono>
+#include <complex>
+#include <map>
+#include <memory>
+
+using namespace std;
+
+extern "C" {
+  void FC_FUNC(dgetrf,DGETRF)(int*,int*,double*,int*,int*,int*);
+  void FC_FUNC(dgetrs,DGETRS)(const char*,int*,int*,double*,int*,int*,double*,int*,int*);
+  void FC_FUNC(zgetrf,ZGETRF)(int*,int*,double*,int*,int*,int*);
+  void FC_FUNC(zgetrs,ZGETRS)(const char*,int*,int*,double*,int*,int*,double*,int*,int*);
+  void FC_FUNC(dgefa,DGEFA)(double*,int*,int*,int*,int*);
+  void FC_FUNC(dgesl,DGESL)(double*,int*,int*,int*,double*,int*);
+}
+
+namespace MBSim {
+
+  namespace {
+    double elapsed(const chrono::steady_clock::time_point &start) {
+      return chrono::duration<double>(chrono::steady_clock::now()-start).count();
+    }
+  }
+
+  struct SparseLinearSolverScope::Data {
+    struct Factorization {
+      SparseLU lu;
+      int n{0};
+      int count{0};
+      bool compare{false}; // the current factorisation is done sparse and dense
+      double sparseTime{0}, denseTime{0};
+      bool dense{false};
+    };
+    bool enabled;
+    int nDense{0};
+    // the Fortran codes factorise and solve a matrix in place; hence, the matrix is identified by its address
+    map<const void*, unique_ptr<Factorization>> factorizations;
+  };
+
+  namespace {
+    // the innermost scope of each thread
+    thread_local SparseLinearSolverScope *current = nullptr;
+  }
+
+  // the routines called by the Fortran codes use the innermost enabled scope of the calling thread
+  struct SparseLinearSolverAccess {
+    static SparseLinearSolverScope::Data* data() {
+      return current and current->data->enabled ? current->data.get() : nullptr;
+    }
+
+    // factorise sparse; returns false if the dense routine must be used
+    template<class T>
+    static bool factorize(int n, T *A, int lda, int &info) {
+      auto *d = data();
+      if(not d)
+        return false;
+      auto &f = d->factorizations[A];
+      if(not f)
+        f.reset(new SparseLinearSolverScope::Data::Factorization);
+      if(f->dense)
+        return false;
+      auto start = chrono::steady_clock::now();
+      info = f->lu.factorize(n, A, lda);
+      f->n = n;
+      // the first factorisation includes the symbolic analysis; hence, the second one is compared with the dense
+      // routine, which is called on return (the sparse factorisation of the same matrix remains valid)
+      if(info==0 and ++f->count==2) {
+        f->sparseTime = elapsed(start);
+        f->compare = true;
+        return false;
+      }
+      return true;
+    }
+
+    // the dense routine has factorised A in time
+    template<class T>
+    static void denseFactorized(T *A, double time) {
+      auto *d = data();
+      if(not d)
+        return;
+      d->nDense++;
+      auto it = d->factorizations.find(A);
+      if(it==d->factorizations.end() or not it->second->compare)
+        return;
+      // the pattern of an iteration matrix is (nearly) constant; hence, the faster routine stays faster
+      auto &f = it->second;
+      f->compare = false;
+      f->denseTime = time;
+      f->dense = f->denseTime<f->sparseTime;
+    }
+
+    template<class T>
+    static bool solve(T *A, T *b) {
+      auto *d = data();
+      if(not d)
+        return false;
+      auto it = d->factorizations.find(A);
+      if(it==d->factorizations.end() or it->second->dense)
+        return false;
+      it->second->lu.solve(b);
+      return true;
+    }
+  };
+
+  SparseLinearSolverScope::SparseLinearSolverScope(bool enable) : data(new Data), previous(current) {
+    data->enabled = enable;
+    current = this;
+  }
+
+  SparseLinearSolverScope::~SparseLinearSolverScope() {
+    current = previous;
+  }
+
+  bool SparseLinearSolverScope::isEnabled() const {
+    return data->enabled;
+  }
+
+  int SparseLinearSolverScope::getNumberOfSymbolicAnalyses() const {
+    int n = 0;
+    for(auto &f : data->factorizations)
+      n += f.second->lu.getNumberOfSymbolicAnalyses();
+    return n;
+  }
+
+  int SparseLinearSolverScope::getNumberOfFactorizations() const {
+    int n = 0;
+    for(auto &f : data->factorizations)
+      n += f.second->lu.getNumberOfFactorizations();
+    return n;
+  }
+
+  int SparseLinearSolverScope::getNumberOfDenseFactorizations() const {
+    return data->nDense;
+  }
+
+  vector<SparseLinearSolverScope::MatrixStatistics> SparseLinearSolverScope::getMatrixStatistics() const {
+    vector<MatrixStatistics> s;
+    for(auto &f : data->factorizations)
+      s.push_back({f.second->n, f.second->lu.getDensity(), f.second->sparseTime, f.second->denseTime, f.second->dense});
+    return s;
+  }
+
+  void SparseLinearSolverScope::msgStatistics() const {
+    if(not data->enabled)
+      return;
+    fmatvec::Atom::msgStatic(fmatvec::Atom::Info)<<"nrSymbolicAnalyses (sparse LU): "<<getNumberOfSymbolicAnalyses()<<endl;
+    fmatvec::Atom::msgStatic(fmatvec::Atom::Info)<<"nrLUdecom (sparse): "<<getNumberOfFactorizations()<<endl;
+    fmatvec::Atom::msgStatic(fmatvec::Atom::Info)<<"nrLUdecom (dense): "<<getNumberOfDenseFactorizations()<<endl;
+    for(auto &s : getMatrixStatistics())
+      fmatvec::Atom::msgStatic(fmatvec::Atom::Info)<<"iteration matrix (n = "<<s.n<<", density = "<<s.density<<"): "
+        <<(s.dense?"dense":"sparse")<<" LU (numeric factorisation sparse "<<s.sparseTime<<" s, dense "<<s.denseTime<<" s)"<<endl;
+  }
+
+}
+
+using namespace MBSim;
+
+namespace {
+  template<class T>
+  bool factorize(int n, T *A, int lda, int &info) { return SparseLinearSolverAccess::factorize(n, A, lda, info); }
+
+  template<class T>
+  bool solve(T *A, T *b) { return SparseLinearSolverAccess::solve(A, b); }
+
+  // call the dense factorisation f of A and report its time
+  template<class T, class F>
+  void denseFactorize(T *A, F f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    SparseLinearSolverAccess::denseFactorized(A, elapsed(start));
+  }
+}
+
+// routines called by dc_lapack.f: full matrices, one right hand side, no transpose
+
+void MBDGETRF(int *m, int *n, double *A, int *lda, int *ipiv, int *info) {
+  if(not factorize(*n, A, *lda, *info))
+    denseFactorize(A, [&]() { FC_FUNC(dgetrf,DGETRF)(m, n, A, lda, ipiv, info); });
+}
+
+void MBDGETRS(int *n, int *nrhs, double *A, int *lda, int *ipiv, double *b, int *ldb, int *info) {
+  *info = 0;
+  if(not solve(A, b))
+    FC_FUNC(dgetrs,DGETRS)("N", n, nrhs, A, lda, ipiv, b, ldb, info);
+}
+
+void MBZGETRF(int *m, int *n, double *A, int *lda, int *ipiv, int *info) {
+  if(not factorize(*n, reinterpret_cast<complex<double>*>(A), *lda, *info))
+    denseFactorize(reinterpret_cast<complex<double>*>(A), [&]() { FC_FUNC(zgetrf,ZGETRF)(m, n, A, lda, ipiv, info); });
+}
+
+void MBZGETRS(int *n, int *nrhs, double *A, int *lda, int *ipiv, double *b, int *ldb, int *info) {
+  *info = 0;
+  if(not solve(reinterpret_cast<complex<double>*>(A), reinterpret_cast<complex<double>*>(b)))
+    FC_FUNC(zgetrs,ZGETRS)("N", n, nrhs, A, lda, ipiv, b, ldb, info);
+}
+
+// routines called by ddaspk.f (LINPACK interface)
+
+void MBDGEFA(double *A, int *lda, int *n, int *ipvt, int *info) {
+  if(not factorize(*n, A, *lda, *info))
+    denseFactorize(A, [&]() { FC_FUNC(dgefa,DGEFA)(A, lda, n, ipvt, info); });
+}
+
+void MBDGESL(double *A, int *lda, int *n, int *ipvt, double *b, int *job) {
+  if(not solve(A, b))
+    FC_FUNC(dgesl,DGESL)(A, lda, n, ipvt, b, job);
+}
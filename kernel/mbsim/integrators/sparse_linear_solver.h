@@ -0,0 +1,78 @@
+/* Copyright (C) 2004-2015 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _SPARSE_LINEAR_SOLVER_H_
+#define _SPARSE_LINEAR_SOLVER_H_
+
+#include <memory>
+#include <vector>
+
+namespace MBSim {
+
+  /** \brief Selects the linear solver of the iteration matrices of the Fortran integrators.
+   *
+   * RADAU5, RADAU, RODAS and SEULEX (full matrices, dc_lapack.f) and DASPK (direct method) factorise their
+   * iteration matrices by the routines MBDGETRF/MBZGETRF and MBDGEFA and solve by MBDGETRS/MBZGETRS and MBDGESL.
+   * These routines use the innermost scope of the calling thread: if the sparse solver of this scope is enabled they
+   * use a sparse LU decomposition (SparseLU), which keeps the symbolic analysis as long as the nonzero pattern of the
+   * matrix does not change. The second factorisation of each matrix (the first one without symbolic analysis) is done
+   * sparse and dense by LAPACK (LINPACK for DASPK); the faster one is used for all further factorisations of this
+   * matrix. Note that the rows of u contain M^{-1} dh/dz: the iteration matrix is only sparse if the mass matrices of
+   * the bodies are (block) diagonal or small. If the sparse solver is disabled or no scope exists the dense routines
+   * are used.
+   * Each integrator creates its own scope in integrate(); the factorisations and counters are owned by the scope,
+   * hence there is no state shared between integrators (e.g. nested or running in different threads).
+   */
+  class SparseLinearSolverScope {
+    public:
+      SparseLinearSolverScope(bool enable);
+      ~SparseLinearSolverScope();
+      SparseLinearSolverScope(const SparseLinearSolverScope&) = delete;
+      SparseLinearSolverScope& operator=(const SparseLinearSolverScope&) = delete;
+
+      bool isEnabled() const;
+      //! number of symbolic analyses of all matrices factorised sparse
+      int getNumberOfSymbolicAnalyses() const;
+      //! number of sparse numeric factorisations of all matrices
+      int getNumberOfFactorizations() const;
+      //! number of dense factorisations
+      int getNumberOfDenseFactorizations() const;
+
+      //! statistics of one iteration matrix
+      struct MatrixStatistics {
+        int n; // size
+        double density; // ratio of nonzero entries
+        double sparseTime, denseTime; // time of the compared numeric factorisations (0 if not compared yet)
+        bool dense; // true if factorised dense
+      };
+      std::vector<MatrixStatistics> getMatrixStatistics() const;
+
+      //! print the counters and the statistics of all matrices
+      void msgStatistics() const;
+
+    private:
+      friend struct SparseLinearSolverAccess;
+      struct Data;
+      std::unique_ptr<Data> data;
+      SparseLinearSolverScope *previous;
+  };
+
+}
+
+#endif
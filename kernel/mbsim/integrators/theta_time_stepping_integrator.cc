@@ -23,6 +23,7 @@
 #include "mbsim/dynamic_system_solver.h"
 #include "mbsim/utils/eps.h"
 #include <ctime>
+#include <cstring>
 
 #ifndef NO_ISO_14882
 using namespace std;
@@ -40,9 +41,10 @@ namespace MBSim {
   void ThetaTimeSteppingIntegrator::preIntegrate() {
     debugInit();
     // initialisation
-    assert(dtPlot >= dt);
+    assert(outputInterpolation or dtPlot >= dt);
 
     system->setTime(tStart);
+    tPlot = tStart;
 
     system->setStepSize(dt);
 
@@ -62,8 +64,13 @@ namespace MBSim {
       system->projectGeneralizedPositions(3,true);
     }
 
+    jacAge = -1;
+    JacCounter = 0;
+    reuses = 0;
+    rejectedReuses = 0;
+
     stepPlot = (int) (dtPlot/dt + 0.5);
-    if(fabs(stepPlot*dt - dtPlot) > dt*dt) {
+    if(not outputInterpolation and fabs(stepPlot*dt - dtPlot) > dt*dt) {
       msg(Warn) << "Due to the plot-Step settings it is not possible to plot exactly at the correct times." << endl;
     }
 
@@ -73,7 +80,9 @@ namespace MBSim {
   void ThetaTimeSteppingIntegrator::subIntegrate(double tStop) {
     while(system->getTime()<tStop) { // time loop
       integrationSteps++;
-      if((step*stepPlot - integrationSteps) < 0) {
+      if(outputInterpolation)
+        output.beginStep(system);
+      else if((step*stepPlot - integrationSteps) < 0) {
         step++;
         system->setla(system->getLa(false)/dt);
         system->setqd(system->getdq(false)/dt);
@@ -91,29 +100,51 @@ namespace MBSim {
       }
 
       Vec hOld = system->evalh();
-      Mat dhdq(system->gethSize(),system->getqSize(),NONINIT);
-      for (int i=0; i<system->getqSize(); i++) {
-        double qtmp = system->getq()(i);
-        system->getq()(i) += epsroot;
-        system->resetUpToDate();
-        dhdq.set(i, (system->evalh()-hOld)/epsroot);
-        system->getq()(i) = qtmp;
+      bool recompute = jacAge<0 or jacAge>=maxJacAge;
+      if(not recompute) {
+        // check the linearisation of h over the last step
+        Vec dh = hOld-hPrev;
+        if(nrmInf(dh-dhdq*(system->getq()-qPrev)-dhdu*(system->getu()-uPrev))>jacobianRecomputation*nrmInf(dh)) {
+          recompute = true;
+          rejectedReuses++;
+        }
+        else
+          reuses++;
       }
-      Mat dhdu(system->gethSize(),system->getuSize(),NONINIT);
-      for (int i=0; i<system->getuSize(); i++) {
-        double utmp = system->getu()(i);
-        system->getu()(i) += epsroot;
-        system->resetUpToDate();
-        dhdu.set(i, (system->evalh()-hOld)/epsroot);
-        system->getu()(i) = utmp;
+      if(recompute) {
+        dhdq.resize(system->gethSize(),system->getqSize(),NONINIT);
+        for (int i=0; i<system->getqSize(); i++) {
+          double qtmp = system->getq()(i);
+          system->getq()(i) += epsroot;
+          system->resetUpToDate();
+          dhdq.set(i, (system->evalh()-hOld)/epsroot);
+          system->getq()(i) = qtmp;
+        }
+        dhdu.resize(system->gethSize(),system->getuSize(),NONINIT);
+        for (int i=0; i<system->getuSize(); i++) {
+          double utmp = system->getu()(i);
+          system->getu()(i) += epsroot;
+          system->resetUpToDate();
+          dhdu.set(i, (system->evalh()-hOld)/epsroot);
+          system->getu()(i) = utmp;
+        }
+        JacCounter++;
+        jacAge = 0;
       }
+      jacAge++;
+      hPrev <<= hOld;
+      qPrev <<= system->getq();
+      uPrev <<= system->getu();
 
       double te = system->getTime() + dt;
       system->getTime() += theta*dt;
       system->resetUpToDate();
 
       system->checkActive(1);
-      if (system->gActiveChanged()) resize();
+      if (system->gActiveChanged()) {
+        resize();
+        jacAge = -1; // new derivatives after a change of the active set
+      }
 
       if(gMax>=0 and system->positionDriftCompensationNeeded(gMax))
         system->projectGeneralizedPositions(3);
@@ -146,11 +177,58 @@ namespace MBSim {
       if(system->getIterI()>maxIter) maxIter = system->getIterI();
       sumIter += system->getIterI();
 
+      if(outputInterpolation and output.endStep(system, system->getLa(false)/dt, tPlot, dtPlot)) {
+        double s1 = clock();
+        time += (s1-s0)/CLOCKS_PER_SEC;
+        s0 = s1;
+        if(msgAct(Status)) msg(Status) << "   t = " << system->getTime() << ",\tdt = "<< dt << ",\titer = "<<setw(5)<<setiosflags(ios::left) << system->getIterI() <<  flush;
+      }
+
       system->updateInternalState();
     }
   }
 
   void ThetaTimeSteppingIntegrator::postIntegrate() {
+    msg(Info) << "Integration steps: " << integrationSteps << endl;
+    msg(Info) << "Computed derivatives of h (JacCounter): " << JacCounter << endl;
+    msg(Info) << "Reuses of derivatives of h: " << reuses << endl;
+    msg(Info) << "Rejected reuses of derivatives of h: " << rejectedReuses << endl;
+  }
+
+  namespace {
+    struct ThetaTimeSteppingIntegratorSnapshot {
+      double tPlot;
+      int step;
+      int integrationSteps;
+      int maxIter;
+      int sumIter;
+    };
+  }
+
+  size_t ThetaTimeSteppingIntegrator::getSnapshotSize() const {
+    return sizeof(ThetaTimeSteppingIntegratorSnapshot);
+  }
+
+  void ThetaTimeSteppingIntegrator::getSnapshot(char *snapshot) const {
+    ThetaTimeSteppingIntegratorSnapshot s;
+    s.tPlot = tPlot;
+    s.step = step;
+    s.integrationSteps = integrationSteps;
+    s.maxIter = maxIter;
+    s.sumIter = sumIter;
+    memcpy(snapshot, &s, sizeof(s));
+  }
+
+  void ThetaTimeSteppingIntegrator::setSnapshot(const char *snapshot) {
+    ThetaTimeSteppingIntegratorSnapshot s;
+    memcpy(&s, snapshot, sizeof(s));
+    tPlot = s.tPlot;
+    step = s.step;
+    integrationSteps = s.integrationSteps;
+    maxIter = s.maxIter;
+    sumIter = s.sumIter;
+    jacAge = -1; // the state of the system may have changed
+    resize();
   }
 
   void ThetaTimeSteppingIntegrator::integrate() {
@@ -168,6 +246,12 @@ namespace MBSim {
     if(e) setTheta(E(e)->getText<double>());
     e=E(element)->getFirstElementChildNamed(MBSIM%"toleranceForPositionConstraints");
     if(e) setToleranceForPositionConstraints(E(e)->getText<double>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"outputInterpolation");
+    if(e) setOutputInterpolation(E(e)->getText<bool>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"maximumJacobianAge");
+    if(e) setMaximumJacobianAge(E(e)->getText<int>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"jacobianRecomputation");
+    if(e) setJacobianRecomputation(E(e)->getText<double>());
   }
 
   void ThetaTimeSteppingIntegrator::resize() {
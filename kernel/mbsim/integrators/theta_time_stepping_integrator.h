@@ -21,6 +21,7 @@
 #define _THETA_TIME_STEPPING_INTEGRATOR_H_
 
 #include "integrator.h"
+#include "time_stepping_output.h"
 
 namespace MBSim {
 
@@ -43,6 +44,9 @@ namespace MBSim {
       void preIntegrate() override;
       void subIntegrate(double tStop) override;
       void postIntegrate() override;
+      size_t getSnapshotSize() const override;
+      void getSnapshot(char *snapshot) const override;
+      void setSnapshot(const char *snapshot) override;
 
       /* INHERITED INTERFACE OF INTEGRATOR */
       using Integrator::integrate;
@@ -54,6 +58,9 @@ namespace MBSim {
       void setStepSize(double dt_) { dt = dt_; }
       void setTheta(double theta_ ) { theta  = theta_; }
       void setToleranceForPositionConstraints(double gMax_) { gMax = gMax_; }
+      void setOutputInterpolation(bool outputInterpolation_) { outputInterpolation = outputInterpolation_; }
+      void setMaximumJacobianAge(int maxJacAge_) { maxJacAge = maxJacAge_; }
+      void setJacobianRecomputation(double value) { jacobianRecomputation = value; }
       /***************************************************/
 
     private:
@@ -91,6 +98,28 @@ namespace MBSim {
 
       /** tolerance for position constraints */
       double gMax{-1};
+
+      /**
+       * \brief interpolate the plot times within the steps; the step size need not be a divisor of the plot step size
+       */
+      bool outputInterpolation{false};
+
+      TimeSteppingOutput output;
+
+      /**
+       * \brief maximum number of steps the derivatives dh/dq and dh/du are used for (1: recomputed in each step)
+       */
+      int maxJacAge{1};
+
+      /**
+       * \brief the derivatives are recomputed if the defect of the linearisation of h over the last step relative to the change of h exceeds this value
+       */
+      double jacobianRecomputation{0.1};
+
+      fmatvec::Mat dhdq, dhdu;
+      fmatvec::Vec hPrev, qPrev, uPrev;
+      int jacAge{-1};
+      int JacCounter{0}, reuses{0}, rejectedReuses{0};
   };
 
 }
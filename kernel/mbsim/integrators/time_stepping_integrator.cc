@@ -21,6 +21,7 @@
 #include <mbsim/dynamic_system_solver.h>
 #include "time_stepping_integrator.h"
 #include <ctime>
+#include <cstring>
 
 #ifndef NO_ISO_14882
 using namespace std;
@@ -38,9 +39,10 @@ namespace MBSim {
   void TimeSteppingIntegrator::preIntegrate() {
     debugInit();
     // initialisation
-    assert(dtPlot >= dt);
+    assert(outputInterpolation or dtPlot >= dt);
 
     system->setTime(tStart);
+    tPlot = tStart;
 
     system->setStepSize(dt);
 
@@ -61,7 +63,7 @@ namespace MBSim {
     }
 
     stepPlot = (int) (dtPlot/dt + 0.5);
-    if(fabs(stepPlot*dt - dtPlot) > dt*dt) {
+    if(not outputInterpolation and fabs(stepPlot*dt - dtPlot) > dt*dt) {
       msg(Warn) << "Due to the plot-Step settings it is not possible to plot exactly at the correct times." << endl;
     }
 
@@ -71,7 +73,9 @@ namespace MBSim {
   void TimeSteppingIntegrator::subIntegrate(double tStop) {
     while(system->getTime()<tStop) { // time loop
       integrationSteps++;
-      if((step*stepPlot - integrationSteps) < 0) {
+      if(outputInterpolation)
+        output.beginStep(system);
+      else if((step*stepPlot - integrationSteps) < 0) {
         step++;
         system->setla(system->getLa(false)/dt);
         system->setqd(system->getdq(false)/dt);
@@ -109,6 +113,13 @@ namespace MBSim {
       if(system->getIterI()>maxIter) maxIter = system->getIterI();
       sumIter += system->getIterI();
 
+      if(outputInterpolation and output.endStep(system, system->getLa(false)/dt, tPlot, dtPlot)) {
+        double s1 = clock();
+        time += (s1-s0)/CLOCKS_PER_SEC;
+        s0 = s1;
+        if(msgAct(Status)) msg(Status) << "   t = " << system->getTime() << ",\tdt = "<< dt << ",\titer = "<<setw(5)<<setiosflags(ios::left) << system->getIterI() <<  flush;
+      }
+
       system->updateInternalState();
     }
   }
@@ -125,6 +136,41 @@ namespace MBSim {
     msg(Info).flush();
   }
 
+  namespace {
+    struct TimeSteppingIntegratorSnapshot {
+      double tPlot;
+      int step;
+      int integrationSteps;
+      int maxIter;
+      int sumIter;
+    };
+  }
+
+  size_t TimeSteppingIntegrator::getSnapshotSize() const {
+    return sizeof(TimeSteppingIntegratorSnapshot);
+  }
+
+  void TimeSteppingIntegrator::getSnapshot(char *snapshot) const {
+    TimeSteppingIntegratorSnapshot s;
+    s.tPlot = tPlot;
+    s.step = step;
+    s.integrationSteps = integrationSteps;
+    s.maxIter = maxIter;
+    s.sumIter = sumIter;
+    memcpy(snapshot, &s, sizeof(s));
+  }
+
+  void TimeSteppingIntegrator::setSnapshot(const char *snapshot) {
+    TimeSteppingIntegratorSnapshot s;
+    memcpy(&s, snapshot, sizeof(s));
+    tPlot = s.tPlot;
+    step = s.step;
+    integrationSteps = s.integrationSteps;
+    maxIter = s.maxIter;
+    sumIter = s.sumIter;
+    resize();
+  }
+
   void TimeSteppingIntegrator::integrate() {
     preIntegrate();
     subIntegrate(tEnd);
@@ -138,6 +184,8 @@ namespace MBSim {
     if(e) setStepSize(E(e)->getText<double>());
     e=E(element)->getFirstElementChildNamed(MBSIM%"toleranceForPositionConstraints");
     if(e) setToleranceForPositionConstraints(E(e)->getText<double>());
+    e=E(element)->getFirstElementChildNamed(MBSIM%"outputInterpolation");
+    if(e) setOutputInterpolation(E(e)->getText<bool>());
   }
 
   void TimeSteppingIntegrator::resize() {
@@ -21,6 +21,7 @@
 #define _TIME_STEPPING_INTEGRATOR_H_
 
 #include "integrator.h"
+#include "time_stepping_output.h"
 
 namespace MBSim {
 
@@ -39,6 +40,9 @@ namespace MBSim {
       void preIntegrate() override;
       void subIntegrate(double tStop) override;
       void postIntegrate() override;
+      size_t getSnapshotSize() const override;
+      void getSnapshot(char *snapshot) const override;
+      void setSnapshot(const char *snapshot) override;
 
       /* INHERITED INTERFACE OF INTEGRATOR */
       using Integrator::integrate;
@@ -49,6 +53,7 @@ namespace MBSim {
       /* GETTER / SETTER */
       void setStepSize(double dt_) { dt = dt_; }
       void setToleranceForPositionConstraints(double gMax_) { gMax = gMax_; }
+      void setOutputInterpolation(bool outputInterpolation_) { outputInterpolation = outputInterpolation_; }
       /***************************************************/
     
     private:
@@ -81,6 +86,13 @@ namespace MBSim {
 
       /** tolerance for position constraints */
       double gMax{-1};
+
+      /**
+       * \brief interpolate the plot times within the steps; the step size need not be a divisor of the plot step size
+       */
+      bool outputInterpolation{false};
+
+      TimeSteppingOutput output;
   };
 
 }
@@ -0,0 +1,68 @@
+/* Copyright (C) 2004-2009 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h>
+#include "mbsim/integrators/time_stepping_output.h"
+#include "mbsim/dynamic_system_solver.h"
+#include "mbsim/utils/eps.h"
+
+using namespace fmatvec;
+
+namespace MBSim {
+
+  void TimeSteppingOutput::beginStep(DynamicSystemSolver *system) {
+    t0 = system->getTime();
+    z0 = system->getState();
+  }
+
+  int TimeSteppingOutput::endStep(DynamicSystemSolver *system, const Vec &la, double &tPlot, double dtPlot) {
+    Vec z1 = system->getState();
+    return plot(system, t0, z0, system->getTime(), z1, la, tPlot, dtPlot);
+  }
+
+  int TimeSteppingOutput::plot(DynamicSystemSolver *system, double t0, const Vec &z0, double t1, const Vec &z1, const Vec &la, double &tPlot, double dtPlot) {
+    if(tPlot>t1+epsroot)
+      return 0;
+
+    double h = t1-t0;
+    Vec zd = (z1-z0)/h;
+    Vec la_ = la; // la may refer to the constraint forces of the system
+    int n = 0;
+    while(tPlot<=t1+epsroot) {
+      system->setTime(tPlot);
+      system->setState(z0+(tPlot-t0)*zd);
+      system->resetUpToDate();
+      system->setzd(zd);
+      system->setUpdatezd(false);
+      if(la_.size()==system->getlaSize())
+        system->setla(la_);
+      system->setUpdatela(false);
+      system->setUpdateLa(false);
+      system->plot();
+      tPlot += dtPlot;
+      n++;
+    }
+
+    system->setTime(t1);
+    system->setState(z1);
+    system->resetUpToDate();
+    return n;
+  }
+
+}
@@ -0,0 +1,64 @@
+/* Copyright (C) 2004-2009 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _TIME_STEPPING_OUTPUT_H_
+#define _TIME_STEPPING_OUTPUT_H_
+
+#include <fmatvec/fmatvec.h>
+
+namespace MBSim {
+
+  class DynamicSystemSolver;
+
+  /**
+   * \brief interpolating output stage of the time-stepping integrators
+   *
+   * The plot times are decoupled from the step sequence: after each step all plot times within the step are written
+   * with the positions, velocities and states linearly interpolated between the step points. The derivatives of
+   * the state are the increments of the step divided by the step size and the constraint forces are the impulses of
+   * the step divided by the step size; hence, both are constant within a step.
+   */
+  class TimeSteppingOutput {
+    public:
+      /**
+       * \brief store the current time and state of the system as the beginning of a step
+       */
+      void beginStep(DynamicSystemSolver *system);
+
+      /**
+       * \brief plot all plot times tPlot, tPlot+dtPlot, ... up to the current time of the system (end of the step)
+       * \param la constraint forces of the step
+       * \return number of plotted time points
+       */
+      int endStep(DynamicSystemSolver *system, const fmatvec::Vec &la, double &tPlot, double dtPlot);
+
+      /**
+       * \brief plot all plot times up to t1 for the step (t0, z0) -> (t1, z1); the system is left at the end of the step
+       * \return number of plotted time points
+       */
+      static int plot(DynamicSystemSolver *system, double t0, const fmatvec::Vec &z0, double t1, const fmatvec::Vec &z1, const fmatvec::Vec &la, double &tPlot, double dtPlot);
+
+    private:
+      double t0{0};
+      fmatvec::Vec z0;
+  };
+
+}
+
+#endif
@@ -20,9 +20,12 @@
 #include <config.h>
 #include "mbsim/dynamic_system_solver.h"
 #include "mbsim/links/link.h"
+#include "mbsim/links/contact.h"
 #include "time_stepping_ssc_integrator.h"
+#include "time_stepping_output.h"
 #include "mbsim/utils/eps.h"
 #include "mbsim/utils/stopwatch.h"
+#include <limits>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -85,6 +88,8 @@ namespace MBSim {
     order = maxOrder;
 
     // FlagGapControl = GapControlStrategy >= 0; temporary deactivated
+    // the linear impact estimation of the links is not available, the roots are the estimated times of impact
+    FlagGapControl = gapControlByTimeOfImpact and GapControlStrategy>noGapControl;
 
     sysT1 = &systemT1_;
     sysT2 = &systemT2_;
@@ -203,6 +208,7 @@ namespace MBSim {
     Timer.start();
 
     lae <<= system->getla(false);
+    la <<= lae;
 
     qUncertaintyByExtrapolation=0;
 
@@ -858,48 +864,9 @@ namespace MBSim {
       sysT1->plot();
     }
     if ((t>=tPlot) && outputInterpolation && !FlagPlotEveryStep) {
-      throwError("Not implemented");
-
-      // Dimension/size von la und lae synchronisieren
-      Vec laSynchron;
-      Vec laeSynchron;
-      VecInt laSizesSynchron;
-      if(t>tPlot) {
-        int nLinks = laSizes.size();
-        if (nLinks>laeSizes.size()) nLinks=laeSizes.size();
-        int nlaAll=0;
-        for(int i=0; i<nLinks; i++) {
-          if (laSizes(i)>laeSizes(i)) nlaAll+=laeSizes(i);
-          else nlaAll+=laSizes(i);
-        }
-        laSynchron.resize(nlaAll,NONINIT);
-        laeSynchron.resize(nlaAll,NONINIT);
-        laSizesSynchron.resize(nlaAll,NONINIT);
-        int ila=0;
-        int ilae=0;
-        int iSynchron=0;
-        for(int i=0; i<nLinks;i++) {
-          laSizesSynchron(i) = laSizes(i);
-          if (laSizesSynchron(i)>laeSizes(i)) laSizesSynchron(i) = laeSizes(i);
-          laSynchron.set(RangeV(iSynchron,iSynchron+laSizesSynchron(i)-1), la(RangeV(ila,ila+laSizesSynchron(i)-1)));
-          laeSynchron.set(RangeV(iSynchron,iSynchron+laSizesSynchron(i)-1), lae(RangeV(ilae,ilae+laSizesSynchron(i)-1)));
-          ilae+=laeSizes(i);
-          ila+=laSizes(i);
-          iSynchron+=laSizesSynchron(i);
-        }
-      }
-
-      while (t>tPlot) {
-        double ratio = (tPlot -(t-dte))/dte;
-        sysT1->setTime(tPlot);
-        sysT1->setState(zi + (ze-zi)*ratio);
-        sysT1->setla(laSynchron+(laeSynchron-laSynchron)*ratio);
-        sysT1->resetUpToDate();
-        sysT1->setUpdatela(false);
-        sysT1->setUpdateLa(false);
-        sysT1->plot();
-        tPlot += dtPlot;
-      }
+      // the plot times lie within the step; hence, the constraint forces at the beginning of the step are used
+      sysT1->calclaSize(2);
+      TimeSteppingOutput::plot(sysT1, t-dte, zi, t, ze, la, tPlot, dtPlot);
     }
 
     if (msgAct(Status) and (not FlagOutputOnlyAtTPlot or (FlagOutputOnlyAtTPlot and FlagtPlot) ))
@@ -1385,21 +1352,41 @@ namespace MBSim {
   // Vector<int> laSizes contains the singel la-size of each link
 
   void TimeSteppingSSCIntegrator::getDataForGapControl() {
-    throwError("TimeSteppingSSCIntegrator::getDataForGapControl not implemented");
-//    int nInActive=0;
-//    int nActive=0;
-//    throw;
-//    for(unsigned int i=0; i<SetValuedLinkListT1.size(); i++){ 
-//      SetValuedLinkListT1[i]->checkActive(1);
-//      SetValuedLinkListT1[i]->SizeLinearImpactEstimation(&nInActive, &nActive);
-//    }
-//    gInActive.resize(nInActive,NONINIT);
-//    gdInActive.resize(nInActive,NONINIT);
-//    gUniActive.resize(nActive,NONINIT);
-//    nInActive=0;
-//    nActive=0;
-//    for(unsigned int i=0; i<SetValuedLinkListT1.size(); i++) 
-//      SetValuedLinkListT1[i]->LinearImpactEstimation(t,gInActive,gdInActive,&nInActive,gUniActive,&nActive);
+    // state at the end of the accepted step; the gap of each open contact with the mean gap velocity up to its estimated
+    // time of impact, such that the root -g/gd is the time of impact; the penetration of the closed contacts
+    sysT1->setTime(t+dte);
+    sysT1->setState(ze);
+    sysT1->resetUpToDate();
+    vector<double> gIn, gdIn, gAct;
+    for(auto & l : sysT1->getLinksWithStopVector()) {
+      auto *contact = dynamic_cast<Contact*>(l);
+      if(not contact)
+        continue;
+      double g = numeric_limits<double>::infinity();
+      for(size_t i=0; i<contact->getSubcontacts().size(); i++) {
+        double gi = contact->getSingleContact(i).evalGeneralizedRelativePosition()(0);
+        if(gi>0)
+          g = min(g, gi);
+        else if(gi<0)
+          gAct.push_back(gi);
+      }
+      if(g<numeric_limits<double>::infinity()) {
+        double toi = contact->evalTimeOfImpact(1.5*dt);
+        if(toi<numeric_limits<double>::infinity()) {
+          gIn.push_back(g);
+          gdIn.push_back(-g/toi);
+        }
+      }
+    }
+    gInActive.resize(gIn.size(),NONINIT);
+    gdInActive.resize(gdIn.size(),NONINIT);
+    gUniActive.resize(gAct.size(),NONINIT);
+    for(size_t i=0; i<gIn.size(); i++) {
+      gInActive(i) = gIn[i];
+      gdInActive(i) = gdIn[i];
+    }
+    for(size_t i=0; i<gAct.size(); i++)
+      gUniActive(i) = gAct[i];
   }
 
   bool TimeSteppingSSCIntegrator::changedLinkStatus(const VecInt &L1, const VecInt &L2, int ex) {
@@ -1483,6 +1470,9 @@ namespace MBSim {
 
     e=E(element)->getFirstElementChildNamed(MBSIM%"safetyFactor");
     if (e) setSafetyFactor(E(e)->getText<double>());
+
+    e=E(element)->getFirstElementChildNamed(MBSIM%"gapControlByTimeOfImpact");
+    if (e) setGapControlByTimeOfImpact(E(e)->getText<bool>());
   }
 
   void TimeSteppingSSCIntegrator::resize(DynamicSystemSolver *system) {
@@ -134,6 +134,8 @@ namespace MBSim {
       Method method{extrapolation};
       /* Flag for Gap Control */
       bool FlagGapControl{false};
+      /** gap control with the estimated time of impact of the open contacts as roots */
+      bool gapControlByTimeOfImpact{false};
       /** Toleranz for closing gaps */
       double gapTol{1e-6};
       /** maximal gain factor for increasing dt by stepsize control (default 2.5; maxGain * safetyFactor must be GT 1)*/
@@ -212,6 +214,8 @@ namespace MBSim {
        *   -1: gap control deactivated without statistic calculations
        */
       void setGapControl(GapControl gapControl) { GapControlStrategy = gapControl; }
+      /*! Activate the gap control with the estimated time of impact of the open contacts (see Contact::evalTimeOfImpact) */
+      void setGapControlByTimeOfImpact(bool b) { gapControlByTimeOfImpact = b; }
       /*! Set drift compensation */
       void setDriftCompensation(bool dc) { driftCompensation = dc; }
       /*! set maximum order (1,2,3 (method=extrapolation) or 1 to 4 (method=embedded,embeddedHigherOrder) and
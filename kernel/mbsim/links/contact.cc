@@ -73,6 +73,10 @@ namespace MBSim {
       iter->updateg();
   }
 
+  double Contact::evalTimeOfImpact(double dt) {
+    return contactKinematics->evalTimeOfImpact(dt);
+  }
+
   void Contact::updategd() {
     for (vector<SingleContact>::iterator iter = contacts.begin(); iter != contacts.end(); ++iter)
       iter->updategd();
@@ -555,6 +559,27 @@ namespace MBSim {
       iter->checkActive(j);
   }
 
+  int Contact::getActiveFlagsSize() const {
+    int n = 0;
+    for (const auto & contact : contacts)
+      n += contact.getActiveFlagsSize();
+    return n;
+  }
+
+  void Contact::getActiveFlags(unsigned int *flags) const {
+    for (const auto & contact : contacts) {
+      contact.getActiveFlags(flags);
+      flags += contact.getActiveFlagsSize();
+    }
+  }
+
+  void Contact::setActiveFlags(const unsigned int *flags) {
+    for (auto & contact : contacts) {
+      contact.setActiveFlags(flags);
+      flags += contact.getActiveFlagsSize();
+    }
+  }
+
   int Contact::getFrictionDirections() {
     if (fdf)
       return fdf->getFrictionDirections();
@@ -705,6 +730,11 @@ namespace MBSim {
       iter->resetUpToDate();
   }
 
+  void Contact::resetForcesUpToDate() {
+    for (vector<SingleContact>::iterator iter = contacts.begin(); iter != contacts.end(); ++iter)
+      iter->resetForcesUpToDate();
+  }
+
   void Contact::updateGeneralizedPositions() {
     contactKinematics->updateg(contacts);
     updrrel = false;
@@ -115,6 +115,9 @@ namespace MBSim {
       void checkConstraintsForTermination() override;
       void checkImpactsForTermination() override;
       void checkActive(int j) override;
+      int getActiveFlagsSize() const override;
+      void getActiveFlags(unsigned int *flags) const override;
+      void setActiveFlags(const unsigned int *flags) override;
       void setGeneralizedForceTolerance(double tol) override;
       void setGeneralizedImpulseTolerance(double tol) override;
       void setGeneralizedRelativePositionTolerance(double tol) override;
@@ -145,6 +148,7 @@ namespace MBSim {
       /***************************************************/
 
       void resetUpToDate() override;
+      void resetForcesUpToDate() override;
 
       /* GETTER / SETTER */
 
@@ -156,6 +160,11 @@ namespace MBSim {
       void setContactKinematics(ContactKinematics* ck) { contactKinematics = ck; }
       ContactKinematics* getContactKinematics() const { return contactKinematics; }
 
+      /**
+       * \return estimated time of impact within the horizon dt (see ContactKinematics::evalTimeOfImpact)
+       */
+      double evalTimeOfImpact(double dt);
+
       const std::vector<SingleContact>& getSubcontacts() const { return contacts; }
       /***************************************************/
 
@@ -153,6 +153,12 @@ namespace MBSim {
     cFrame[1]->resetUpToDate();
   }
 
+  void ContourLink::resetForcesUpToDate() {
+    MechanicalLink::resetForcesUpToDate();
+    cFrame[0]->resetAccelerationsUpToDate();
+    cFrame[1]->resetAccelerationsUpToDate();
+  }
+
   void ContourLink::initializeUsingXML(DOMElement *element) {
     MechanicalLink::initializeUsingXML(element);
     DOMElement *e;
@@ -67,6 +67,7 @@ namespace MBSim {
       ContourFrame* getContourFrame(int i) { return cFrame[i]; }
 
       void resetUpToDate() override;
+      void resetForcesUpToDate() override;
 
       //void updatePositions() override { }
       //void updateVelocities() override { }
@@ -50,6 +50,12 @@ namespace MBSim {
     updlaT = true;
   }
 
+  void DiskContact::resetForcesUpToDate() {
+    ContourLink::resetForcesUpToDate();
+    updlaN = true;
+    updlaT = true;
+  }
+
   bool DiskContact::isSticking() const { 
     return laT.size();
   }
@@ -911,6 +917,28 @@ namespace MBSim {
     }
   }
 
+  int DiskContact::getActiveFlagsSize() const {
+    return 6;
+  }
+
+  void DiskContact::getActiveFlags(unsigned int *flags) const {
+    flags[0] = gActive;
+    flags[1] = gActive0;
+    flags[2] = gdActive[normal];
+    flags[3] = gdActive[tangential];
+    flags[4] = gddActive[normal];
+    flags[5] = gddActive[tangential];
+  }
+
+  void DiskContact::setActiveFlags(const unsigned int *flags) {
+    gActive = flags[0];
+    gActive0 = flags[1];
+    gdActive[normal] = flags[2];
+    gdActive[tangential] = flags[3];
+    gddActive[normal] = flags[4];
+    gddActive[tangential] = flags[5];
+  }
+
   void DiskContact::checkActive(int j) {
     if (j == 1) { // formerly checkActiveg()
       if(fcl->isSetValued()) {
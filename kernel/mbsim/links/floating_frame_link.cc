@@ -36,6 +36,11 @@ namespace MBSim {
     C.resetUpToDate();  
   }
 
+  void FloatingFrameLink::resetForcesUpToDate() {
+    FrameLink::resetForcesUpToDate();
+    C.resetAccelerationsUpToDate();
+  }
+
   void FloatingFrameLink::calcSize() {
     ng = forceDir.cols() + momentDir.cols();
     ngd = ng;
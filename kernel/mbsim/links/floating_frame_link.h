@@ -65,6 +65,7 @@ namespace MBSim {
       void setFrameOfReference(FrameOfReference refFrame_) { refFrame = refFrame_; }
 
       void resetUpToDate() override;
+      void resetForcesUpToDate() override;
       void updatePositions(Frame *frame) override;
       void updateVelocities() override;
       void updateGeneralizedPositions() override;
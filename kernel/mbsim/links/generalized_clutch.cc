@@ -204,6 +204,24 @@ namespace MBSim {
     svSize = laT->isSetValued() ? (e?2:1) : 0;
   }
 
+  int GeneralizedClutch::getActiveFlagsSize() const {
+    return 4;
+  }
+
+  void GeneralizedClutch::getActiveFlags(unsigned int *flags) const {
+    flags[0] = gActive;
+    flags[1] = gActive0;
+    flags[2] = gdActive;
+    flags[3] = gddActive;
+  }
+
+  void GeneralizedClutch::setActiveFlags(const unsigned int *flags) {
+    gActive = flags[0];
+    gActive0 = flags[1];
+    gdActive = flags[2];
+    gddActive = flags[3];
+  }
+
   void GeneralizedClutch::checkActive(int j) {
     if (j == 1) {
       if(e)
@@ -76,6 +76,9 @@ class GeneralizedClutch : public DualRigidBodyLink {
       void calcrFactorSize(int j) override;
       void calcsvSize() override;
       void checkActive(int j) override;
+      int getActiveFlagsSize() const override;
+      void getActiveFlags(unsigned int *flags) const override;
+      void setActiveFlags(const unsigned int *flags) override;
       void calccorrSize(int j) override;
       void updatecorr(int j) override;
       void checkRoot() override;
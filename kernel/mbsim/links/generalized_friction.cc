@@ -176,6 +176,20 @@ namespace MBSim {
     svSize = laT->isSetValued() ? 1 : 0;
   }
 
+  int GeneralizedFriction::getActiveFlagsSize() const {
+    return 2;
+  }
+
+  void GeneralizedFriction::getActiveFlags(unsigned int *flags) const {
+    flags[0] = gdActive;
+    flags[1] = gddActive;
+  }
+
+  void GeneralizedFriction::setActiveFlags(const unsigned int *flags) {
+    gdActive = flags[0];
+    gddActive = flags[1];
+  }
+
   void GeneralizedFriction::checkActive(int j) {
     if (j == 1)
       gdActive = 1;
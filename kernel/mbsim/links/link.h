@@ -337,11 +337,29 @@ namespace MBSim {
        */
       virtual void checkActive(int j) { }
 
+      /**
+       * \return number of activity flags (gActive, gdActive, ...) of the link
+       *
+       * the flags are part of the system state which is saved and restored by DynamicSystemSolver::getSnapshot and setSnapshot
+       */
+      virtual int getActiveFlagsSize() const { return 0; }
+
+      /**
+       * \brief copy the activity flags to flags
+       */
+      virtual void getActiveFlags(unsigned int *flags) const { }
+
+      /**
+       * \brief restore the activity flags from flags
+       */
+      virtual void setActiveFlags(const unsigned int *flags) { }
+
       virtual void setGeneralizedForceTolerance(double tol) { laTol = tol; }
       virtual void setGeneralizedImpulseTolerance(double tol) { LaTol = tol; }
       virtual void setGeneralizedRelativePositionTolerance(double tol) { gTol = tol; }
       virtual void setGeneralizedRelativeVelocityTolerance(double tol) { gdTol = tol; }
       virtual void setGeneralizedRelativeAccelerationTolerance(double tol) { gddTol = tol; }
+      double getGeneralizedRelativePositionTolerance() const { return gTol; }
       virtual void setGeneralizedRelativePositionCorrectionValue(double corr) { gCorr = corr; }
       virtual void setGeneralizedRelativeVelocityCorrectionValue(double corr) { gdCorr = corr; }
       virtual void setrMax(double rMax_) { rMax = rMax_; }
@@ -376,6 +394,7 @@ namespace MBSim {
       void setx(const fmatvec::Vec &x_) { x = x_; }
       
       virtual void setsvInd(int svInd_) { svInd = svInd_; };
+      int getsvInd() const { return svInd; }
       int getsvSize() const { return svSize; }
 
       int getLinkStatusSize() const { return LinkStatusSize; }
@@ -399,6 +418,7 @@ namespace MBSim {
       const fmatvec::Vec& evalwb();
       const fmatvec::Vec& evalxd();
 
+      int getgInd() const { return gInd; }
       int getgdInd() const { return gdInd; } 
       int getgSize() const { return gSize; } 
       int getgdSize() const { return gdSize; } 
@@ -408,6 +428,11 @@ namespace MBSim {
       const fmatvec::VecInt& getrFactorUnsure() const { return rFactorUnsure; }
 
       void resetUpToDate() override { updrrel = true; updvrel = true; updla = true; }
+      /**
+       * \brief reset all quantities which may depend on the inputs of the system but not on its state
+       * The default implementation resets everything.
+       */
+      virtual void resetForcesUpToDate() { resetUpToDate(); }
 
       virtual void updateGeneralizedPositions() { updrrel = false; }
       virtual void updateGeneralizedVelocities() { updvrel = false; }
@@ -668,6 +668,32 @@ namespace MBSim {
     }
   }
 
+  int MaxwellContact::getActiveFlagsSize() const {
+    int n = 0;
+    for (const auto & iter : contacts)
+      for (const auto & contact : iter)
+        n += contact.getActiveFlagsSize();
+    return n;
+  }
+
+  void MaxwellContact::getActiveFlags(unsigned int *flags) const {
+    for (const auto & iter : contacts) {
+      for (const auto & contact : iter) {
+        contact.getActiveFlags(flags);
+        flags += contact.getActiveFlagsSize();
+      }
+    }
+  }
+
+  void MaxwellContact::setActiveFlags(const unsigned int *flags) {
+    for (auto & iter : contacts) {
+      for (auto & contact : iter) {
+        contact.setActiveFlags(flags);
+        flags += contact.getActiveFlagsSize();
+      }
+    }
+  }
+
   int MaxwellContact::getFrictionDirections() {
     if (fdf)
       return fdf->getFrictionDirections();
@@ -892,6 +918,13 @@ namespace MBSim {
     }
   }
 
+  void MaxwellContact::resetForcesUpToDate() {
+    for (std::vector<std::vector<SingleContact>>::iterator iter = contacts.begin(); iter != contacts.end(); ++iter) {
+      for (std::vector<SingleContact>::iterator jter = iter->begin(); jter != iter->end(); ++jter)
+        jter->resetForcesUpToDate();
+    }
+  }
+
   void MaxwellContact::initializeContourCouplings() {
     for(size_t i = 0; i < referenceXML.size(); i++) {
       Contour* contour1 = getByPath<Contour>(referenceXML[i].name1);
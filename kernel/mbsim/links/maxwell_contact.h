@@ -103,6 +103,9 @@ namespace MBSim {
       void checkConstraintsForTermination() override;
       void checkImpactsForTermination() override;
       void checkActive(int j) override;
+      int getActiveFlagsSize() const override;
+      void getActiveFlags(unsigned int *flags) const override;
+      void setActiveFlags(const unsigned int *flags) override;
       void setGeneralizedForceTolerance(double tol) override;
       void setGeneralizedImpulseTolerance(double tol) override;
       void setGeneralizedRelativePositionTolerance(double tol) override;
@@ -131,6 +134,7 @@ namespace MBSim {
       /***************************************************/
 
       void resetUpToDate() override;
+      void resetForcesUpToDate() override;
 
       /* GETTER / SETTER */
 
@@ -46,6 +46,14 @@ namespace MBSim {
     updlaM = true;
   }
 
+  void MechanicalLink::resetForcesUpToDate() {
+    updla = true;
+    updF = true;
+    updM = true;
+    updlaF = true;
+    updlaM = true;
+  }
+
   void MechanicalLink::updateGeneralizedForces() {
     lambda.set(iF, evallaF());
     lambda.set(iM, evallaM());
@@ -39,6 +39,7 @@ namespace MBSim {
       MechanicalLink(const std::string &name);
 
       void resetUpToDate() override;
+      void resetForcesUpToDate() override;
 
       virtual void updatePositions() { }
       virtual void updateVelocities() { }
@@ -227,4 +227,10 @@ namespace MBSim {
       i.resetUpToDate();
   }
 
+  void RigidBodyLink::resetForcesUpToDate() {
+    MechanicalLink::resetForcesUpToDate();
+    for(auto & i : C)
+      i.resetAccelerationsUpToDate();
+  }
+
 }
@@ -75,6 +75,7 @@ namespace MBSim {
       void initializeUsingXML(xercesc::DOMElement * element) override;
 
       void resetUpToDate() override; 
+      void resetForcesUpToDate() override;
 
       virtual void setSupportFrame(Frame *frame) { support = frame; }
 
@@ -39,6 +39,12 @@ namespace MBSim {
     updlaT = true;
   }
 
+  void SingleContact::resetForcesUpToDate() {
+    ContourLink::resetForcesUpToDate();
+    updlaN = true;
+    updlaT = true;
+  }
+
   bool SingleContact::isSticking() const { 
     return laT.size();
   }
@@ -923,6 +929,28 @@ namespace MBSim {
     }
   }
 
+  int SingleContact::getActiveFlagsSize() const {
+    return 6;
+  }
+
+  void SingleContact::getActiveFlags(unsigned int *flags) const {
+    flags[0] = gActive;
+    flags[1] = gActive0;
+    flags[2] = gdActive[normal];
+    flags[3] = gdActive[tangential];
+    flags[4] = gddActive[normal];
+    flags[5] = gddActive[tangential];
+  }
+
+  void SingleContact::setActiveFlags(const unsigned int *flags) {
+    gActive = flags[0];
+    gActive0 = flags[1];
+    gdActive[normal] = flags[2];
+    gdActive[tangential] = flags[3];
+    gddActive[normal] = flags[4];
+    gddActive[tangential] = flags[5];
+  }
+
   void SingleContact::checkActive(int j) {
     if (j == 1) { // formerly checkActiveg()
       if(fcl->isSetValued()) {
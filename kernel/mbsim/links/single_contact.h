@@ -56,6 +56,7 @@ namespace MBSim {
       SingleContact(const std::string &name="") : ContourLink(name) { }
 
       void resetUpToDate() override;
+      void resetForcesUpToDate() override;
 
       bool isSticking() const;
 
@@ -133,6 +134,9 @@ namespace MBSim {
       void checkConstraintsForTermination() override;
       void checkImpactsForTermination() override;
       void checkActive(int j) override;
+      int getActiveFlagsSize() const override;
+      void getActiveFlags(unsigned int *flags) const override;
+      void setActiveFlags(const unsigned int *flags) override;
       void LinearImpactEstimation(double t, fmatvec::Vec &gInActive_,fmatvec::Vec &gdInActive_,int *IndInActive_,fmatvec::Vec &gAct_,int *IndActive_) override;
       void SizeLinearImpactEstimation(int *sizeInActive_, int *sizeActive_) override;
  
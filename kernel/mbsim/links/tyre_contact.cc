@@ -357,4 +357,9 @@ namespace MBSim {
     updfvel = true;
   }
 
+  void TyreContact::resetForcesUpToDate() {
+    // the tyre model may cache input dependent quantities
+    resetUpToDate();
+  }
+
 }
@@ -62,6 +62,7 @@ namespace MBSim {
       void setTolerance(double tol_) { tol = tol_; }
 
       void resetUpToDate() override;
+      void resetForcesUpToDate() override;
 
     protected:
       TyreModel *model{nullptr};
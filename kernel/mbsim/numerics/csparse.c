@@ -1885,7 +1885,7 @@ int cs_splsolve(cs *L, const cs *B, int k, int *xi, double *x, const int *Pinv)
     jnew = Pinv ? (Pinv[j]) : j; /* j is column jnew of L */
     if (jnew < 0)
       continue; /* column jnew is empty */
-    x[j] /= Lx[Lp[j]];
+    x[j] /= Lx[Lp[jnew]];
     for (p = Lp[jnew] + 1; p < Lp[jnew + 1]; p++) {
       x[Li[p]] -= Lx[p] * x[j]; /* x(i) -= L(i,j) * x(j) */
     }
@@ -725,6 +725,119 @@ namespace MBSim {
     }
   }
 
+  /*!
+   \brief computes the knot spans and the derivatives of the basis functions
+   up to degree \a d at \a (u,v)
+
+   The result only depends on the knot vectors and the degrees. Hence, it can be
+   reused for all surfaces sharing the knot vectors (see hasSameKnots).
+
+   \param  u  the u parametric value
+   \param  v  the v parametric value
+   \param  d  the derivative is computed up to and including to this value
+   \param uspan  the span in the U direction
+   \param vspan  the span in the V direction
+   \param Nu  the derivatives of the basis functions in the U direction
+   \param Nv  the derivatives of the basis functions in the V direction
+   */
+  void NurbsSurface::dersBasisFunsAt(double u, double v, int d, int &uspan, int &vspan, Mat &Nu, Mat &Nv) const {
+    uspan = findSpanU(u);
+    vspan = findSpanV(v);
+    dersBasisFuns((d <= degU) ? d : degU, u, uspan, degU, U, Nu);
+    dersBasisFuns((d <= degV) ? d : degV, v, vspan, degV, V, Nv);
+  }
+
+  /*!
+   \brief checks whether \a srf has the same degrees, knot vectors and number of control points
+   */
+  bool NurbsSurface::hasSameKnots(const NurbsSurface &srf) const {
+    if (degU != srf.degU || degV != srf.degV || U.size() != srf.U.size() || V.size() != srf.V.size() || P.rows() != srf.P.rows() || P.cols() != srf.P.cols())
+      return false;
+    for (int i = 0; i < U.size(); i++)
+      if (U(i) != srf.U(i))
+        return false;
+    for (int i = 0; i < V.size(); i++)
+      if (V(i) != srf.V(i))
+        return false;
+    return true;
+  }
+
+  /*!
+   \brief computes the derivatives skl(k,l) with \a dmin <= k+l <= \a d
+
+   Like deriveAtH(double, double, int, GeneralMatrix<Vec4>&) but with
+   precomputed spans and basis functions (see dersBasisFunsAt). Derivatives
+   with k+l < \a dmin are kept, \a skl must have been evaluated at the same
+   parameters for these entries.
+   */
+  void NurbsSurface::deriveAtH(int uspan, int vspan, const Mat &Nu, const Mat &Nv, int d, GeneralMatrix<Vec4> &skl, int dmin) const {
+    if (skl.rows() < d + 1 || skl.cols() < d + 1)
+      skl.resize(d + 1, d + 1);
+    for (int k = 0; k <= d; ++k) {
+      for (int l = (dmin > k ? dmin - k : 0); l <= d - k; ++l) {
+        Vec4 &sum = skl(k, l);
+        sum.init(0.0);
+        if (k >= Nu.rows() || l >= Nv.rows())
+          continue;
+        for (int s = 0; s <= degV; ++s) {
+          for (int r = 0; r <= degU; ++r) {
+            double w = Nu(k, r) * Nv(l, s);
+            const Vec4 &Pij = P(uspan - degU + r, vspan - degV + s);
+            for (int c = 0; c < 4; ++c)
+              sum(c) += w * Pij(c);
+          }
+        }
+      }
+    }
+  }
+
+  /*!
+   \brief computes the derivatives skl[i](k,l) with \a dmin <= k+l <= \a d of all surfaces \a srf[i]
+
+   All surfaces must share the knot vectors (see hasSameKnots). The products of the
+   basis functions are computed once and contracted with the control points of all
+   surfaces.
+   */
+  void NurbsSurface::deriveAtH(const vector<NurbsSurface> &srf, int uspan, int vspan, const Mat &Nu, const Mat &Nv, int d, vector<GeneralMatrix<Vec4>> &skl, int dmin) {
+    if (srf.empty())
+      return;
+    int degU = srf[0].degU, degV = srf[0].degV;
+    int nw = (degU + 1) * (degV + 1);
+    vector<pair<int, int>> kl;
+    for (int k = 0; k <= d; ++k)
+      for (int l = (dmin > k ? dmin - k : 0); l <= d - k; ++l)
+        kl.emplace_back(k, l);
+    vector<double> w(kl.size() * nw, 0.0);
+    for (size_t m = 0; m < kl.size(); m++) {
+      int k = kl[m].first, l = kl[m].second;
+      if (k >= Nu.rows() || l >= Nv.rows())
+        continue;
+      for (int s = 0; s <= degV; ++s)
+        for (int r = 0; r <= degU; ++r)
+          w[m * nw + s * (degU + 1) + r] = Nu(k, r) * Nv(l, s);
+    }
+    skl.resize(srf.size());
+    for (size_t i = 0; i < srf.size(); i++) {
+      if (skl[i].rows() < d + 1 || skl[i].cols() < d + 1)
+        skl[i].resize(d + 1, d + 1);
+      const GeneralMatrix<Vec4> &P = srf[i].P;
+      for (size_t m = 0; m < kl.size(); m++) {
+        double sum[4] = {0, 0, 0, 0};
+        const double *wm = &w[m * nw];
+        for (int s = 0; s <= degV; ++s) {
+          for (int r = 0; r <= degU; ++r) {
+            const Vec4 &Pij = P(uspan - degU + r, vspan - degV + s);
+            for (int c = 0; c < 4; ++c)
+              sum[c] += wm[s * (degU + 1) + r] * Pij(c);
+          }
+        }
+        Vec4 &sklm = skl[i](kl[m].first, kl[m].second);
+        for (int c = 0; c < 4; ++c)
+          sklm(c) = sum[c];
+      }
+    }
+  }
+
   /*!
    \brief Computes the normal of the surface at \a (u,v)
 
@@ -101,6 +101,10 @@ namespace MBSim {
       // Derivative functions
       void deriveAt(double u, double v, int d, fmatvec::GeneralMatrix<fmatvec::Vec3> &skl) const;
       void deriveAtH(double u, double v, int d, fmatvec::GeneralMatrix<fmatvec::Vec4> &skl) const;
+      void deriveAtH(int uspan, int vspan, const fmatvec::Mat &Nu, const fmatvec::Mat &Nv, int d, fmatvec::GeneralMatrix<fmatvec::Vec4> &skl, int dmin=0) const;
+      static void deriveAtH(const std::vector<NurbsSurface> &srf, int uspan, int vspan, const fmatvec::Mat &Nu, const fmatvec::Mat &Nv, int d, std::vector<fmatvec::GeneralMatrix<fmatvec::Vec4>> &skl, int dmin=0);
+      void dersBasisFunsAt(double u, double v, int d, int &uspan, int &vspan, fmatvec::Mat &Nu, fmatvec::Mat &Nv) const;
+      bool hasSameKnots(const NurbsSurface &srf) const;
       fmatvec::Vec3 normal(double u, double v) const;
 
       // Surface fitting functions
@@ -0,0 +1,165 @@
+/* Copyright (C) 2004-2015 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h>
+#include "mbsim/numerics/sparse_lu.h"
+#include "mbsim/numerics/csparse.h"
+
+using namespace std;
+
+namespace MBSim {
+
+  namespace {
+    // pivots are taken from the diagonal if they are at least this fraction of the largest entry of the column
+    const double pivotTolerance = 0.1;
+
+    // append the entries of the column to the compressed column storage and track whether the pattern changes
+    template<class Get>
+    void appendColumn(int n, int offset, const Get &get, vector<int> &Ai, vector<double> &Ax, size_t &nz, bool &changed) {
+      for(int i=0; i<n; i++) {
+        double v = get(i);
+        if(v==0)
+          continue;
+        if(nz<Ai.size()) {
+          if(Ai[nz]!=i+offset) {
+            changed = true;
+            Ai[nz] = i+offset;
+          }
+          Ax[nz] = v;
+        }
+        else {
+          changed = true;
+          Ai.push_back(i+offset);
+          Ax.push_back(v);
+        }
+        nz++;
+      }
+    }
+  }
+
+  SparseLU::~SparseLU() {
+    cs_nfree(N);
+    cs_sfree(S);
+  }
+
+  int SparseLU::factorize(int n_, const double *A, int lda) {
+    bool changed = n_!=n;
+    n = n_;
+    Ap.resize(n+1);
+    size_t nz = 0;
+    for(int j=0; j<n; j++) {
+      if(Ap[j]!=int(nz))
+        changed = true;
+      Ap[j] = nz;
+      const double *col = A+size_t(j)*lda;
+      appendColumn(n, 0, [col](int i) { return col[i]; }, Ai, Ax, nz, changed);
+    }
+    changed = changed or Ap[n]!=int(nz);
+    Ap[n] = nz;
+    Ai.resize(nz);
+    Ax.resize(nz);
+    patternChanged = patternChanged or changed;
+    return factorize();
+  }
+
+  int SparseLU::factorize(int n_, const complex<double> *A, int lda) {
+    // [Re -Im; Im Re] [x_re; x_im] = [b_re; b_im]
+    bool changed = 2*n_!=n;
+    n = 2*n_;
+    Ap.resize(n+1);
+    size_t nz = 0;
+    for(int j=0; j<n; j++) {
+      if(Ap[j]!=int(nz))
+        changed = true;
+      Ap[j] = nz;
+      const complex<double> *col = A+size_t(j%n_)*lda;
+      if(j<n_) {
+        appendColumn(n_, 0, [col](int i) { return col[i].real(); }, Ai, Ax, nz, changed);
+        appendColumn(n_, n_, [col](int i) { return col[i].imag(); }, Ai, Ax, nz, changed);
+      }
+      else {
+        appendColumn(n_, 0, [col](int i) { return -col[i].imag(); }, Ai, Ax, nz, changed);
+        appendColumn(n_, n_, [col](int i) { return col[i].real(); }, Ai, Ax, nz, changed);
+      }
+    }
+    changed = changed or Ap[n]!=int(nz);
+    Ap[n] = nz;
+    Ai.resize(nz);
+    Ax.resize(nz);
+    patternChanged = patternChanged or changed;
+    return factorize();
+  }
+
+  int SparseLU::factorize(int n_, const vector<int> &Ap_, const vector<int> &Ai_, const vector<double> &Ax_) {
+    patternChanged = patternChanged or n_!=n or Ap_!=Ap or Ai_!=Ai;
+    n = n_;
+    Ap = Ap_;
+    Ai = Ai_;
+    Ax = Ax_;
+    return factorize();
+  }
+
+  int SparseLU::factorize() {
+    density = n ? double(Ap[n])/n/n : 0;
+    cs A;
+    A.nzmax = Ap[n];
+    A.m = n;
+    A.n = n;
+    A.p = Ap.data();
+    A.i = Ai.data();
+    A.x = Ax.data();
+    A.nz = -1;
+
+    if(patternChanged) {
+      cs_sfree(S);
+      S = cs_sqr(&A, 1, 0); // fill-reducing ordering for LU
+      nSymbolic++;
+      patternChanged = false;
+    }
+    cs_nfree(N);
+    N = S ? cs_lu(&A, S, pivotTolerance) : nullptr;
+    nNumeric++;
+    x.resize(n);
+    if(not N) {
+      patternChanged = true; // start with a new analysis next time
+      return 1;
+    }
+    return 0;
+  }
+
+  void SparseLU::solve(double *b) {
+    cs_ipvec(n, N->Pinv, b, x.data()); // x = P*b
+    cs_lsolve(N->L, x.data()); // x = L\x
+    cs_usolve(N->U, x.data()); // x = U\x
+    cs_ipvec(n, S->Q, x.data(), b); // b = Q*x
+  }
+
+  void SparseLU::solve(complex<double> *b) {
+    int n_ = n/2;
+    vector<double> br(n);
+    for(int i=0; i<n_; i++) {
+      br[i] = b[i].real();
+      br[i+n_] = b[i].imag();
+    }
+    solve(br.data());
+    for(int i=0; i<n_; i++)
+      b[i] = complex<double>(br[i], br[i+n_]);
+  }
+
+}
@@ -0,0 +1,84 @@
+/* Copyright (C) 2004-2015 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _SPARSE_LU_H_
+#define _SPARSE_LU_H_
+
+#include <complex>
+#include <vector>
+
+struct cs_sparse;
+struct cs_symbolic;
+struct cs_numeric;
+
+namespace MBSim {
+
+  /*!
+   * \brief sparse direct LU solver (CSparse) for matrices given in dense column major or compressed column storage
+   *
+   * The fill-reducing ordering (symbolic analysis) is only computed if the nonzero pattern of the matrix changes;
+   * otherwise only the numeric factorisation is redone. Complex matrices are factorised by the equivalent real
+   * system [Re -Im; Im Re] of twice the size.
+   */
+  class SparseLU {
+    public:
+      SparseLU() = default;
+      SparseLU(const SparseLU&) = delete;
+      SparseLU& operator=(const SparseLU&) = delete;
+      ~SparseLU();
+
+      /*!
+       * \brief factorise the n x n matrix A with leading dimension lda
+       * \return 0 on success, 1 if the matrix is singular
+       */
+      int factorize(int n, const double *A, int lda);
+      int factorize(int n, const std::complex<double> *A, int lda);
+
+      /*!
+       * \brief factorise the n x n matrix in compressed column storage (column pointers Ap_, row indices Ai_ and values Ax_)
+       * \return 0 on success, 1 if the matrix is singular
+       */
+      int factorize(int n, const std::vector<int> &Ap_, const std::vector<int> &Ai_, const std::vector<double> &Ax_);
+
+      //! solve A x = b for the last factorised matrix; b is overwritten with x
+      void solve(double *b);
+      void solve(std::complex<double> *b);
+
+      //! ratio of nonzero entries of the last matrix
+      double getDensity() const { return density; }
+      int getNumberOfSymbolicAnalyses() const { return nSymbolic; }
+      int getNumberOfFactorizations() const { return nNumeric; }
+
+    private:
+      //! factorise the compressed column matrix in Ap, Ai, Ax
+      int factorize();
+
+      int n{0};
+      std::vector<int> Ap, Ai;
+      std::vector<double> Ax, x;
+      cs_symbolic *S{nullptr};
+      cs_numeric *N{nullptr};
+      bool patternChanged{true};
+      double density{0};
+      int nSymbolic{0}, nNumeric{0};
+  };
+
+}
+
+#endif
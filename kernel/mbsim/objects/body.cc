@@ -220,6 +220,8 @@ namespace MBSim {
     updPos = true;
     for(auto & i : frame)
       i->resetPositionsUpToDate();
+    for(auto & i : contour)
+      i->resetPositionsUpToDate();
   }
   void Body::resetVelocitiesUpToDate() {
     updVel = true;
@@ -234,5 +236,9 @@ namespace MBSim {
     for(auto & i : frame)
       i->resetGyroscopicAccelerationsUpToDate();
   }
+  void Body::resetAccelerationsUpToDate() {
+    for(auto & i : frame)
+      i->resetAccelerationsUpToDate();
+  }
 
 }
@@ -150,6 +150,7 @@ namespace MBSim {
       virtual void resetVelocitiesUpToDate();
       virtual void resetJacobiansUpToDate();
       virtual void resetGyroscopicAccelerationsUpToDate();
+      virtual void resetAccelerationsUpToDate();
       virtual void updateJacobians() { }
 
       /**
@@ -250,6 +250,12 @@ namespace MBSim {
       fmatvec::Vec& getudall(bool check=true);
 
       void resetUpToDate() override { updq = true; updu = true; updqd = true; updud = true; }
+      /**
+       * \brief reset all quantities which may depend on the generalized forces acting on the object
+       * (used if only inputs of the system have changed but not the state)
+       * The default implementation resets everything.
+       */
+      virtual void resetForcesUpToDate() { resetUpToDate(); }
 
       virtual void updateGeneralizedPositions();
       virtual void updateGeneralizedVelocities();
@@ -481,6 +481,16 @@ namespace MBSim {
     Z.resetGyroscopicAccelerationsUpToDate();
   }
 
+  void RigidBody::resetAccelerationsUpToDate() {
+    Body::resetAccelerationsUpToDate();
+    Z.resetAccelerationsUpToDate();
+  }
+
+  void RigidBody::resetForcesUpToDate() {
+    updud = true;
+    resetAccelerationsUpToDate();
+  }
+
   void RigidBody::resetUpToDate() {
     Body::resetUpToDate();
     Z.resetUpToDate();
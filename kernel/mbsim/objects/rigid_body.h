@@ -233,6 +233,8 @@ namespace MBSim {
       void resetVelocitiesUpToDate() override;
       void resetJacobiansUpToDate() override;
       void resetGyroscopicAccelerationsUpToDate() override;
+      void resetAccelerationsUpToDate() override;
+      void resetForcesUpToDate() override;
       const fmatvec::VecV& evalqTRel() { if(updq) updateGeneralizedPositions(); return qTRel; }
       const fmatvec::VecV& evalqRRel() { if(updq) updateGeneralizedPositions(); return qRRel; }
       const fmatvec::VecV& evaluTRel() { if(updu) updateGeneralizedVelocities(); return uTRel; }
@@ -0,0 +1,97 @@
+/* Copyright (C) 2004-2026 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h>
+#include "mbsim/utils/fork_utils.h"
+#include <iostream>
+#include <cstdio>
+#ifndef _WIN32
+#include <unistd.h>
+#include <dirent.h>
+#endif
+
+using namespace std;
+
+namespace MBSim {
+
+  namespace ForkUtils {
+
+    bool isAvailable() {
+#ifndef _WIN32
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    bool isSingleThreaded() {
+#ifndef _WIN32
+      DIR *dir = opendir("/proc/self/task");
+      if(!dir)
+        return false;
+      int n = 0;
+      while(auto *e = readdir(dir))
+        if(e->d_name[0]!='.')
+          n++;
+      closedir(dir);
+      return n==1;
+#else
+      return false;
+#endif
+    }
+
+    void flushBeforeFork() {
+      cout.flush();
+      cerr.flush();
+      fflush(nullptr);
+    }
+
+    bool writeAll(int fd, const char *p, size_t n) {
+#ifndef _WIN32
+      while(n>0) {
+        ssize_t w = write(fd, p, n);
+        if(w<=0)
+          return false;
+        p += w;
+        n -= w;
+      }
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    bool readAll(int fd, char *p, size_t n) {
+#ifndef _WIN32
+      while(n>0) {
+        ssize_t r = read(fd, p, n);
+        if(r<=0)
+          return false;
+        p += r;
+        n -= r;
+      }
+      return true;
+#else
+      return false;
+#endif
+    }
+
+  }
+
+}
@@ -0,0 +1,56 @@
+/* Copyright (C) 2004-2026 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _FORK_UTILS_H_
+#define _FORK_UTILS_H_
+
+#include <cstddef>
+
+namespace MBSim {
+
+  /*!
+   * \brief helpers for evaluations in forked processes, which are independent copies of the initialised system
+   *
+   * A forked process contains only the calling thread; if other threads exist (e.g. an OpenMP thread pool) locks held
+   * by them at the fork are never released in the child. Hence, only a single threaded process may be forked. The
+   * HDF5 and OpenMBV files of the system stay open in the child and must not be accessed there; the child terminates
+   * with _exit (no destructors, no flush of inherited HDF5 or stdio buffers).
+   */
+  namespace ForkUtils {
+
+    //! true if fork is available on this platform
+    bool isAvailable();
+
+    //! true if the process has exactly one thread; without /proc the process is assumed to be multi threaded
+    bool isSingleThreaded();
+
+    //! flush pending stdio output, such that it is not duplicated by the children
+    void flushBeforeFork();
+
+    //! write n bytes to the file descriptor fd; false on error
+    bool writeAll(int fd, const char *p, size_t n);
+
+    //! read n bytes from the file descriptor fd; false on error or end of file
+    bool readAll(int fd, char *p, size_t n);
+
+  }
+
+}
+
+#endif
@@ -46,6 +46,9 @@ namespace {
 
   void copyShLibToFMU(const std::shared_ptr<DOMParser> &parser,
                       CreateZip &fmuFile, const path &dst, const path &depdstdir, const path &src);
+
+  map<size_t, vector<size_t> > getDependencies(const vector<std::shared_ptr<Variable> > &var, DynamicSystemSolver *dss,
+                                               bool states);
 }
 
 int main(int argc, char *argv[]) {
@@ -87,10 +90,10 @@ int main(int argc, char *argv[]) {
 
     // help
     if(argc<2 || find(args.begin(), args.end(), "-h")!=args.end() || find(args.begin(), args.end(), "--help")!=args.end()) {
-      cout<<"Usage: "<<argv[0]<<" [-h|--help] [--nocompress] [--cosim] [--param <name> [--param <name> ...]]"<<endl;
+      cout<<"Usage: "<<argv[0]<<" [-h|--help] [--nocompress] [--cosim] [--fmi2] [--param <name> [--param <name> ...]]"<<endl;
       cout<<"  [-C <dir/file>|--CC] <MBSim Project XML File>|<MBSim FMI shared library>"<<endl;
       cout<<endl;
-      cout<<"Create Functional Mock-Up Unit (FMI/FMU 1.0)."<<endl;
+      cout<<"Create Functional Mock-Up Unit (FMI/FMU 1.0 or 2.0)."<<endl;
       cout<<"Creates mbsim.fmu in the current directory."<<endl;
       cout<<endl;
       cout<<"<MBSim Project XML File>    Create a FMU from XML project file"<<endl;
@@ -106,6 +109,8 @@ int main(int argc, char *argv[]) {
       cout<<"                            Only for XML project files."<<endl;
       cout<<"--nocompress                Zip FMU without compression."<<endl;
       cout<<"--cosim                     Generate a FMI for Cosimulation FMU instead of a FMI for Model-Exchange FMU."<<endl;
+      cout<<"--fmi2                      Generate a FMI 2.0 FMU instead of a FMI 1.0 FMU. Only FMI 2.0 FMUs provide the"<<endl;
+      cout<<"                            FMU state and directional derivative functions."<<endl;
       cout<<"-C <dir/file>               Change current to dir to <dir>/dir of <file> first."<<endl;
       cout<<"                            All arguments are still relative to the original current dir."<<endl;
       cout<<"--CC                        Change current dir to dir of <mbsimprjfile> first."<<endl;
@@ -156,6 +161,11 @@ int main(int argc, char *argv[]) {
       cosim=true;
       args.erase(i);
     }
+    bool fmi2=false;
+    if(auto i=std::find(args.begin(), args.end(), "--fmi2"); i!=args.end()) {
+      fmi2=true;
+      args.erase(i);
+    }
 
     // get model file
     if(args.size()!=1) {
@@ -313,6 +323,8 @@ int main(int argc, char *argv[]) {
     cout<<"Initialize the model."<<endl;
     dss->initialize();
 
+    // the FMU state of a cosim FMU includes the integrator snapshot, which not all integrators provide
+    bool canGetAndSetFMUstate=true;
     if(cosim) {
       try {
         integrator->setSystem(dss.get());
@@ -325,12 +337,27 @@ int main(int argc, char *argv[]) {
           ex.what()+"\n"+
           "The model may be wrong or this integrator cannot be used for cosim FMUs.");
       }
+      try {
+        integrator->getSnapshotSize();
+      }
+      catch(MBSimError &) {
+        canGetAndSetFMUstate=false;
+      }
     }
 
     // build list of value references
     cout<<"Create model input/output variables."<<endl;
     addModelInputOutputs(var, dss.get());
 
+    // dependencies of the outputs (and for FMI 2.0 ME of the state derivatives) on the inputs (and states)
+    cout<<"Detect dependencies of outputs on inputs."<<endl;
+    int nz=fmi2 && !cosim ? dss->getzSize() : 0;
+    if(!cosim) {
+      dss->evalz0();
+      dss->computeInitialCondition();
+    }
+    map<size_t, vector<size_t> > dependency=getDependencies(var, dss.get(), nz>0);
+
     // create DOM of modelDescription.xml
     std::shared_ptr<DOMDocument> modelDescDoc(parserNoneVali->createDocument());
 
@@ -340,21 +367,38 @@ int main(int argc, char *argv[]) {
     modelDescDoc->appendChild(modelDesc);
     E(modelDesc)->setAttribute("author", getenv(USERENVVAR.c_str()));
     E(modelDesc)->setAttribute("description", "FMI export of a MBSim-XML model");
-    E(modelDesc)->setAttribute("fmiVersion", "1.0");
+    E(modelDesc)->setAttribute("fmiVersion", fmi2?"2.0":"1.0");
     E(modelDesc)->setAttribute("generationDateAndTime",
       boost::posix_time::to_iso_extended_string(boost::posix_time::second_clock::local_time())+"Z");
     E(modelDesc)->setAttribute("generationTool", string("MBSimFMI Version ")+VERSION);
     E(modelDesc)->setAttribute("version", "1.0");
     E(modelDesc)->setAttribute("guid", "mbsimfmi_guid");
-    E(modelDesc)->setAttribute("modelIdentifier", "mbsim");
+    if(!fmi2)
+      E(modelDesc)->setAttribute("modelIdentifier", "mbsim");
     path desc=inputFilename.filename();
     desc.replace_extension();
     desc.replace_extension();
     E(modelDesc)->setAttribute("modelName", desc.string());
-    E(modelDesc)->setAttribute("numberOfContinuousStates", cosim?0:dss->getzSize());
+    if(!fmi2)
+      E(modelDesc)->setAttribute("numberOfContinuousStates", cosim?0:dss->getzSize());
     E(modelDesc)->setAttribute("numberOfEventIndicators", cosim?0:dss->getsvSize());
     E(modelDesc)->setAttribute("variableNamingConvention", "structured");
 
+      // FMI 2.0: ModelExchange or CoSimulation element with the capability flags
+      if(fmi2) {
+        DOMElement *fmuType=D(modelDescDoc)->createElement(cosim?"CoSimulation":"ModelExchange");
+        modelDesc->appendChild(fmuType);
+        E(fmuType)->setAttribute("modelIdentifier", "mbsim");
+        if(cosim) {
+          E(fmuType)->setAttribute("canHandleVariableCommunicationStepSize", true);
+          E(fmuType)->setAttribute("canInterpolateInputs", false);
+        }
+        E(fmuType)->setAttribute("canNotUseMemoryManagementFunctions", true);
+        E(fmuType)->setAttribute("canGetAndSetFMUstate", canGetAndSetFMUstate);
+        E(fmuType)->setAttribute("canSerializeFMUstate", canGetAndSetFMUstate);
+        E(fmuType)->setAttribute("providesDirectionalDerivative", true);
+      }
+
       // Type definition
       // get a unique list of all enumeration types
       set<Variable::EnumList> enumType;
@@ -362,20 +406,26 @@ int main(int argc, char *argv[]) {
         if(vr->getEnumerationList())
           enumType.insert(vr->getEnumerationList());
       // write all enumeration type to xml file
+      // (FMI 2.0 does not allow empty elements)
       DOMElement *typeDef=D(modelDescDoc)->createElement("TypeDefinitions");
-      modelDesc->appendChild(typeDef);
+      if(!fmi2 || !enumType.empty())
+        modelDesc->appendChild(typeDef);
         for(const auto & it : enumType) {
-          DOMElement *type=D(modelDescDoc)->createElement("Type");
+          DOMElement *type=D(modelDescDoc)->createElement(fmi2?"SimpleType":"Type");
           typeDef->appendChild(type);
           E(type)->setAttribute("name", "EnumType_"+boost::lexical_cast<string>(it));
-            DOMElement *enumEle=D(modelDescDoc)->createElement("EnumerationType");
+            DOMElement *enumEle=D(modelDescDoc)->createElement(fmi2?"Enumeration":"EnumerationType");
             type->appendChild(enumEle);
-            E(enumEle)->setAttribute("min", "1");
-            E(enumEle)->setAttribute("max", it->size());
+            if(!fmi2) {
+              E(enumEle)->setAttribute("min", "1");
+              E(enumEle)->setAttribute("max", it->size());
+            }
             for(size_t id=0; id<it->size(); ++id) {
               DOMElement *item=D(modelDescDoc)->createElement("Item");
               enumEle->appendChild(item);
               E(item)->setAttribute("name", (*it)[id].second);
+              if(fmi2)
+                E(item)->setAttribute("value", id+1);
               E(item)->setAttribute("description", (*it)[id].second);
             }
         }
@@ -423,25 +473,89 @@ int main(int argc, char *argv[]) {
           E(scalarVar)->setAttribute("valueReference", vr);
           switch(var[vr]->getType()) {
             case Parameter:
-              E(scalarVar)->setAttribute("causality", "internal");
-              E(scalarVar)->setAttribute("variability", "parameter");
+              E(scalarVar)->setAttribute("causality", fmi2?"parameter":"internal");
+              E(scalarVar)->setAttribute("variability", fmi2?"fixed":"parameter");
               E(varType)->setAttribute("start", var[vr]->getValueAsString());
-              E(varType)->setAttribute("fixed", "true");
+              if(!fmi2)
+                E(varType)->setAttribute("fixed", "true");
               break;
             case Input:
               E(scalarVar)->setAttribute("causality", "input");
               E(scalarVar)->setAttribute("variability", "continuous");
               E(varType)->setAttribute("start", var[vr]->getValueAsString());
-              E(varType)->setAttribute("fixed", "true");
+              if(!fmi2)
+                E(varType)->setAttribute("fixed", "true");
               break;
             case Output:
               E(scalarVar)->setAttribute("causality", "output");
               E(scalarVar)->setAttribute("variability", "continuous");
+              if(!fmi2 && dependency.find(vr)!=dependency.end()) {
+                DOMElement *directDep=D(modelDescDoc)->createElement("DirectDependency");
+                scalarVar->appendChild(directDep);
+                for(auto in : dependency[vr]) {
+                  DOMElement *name=D(modelDescDoc)->createElement("Name");
+                  directDep->appendChild(name);
+                  name->appendChild(modelDescDoc->createTextNode(X()%var[in]->getName()));
+                }
+              }
               break;
           }
         }
 
-      if(cosim) {
+        // FMI 2.0 ME: the states (value reference var.size()+i) and their derivatives (value reference
+        // var.size()+nz+i) are ScalarVariables too
+        for(int i=0; i<2*nz; ++i) {
+          DOMElement *scalarVar=D(modelDescDoc)->createElement("ScalarVariable");
+          modelVars->appendChild(scalarVar);
+            DOMElement *varType=D(modelDescDoc)->createElement("Real");
+            scalarVar->appendChild(varType);
+            if(i>=nz)
+              E(varType)->setAttribute("derivative", var.size()+i-nz+1); // 1-based index of the state
+          string name="z["+fmatvec::toString(i%nz+1)+"]";
+          E(scalarVar)->setAttribute("name", i<nz ? name : "der("+name+")");
+          E(scalarVar)->setAttribute("description", i<nz ? "MBSim state" : "Derivative of the MBSim state");
+          E(scalarVar)->setAttribute("valueReference", var.size()+i);
+          E(scalarVar)->setAttribute("causality", "local");
+          E(scalarVar)->setAttribute("variability", "continuous");
+          E(scalarVar)->setAttribute("initial", "calculated");
+        }
+
+      // FMI 2.0: ModelStructure element (1-based ScalarVariable index = value reference + 1)
+      if(fmi2) {
+        DOMElement *modelStructure=D(modelDescDoc)->createElement("ModelStructure");
+        modelDesc->appendChild(modelStructure);
+          // add a Unknown element to the child parentName of ModelStructure (empty elements are not allowed)
+          // the dependencies are only known for Outputs and Derivatives; no dependencies attribute means depending on all
+          auto addUnknown=[&modelDescDoc, modelStructure, &dependency](const string &parentName, size_t vr, bool withDep) {
+            DOMElement *parent=E(modelStructure)->getFirstElementChildNamed(parentName);
+            if(!parent) {
+              parent=D(modelDescDoc)->createElement(parentName);
+              modelStructure->appendChild(parent);
+            }
+            DOMElement *unknown=D(modelDescDoc)->createElement("Unknown");
+            parent->appendChild(unknown);
+            E(unknown)->setAttribute("index", vr+1);
+            auto dep=dependency.find(vr);
+            if(withDep && dep!=dependency.end()) {
+              string indices;
+              for(auto known : dep->second)
+                indices+=(indices.empty()?"":" ")+fmatvec::toString(known+1);
+              E(unknown)->setAttribute("dependencies", indices);
+            }
+          };
+          for(size_t vr=0; vr<var.size(); ++vr)
+            if(var[vr]->getType()==Output)
+              addUnknown("Outputs", vr, true);
+          for(int i=0; i<nz; ++i)
+            addUnknown("Derivatives", var.size()+nz+i, true);
+          for(size_t vr=0; vr<var.size(); ++vr)
+            if(var[vr]->getType()==Output)
+              addUnknown("InitialUnknowns", vr, false);
+          for(int i=0; i<2*nz; ++i)
+            addUnknown("InitialUnknowns", var.size()+i, false);
+      }
+
+      if(cosim && !fmi2) {
         // Implementation element
         DOMElement *implementation=D(modelDescDoc)->createElement("Implementation");
         modelDesc->appendChild(implementation);
@@ -551,7 +665,7 @@ int main(int argc, char *argv[]) {
     }
 
     cout<<"Copy MBSim FMI wrapper library and dependencies to FMU."<<endl;
-    string fmuLibName(cosim?"mbsim_cosim":"mbsim_me");
+    string fmuLibName(fmi2?"mbsim_fmi2":cosim?"mbsim_cosim":"mbsim_me");
     copyShLibToFMU(parserNoneVali, fmuFile, path("binaries")/FMIOS/("mbsim"+SHEXT), path("binaries")/FMIOS,
                    installPath/"lib"/(fmuLibName+SHEXT));
     cout<<endl;
@@ -627,4 +741,84 @@ namespace {
     }
   }
 
+
+  // Detect on which real inputs (and states if states is true) the real outputs (and state derivatives if states is
+  // true) depend by disturbing each of these known variables. Variables are identified by their value reference: the
+  // states and derivatives have the value references var.size()+i and var.size()+nz+i. The model has no structural
+  // information about the dependencies, hence each known variable is disturbed at two points: the initial point and a
+  // point where all known variables are disturbed. A dependency which vanishes by chance at one of these points is still
+  // detected. Unknown variables which are not real outputs or derivatives are not contained in the returned map.
+  map<size_t, vector<size_t> > getDependencies(const vector<std::shared_ptr<Variable> > &var, DynamicSystemSolver *dss,
+                                               bool states) {
+    size_t nz=states ? dss->getzSize() : 0;
+    vector<size_t> in, out;
+    for(size_t vr=0; vr<var.size(); ++vr) {
+      if(var[vr]->getDatatypeChar()!='r')
+        continue;
+      if(var[vr]->getType()==Input)
+        in.push_back(vr);
+      else if(var[vr]->getType()==Output)
+        out.push_back(vr);
+    }
+    for(size_t i=0; i<nz; ++i) {
+      in.push_back(var.size()+i);
+      out.push_back(var.size()+nz+i);
+    }
+
+    map<size_t, vector<size_t> > dep;
+    if(out.empty())
+      return dep;
+    auto getKnown=[&var, dss](size_t vr) {
+      return vr<var.size() ? var[vr]->getValue(double()) : dss->getState()(vr-var.size());
+    };
+    auto setKnown=[&var, dss](size_t vr, double v) {
+      if(vr<var.size())
+        var[vr]->setValue(v);
+      else
+        dss->getState()(vr-var.size())=v;
+      dss->resetUpToDate();
+    };
+    auto getUnknown=[&var, dss, nz](size_t vr) {
+      return vr<var.size() ? var[vr]->getValue(double()) : dss->evalzd()(vr-var.size()-nz);
+    };
+
+    vector<double> x0(in.size()), y0(out.size());
+    for(size_t i=0; i<in.size(); ++i)
+      x0[i]=getKnown(in[i]);
+    vector<vector<bool> > depends(out.size(), vector<bool>(in.size(), false));
+    for(int point=0; point<2; ++point) {
+      // the second point: all known variables disturbed (alternating sign)
+      for(size_t i=0; i<in.size(); ++i)
+        setKnown(in[i], x0[i]+(point==0 ? 0 : (i%2==0 ? 1 : -1)*0.1*(1+fabs(x0[i]))));
+      try {
+        for(size_t j=0; j<out.size(); ++j)
+          y0[j]=getUnknown(out[j]);
+        for(size_t i=0; i<in.size(); ++i) {
+          double xi=getKnown(in[i]);
+          setKnown(in[i], xi+1e-3*(1+fabs(xi)));
+          for(size_t j=0; j<out.size(); ++j)
+            if(getUnknown(out[j])!=y0[j])
+              depends[j][i]=true;
+          setKnown(in[i], xi);
+        }
+      }
+      catch(const exception &ex) {
+        if(point==0)
+          throw;
+        fmatvec::Atom::msgStatic(fmatvec::Atom::Warn)<<"The model cannot be evaluated at the disturbed point, the dependencies "
+          "are only detected at the initial point:"<<endl<<ex.what()<<endl;
+      }
+    }
+    for(size_t i=0; i<in.size(); ++i)
+      setKnown(in[i], x0[i]);
+
+    for(size_t j=0; j<out.size(); ++j) {
+      auto &d=dep[out[j]];
+      for(size_t i=0; i<in.size(); ++i)
+        if(depends[j][i])
+          d.push_back(in[i]);
+    }
+    return dep;
+  }
+
 }
@@ -0,0 +1,352 @@
+// includes
+#include "config.h"
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <utility>
+#include <mbxmlutilshelper/shared_library.h>
+
+#define BOOST_ERROR_CODE_HEADER_ONLY
+#include <mbxmlutilshelper/thislinelocation.h>
+
+// include the fmi header
+#define MODEL_IDENTIFIER mbsim
+#include <fmiinstancebase.h> // this includes the FMI 1.0 headers used by FMIInstanceBase
+extern "C" {
+  #include <3rdparty/fmi2Functions.h>
+}
+
+#define DLLEXPORT __attribute__((visibility("default")))
+
+// use namespaces
+using namespace std;
+using namespace MBSimFMI;
+using namespace MBXMLUtils;
+
+// FMI 2.0 wrapper for ME and cosim FMUs: maps the fmi2* functions to the (FMI 1.0 based) FMIInstanceBase interface.
+// The FMI 1.0 and FMI 2.0 datatypes are identical except fmiBoolean (char) and fmi2Boolean (int).
+
+namespace {
+  ThisLineLocation fmuWrapperLoc;
+
+  // some platform dependent values
+#ifdef _WIN32
+  string SHEXT(".dll");
+  string LIBDIR="bin";
+#else
+  string SHEXT(".so");
+  string LIBDIR="lib";
+#endif
+
+  // FMI instance struct of mbsim.so: hold the real instance and the FMI 2.0 callbacks
+  struct Instance {
+    Instance(bool cosim_, string instanceName_, const fmi2CallbackFunctions *functions_) :
+      cosim(cosim_), instanceName(std::move(instanceName_)), functions(*functions_) {}
+    bool cosim;
+    string instanceName;
+    fmi2CallbackFunctions functions;
+    std::shared_ptr<FMIInstanceBase> instance;
+    // fmi2SetupExperiment arguments, used by fmi2EnterInitializationMode
+    bool toleranceDefined { false };
+    double tolerance { 0 };
+    double startTime { 0 };
+    bool stopTimeDefined { false };
+    double stopTime { 0 };
+  };
+
+  // FMI 1.0 logger called by FMIInstanceBase: c is the Instance (see fmiInstanceCreate)
+  void logger(fmiComponent c, fmiString instanceName, fmiStatus status, fmiString category, fmiString message, ...) {
+    auto *inst=static_cast<Instance*>(c);
+    inst->functions.logger(inst->functions.componentEnvironment, instanceName, static_cast<fmi2Status>(status), category,
+                           "%s", message);
+  }
+
+  vector<fmiBoolean> toFMI1Boolean(const fmi2Boolean value[], size_t n) {
+    vector<fmiBoolean> ret(n);
+    for(size_t i=0; i<n; ++i)
+      ret[i]=value[i] ? fmiTrue : fmiFalse;
+    return ret;
+  }
+}
+
+// define all FMI function as C functions
+extern "C" {
+
+  // global FMI function.
+  DLLEXPORT const char* fmi2GetTypesPlatform() {
+    return fmi2TypesPlatform;
+  }
+
+  // global FMI function.
+  DLLEXPORT const char* fmi2GetVersion() {
+    return fmi2Version;
+  }
+
+  // FMI instantiate function: just calls the FMIInstanceBase ctor
+  // Convert exceptions to FMI logger calls and return no instance.
+  DLLEXPORT fmi2Component fmi2Instantiate(fmi2String instanceName_, fmi2Type fmuType, fmi2String GUID,
+                                          fmi2String fmuResourceLocation, const fmi2CallbackFunctions *functions,
+                                          fmi2Boolean visible, fmi2Boolean loggingOn) {
+    Instance *inst=nullptr;
+    try {
+      inst=new Instance(fmuType==fmi2CoSimulation, instanceName_, functions);
+      string fmuDir=fmuWrapperLoc();
+      size_t s=string::npos;
+      // replace /./ with /
+      while((s=fmuDir.find("/./"))!=string::npos)
+        fmuDir.replace(s, 3, "/");
+      while((s=fmuDir.find("\\.\\"))!=string::npos)
+        fmuDir.replace(s, 3, "/");
+      while((s=fmuDir.find("\\./"))!=string::npos)
+        fmuDir.replace(s, 3, "/");
+      while((s=fmuDir.find("/.\\"))!=string::npos)
+        fmuDir.replace(s, 3, "/");
+      // remove trailing /binaries/<os>/mbism.so
+      for(int i=0; i<3; ++i)
+        s=fmuDir.find_last_of("/\\", s)-1;
+      // load main mbsim FMU library
+      auto fmiInstanceCreate=SharedLibrary::getSymbol<fmiInstanceCreatePtr>(
+        fmuDir.substr(0, s+1)+"/resources/local/"+LIBDIR+"/libmbsimXXX_fmi"+SHEXT, "fmiInstanceCreate");
+      inst->instance=fmiInstanceCreate(inst->cosim, instanceName_, GUID, &logger, inst, loggingOn ? fmiTrue : fmiFalse);
+      return inst;
+    }
+    // note: we can not use the instance here since the creation has failed
+    catch(const exception &ex) {
+      delete inst;
+      functions->logger(functions->componentEnvironment, instanceName_, fmi2Error, "error", "%s", ex.what());
+      return nullptr;
+    }
+    catch(...) {
+      delete inst;
+      functions->logger(functions->componentEnvironment, instanceName_, fmi2Error, "error", "Unknown error");
+      return nullptr;
+    }
+  }
+
+  // FMI free instance function: just calls the FMIInstanceBase dtor.
+  // No exception handling needed since the dtor must not throw.
+  DLLEXPORT void fmi2FreeInstance(fmi2Component c) {
+    // must not throw
+    delete static_cast<Instance*>(c);
+  }
+
+  // All other FMI functions: just execute code using the Instance inst and its FMIInstanceBase instance.
+  // Convert exceptions to call of logError which itself passed these to the FMI logge and return with fmi2Error.
+  #define FMI2FUNC(fmiFuncName, Sig, code) \
+  DLLEXPORT fmi2Status fmiFuncName Sig { \
+    auto *inst=static_cast<Instance*>(c); \
+    std::shared_ptr<FMIInstanceBase> instance=inst->instance; \
+    try { \
+      code; \
+      return fmi2OK; \
+    } \
+    catch(const exception &ex) { \
+      instance->logException(ex); \
+      return fmi2Error; \
+    } \
+    catch(...) { \
+      instance->logException(runtime_error("Unknwon error")); \
+      return fmi2Error; \
+    } \
+  }
+
+  // All other FMI function (see above macro)
+  FMI2FUNC(fmi2SetDebugLogging,
+    (fmi2Component c, fmi2Boolean loggingOn, size_t nCategories, const fmi2String categories[]),
+    instance->setDebugLogging(loggingOn ? fmiTrue : fmiFalse))
+
+  FMI2FUNC(fmi2SetupExperiment,
+    (fmi2Component c, fmi2Boolean toleranceDefined, fmi2Real tolerance, fmi2Real startTime, fmi2Boolean stopTimeDefined,
+     fmi2Real stopTime),
+    inst->toleranceDefined=toleranceDefined;
+    inst->tolerance=tolerance;
+    inst->startTime=startTime;
+    inst->stopTimeDefined=stopTimeDefined;
+    inst->stopTime=stopTime)
+
+  // the model is created and initialized here: all parameters must be set before
+  FMI2FUNC(fmi2EnterInitializationMode,
+    (fmi2Component c),
+    if(inst->cosim)
+      instance->initialize_cosim(inst->startTime, inst->stopTimeDefined ? fmiTrue : fmiFalse, inst->stopTime);
+    else {
+      instance->setTime(inst->startTime);
+      fmiEventInfo eventInfo;
+      instance->initialize_me(inst->toleranceDefined ? fmiTrue : fmiFalse, inst->tolerance, &eventInfo);
+    })
+
+  FMI2FUNC(fmi2ExitInitializationMode,
+    (fmi2Component c),
+    )
+
+  FMI2FUNC(fmi2Terminate,
+    (fmi2Component c),
+    instance->terminate())
+
+  FMI2FUNC(fmi2Reset,
+    (fmi2Component c),
+    if(!inst->cosim)
+      throw runtime_error("fmi2Reset is not supported for model exchange FMUs: free and instantiate the FMU again.");
+    instance->resetSlave())
+
+  FMI2FUNC(fmi2GetReal,
+    (fmi2Component c, const fmi2ValueReference vr[], size_t nvr, fmi2Real value[]),
+    instance->getDoubleValue(vr, nvr, value))
+
+  FMI2FUNC(fmi2GetInteger,
+    (fmi2Component c, const fmi2ValueReference vr[], size_t nvr, fmi2Integer value[]),
+    instance->getIntValue(vr, nvr, value))
+
+  FMI2FUNC(fmi2GetBoolean,
+    (fmi2Component c, const fmi2ValueReference vr[], size_t nvr, fmi2Boolean value[]),
+    vector<fmiBoolean> v(nvr);
+    instance->getBoolValue(vr, nvr, v.data());
+    for(size_t i=0; i<nvr; ++i)
+      value[i]=v[i] ? fmi2True : fmi2False)
+
+  FMI2FUNC(fmi2GetString,
+    (fmi2Component c, const fmi2ValueReference vr[], size_t nvr, fmi2String value[]),
+    instance->getStringValue(vr, nvr, value))
+
+  FMI2FUNC(fmi2SetReal,
+    (fmi2Component c, const fmi2ValueReference vr[], size_t nvr, const fmi2Real value[]),
+    instance->setDoubleValue(vr, nvr, value))
+
+  FMI2FUNC(fmi2SetInteger,
+    (fmi2Component c, const fmi2ValueReference vr[], size_t nvr, const fmi2Integer value[]),
+    instance->setIntValue(vr, nvr, value))
+
+  FMI2FUNC(fmi2SetBoolean,
+    (fmi2Component c, const fmi2ValueReference vr[], size_t nvr, const fmi2Boolean value[]),
+    instance->setBoolValue(vr, nvr, toFMI1Boolean(value, nvr).data()))
+
+  FMI2FUNC(fmi2SetString,
+    (fmi2Component c, const fmi2ValueReference vr[], size_t nvr, const fmi2String value[]),
+    instance->setStringValue(vr, nvr, value))
+
+  FMI2FUNC(fmi2GetFMUstate,
+    (fmi2Component c, fmi2FMUstate* FMUstate),
+    instance->getFMUstate(FMUstate))
+
+  FMI2FUNC(fmi2SetFMUstate,
+    (fmi2Component c, fmi2FMUstate FMUstate),
+    instance->setFMUstate(FMUstate))
+
+  FMI2FUNC(fmi2FreeFMUstate,
+    (fmi2Component c, fmi2FMUstate* FMUstate),
+    instance->freeFMUstate(FMUstate))
+
+  FMI2FUNC(fmi2SerializedFMUstateSize,
+    (fmi2Component c, fmi2FMUstate FMUstate, size_t *size),
+    instance->serializedFMUstateSize(FMUstate, size))
+
+  FMI2FUNC(fmi2SerializeFMUstate,
+    (fmi2Component c, fmi2FMUstate FMUstate, fmi2Byte serializedState[], size_t size),
+    instance->serializeFMUstate(FMUstate, serializedState, size))
+
+  FMI2FUNC(fmi2DeSerializeFMUstate,
+    (fmi2Component c, const fmi2Byte serializedState[], size_t size, fmi2FMUstate* FMUstate),
+    instance->deSerializeFMUstate(serializedState, size, FMUstate))
+
+  FMI2FUNC(fmi2GetDirectionalDerivative,
+    (fmi2Component c, const fmi2ValueReference vUnknown_ref[], size_t nUnknown, const fmi2ValueReference vKnown_ref[],
+     size_t nKnown, const fmi2Real dvKnown[], fmi2Real dvUnknown[]),
+    instance->getDirectionalDerivative(vUnknown_ref, nUnknown, vKnown_ref, nKnown, dvKnown, dvUnknown))
+
+  /* me special functions */
+
+  FMI2FUNC(fmi2EnterEventMode,
+    (fmi2Component c),
+    )
+
+  FMI2FUNC(fmi2NewDiscreteStates,
+    (fmi2Component c, fmi2EventInfo *fmi2eventInfo),
+    fmiEventInfo eventInfo;
+    instance->eventUpdate(fmiFalse, &eventInfo);
+    fmi2eventInfo->newDiscreteStatesNeeded=!eventInfo.iterationConverged;
+    fmi2eventInfo->terminateSimulation=eventInfo.terminateSimulation;
+    fmi2eventInfo->nominalsOfContinuousStatesChanged=fmi2False;
+    fmi2eventInfo->valuesOfContinuousStatesChanged=eventInfo.stateValuesChanged;
+    fmi2eventInfo->nextEventTimeDefined=eventInfo.upcomingTimeEvent;
+    fmi2eventInfo->nextEventTime=eventInfo.nextEventTime)
+
+  FMI2FUNC(fmi2EnterContinuousTimeMode,
+    (fmi2Component c),
+    )
+
+  FMI2FUNC(fmi2CompletedIntegratorStep,
+    (fmi2Component c, fmi2Boolean noSetFMUStatePriorToCurrentPoint, fmi2Boolean *enterEventMode,
+     fmi2Boolean *terminateSimulation),
+    fmiBoolean callEventUpdate;
+    instance->completedIntegratorStep(&callEventUpdate);
+    *enterEventMode=callEventUpdate ? fmi2True : fmi2False;
+    *terminateSimulation=fmi2False)
+
+  FMI2FUNC(fmi2SetTime,
+    (fmi2Component c, fmi2Real time),
+    instance->setTime(time))
+
+  FMI2FUNC(fmi2SetContinuousStates,
+    (fmi2Component c, const fmi2Real x[], size_t nx),
+    instance->setContinuousStates(x, nx))
+
+  FMI2FUNC(fmi2GetDerivatives,
+    (fmi2Component c, fmi2Real derivatives[], size_t nx),
+    instance->getDerivatives(derivatives, nx))
+
+  FMI2FUNC(fmi2GetEventIndicators,
+    (fmi2Component c, fmi2Real eventIndicators[], size_t ni),
+    instance->getEventIndicators(eventIndicators, ni))
+
+  FMI2FUNC(fmi2GetContinuousStates,
+    (fmi2Component c, fmi2Real x[], size_t nx),
+    instance->getContinuousStates(x, nx))
+
+  FMI2FUNC(fmi2GetNominalsOfContinuousStates,
+    (fmi2Component c, fmi2Real x_nominal[], size_t nx),
+    instance->getNominalContinuousStates(x_nominal, nx))
+
+  /* cosim special functions */
+
+  FMI2FUNC(fmi2SetRealInputDerivatives,
+    (fmi2Component c, const fmi2ValueReference vr[], size_t nvr, const fmi2Integer order[], const fmi2Real value[]),
+    instance->setRealInputDerivatives(vr, nvr, order, value))
+
+  FMI2FUNC(fmi2GetRealOutputDerivatives,
+    (fmi2Component c, const fmi2ValueReference vr[], size_t nvr, const fmi2Integer order[], fmi2Real value[]),
+    instance->getRealOutputDerivatives(vr, nvr, order, value))
+
+  FMI2FUNC(fmi2DoStep,
+    (fmi2Component c, fmi2Real currentCommunicationPoint, fmi2Real communicationStepSize,
+     fmi2Boolean noSetFMUStatePriorToCurrentPoint),
+    instance->doStep(currentCommunicationPoint, communicationStepSize, fmiTrue))
+
+  FMI2FUNC(fmi2CancelStep,
+    (fmi2Component c),
+    instance->cancelStep())
+
+  FMI2FUNC(fmi2GetStatus,
+    (fmi2Component c, const fmi2StatusKind s, fmi2Status* value),
+    fmiStatus v;
+    instance->getStatus(static_cast<fmiStatusKind>(s), &v);
+    *value=static_cast<fmi2Status>(v))
+
+  FMI2FUNC(fmi2GetRealStatus,
+    (fmi2Component c, const fmi2StatusKind s, fmi2Real* value),
+    instance->getDoubleStatus(static_cast<fmiStatusKind>(s), value))
+
+  FMI2FUNC(fmi2GetIntegerStatus,
+    (fmi2Component c, const fmi2StatusKind s, fmi2Integer* value),
+    instance->getIntStatus(static_cast<fmiStatusKind>(s), value))
+
+  FMI2FUNC(fmi2GetBooleanStatus,
+    (fmi2Component c, const fmi2StatusKind s, fmi2Boolean* value),
+    fmiBoolean v;
+    instance->getBoolStatus(static_cast<fmiStatusKind>(s), &v);
+    *value=v ? fmi2True : fmi2False)
+
+  FMI2FUNC(fmi2GetStringStatus,
+    (fmi2Component c, const fmi2StatusKind s, fmi2String* value),
+    instance->getStringStatus(static_cast<fmiStatusKind>(s), value))
+
+}
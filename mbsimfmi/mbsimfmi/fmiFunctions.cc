@@ -74,7 +74,7 @@ extern "C" {
       // load main mbsim FMU library
       auto fmiInstanceCreate=SharedLibrary::getSymbol<fmiInstanceCreatePtr>(
         fmuDir.substr(0, s+1)+"/resources/local/"+LIBDIR+"/libmbsimXXX_fmi"+SHEXT, "fmiInstanceCreate");
-      return new Instance(fmiInstanceCreate(true, instanceName_, GUID, functions.logger, loggingOn));
+      return new Instance(fmiInstanceCreate(true, instanceName_, GUID, functions.logger, nullptr, loggingOn));
     }
     // note: we can not use the instance here since the creation has failed
     catch(const exception &ex) {
@@ -8,6 +8,8 @@
 #include <mbsim/dynamic_system_solver.h>
 #include <mbsim/integrators/integrator.h>
 #include <mbxmlutilshelper/thislinelocation.h>
+#include <cstring>
+#include <algorithm>
 
 // rethrow a catched exception after prefixing the what() string with the FMI variable name
 #define RETHROW_VR(vr) \
@@ -28,10 +30,12 @@ namespace {
 
   template<class Datatype>
   void addPreInitVariable(const xercesc::DOMElement *scalarVar, vector<shared_ptr<MBSimFMI::Variable> > &var) {
-    // get type
+    // get type (FMI 1.0 and FMI 2.0 causality/variability)
     MBSimFMI::Type type;
     if     (E(scalarVar)->getAttribute("causality")=="internal" && E(scalarVar)->getAttribute("variability")=="parameter")
       type=MBSimFMI::Parameter;
+    else if(E(scalarVar)->getAttribute("causality")=="parameter")
+      type=MBSimFMI::Parameter;
     else if(E(scalarVar)->getAttribute("causality")=="input"    && E(scalarVar)->getAttribute("variability")=="continuous")
       type=MBSimFMI::Input;
     else if(E(scalarVar)->getAttribute("causality")=="output"   && E(scalarVar)->getAttribute("variability")=="continuous")
@@ -46,6 +50,14 @@ namespace {
     var.push_back(make_shared<MBSimFMI::VariableStore<Datatype> >(E(scalarVar)->getAttribute("name"), type, defaultValue));
   }
 
+  // fixed size part of a FMU state
+  struct FMUStateHeader {
+    size_t size; // size of the complete FMU state (used to check deserialized states)
+    int driftCompensation;
+    int completedStepCounter;
+    double nextPlotTime;
+  };
+
 }
 
 namespace MBSimFMI {
@@ -53,15 +65,17 @@ namespace MBSimFMI {
   ThisLineLocation fmuLoc;
 
   shared_ptr<FMIInstanceBase> fmiInstanceCreate(bool cosim, fmiString instanceName_, fmiString GUID,
-                                                fmiCallbackLogger logger, fmiBoolean loggingOn) {
-    return shared_ptr<FMIInstance>(new FMIInstance(cosim, instanceName_, GUID, logger, loggingOn));
+                                                fmiCallbackLogger logger, fmiComponent loggerComponent, fmiBoolean loggingOn) {
+    return shared_ptr<FMIInstance>(new FMIInstance(cosim, instanceName_, GUID, logger, loggerComponent, loggingOn));
   }
 
   // A MBSim FMI instance. Called by fmiInstantiateModel
-  FMIInstance::FMIInstance(bool cosim_, fmiString instanceName_, fmiString GUID, fmiCallbackLogger logger_, fmiBoolean loggingOn) :
+  FMIInstance::FMIInstance(bool cosim_, fmiString instanceName_, fmiString GUID, fmiCallbackLogger logger_,
+                           fmiComponent loggerComponent_, fmiBoolean loggingOn) :
     cosim(cosim_),
     instanceName(instanceName_),
     logger(logger_),
+    loggerComponent(loggerComponent_ ? loggerComponent_ : this),
     time(timeStore),
     z(zStore) {
     // if MBXMLUTILS_ERROROUTPUT is not set, set it to GCCNONE
@@ -75,7 +89,7 @@ namespace MBSimFMI {
 
     // use the per FMIInstance provided buffers for all subsequent fmatvec::Atom objects
     auto f=[this](const string &s, fmiStatus status, const string &category){
-      logger(this, instanceName.c_str(), status, category.c_str(), s.c_str());
+      logger(loggerComponent, instanceName.c_str(), status, category.c_str(), s.c_str());
     };
     fmatvec::Atom::setCurrentMessageStream(fmatvec::Atom:: Info,       make_shared<bool>(true ),
       make_shared<fmatvec::PrePostfixedStream>("", "", [f](auto && msg) { return f(msg, fmiOK, "info"); }));
@@ -108,9 +122,19 @@ namespace MBSimFMI {
       "modelDescription.xml";
     shared_ptr<xercesc::DOMDocument> doc=parser->parse(modelDescriptionXMLFile, nullptr, false);
 
+    bool fmi2=E(doc->getDocumentElement())->getAttribute("fmiVersion")=="2.0";
     if(!cosim) {
       // init state vector size (just to be usable before initialize is called)
-      z.get().resize(boost::lexical_cast<size_t>(E(doc->getDocumentElement())->getAttribute("numberOfContinuousStates")));
+      size_t nz=0;
+      if(fmi2) {
+        // FMI 2.0 has no numberOfContinuousStates: count the derivatives in ModelStructure
+        auto *der=E(E(doc->getDocumentElement())->getFirstElementChildNamed("ModelStructure"))->getFirstElementChildNamed("Derivatives");
+        for(auto *u=der ? der->getFirstElementChild() : nullptr; u; u=u->getNextElementSibling())
+          ++nz;
+      }
+      else
+        nz=boost::lexical_cast<size_t>(E(doc->getDocumentElement())->getAttribute("numberOfContinuousStates"));
+      z.get().resize(nz);
       svLast.resize(boost::lexical_cast<size_t>(E(doc->getDocumentElement())->getAttribute("numberOfEventIndicators")));
     }
 
@@ -125,6 +149,9 @@ namespace MBSimFMI {
       // skip all predefined parameters which are already added by addPredefinedParameters above
       if(vr<numPredefParam)
         continue;
+      // skip the states and derivatives of a FMI 2.0 ME FMU: these are not FMI variables of the model
+      if(fmi2 && E(scalarVar)->getAttribute("causality")=="local")
+        break;
 
       // now add all other parameters
       msg(Debug)<<"Generate variable '"<<E(scalarVar)->getAttribute("name")<<"'"<<endl;
@@ -162,13 +189,20 @@ namespace MBSimFMI {
   // set a real/integer/boolean/string variable
   template<typename CppDatatype, typename FMIDatatype>
   void FMIInstance::setValue(const fmiValueReference vr[], size_t nvr, const FMIDatatype value[]) {
+    bool inputsOnly=true;
     for(size_t i=0; i<nvr; ++i) {
       if(vr[i]>=var.size())
         throw runtime_error("No such value reference "+fmatvec::toString(vr[i]));
       try { var[vr[i]]->setValue(CppDatatype(value[i])); } RETHROW_VR(vr[i])
+      inputsOnly=inputsOnly && var[vr[i]]->getType()==Input;
+    }
+    if(dss) {
+      // inputs do not change the state: keep the state dependent quantities (kinematics, mass matrix, ...)
+      if(inputsOnly)
+        dss->resetForcesUpToDate();
+      else
+        dss->resetUpToDate();
     }
-    if(dss)
-      dss->resetUpToDate();
   }
   // explicitly instantiate all four FMI types
   template void FMIInstance::setValue<double, fmiReal   >(const fmiValueReference vr[], size_t nvr, const fmiReal    value[]);
@@ -194,6 +228,23 @@ namespace MBSimFMI {
       try { value[i]=cppDatatypeToFMIDatatype<FMIDatatype, CppDatatype>(var[vr[i]]->getValue(CppDatatype())); } RETHROW_VR(vr[i])
     }
   }
+  // get a real variable; the value references var.size()+i and var.size()+nz+i are the state i and its derivative (ME)
+  void FMIInstance::getDoubleValue(const fmiValueReference vr[], size_t nvr, fmiReal value[]) {
+    size_t nz=cosim ? 0 : z.get().size();
+    for(size_t i=0; i<nvr; ++i) {
+      if(vr[i]<var.size())
+        getValue<double>(&vr[i], 1, &value[i]);
+      else if(vr[i]<var.size()+nz)
+        value[i]=z.get()(vr[i]-var.size());
+      else if(vr[i]<var.size()+2*nz) {
+        if(!dss)
+          throw runtime_error("The derivative of state "+fmatvec::toString(vr[i]-var.size()-nz)+" is only available after the initialization of the FMU.");
+        value[i]=dss->evalzd()(vr[i]-var.size()-nz);
+      }
+      else
+        throw runtime_error("No such value reference "+fmatvec::toString(vr[i]));
+    }
+  }
   // explicitly instantiate all four FMI types
   template void FMIInstance::getValue<double, fmiReal   >(const fmiValueReference vr[], size_t nvr, fmiReal value[]);
   template void FMIInstance::getValue<int,    fmiInteger>(const fmiValueReference vr[], size_t nvr, fmiInteger value[]);
@@ -217,13 +268,14 @@ namespace MBSimFMI {
     time=std::ref(timeStore);
     z=std::ref(zStore); // only used for ME
     dss.reset();
+    fmuStateSize=0;
   }
 
   // FMI helper functions
 
   // print exceptions using the FMI logger
   void FMIInstance::logException(const std::exception &ex) {
-    logger(this, instanceName.c_str(), fmiError, "error", ex.what());
+    logger(loggerComponent, instanceName.c_str(), fmiError, "error", ex.what());
   }
 
   // rethrow a exception thrown during a operation on a valueReference: prefix the exception text with the variable name.
@@ -333,6 +385,13 @@ namespace MBSimFMI {
     // var is now no longer needed since we use varSim now.
     var=varSim;
 
+    // the inputs are part of a FMU state
+    inputVR.clear();
+    for(size_t i=0; i<var.size(); ++i)
+      if(var[i]->getType()==Input)
+        inputVR.push_back(i);
+    fmuStateSize=0;
+
     // initialize state
     msg(Debug)<<"Initialize initial conditions of the DynamicSystemSolver."<<endl;
     dss->evalz0();
@@ -593,6 +652,7 @@ namespace MBSimFMI {
     time=std::ref(timeStore);
     z=std::ref(zStore); // only used for ME
     dss.reset();
+    fmuStateSize=0;
   }
 
   void FMIInstance::setRealInputDerivatives(const fmiValueReference vr[], size_t nvr, const fmiInteger order[], const fmiReal value[]) {
@@ -652,4 +712,184 @@ namespace MBSimFMI {
     throw std::runtime_error("This call is not allowed according the capability flags of this FMU.");
   }
 
+
+
+
+  /* fmu state functions */
+
+  void FMIInstance::initFMUStateSize() {
+    if(fmuStateSize>0)
+      return;
+    if(!dss)
+      throw runtime_error("A FMU state is only available after the initialization of the FMU.");
+    fmuStateSize=sizeof(FMUStateHeader)+(inputVR.size()+svLast.size())*sizeof(double)+dss->getSnapshotSize();
+    if(cosim)
+      fmuStateSize+=integrator->getSnapshotSize();
+  }
+
+  void FMIInstance::getFMUstate(fmiFMUstate* state) {
+    initFMUStateSize();
+    // reuse the given state: no allocation on repeated calls
+    auto *s=static_cast<FMUState*>(*state);
+    if(!s)
+      s=new FMUState;
+    s->data.resize(fmuStateSize);
+    char *p=s->data.data();
+
+    FMUStateHeader h;
+    h.size=fmuStateSize;
+    h.driftCompensation=driftCompensation;
+    h.completedStepCounter=completedStepCounter;
+    h.nextPlotTime=nextPlotTime;
+    memcpy(p, &h, sizeof(h));
+    p+=sizeof(h);
+    for(auto vr : inputVR) {
+      memcpy(p, &var[vr]->getValue(double()), sizeof(double));
+      p+=sizeof(double);
+    }
+    if(svLast.size()>0)
+      memcpy(p, &svLast(0), svLast.size()*sizeof(double));
+    p+=svLast.size()*sizeof(double);
+    dss->getSnapshot(p);
+    p+=dss->getSnapshotSize();
+    if(cosim)
+      integrator->getSnapshot(p);
+
+    *state=s;
+  }
+
+  void FMIInstance::setFMUstate(fmiFMUstate state) {
+    initFMUStateSize();
+    auto *s=static_cast<FMUState*>(state);
+    if(!s || s->data.size()!=fmuStateSize)
+      throw runtime_error("The FMU state does not match this FMU.");
+    const char *p=s->data.data();
+
+    FMUStateHeader h;
+    memcpy(&h, p, sizeof(h));
+    p+=sizeof(h);
+    driftCompensation=static_cast<DriftCompensation>(h.driftCompensation);
+    completedStepCounter=h.completedStepCounter;
+    nextPlotTime=h.nextPlotTime;
+    for(auto vr : inputVR) {
+      double v;
+      memcpy(&v, p, sizeof(double));
+      var[vr]->setValue(v);
+      p+=sizeof(double);
+    }
+    if(svLast.size()>0)
+      memcpy(&svLast(0), p, svLast.size()*sizeof(double));
+    p+=svLast.size()*sizeof(double);
+    dss->setSnapshot(p);
+    p+=dss->getSnapshotSize();
+    if(cosim) {
+      integrator->setSystem(dss.get());
+      integrator->setSnapshot(p);
+    }
+  }
+
+  void FMIInstance::freeFMUstate(fmiFMUstate* state) {
+    delete static_cast<FMUState*>(*state);
+    *state=nullptr;
+  }
+
+  void FMIInstance::serializedFMUstateSize(fmiFMUstate state, size_t *size) {
+    *size=static_cast<FMUState*>(state)->data.size();
+  }
+
+  void FMIInstance::serializeFMUstate(fmiFMUstate state, char serializedState[], size_t size) {
+    const auto &data=static_cast<FMUState*>(state)->data;
+    if(size<data.size())
+      throw runtime_error("The buffer for the serialized FMU state is too small.");
+    memcpy(serializedState, data.data(), data.size());
+  }
+
+  void FMIInstance::deSerializeFMUstate(const char serializedState[], size_t size, fmiFMUstate* state) {
+    initFMUStateSize();
+    FMUStateHeader h;
+    if(size<sizeof(h))
+      throw runtime_error("The serialized FMU state is invalid.");
+    memcpy(&h, serializedState, sizeof(h));
+    if(h.size!=size || size!=fmuStateSize)
+      throw runtime_error("The serialized FMU state does not match this FMU.");
+    auto *s=static_cast<FMUState*>(*state);
+    if(!s)
+      s=new FMUState;
+    s->data.assign(serializedState, serializedState+size);
+    *state=s;
+  }
+
+
+
+  /* partial derivative functions */
+
+  double FMIInstance::getUnknown(fmiValueReference vr) {
+    size_t nx=cosim ? 0 : z.get().size();
+    if(vr<var.size() && var[vr]->getType()==Output && var[vr]->getDatatypeChar()=='r')
+      return var[vr]->getValue(double());
+    if(vr>=var.size()+nx && vr<var.size()+2*nx)
+      return dss->evalzd()(vr-var.size()-nx);
+    throw runtime_error("Value reference "+fmatvec::toString(vr)+" is not a real output or a state derivative.");
+  }
+
+  double FMIInstance::getKnown(fmiValueReference vr) {
+    size_t nx=cosim ? 0 : z.get().size();
+    if(vr<var.size() && var[vr]->getType()==Input && var[vr]->getDatatypeChar()=='r')
+      return var[vr]->getValue(double());
+    if(vr>=var.size() && vr<var.size()+nx)
+      return z.get()(vr-var.size());
+    throw runtime_error("Value reference "+fmatvec::toString(vr)+" is not a real input or a state.");
+  }
+
+  void FMIInstance::setKnown(fmiValueReference vr, double v) {
+    if(vr<var.size())
+      var[vr]->setValue(v);
+    else
+      z.get()(vr-var.size())=v;
+  }
+
+  // forward difference in the direction dvKnown: one additional model evaluation independent of nKnown
+  void FMIInstance::getDirectionalDerivative(const fmiValueReference vUnknown_ref[], size_t nUnknown,
+                                             const fmiValueReference vKnown_ref[], size_t nKnown,
+                                             const fmiReal dvKnown[], fmiReal dvUnknown[]) {
+    if(!dss)
+      throw runtime_error("Directional derivatives are only available after the initialization of the FMU.");
+    knownWork.resize(nKnown);
+    unknownWork.resize(nUnknown);
+
+    // undisturbed values
+    double nrmKnown=0, nrmDir=0;
+    for(size_t i=0; i<nKnown; ++i) {
+      knownWork[i]=getKnown(vKnown_ref[i]);
+      nrmKnown=max(nrmKnown, fabs(knownWork[i]));
+      nrmDir=max(nrmDir, fabs(dvKnown[i]));
+    }
+    if(nrmDir==0) {
+      fill(dvUnknown, dvUnknown+nUnknown, 0);
+      return;
+    }
+    for(size_t i=0; i<nUnknown; ++i)
+      unknownWork[i]=getUnknown(vUnknown_ref[i]);
+
+    // disturbed values; if only inputs are disturbed the state dependent quantities stay valid
+    bool inputsOnly=all_of(vKnown_ref, vKnown_ref+nKnown, [this](fmiValueReference vr) { return vr<var.size(); });
+    auto reset=[this, inputsOnly]() {
+      if(inputsOnly)
+        dss->resetForcesUpToDate();
+      else
+        dss->resetUpToDate();
+    };
+    double delta=sqrt(numeric_limits<double>::epsilon())*(1+nrmKnown)/nrmDir;
+    for(size_t i=0; i<nKnown; ++i)
+      setKnown(vKnown_ref[i], knownWork[i]+delta*dvKnown[i]);
+    reset();
+    for(size_t i=0; i<nUnknown; ++i)
+      dvUnknown[i]=(getUnknown(vUnknown_ref[i])-unknownWork[i])/delta;
+
+    // restore the undisturbed values
+    for(size_t i=0; i<nKnown; ++i)
+      setKnown(vKnown_ref[i], knownWork[i]);
+    reset();
+  }
+
 }
@@ -35,7 +35,8 @@ namespace MBSimFMI {
   /*! A MBSim FMI instance */
   class FMIInstance : public FMIInstanceBase, virtual public fmatvec::Atom {
     friend std::shared_ptr<FMIInstanceBase> fmiInstanceCreate(bool cosim, fmiString instanceName_, fmiString GUID,
-                                                              fmiCallbackLogger logger, fmiBoolean loggingOn);
+                                                              fmiCallbackLogger logger, fmiComponent loggerComponent,
+                                                              fmiBoolean loggingOn);
     public:
       //! dtor used in fmiFreeModelInstance
       ~FMIInstance() override;
@@ -57,7 +58,7 @@ namespace MBSimFMI {
       void setValue      (const fmiValueReference vr[], size_t nvr, const FMIDatatype value[]);
 
       // wrap the virtual none template functions to the corresponding template function
-      void getDoubleValue(const fmiValueReference vr[], size_t nvr, fmiReal value[]) override    { getValue<double>     (vr, nvr, value); }
+      void getDoubleValue(const fmiValueReference vr[], size_t nvr, fmiReal value[]) override; // also states and derivatives
       void getIntValue   (const fmiValueReference vr[], size_t nvr, fmiInteger value[]) override { getValue<int>        (vr, nvr, value); }
       void getBoolValue  (const fmiValueReference vr[], size_t nvr, fmiBoolean value[]) override { getValue<bool>       (vr, nvr, value); }
       void getStringValue(const fmiValueReference vr[], size_t nvr, fmiString value[]) override  { getValue<std::string>(vr, nvr, value); }
@@ -92,9 +93,23 @@ namespace MBSimFMI {
       void getBoolStatus(const fmiStatusKind s, fmiBoolean* value) override;
       void getStringStatus(const fmiStatusKind s, fmiString* value) override;
 
+      /* fmu state functions */
+      void getFMUstate(fmiFMUstate* state) override;
+      void setFMUstate(fmiFMUstate state) override;
+      void freeFMUstate(fmiFMUstate* state) override;
+      void serializedFMUstateSize(fmiFMUstate state, size_t *size) override;
+      void serializeFMUstate(fmiFMUstate state, char serializedState[], size_t size) override;
+      void deSerializeFMUstate(const char serializedState[], size_t size, fmiFMUstate* state) override;
+
+      /* partial derivative functions */
+      void getDirectionalDerivative(const fmiValueReference vUnknown_ref[], size_t nUnknown,
+                                    const fmiValueReference vKnown_ref[], size_t nKnown,
+                                    const fmiReal dvKnown[], fmiReal dvUnknown[]) override;
+
     private:
       //! ctor used in fmiInstantiateModel
-      FMIInstance(bool cosim, fmiString instanceName_, fmiString GUID, fmiCallbackLogger logger_, fmiBoolean loggingOn);
+      FMIInstance(bool cosim, fmiString instanceName_, fmiString GUID, fmiCallbackLogger logger_, fmiComponent loggerComponent_,
+                  fmiBoolean loggingOn);
 
       void rethrowVR(size_t vr, const std::exception &ex=std::runtime_error("Unknown exception."));
 
@@ -103,6 +118,7 @@ namespace MBSimFMI {
       // store FMI instanceName and logger
       std::string instanceName;
       fmiCallbackLogger logger;
+      fmiComponent loggerComponent;
 
       // XML parser (none validating)
       std::shared_ptr<MBXMLUtils::DOMParser> parser;
@@ -137,9 +153,29 @@ namespace MBSimFMI {
       int completedStepCounter;
       double nextPlotTime;
 
+      // a FMU state is a binary snapshot of this instance, the system and (for cosim) the integrator:
+      // [FMUStateHeader][input values][svLast][system snapshot][integrator snapshot]
+      struct FMUState {
+        std::vector<char> data;
+      };
+      // size of a FMU state of this instance (constant after initialize)
+      size_t fmuStateSize { 0 };
+      // value references of all inputs (saved in a FMU state)
+      std::vector<size_t> inputVR;
+
       void addModelParametersAndCreateSystem(std::vector<std::shared_ptr<Variable> > &varSim);
 
       void initialize();
+
+      // compute fmuStateSize if not already done
+      void initFMUStateSize();
+
+      // get/set a known/unknown variable of getDirectionalDerivative
+      double getUnknown(fmiValueReference vr);
+      double getKnown(fmiValueReference vr);
+      void setKnown(fmiValueReference vr, double v);
+      // work arrays of getDirectionalDerivative (no allocation on repeated calls)
+      std::vector<double> knownWork, unknownWork;
   };
 
 }
@@ -10,6 +10,12 @@ extern "C" {
   #include <3rdparty/fmiModelFunctions.h>
 }
 
+// FMU state: FMI 1.0 has no FMU state; only the FMI 2.0 wrapper (fmi2Functions.cc) provides the FMU state and
+// directional derivative functions (fmi2GetFMUstate, ..., fmi2GetDirectionalDerivative) using these methods.
+// For ME FMUs the value references nx+i and nx+nz+i (nx = number of FMI variables, nz = number of states) denote the
+// continuous state i and its derivative, respectively.
+typedef void* fmiFMUstate;
+
 namespace MBSimFMI {
 
   /*! A pure virtual MBSim FMI instance base class */
@@ -57,13 +63,27 @@ namespace MBSimFMI {
       virtual void getIntStatus(const fmiStatusKind s, fmiInteger* value)=0;
       virtual void getBoolStatus(const fmiStatusKind s, fmiBoolean* value)=0;
       virtual void getStringStatus(const fmiStatusKind s, fmiString* value)=0;
+
+      /* fmu state funcs */
+      virtual void getFMUstate(fmiFMUstate* state)=0;
+      virtual void setFMUstate(fmiFMUstate state)=0;
+      virtual void freeFMUstate(fmiFMUstate* state)=0;
+      virtual void serializedFMUstateSize(fmiFMUstate state, size_t *size)=0;
+      virtual void serializeFMUstate(fmiFMUstate state, char serializedState[], size_t size)=0;
+      virtual void deSerializeFMUstate(const char serializedState[], size_t size, fmiFMUstate* state)=0;
+
+      /* partial derivative funcs */
+      virtual void getDirectionalDerivative(const fmiValueReference vUnknown_ref[], size_t nUnknown,
+                                            const fmiValueReference vKnown_ref[], size_t nKnown,
+                                            const fmiReal dvKnown[], fmiReal dvUnknown[])=0;
   };
 
   extern "C"
-  using fmiInstanceCreatePtr = std::shared_ptr<FMIInstanceBase> (*)(bool, fmiString, fmiString, fmiCallbackLogger, fmiBoolean);
+  using fmiInstanceCreatePtr = std::shared_ptr<FMIInstanceBase> (*)(bool, fmiString, fmiString, fmiCallbackLogger, fmiComponent, fmiBoolean);
+  // loggerComponent is passed as first argument to logger (nullptr = the created instance)
   extern "C"
   std::shared_ptr<FMIInstanceBase> fmiInstanceCreate(bool cosim, fmiString instanceName_, fmiString GUID,
-                                                     fmiCallbackLogger logger, fmiBoolean loggingOn);
+                                                     fmiCallbackLogger logger, fmiComponent loggerComponent, fmiBoolean loggingOn);
 
 }
 
@@ -0,0 +1,181 @@
+// benchmark of a typical model exchange master loop of a FMU
+// usage: mbsimBenchmarkFMU <FMU dir> [<number of iterations> [<input VR> ...]]
+
+// includes
+#include <cassert>
+#include <cfenv>
+#include <mbxmlutilshelper/shared_library.h>
+#include <fmiModelFunctions.h>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+// typedefs for FMI function (must be in sync with fmiModelFunction.h)
+using t_fmiInstantiateModel = fmiComponent (*)(fmiString, fmiString, fmiCallbackFunctions_me, fmiBoolean);
+using t_fmiInitialize = fmiStatus (*)(fmiComponent, fmiBoolean, fmiReal, fmiEventInfo *);
+using t_fmiSetTime = fmiStatus (*)(fmiComponent, fmiReal);
+using t_fmiSetContinuousStates = fmiStatus (*)(fmiComponent, const fmiReal *, size_t);
+using t_fmiGetContinuousStates = fmiStatus (*)(fmiComponent, fmiReal *, size_t);
+using t_fmiSetReal = fmiStatus (*)(fmiComponent, const fmiValueReference *, size_t, const fmiReal *);
+using t_fmiGetReal = fmiStatus (*)(fmiComponent, const fmiValueReference *, size_t, fmiReal *);
+using t_fmiGetDerivatives = fmiStatus (*)(fmiComponent, fmiReal *, size_t);
+using t_fmiTerminate = fmiStatus (*)(fmiComponent);
+using t_fmiFreeModelInstance = void (*)(fmiComponent);
+
+using namespace std;
+using namespace boost::filesystem;
+using namespace MBXMLUtils;
+
+namespace {
+
+// some platform dependent file suffixes, directory names, ...
+#ifdef _WIN32
+  std::string SHEXT(".dll");
+  #ifdef _WIN64
+    const string FMIOS("win64");
+  #else
+    const string FMIOS("win32");
+  #endif
+#else
+  std::string SHEXT(".so");
+  #ifdef __x86_64__
+    const string FMIOS("linux64");
+  #else
+    const string FMIOS("linux32");
+  #endif
+#endif
+
+// FMI callback function
+extern "C"
+void fmiCallbackLoggerImpl(fmiComponent c, fmiString instanceName, fmiStatus status, fmiString category, fmiString message, ...) {
+  cout<<"Message from "<<instanceName<<" with category "<<category<<":"<<endl;
+  va_list ap;
+  va_start(ap, message);
+  vprintf(message, ap);
+  va_end(ap);
+  cout<<endl;
+}
+
+// the number of states is only available in the model description for FMI 1.0
+size_t getNumberOfContinuousStates(const path &fmuDir) {
+  boost::filesystem::ifstream file(fmuDir/"modelDescription.xml");
+  string content((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+  string key="numberOfContinuousStates=\"";
+  size_t pos=content.find(key);
+  if(pos==string::npos)
+    throw runtime_error("numberOfContinuousStates not found in the model description");
+  return stoul(content.substr(pos+key.length()));
+}
+
+void check(fmiStatus status, const string &func) {
+  if(status!=fmiOK)
+    throw runtime_error(func+" failed");
+}
+
+void report(const string &name, vector<double> &dt) {
+  sort(dt.begin(), dt.end());
+  double sum=0;
+  for(double d : dt)
+    sum+=d;
+  cout<<name<<": mean "<<sum/dt.size()*1e6<<" us, min "<<dt.front()*1e6<<" us, median "<<dt[dt.size()/2]*1e6
+      <<" us, max "<<dt.back()*1e6<<" us"<<endl;
+}
+
+}
+
+
+
+int main(int argc, char *argv[]) {
+#ifndef _WIN32
+  assert(feenableexcept(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW)!=-1);
+#endif
+  setlocale(LC_ALL, "C");
+
+  if(argc<2) {
+    cout<<"Usage: "<<argv[0]<<" <FMU dir> [<number of iterations> [<input VR> ...]]"<<endl;
+    return 1;
+  }
+
+  try {
+    // configuration
+    string fmu="mbsim" + SHEXT;
+    string guid="mbsimfmi_guid";
+    string modelIdentifier="mbsim";
+
+    // arguments
+    path fmuDir(argv[1]);
+    path fmuFile=canonical(fmuDir/"binaries"/FMIOS/fmu);
+    int N=argc>2 ? stoi(argv[2]) : 10000;
+    vector<fmiValueReference> inputVR;
+    for(int i=3; i<argc; ++i)
+      inputVR.push_back(stoul(argv[i]));
+
+    auto sym=[&fmuFile, &modelIdentifier](auto func, const string &name) {
+      return SharedLibrary::getSymbol<decltype(func)>(fmuFile.string(), modelIdentifier+"_"+name);
+    };
+    auto setTime=sym(t_fmiSetTime(), "fmiSetTime");
+    auto setContinuousStates=sym(t_fmiSetContinuousStates(), "fmiSetContinuousStates");
+    auto setReal=sym(t_fmiSetReal(), "fmiSetReal");
+    auto getReal=sym(t_fmiGetReal(), "fmiGetReal");
+    auto getDerivatives=sym(t_fmiGetDerivatives(), "fmiGetDerivatives");
+
+    // callbacks
+    fmiCallbackFunctions_me cbFuncs_me;
+    cbFuncs_me.logger=&fmiCallbackLoggerImpl;
+    cbFuncs_me.allocateMemory=&calloc;
+    cbFuncs_me.freeMemory=&free;
+
+    fmiComponent comp=sym(t_fmiInstantiateModel(), "fmiInstantiateModel")("fmu1", guid.c_str(), cbFuncs_me, fmiFalse);
+    if(!comp)
+      throw runtime_error("fmiInstantiateModel failed");
+    fmiEventInfo ei;
+    check(sym(t_fmiInitialize(), "fmiInitialize")(comp, fmiFalse, 0.0, &ei), "fmiInitialize");
+
+    size_t nx=getNumberOfContinuousStates(fmuDir);
+    vector<double> x(nx), xd(nx), u(inputVR.size());
+    check(sym(t_fmiGetContinuousStates(), "fmiGetContinuousStates")(comp, x.data(), nx), "fmiGetContinuousStates");
+    check(getReal(comp, inputVR.data(), inputVR.size(), u.data()), "fmiGetReal");
+    cout<<nx<<" states, "<<inputVR.size()<<" inputs, "<<N<<" iterations"<<endl;
+
+    vector<double> dt(N);
+
+    // integrator step: time, states and inputs are set before the derivatives are evaluated
+    for(int i=0; i<N; ++i) {
+      auto start=chrono::steady_clock::now();
+      check(setTime(comp, 0.0), "fmiSetTime");
+      check(setContinuousStates(comp, x.data(), nx), "fmiSetContinuousStates");
+      check(setReal(comp, inputVR.data(), inputVR.size(), u.data()), "fmiSetReal");
+      check(getDerivatives(comp, xd.data(), nx), "fmiGetDerivatives");
+      dt[i]=chrono::duration<double>(chrono::steady_clock::now()-start).count();
+    }
+    report("states and inputs", dt);
+
+    // algebraic loop of the master: only the inputs change between the evaluations
+    if(!inputVR.empty()) {
+      for(int i=0; i<N; ++i) {
+        auto start=chrono::steady_clock::now();
+        check(setReal(comp, inputVR.data(), inputVR.size(), u.data()), "fmiSetReal");
+        check(getDerivatives(comp, xd.data(), nx), "fmiGetDerivatives");
+        dt[i]=chrono::duration<double>(chrono::steady_clock::now()-start).count();
+      }
+      report("inputs only", dt);
+    }
+
+    check(sym(t_fmiTerminate(), "fmiTerminate")(comp), "fmiTerminate");
+    sym(t_fmiFreeModelInstance(), "fmiFreeModelInstance")(comp);
+    return 0;
+  }
+  catch(const std::exception &ex) {
+    cout<<"Exception: "<<ex.what()<<endl;
+  }
+  catch(...) {
+    cout<<"Unknown exception."<<endl;
+  }
+  return 1;
+}
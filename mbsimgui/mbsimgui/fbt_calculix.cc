@@ -20,6 +20,7 @@
 #include <config.h>
 #include "wizards.h"
 #include "basic_widgets.h"
+#include "text_parser.h"
 #include <QMessageBox>
 
 using namespace std;
@@ -33,54 +34,50 @@ namespace MBSimGUI {
     string resultFileName = page<CalculixPage>(PageCalculix)->file->getWidget<FileWidget>()->getFile(true).toStdString();
     string jobname = resultFileName.substr(0,resultFileName.length()-4);
 
-    ifstream isDOF(jobname+".dof");
+    TextParser isDOF(jobname+".dof");
     // dof
     std::vector<std::pair<size_t,size_t>> dof;
     double d;
-    while(true) {
-      isDOF >> d;
-      if(isDOF.eof()) break;
+    while(isDOF.number(d))
       dof.push_back(make_pair(size_t(d)-1,int(d*10)-size_t(d)*10-1));
-    }
-    isDOF.close();
 
-    ifstream isRes(jobname+".frd");
+    TextParser isRes(jobname+".frd");
     // nodes
-    string str;
-    while(isRes) {
-      getline(isRes,str);
+    string_view str;
+    while(isRes.getline(str)) {
       if(str.length()>6 and str.substr(4,2)=="2C")
 	break;
     }
-    int nN;
-    stringstream sN(str);
-    sN >> str >> nN;
+    TextParser::skipWord(str);
+    int nN = TextParser::parseNumber(str);
     nodeNumbers.resize(nN);
     r.resize(nN);
     int dmax = 0;
     for(size_t i=0; i<nN; i++) {
-      isRes >> d >> d;
+      isRes.number();
+      d = isRes.number();
       nodeNumbers[i] = d;
       if(d>dmax) dmax = d;
       for(size_t k=0; k<3; k++)
-	isRes >> r[i](k);
+	r[i](k) = isRes.number();
     }
     nodeTable.resize(dmax+1);
     for(size_t i=0; i<nN; i++)
       nodeTable[nodeNumbers[i]] = i;
     // elements
-    while(isRes) {
-      getline(isRes,str);
+    isRes.skipLine();
+    while(isRes.getline(str)) {
       if(str.length()>6 and str.substr(4,2)=="3C")
 	break;
     }
-    int nE;
-    stringstream sE(str);
-    sE >> str >> nE;
+    TextParser::skipWord(str);
+    int nE = TextParser::parseNumber(str);
     Matrix<General,Var,Var,int> eles(nE,20,NONINIT);
     size_t type, nNpE = 0;
     for(size_t i=0; i<nE; i++) {
-      isRes >> str >> str >> type;
+      isRes.word();
+      isRes.word();
+      type = isRes.number();
       if(type==4)
 	nNpE = 20;
       else if(type==5)
@@ -91,60 +88,57 @@ namespace MBSimGUI {
 	QMessageBox::warning(this, "Flexible body tool", "Unknown element type.");
 	return;
       }
-      getline(isRes,str);
+      isRes.skipLine();
       for(size_t j=0; j<nNpE;) {
-	isRes >> d;
+	d = isRes.number();
 	if(d>0) {
 	  eles.e(i,j) = d;
 	  j++;
 	}
       }
-      getline(isRes,str);
+      isRes.skipLine();
     }
     std::vector<VecV> disp;
     std::vector<VecV> stress;
-    size_t i, nN_;
-    while(isRes) {
-      getline(isRes,str);
+    while(isRes.getline(str)) {
       if(str.length()>6 and str.substr(2,4)=="100C") {
-	//        cout << str[57] << endl;
-	stringstream s(str);
-	s >> str >> str >> str >> nN_;
+	for(int k=0; k<3; k++)
+	  TextParser::skipWord(str);
+	int nN_ = TextParser::parseNumber(str);
 	if(nN != nN_) {
 	  QMessageBox::warning(this, "Flexible body tool", "Number of nodes does not match.");
 	  return;
 	}
-	isRes >> i >> str;
-	if(str=="DISP") {
+	isRes.number();
+	auto name = isRes.word();
+	if(name=="DISP") {
 	  VecV dispi(3*nN,NONINIT);
-	  double d;
-	  string str;
 	  for(size_t i=0; i<5; i++)
-	    getline(isRes,str);
+	    isRes.skipLine();
 	  for(size_t i=0; i<nN; i++) {
-	    isRes >> d >> d;
+	    isRes.number();
+	    isRes.number();
 	    for(size_t k=0; k<3; k++)
-	      isRes >> dispi.e(3*i+k);
+	      dispi.e(3*i+k) = isRes.number();
 	  }
 	  disp.push_back(dispi);
 	}
-	else if(str=="STRESS") {
+	else if(name=="STRESS") {
 	  VecV stressi(6*nN,NONINIT);
-	  double d;
-	  string str;
 	  for(size_t i=0; i<7; i++)
-	    getline(isRes,str);
+	    isRes.skipLine();
 	  for(size_t i=0; i<nN; i++) {
-	    isRes >> d >> d;
+	    isRes.number();
+	    isRes.number();
 	    for(size_t k=0; k<6; k++)
-	      isRes >> stressi.e(6*i+k);
+	      stressi.e(6*i+k) = isRes.number();
 	  }
 	  stress.push_back(stressi);
 	}
+	isRes.skipLine();
       }
     }
     int nM = disp.size();
-    isRes.close();
 
     M <<= readMat(jobname+".mas");
     K <<= readMat(jobname+".sti");
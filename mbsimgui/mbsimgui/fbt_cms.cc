@@ -23,7 +23,10 @@
 #include "variable_widgets.h"
 #include "extended_widgets.h"
 #include "special_widgets.h"
-#include <fmatvec/sparse_linear_algebra_double.h>
+#include "sparse_eigen_solver.h"
+#include <fmatvec/atom.h>
+#include <chrono>
+#include <limits>
 
 using namespace std;
 using namespace fmatvec;
@@ -70,6 +73,48 @@ namespace MBSimGUI {
     return minimum;
   }
 
+  namespace {
+    double elapsed(const chrono::steady_clock::time_point &start) {
+      return chrono::duration<double>(chrono::steady_clock::now()-start).count();
+    }
+
+    SparseLDL factorize(const string &name, const SymSparseMat &K, double sigma=0, const SymSparseMat *M=nullptr) {
+      auto start = chrono::steady_clock::now();
+      SparseLDL Kf(K,sigma,M);
+      Atom::msgStatic(Atom::Info) << "CMS: factorisation of " << name << " (n = " << Kf.size() << ", nnz(L) = " << Kf.nonZeroElements() << ", "
+        << Kf.getMemoryUsage()/1048576. << " MB) in " << elapsed(start) << " s" << endl;
+      return Kf;
+    }
+
+    // Shift below the rigid body modes in the scale of the model: the Rayleigh quotients K_ii/M_ii of the unit vectors
+    // are in the scale of the lowest elastic eigenvalues; a small fraction of the smallest one is independent of the
+    // units and keeps K-sigma*M well conditioned, unlike a fixed shift of -1.
+    double rigidBodyShift(const SymSparseMat &K, const SymSparseMat &M) {
+      double ratio = numeric_limits<double>::max();
+      for(int i=0; i<K.size(); i++) {
+        double Kii = 0, Mii = 0;
+        for(int k=K.Ip()[i]; k<K.Ip()[i+1]; k++)
+          if(K.Jp()[k]==i) Kii = K()[k];
+        for(int k=M.Ip()[i]; k<M.Ip()[i+1]; k++)
+          if(M.Jp()[k]==i) Mii = M()[k];
+        if(Kii>0 and Mii>0)
+          ratio = std::min(ratio, Kii/Mii);
+      }
+      double sigma = ratio<numeric_limits<double>::max() ? -1e-3*ratio : -1;
+      Atom::msgStatic(Atom::Info) << "CMS: shift of the free normal modes sigma = " << sigma << endl;
+      return sigma;
+    }
+
+    void eigvec(const string &name, const SparseLDL &Kf, const SymSparseMat &M, int nev, Mat &V, Vec &w) {
+      auto start = chrono::steady_clock::now();
+      int nconv = eigvecShiftInvert(Kf,M,nev,V,w);
+      Atom::msgStatic(Atom::Info) << "CMS: " << nev << " normal modes of " << name << " in " << elapsed(start) << " s (basis "
+        << size_t(Kf.size())*V.cols()*sizeof(double)/1048576. << " MB)" << endl;
+      if(nconv<nev)
+        Atom::msgStatic(Atom::Warn) << "CMS: only " << nconv << " of " << nev << " normal modes converged" << endl;
+    }
+  }
+
   void FlexibleBodyTool::cms() {
     auto *list = page<BoundaryConditionsPage>(PageBC)->bc->getWidget<ListWidget>();
     vector<vector<int>> dof(list->getSize());;
@@ -187,6 +232,8 @@ namespace MBSimGUI {
 
     MatV Ui, Un, D;
     SymSparseMat Ms, Mrcs, Krcs, Krns, Mrns;
+    // one factorisation of Krns serves the static modes and the fixed boundary normal modes
+    SparseLDL Krnsf;
     if(not Mm.size()) {
       Ms <<= PPdms[0];
       for(int i=0; i<Ms.nonZeroElements(); i++)
@@ -230,6 +277,9 @@ namespace MBSimGUI {
 	if(reduceToNode[i]) rdn = true;
       }
 
+      if(not(rdn and typeOfConstraint==distributing) or normalModes==fixedBoundaryNormalModes)
+	Krnsf = factorize("Krns",Krns);
+
       if(rdn) {
 	if(typeOfConstraint==kinematic) {
 	  D.resize(iH.size(),ni);
@@ -312,7 +362,7 @@ namespace MBSimGUI {
 	    Krcs.Ip()[ii+1] = k;
 	  }
 	  Ui.resize(Ks.size(),ni,NONINIT);
-	  MatV Q = -slvLU(Krns,Krnc);
+	  MatV Q = -Krnsf.solve(Krnc);
 	  RangeV IJ(0,ni-1);
 	  Ui.set(iN,IJ,Q);
 	  Ui.set(iH,IJ,D);
@@ -365,14 +415,14 @@ namespace MBSimGUI {
 	      fri.set(RangeV(ii,ii+2),RangeV(0,2),B);
 	      fri.set(RangeV(ii,ii+2),RangeV(3,5),slvLL(A,tilde(r[nodeTable[inodes[i][j]]]-rr).T()*B));
 	    }
-	    Ui.set(iHi,RangeV(ni,ni+idof[i].size()-1), slvLU(Kris,fri(RangeV(0,fri.rows()-1),idof[i])));
+	    Ui.set(iHi,RangeV(ni,ni+idof[i].size()-1), factorize("Kris",Kris).solve(fri(RangeV(0,fri.rows()-1),idof[i])));
 	    ni += idof[i].size();
 	  }
 	}
       } else {
 	Ui.resize(Ks.size(),iH.size(),NONINIT);
 	RangeV IJ(0,iH.size()-1);
-	Ui.set(iN,IJ,-slvLU(Krns,Krnh));
+	Ui.set(iN,IJ,-Krnsf.solve(Krnh));
 	Ui.set(iH,IJ,MatV(iH.size(),iH.size(),Eye()));
 	Ui.set(iX,IJ,MatV(iX.size(),iH.size()));
       }
@@ -393,7 +443,8 @@ namespace MBSimGUI {
 	}
 	else
 	  reduceMat(Ms,Ks,Mrs,Krs,iF.size(),activeDof0,dofMapF);
-	eigvec(Krs,Mrs,max(nmodes),1,V,w,0.01);
+	// shift below the rigid body modes
+	eigvec("Krs",factorize("Krs-sigma*Mrs",Krs,rigidBodyShift(Krs,Mrs),&Mrs),Mrs,max(nmodes),V,w);
 	Un.resize(Ks.size(),nmodes.size(),NONINIT);
 	for(size_t i=0; i<nmodes.size(); i++) {
 	  Un.set(iF,i,V.col(nmodes[i]-1));
@@ -405,7 +456,7 @@ namespace MBSimGUI {
 	}
       }
       else if(normalModes==fixedBoundaryNormalModes) {
-	eigvec(Krns,Mrns,max(nmodes),1,V,w,0.01);
+	eigvec("Krns",Krnsf,Mrns,max(nmodes),V,w);
 	Un.resize(Ks.size(),nmodes.size(),NONINIT);
 	for(size_t i=0; i<nmodes.size(); i++) {
 	  Un.set(iN,i,V.col(nmodes[i]-1));
@@ -414,7 +465,7 @@ namespace MBSimGUI {
 	}
       }
       else if(normalModes==constrainedBoundaryNormalModes) {
-	eigvec(Krcs,Mrcs,max(nmodes),1,V,w,0.01);
+	eigvec("Krcs",factorize("Krcs-sigma*Mrcs",Krcs,rigidBodyShift(Krcs,Mrcs),&Mrcs),Mrcs,max(nmodes),V,w);
 	Un.resize(Ks.size(),nmodes.size(),NONINIT);
 	for(size_t i=0; i<nmodes.size(); i++) {
 	  Un.set(iN,i,V.col(nmodes[i]-1)(RangeV(0,iN.size()-1)));
@@ -23,6 +23,7 @@
 #include "variable_widgets.h"
 #include "extended_widgets.h"
 #include "special_widgets.h"
+#include "text_parser.h"
 #include <iostream>
 
 using namespace std;
@@ -31,40 +32,27 @@ using namespace fmatvec;
 namespace MBSimGUI {
 
   MatV FlexibleBodyTool::readMat(const string &file) {
-    ifstream is(file);
-    string buf, buf2;
-    getline(is,buf);
-    int m=0;
-    while(!is.eof()) {
-      getline(is,buf2);
-      m++;
-    }
-    is.close();
-
-    istringstream iss(buf);
-    double val;
-    char s;
-    int n=0;
-    while(!iss.eof()) {
-      iss >> val;
-      int c = iss.peek();
-      if(c==44 or c==59 or c==13)
-	iss >> s;
-      n++;
-    }
-
-    MatV A(m,n);
-    is.open(file);
-    for(int i=0; i<m; i++) {
-      for(int j=0; j<n; j++) {
-	is >> A(i,j);
-	int c = is.peek();
-	if(c==44 or c==59)
-	  is >> s;
+    TextParser parser(file);
+    vector<double> data;
+    int m=0, n=0;
+    while(not parser.eof()) {
+      int k=0;
+      for(double x; not parser.atLineEnd() and parser.number(x); k++)
+	data.push_back(x);
+      if(k) {
+	if(not n) n = k;
+	else if(k!=n)
+	  throw runtime_error(parser.position() + ": " + to_string(n) + " columns expected, but " + to_string(k) + " found");
+	m++;
       }
+      parser.skipLine();
     }
-    is.close();
 
+    MatV A(m,n,NONINIT);
+    for(int i=0, k=0; i<m; i++) {
+      for(int j=0; j<n; j++)
+	A(i,j) = data[k++];
+    }
     return A;
   }
 
@@ -1247,6 +1247,12 @@ namespace MBSimGUI {
     initialInput = new ExtWidget("Initial input",new ChoiceWidget(new VecSizeVarWidgetFactory(1),QBoxLayout::RightToLeft,5),true,false,MBSIMCONTROL%"initialInput");
     addToTab("Initial conditions", initialInput);
 
+    centralDifferences = new ExtWidget("Central differences",new ChoiceWidget(new BoolWidgetFactory("0"),QBoxLayout::RightToLeft,5),true,false,MBSIMCONTROL%"centralDifferences");
+    addToTab("General", centralDifferences);
+
+    numberOfProcesses = new ExtWidget("Number of processes",new ChoiceWidget(new ScalarWidgetFactory("1"),QBoxLayout::RightToLeft,5),true,false,MBSIMCONTROL%"numberOfProcesses");
+    addToTab("General", numberOfProcesses);
+
     minimumNaturalFrequency = new ExtWidget("Minimum natural frequency",new ChoiceWidget(new ScalarWidgetFactory("0.01"),QBoxLayout::RightToLeft,5),true,false,MBSIMCONTROL%"minimumNaturalFrequency");
     addToTab("Modal analysis", minimumNaturalFrequency);
 
@@ -1292,6 +1298,8 @@ namespace MBSimGUI {
     initialTime->initializeUsingXML(item->getXMLElement());
     initialState->initializeUsingXML(item->getXMLElement());
     initialInput->initializeUsingXML(item->getXMLElement());
+    centralDifferences->initializeUsingXML(item->getXMLElement());
+    numberOfProcesses->initializeUsingXML(item->getXMLElement());
     minimumNaturalFrequency->initializeUsingXML(item->getXMLElement());
     maximumNaturalFrequency->initializeUsingXML(item->getXMLElement());
     modeScaleFactor->initializeUsingXML(item->getXMLElement());
@@ -1312,6 +1320,8 @@ namespace MBSimGUI {
     initialTime->writeXMLFile(item->getXMLElement());
     initialState->writeXMLFile(item->getXMLElement());
     initialInput->writeXMLFile(item->getXMLElement());
+    centralDifferences->writeXMLFile(item->getXMLElement());
+    numberOfProcesses->writeXMLFile(item->getXMLElement());
     minimumNaturalFrequency->writeXMLFile(item->getXMLElement());
     maximumNaturalFrequency->writeXMLFile(item->getXMLElement());
     modeScaleFactor->writeXMLFile(item->getXMLElement());
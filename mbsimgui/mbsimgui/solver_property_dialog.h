@@ -307,7 +307,7 @@ namespace MBSimGUI {
       xercesc::DOMElement* initializeUsingXML(xercesc::DOMElement *parent) override;
       xercesc::DOMElement* writeXMLFile(xercesc::DOMNode *element, xercesc::DOMNode *ref=nullptr) override;
     protected:
-      ExtWidget *initialTime, *initialState, *initialInput, *minimumNaturalFrequency, *maximumNaturalFrequency, *modeScaleFactor, *modeScale, *excitationFrequencies, *excitationAmplitudeFunction, *excitationPhaseFunction, *visualizeNormalModes, *visualizeFrequencyResponse, *visualizeSuperposedSolution, *plotStepSize, *loops;
+      ExtWidget *initialTime, *initialState, *initialInput, *centralDifferences, *numberOfProcesses, *minimumNaturalFrequency, *maximumNaturalFrequency, *modeScaleFactor, *modeScale, *excitationFrequencies, *excitationAmplitudeFunction, *excitationPhaseFunction, *visualizeNormalModes, *visualizeFrequencyResponse, *visualizeSuperposedSolution, *plotStepSize, *loops;
   };
 
 }
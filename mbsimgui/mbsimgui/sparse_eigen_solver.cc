@@ -0,0 +1,464 @@
+/*
+    MBSimGUI - A fronted for MBSim.
+    Copyright (C) 2022 Martin Förg
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include <config.h>
+#include "sparse_eigen_solver.h"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "mbsim/numerics/csparse.h"
+
+using namespace std;
+using namespace fmatvec;
+
+namespace MBSimGUI {
+
+  namespace {
+
+    // y = M*x for a symmetric matrix stored as upper triangle in compressed row format
+    void symSparseMult(int n, const int *Ip, const int *Jp, const double *M, const double *x, double *y) {
+      fill(y,y+n,0.);
+      for(int i=0; i<n; i++) {
+        for(int k=Ip[i]; k<Ip[i+1]; k++) {
+          int j = Jp[k];
+          y[i] += M[k]*x[j];
+          if(j!=i)
+            y[j] += M[k]*x[i];
+        }
+      }
+    }
+
+    double dot(int n, const double *x, const double *y) {
+      double s = 0;
+      for(int i=0; i<n; i++)
+        s += x[i]*y[i];
+      return s;
+    }
+
+    // eigenvalues and eigenvectors of a small dense symmetric matrix (cyclic Jacobi)
+    // A: n x n column major (destroyed), d: eigenvalues, Z: eigenvectors n x n column major
+    void symmetricEigen(int n, vector<double> &A, vector<double> &d, vector<double> &Z) {
+      Z.assign(size_t(n)*n,0.);
+      for(int i=0; i<n; i++)
+        Z[size_t(i)*n+i] = 1;
+      for(int sweep=0; sweep<100; sweep++) {
+        double off = 0, diag = 0;
+        for(int j=0; j<n; j++) {
+          diag += A[size_t(j)*n+j]*A[size_t(j)*n+j];
+          for(int i=0; i<j; i++)
+            off += A[size_t(j)*n+i]*A[size_t(j)*n+i];
+        }
+        if(off<=1e-30*diag or off==0)
+          break;
+        for(int p=0; p<n-1; p++) {
+          for(int q=p+1; q<n; q++) {
+            double apq = A[size_t(q)*n+p];
+            if(apq==0)
+              continue;
+            double app = A[size_t(p)*n+p], aqq = A[size_t(q)*n+q];
+            double tau = (aqq-app)/(2*apq);
+            double t = (tau>=0?1:-1)/(fabs(tau)+sqrt(1+tau*tau));
+            double c = 1/sqrt(1+t*t), s = t*c;
+            for(int k=0; k<n; k++) {
+              double akp = A[size_t(p)*n+k], akq = A[size_t(q)*n+k];
+              A[size_t(p)*n+k] = c*akp-s*akq;
+              A[size_t(q)*n+k] = s*akp+c*akq;
+            }
+            for(int k=0; k<n; k++) {
+              double apk = A[size_t(k)*n+p], aqk = A[size_t(k)*n+q];
+              A[size_t(k)*n+p] = c*apk-s*aqk;
+              A[size_t(k)*n+q] = s*apk+c*aqk;
+            }
+            for(int k=0; k<n; k++) {
+              double zkp = Z[size_t(p)*n+k], zkq = Z[size_t(q)*n+k];
+              Z[size_t(p)*n+k] = c*zkp-s*zkq;
+              Z[size_t(q)*n+k] = s*zkp+c*zkq;
+            }
+          }
+        }
+      }
+      d.resize(n);
+      for(int i=0; i<n; i++)
+        d[i] = A[size_t(i)*n+i];
+    }
+
+  }
+
+  SparseLDL::SparseLDL(const SymSparseMat &A, double sigma_, const SymSparseMat *M) : n(A.size()), sigma(sigma_) {
+    factorize(A.Ip(),A.Jp(),A(),M?M->Ip():nullptr,M?M->Jp():nullptr,M?(*M)():nullptr);
+  }
+
+  SparseLDL::SparseLDL(int n_, const int *IpA, const int *JpA, const double *A, double sigma_, const int *IpM, const int *JpM, const double *M) : n(n_), sigma(sigma_) {
+    factorize(IpA,JpA,A,IpM,JpM,M);
+  }
+
+  void SparseLDL::factorize(const int *IpA, const int *JpA, const double *A, const int *IpM, const int *JpM, const double *M) {
+    bool shift = M and sigma!=0;
+
+    // fill reducing ordering: approximate minimum degree of the (symmetric) pattern
+    vector<vector<int>> adj(n);
+    auto addPattern = [&](const int *Ip, const int *Jp) {
+      for(int i=0; i<n; i++) {
+        for(int k=Ip[i]; k<Ip[i+1]; k++) {
+          if(Jp[k]!=i) {
+            adj[i].push_back(Jp[k]);
+            adj[Jp[k]].push_back(i);
+          }
+        }
+      }
+    };
+    addPattern(IpA,JpA);
+    if(shift) addPattern(IpM,JpM);
+    vector<int> Gp(n+1,0), Gi;
+    for(int i=0; i<n; i++) {
+      sort(adj[i].begin(),adj[i].end());
+      adj[i].erase(unique(adj[i].begin(),adj[i].end()),adj[i].end());
+      Gp[i+1] = Gp[i]+adj[i].size();
+    }
+    Gi.reserve(Gp[n]);
+    for(auto &a : adj)
+      Gi.insert(Gi.end(),a.begin(),a.end());
+    adj.clear();
+    cs G;
+    G.nzmax = Gp[n];
+    G.m = n;
+    G.n = n;
+    G.p = Gp.data();
+    G.i = Gi.data();
+    G.x = nullptr;
+    G.nz = -1;
+    int *P = cs_amd(&G,0);
+    if(not P)
+      throw runtime_error("(SparseLDL::factorize): ordering failed");
+    perm.assign(P,P+n);
+    cs_free(P);
+    pinv.resize(n);
+    for(int i=0; i<n; i++)
+      pinv[perm[i]] = i;
+
+    // permuted matrix P*(A-sigma*M)*P^T as upper triangle in compressed column format
+    vector<int> Cp(n+1,0);
+    auto count = [&](const int *Ip, const int *Jp) {
+      for(int i=0; i<n; i++) {
+        for(int k=Ip[i]; k<Ip[i+1]; k++)
+          Cp[max(pinv[i],pinv[Jp[k]])+1]++;
+      }
+    };
+    count(IpA,JpA);
+    if(shift) count(IpM,JpM);
+    partial_sum(Cp.begin(),Cp.end(),Cp.begin());
+    vector<int> Ci(Cp[n]), next(Cp.begin(),Cp.end()-1);
+    vector<double> Cx(Cp[n]);
+    auto fillIn = [&](const int *Ip, const int *Jp, const double *X, double c) {
+      for(int i=0; i<n; i++) {
+        for(int k=Ip[i]; k<Ip[i+1]; k++) {
+          int pi = pinv[i], pj = pinv[Jp[k]];
+          int p = next[max(pi,pj)]++;
+          Ci[p] = min(pi,pj);
+          Cx[p] = c*X[k];
+        }
+      }
+    };
+    fillIn(IpA,JpA,A,1);
+    if(shift) fillIn(IpM,JpM,M,-sigma);
+
+    // symbolic analysis: elimination tree and column counts of L
+    vector<int> parent(n), Lnz(n), flag(n);
+    for(int k=0; k<n; k++) {
+      parent[k] = -1;
+      flag[k] = k;
+      Lnz[k] = 0;
+      for(int p=Cp[k]; p<Cp[k+1]; p++) {
+        for(int i=Ci[p]; i<k and flag[i]!=k; i=parent[i]) {
+          if(parent[i]==-1) parent[i] = k;
+          Lnz[i]++;
+          flag[i] = k;
+        }
+      }
+    }
+    Lp.resize(n+1);
+    Lp[0] = 0;
+    for(int k=0; k<n; k++)
+      Lp[k+1] = Lp[k]+Lnz[k];
+    Li.resize(Lp[n]);
+    Lx.resize(Lp[n]);
+    D.resize(n);
+
+    // level schedule of the elimination tree: row k of L only depends on the rows of its subtree, hence the rows of
+    // one level (same height in the tree) are independent and touch disjoint parts of L, flag and the work vector
+    vector<int> height(n,0);
+    int nLevels = 0;
+    for(int k=0; k<n; k++) {
+      if(parent[k]!=-1)
+        height[parent[k]] = max(height[parent[k]],height[k]+1);
+      nLevels = max(nLevels,height[k]+1);
+    }
+    vector<int> levelPtr(nLevels+1,0), levelNodes(n);
+    for(int k=0; k<n; k++)
+      levelPtr[height[k]+1]++;
+    partial_sum(levelPtr.begin(),levelPtr.end(),levelPtr.begin());
+    vector<int> pos(levelPtr.begin(),levelPtr.end()-1);
+    for(int k=0; k<n; k++)
+      levelNodes[pos[height[k]]++] = k;
+
+    // numeric factorisation (up-looking)
+    for(int k=0; k<n; k++)
+      Lnz[k] = 0;
+    int singular = n;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      vector<double> Y(n,0.);
+      vector<int> pattern(n);
+      for(int l=0; l<nLevels; l++) {
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,16)
+#endif
+        for(int q=levelPtr[l]; q<levelPtr[l+1]; q++) {
+          int k = levelNodes[q];
+          int top = n;
+          flag[k] = k;
+          for(int p=Cp[k]; p<Cp[k+1]; p++) {
+            int i = Ci[p];
+            Y[i] += Cx[p];
+            int len = 0;
+            for(; flag[i]!=k; i=parent[i]) {
+              pattern[len++] = i;
+              flag[i] = k;
+            }
+            while(len>0)
+              pattern[--top] = pattern[--len];
+          }
+          D[k] = Y[k];
+          Y[k] = 0;
+          for(; top<n; top++) {
+            int i = pattern[top];
+            double yi = Y[i];
+            Y[i] = 0;
+            int p2 = Lp[i]+Lnz[i];
+            for(int p=Lp[i]; p<p2; p++)
+              Y[Li[p]] -= Lx[p]*yi;
+            double lki = yi/D[i];
+            D[k] -= lki*yi;
+            Li[p2] = k;
+            Lx[p2] = lki;
+            Lnz[i]++;
+          }
+          if(D[k]==0) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            singular = min(singular,k);
+          }
+        }
+      }
+    }
+    if(singular<n)
+      throw runtime_error("(SparseLDL::factorize): matrix is singular (zero pivot in row " + to_string(perm[singular]) + ")");
+  }
+
+  size_t SparseLDL::getMemoryUsage() const {
+    return (perm.size()+pinv.size()+Lp.size()+Li.size())*sizeof(int)+(Lx.size()+D.size())*sizeof(double);
+  }
+
+  void SparseLDL::solve(double *x) const {
+    vector<double> y(n);
+    for(int i=0; i<n; i++)
+      y[i] = x[perm[i]];
+    for(int j=0; j<n; j++) {
+      double yj = y[j];
+      for(int p=Lp[j]; p<Lp[j+1]; p++)
+        y[Li[p]] -= Lx[p]*yj;
+    }
+    for(int j=0; j<n; j++)
+      y[j] /= D[j];
+    for(int j=n-1; j>=0; j--) {
+      double yj = y[j];
+      for(int p=Lp[j]; p<Lp[j+1]; p++)
+        yj -= Lx[p]*y[Li[p]];
+      y[j] = yj;
+    }
+    for(int i=0; i<n; i++)
+      x[perm[i]] = y[i];
+  }
+
+  VecV SparseLDL::solve(const VecV &b) const {
+    VecV x = b;
+    solve(&x(0));
+    return x;
+  }
+
+  MatV SparseLDL::solve(const MatV &B) const {
+    MatV X(B.rows(),B.cols(),NONINIT);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(int j=0; j<B.cols(); j++) {
+      vector<double> x(n);
+      for(int i=0; i<n; i++)
+        x[i] = B.e(i,j);
+      solve(x.data());
+      for(int i=0; i<n; i++)
+        X.e(i,j) = x[i];
+    }
+    return X;
+  }
+
+  int eigvecShiftInvert(const SparseLDL &Kf, const SymSparseMat &M_, int nev, Mat &V, Vec &w, double tol) {
+    int n = Kf.size();
+    const int *Ip = M_.Ip();
+    const int *Jp = M_.Jp();
+    const double *M = M_();
+    nev = min(nev,n);
+    // fixed size of the Lanczos basis; the basis is restarted with the best Ritz vectors (thick restart)
+    int m = min(n,max(2*nev,nev+20));
+    int nKeep = min(m-1,nev+(m-nev)/2);
+    const int maxRestarts = 100;
+
+    // Lanczos basis Q and M*Q (column major), column m is the residual vector
+    vector<double> Q(size_t(m+1)*n), MQ(size_t(m+1)*n), H(size_t(m)*m,0.);
+    vector<double> r(n), Mr(n), c(m);
+    auto q = [&](int j) { return &Q[size_t(j)*n]; };
+    auto Mq = [&](int j) { return &MQ[size_t(j)*n]; };
+
+    // r is M-orthogonalised against the first k columns (classical Gram-Schmidt, twice); c are the coefficients
+    auto orthogonalize = [&](int k) {
+      fill(c.begin(),c.begin()+k,0.);
+      for(int pass=0; pass<2; pass++) {
+        for(int i=0; i<k; i++) {
+          double ci = dot(n,r.data(),Mq(i));
+          c[i] += ci;
+          for(int l=0; l<n; l++)
+            r[l] -= ci*q(i)[l];
+        }
+      }
+      symSparseMult(n,Ip,Jp,M,r.data(),Mr.data());
+      return sqrt(max(dot(n,r.data(),Mr.data()),0.));
+    };
+    auto setColumn = [&](int j, double b) {
+      for(int i=0; i<n; i++) {
+        q(j)[i] = r[i]/b;
+        Mq(j)[i] = Mr[i]/b;
+      }
+    };
+
+    for(int i=0; i<n; i++)
+      r[i] = 1+0.1*sin(i+1.);
+    // start with OP*r to remove components in the nullspace of M
+    symSparseMult(n,Ip,Jp,M,r.data(),Mr.data());
+    Kf.solve((r=Mr).data());
+    double b = orthogonalize(0);
+    if(b==0)
+      throw runtime_error("(eigvecShiftInvert): invalid start vector");
+    setColumn(0,b);
+
+    vector<double> theta, Z, Hk, Qk;
+    vector<int> idx(m);
+    int nconv = 0;
+    int k = 0;
+    for(int restart=0; ; restart++) {
+      for(int j=k; j<m; j++) {
+        // r = (K - sigma*M)^-1 * M * q_j; the coefficients give column j of the projected matrix H
+        copy(Mq(j),Mq(j)+n,r.begin());
+        Kf.solve(r.data());
+        b = orthogonalize(j+1);
+        for(int i=0; i<=j; i++)
+          H[size_t(j)*m+i] = H[size_t(i)*m+j] = c[i];
+        if(j+1==n) {
+          b = 0;
+          break;
+        }
+        if(b<=1e-12*fabs(c[j])) {
+          // invariant subspace found: continue with a new vector orthogonal to Q
+          for(int i=0; i<n; i++)
+            r[i] = cos(3.*i+j);
+          setColumn(j+1,orthogonalize(j+1));
+          b = 0;
+        }
+        else
+          setColumn(j+1,b);
+      }
+      int nk = m;
+      Hk = H;
+      symmetricEigen(nk,Hk,theta,Z);
+
+      // largest Ritz values theta correspond to the eigenvalues closest to the shift
+      idx.resize(nk);
+      iota(idx.begin(),idx.end(),0);
+      sort(idx.begin(),idx.end(),[&](int i1, int i2) { return theta[i1]>theta[i2]; });
+      nconv = 0;
+      for(int i=0; i<min(nev,nk); i++) {
+        if(fabs(b*Z[size_t(idx[i])*nk+nk-1])<=tol*fabs(theta[idx[i]]))
+          nconv++;
+        else
+          break;
+      }
+      if(nconv==nev or nk==n or restart==maxRestarts) {
+        int nout = min(nev,nk);
+        V <<= Mat(n,nout,NONINIT);
+        w <<= Vec(nout,NONINIT);
+        vector<pair<double,int>> lambda(nout);
+        for(int i=0; i<nout; i++)
+          lambda[i] = make_pair(Kf.getShift()+1/theta[idx[i]],idx[i]);
+        sort(lambda.begin(),lambda.end());
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int j=0; j<nout; j++) {
+          int cj = lambda[j].second;
+          w(j) = lambda[j].first;
+          for(int i=0; i<n; i++) {
+            double s = 0;
+            for(int l=0; l<nk; l++)
+              s += Q[size_t(l)*n+i]*Z[size_t(cj)*nk+l];
+            V(i,j) = s;
+          }
+        }
+        return nconv;
+      }
+
+      // thick restart: keep the nKeep best Ritz vectors, the residual vector becomes column nKeep;
+      // H is diagonal in the kept part, the coupling to column nKeep is computed by the next Gram-Schmidt step
+      Qk.resize(size_t(nKeep)*n);
+      for(auto *X : {&Q, &MQ}) {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i=0; i<n; i++) {
+          for(int j=0; j<nKeep; j++) {
+            double s = 0;
+            for(int l=0; l<m; l++)
+              s += (*X)[size_t(l)*n+i]*Z[size_t(idx[j])*m+l];
+            Qk[size_t(j)*n+i] = s;
+          }
+        }
+        copy(X->begin()+size_t(m)*n,X->end(),X->begin()+size_t(nKeep)*n);
+        copy(Qk.begin(),Qk.end(),X->begin());
+      }
+      fill(H.begin(),H.end(),0.);
+      for(int j=0; j<nKeep; j++)
+        H[size_t(j)*m+j] = theta[idx[j]];
+      k = nKeep;
+    }
+  }
+
+}
@@ -0,0 +1,79 @@
+/*
+    MBSimGUI - A fronted for MBSim.
+    Copyright (C) 2022 Martin Förg
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#ifndef _SPARSE_EIGEN_SOLVER_H_
+#define _SPARSE_EIGEN_SOLVER_H_
+
+#include "fmatvec/fmatvec.h"
+#include <vector>
+#include <cstddef>
+
+namespace MBSimGUI {
+
+  /**
+   * \brief sparse LDL^T factorisation of A - sigma*M
+   *
+   * A and M are given in the upper triangular compressed row format of
+   * fmatvec::SymSparseMat and may have different sparsity patterns. The
+   * matrix is reordered by approximate minimum degree (cs_amd of CSparse)
+   * before the symbolic analysis. The rows of one level of the elimination tree
+   * are factorised in parallel. The factorisation is done once and can be used
+   * for any number of solves.
+   */
+  class SparseLDL {
+    public:
+      SparseLDL() = default;
+      SparseLDL(const fmatvec::SymSparseMat &A, double sigma=0, const fmatvec::SymSparseMat *M=nullptr);
+      SparseLDL(int n, const int *IpA, const int *JpA, const double *A, double sigma=0, const int *IpM=nullptr, const int *JpM=nullptr, const double *M=nullptr);
+
+      int size() const { return n; }
+      double getShift() const { return sigma; }
+      /*! number of nonzero elements of the factor L */
+      size_t nonZeroElements() const { return Li.size(); }
+      /*! memory used by the factorisation in bytes */
+      size_t getMemoryUsage() const;
+
+      /*! solve (A - sigma*M) x = b in place */
+      void solve(double *x) const;
+      fmatvec::VecV solve(const fmatvec::VecV &b) const;
+      /*! solve (A - sigma*M) X = B, the columns are solved in parallel */
+      fmatvec::MatV solve(const fmatvec::MatV &B) const;
+
+    private:
+      void factorize(const int *IpA, const int *JpA, const double *A, const int *IpM, const int *JpM, const double *M);
+      int n{0};
+      double sigma{0};
+      std::vector<int> perm, pinv, Lp, Li;
+      std::vector<double> Lx, D;
+  };
+
+  /**
+   * \brief computes the nev eigenpairs of K phi = lambda M phi closest to the shift of Kf
+   *
+   * Shift-invert Lanczos with full M-reorthogonalisation and thick restart, hence the basis has a fixed size
+   * of max(2*nev,nev+20) vectors. Kf is the factorisation of K - sigma*M,
+   * hence the factorisation used for static modes (sigma=0) can be reused for the eigenmodes.
+   * The eigenvalues are returned in ascending order, the eigenvectors are M-normalised.
+   * \return number of converged eigenpairs
+   */
+  int eigvecShiftInvert(const SparseLDL &Kf, const fmatvec::SymSparseMat &M, int nev, fmatvec::Mat &V, fmatvec::Vec &w, double tol=1e-8);
+
+}
+
+#endif
@@ -0,0 +1,145 @@
+/*
+    MBSimGUI - A fronted for MBSim.
+    Copyright (C) 2022 Martin Förg
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#ifndef _TEXT_PARSER_H_
+#define _TEXT_PARSER_H_
+
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <charconv>
+#include <stdexcept>
+#include <algorithm>
+
+namespace MBSimGUI {
+
+  /**
+   * \brief fast parser for large numerical text files (FE results)
+   *
+   * The file is read with one call into memory and the numbers are converted
+   * with std::from_chars. Numbers may be separated by white space, commas or
+   * semicolons; fixed format fields like "1-2.5E+00" are split correctly.
+   * Parse errors are thrown as std::runtime_error with file name and line.
+   */
+  class TextParser {
+    public:
+      TextParser(const std::string &fileName_) : fileName(fileName_) {
+        std::ifstream is(fileName, std::ios::binary);
+        if(not is)
+          throw std::runtime_error("(TextParser): can not open file " + fileName);
+        is.seekg(0, std::ios::end);
+        buf.resize(is.tellg());
+        is.seekg(0);
+        is.read(&buf[0], buf.size());
+        p = buf.data();
+        e = p + buf.size();
+      }
+
+      bool eof() const { return p>=e; }
+
+      /*! read the rest of the current line */
+      bool getline(std::string_view &line) {
+        if(p>=e) return false;
+        const char *n = p;
+        while(n<e and *n!='\n') n++;
+        line = std::string_view(p, n-p);
+        p = n<e ? n+1 : e;
+        return true;
+      }
+
+      /*! skip the rest of the current line */
+      void skipLine() { std::string_view line; getline(line); }
+
+      /*! read the next number */
+      double number() {
+        double x;
+        if(not number(x))
+          throw std::runtime_error(position() + ": (TextParser): unexpected end of file");
+        return x;
+      }
+
+      bool number(double &x) {
+        p = skipSeparators(p, e);
+        try {
+          return parse(p, e, x);
+        }
+        catch(const std::runtime_error &ex) {
+          throw std::runtime_error(position() + ": " + ex.what());
+        }
+      }
+
+      /*! file name and line of the current position (for error messages) */
+      std::string position() const {
+        return fileName + ":" + std::to_string(std::count(buf.data(), p, '\n')+1);
+      }
+
+      /*! read the next word separated by white space */
+      std::string_view word() {
+        p = skipSeparators(p, e);
+        const char *b = p;
+        while(p<e and not isSeparator(*p)) p++;
+        return std::string_view(b, p-b);
+      }
+
+      /*! true if the rest of the current line contains no further token */
+      bool atLineEnd() {
+        while(p<e and (*p==' ' or *p=='\t' or *p=='\r' or *p==',' or *p==';')) p++;
+        return p>=e or *p=='\n';
+      }
+
+      /*! remove the first word of s */
+      static void skipWord(std::string_view &s) {
+        size_t b = s.find_first_not_of(" \t\r");
+        size_t e = s.find_first_of(" \t\r", b);
+        s.remove_prefix(e==std::string_view::npos ? s.size() : e);
+      }
+
+      /*! parse the first number of s and remove it from s */
+      static double parseNumber(std::string_view &s) {
+        const char *b = skipSeparators(s.data(), s.data()+s.size());
+        double x;
+        if(not parse(b, s.data()+s.size(), x))
+          throw std::runtime_error("(TextParser): number expected");
+        s.remove_prefix(b-s.data());
+        return x;
+      }
+
+    private:
+      static bool isSeparator(char c) { return c==' ' or c=='\t' or c=='\r' or c=='\n' or c==',' or c==';'; }
+      static const char* skipSeparators(const char *p, const char *e) {
+        while(p<e and (isSeparator(*p) or (*p=='+' and p+1<e and not isSeparator(*(p+1))))) p++;
+        return p;
+      }
+      // convert the number at p and advance p
+      static bool parse(const char *&p, const char *e, double &x) {
+        if(p>=e) return false;
+        auto res = std::from_chars(p, e, x);
+        if(res.ec!=std::errc())
+          throw std::runtime_error("(TextParser): invalid number near \"" + std::string(p, std::min<size_t>(e-p, 20)) + "\"");
+        p = res.ptr;
+        return true;
+      }
+      std::string fileName;
+      std::string buf;
+      const char *p, *e;
+  };
+
+}
+
+#endif
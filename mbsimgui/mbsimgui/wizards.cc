@@ -703,31 +703,43 @@ namespace MBSimGUI {
   }
 
   void FlexibleBodyTool::create() {
-    if(hasVisitedPage(PageExtFE)) {
-      extfe();
-      if(hasVisitedPage(PageCMS))
-	cms();
-      else if(hasVisitedPage(PageModeShapes))
-	msm();
-      ombv();
-      lma();
-    }
-    else if(hasVisitedPage(PageCalculix)) {
-      calculix();
-      lma();
+    // the parsers of the input files throw on malformed data; report it instead of terminating the GUI
+    bool failed = false;
+    try {
+      if(hasVisitedPage(PageExtFE)) {
+        extfe();
+        if(hasVisitedPage(PageCMS))
+	  cms();
+        else if(hasVisitedPage(PageModeShapes))
+	  msm();
+        ombv();
+        lma();
+      }
+      else if(hasVisitedPage(PageCalculix)) {
+        calculix();
+        lma();
+      }
+      else if(hasVisitedPage(PageFlexibleBeam)) {
+        beam();
+        cms();
+        fma();
+      }
+      else if(hasVisitedPage(PageFiniteElements)) {
+        fe();
+        cms();
+        fma();
+      }
+      damp();
+      exp();
     }
-    else if(hasVisitedPage(PageFlexibleBeam)) {
-      beam();
-      cms();
-      fma();
+    catch(const exception &ex) {
+      QMessageBox::critical(this, "Flexible body tool", QString("Creating the flexible body failed:\n")+ex.what());
+      failed = true;
     }
-    else if(hasVisitedPage(PageFiniteElements)) {
-      fe();
-      cms();
-      fma();
+    catch(...) {
+      QMessageBox::critical(this, "Flexible body tool", "Creating the flexible body failed: unknown error.");
+      failed = true;
     }
-    damp();
-    exp();
 
     m = 0;
     rdm.init(0);
@@ -739,7 +751,8 @@ namespace MBSimGUI {
     Psi.clear();
     PPdm.clear();
     sigmahel.clear();
-    if(not Km.size()) {
+    // after a failure Ks and PPdm2s may still reference the arrays of a previous run, which are already deleted
+    if(not failed and not Km.size()) {
       delete Ks.Ip();
       delete Ks.Jp();
       delete PPdm2s[0].Ip();
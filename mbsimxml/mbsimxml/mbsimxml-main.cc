@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <cstring>
 #include <fstream>
+#include <chrono>
 #include <boost/dll.hpp>
 #include <mbxmlutilshelper/last_write_time.h>
 #include <mbxmlutilshelper/windows_signal_conversion.h>
@@ -82,7 +83,7 @@ int main(int argc, char *argv[]) {
        std::find(args.begin(), args.end(), "--help")!=args.end() ||
        std::find(args.begin(), args.end(), "-?")!=args.end()) {
       cout<<"Usage: mbsimxml [--onlypreprocess|--donotintegrate|--stopafterfirststep|"<<endl
-          <<"                 --autoreload [ms]|--dumpXMLCatalog <file>] [--savefinalstatevector]"<<endl
+          <<"                 --autoreload [ms]|--dumpXMLCatalog <file>] [--savefinalstatevector] [--cache]"<<endl
           <<"                [--modulePath <dir> [--modulePath <dir> ...]]"<<endl
           <<"                [--stdout <msg> [--stdout <msg> ...]] [--stderr <msg> [--stderr <msg> ...]]"<<endl
           <<"                [<paramname>=<value> [<paramname>=<value> ...]]"<<endl
@@ -98,6 +99,9 @@ int main(int argc, char *argv[]) {
           <<"--donotintegrate         Stop after the initialization stage, do not integrate"<<endl
           <<"--savefinalstatevector   Save the state vector to the file \"statevector.asc\" after integration"<<endl
           <<"--savestatetable         Save the state table to the file \"statetable.asc\""<<endl
+          <<"--cache                  Use and write a cache of the preprocessed project file in the user cache"<<endl
+          <<"                         directory (reused if no tracked input file has changed). Files read by"<<endl
+          <<"                         Python/Octave parameter code (e.g. open(), load()) are not tracked."<<endl
           <<"--stopafterfirststep     Stop after outputting the first step (usually at t=0)"<<endl
           <<"                         This generates a HDF5 output file with only one time serie"<<endl
           <<"--autoreload             Same as --stopafterfirststep but rerun mbsimxml each time"<<endl
@@ -176,8 +180,8 @@ int main(int argc, char *argv[]) {
       args.erase(i2);
     }
 
-    // create xml catalog
-    auto xmlCatalogDoc=MBSim::getMBSimXMLCatalog(searchDirs);
+    // create xml catalog (delayed, it is not needed if the cached preprocessed project file is used)
+    shared_ptr<xercesc::DOMDocument> xmlCatalogDoc;
 
     if((i=std::find(args.begin(), args.end(), "--dumpXMLCatalog"))!=args.end()) {
       i2=i; i2++;
@@ -186,6 +190,7 @@ int main(int argc, char *argv[]) {
         cerr<<"No filename specified after --dumpXMLCatalog."<<endl;
         return 1;
       }
+      xmlCatalogDoc=MBSim::getMBSimXMLCatalog(searchDirs);
       DOMParser::serialize(xmlCatalogDoc->getDocumentElement(), *i2);
       args.erase(i2);
       args.erase(i);
@@ -222,6 +227,12 @@ int main(int argc, char *argv[]) {
       args.erase(i);
     }
 
+    bool useCache=false;
+    if((i=std::find(args.begin(), args.end(), "--cache"))!=args.end()) {
+      useCache=true;
+      args.erase(i);
+    }
+
     int AUTORELOADTIME=0;
     if((i=std::find(args.begin(), args.end(), "--autoreload"))!=args.end()) {
       i2=i; i2++;
@@ -265,50 +276,12 @@ int main(int argc, char *argv[]) {
       vector<bfs::path> dependencies;
 
       try {
-        // run preprocessor
-
-        // validate the project file with mbsimxml.xsd
-        Preprocess preprocess(MBSIMPRJ, xmlCatalogDoc->getDocumentElement(), AUTORELOADTIME>0);
-
-        // check Embed elements
-        {
-          auto checkEmbed = [](xercesc::DOMElement *e, const FQN &eleName, bool allowHref) {
-            if(E(e)->getTagName()==PV%"Embed") {
-              if(E(e)->hasAttribute("counterName") || E(e)->hasAttribute("count") ||
-                 (E(e)->hasAttribute("onlyif") && E(e)->getAttribute("onlyif")!="1"))
-                throw runtime_error("A Embed element on "+eleName.second+" level is not allowed to have a counterName, count or onlyif attribute.");
-              if(!allowHref && E(e)->hasAttribute("href"))
-                throw runtime_error("A Embed element on "+eleName.second+" level is not allowed to have a href attribute.");
-            }
-          };
-
-          auto root = preprocess.getDOMDocument()->getDocumentElement();
-          xercesc::DOMElement *mbsimProject;
-          checkEmbed(root, PV%"MBSimProject", false);
-          if(E(root)->getTagName()==PV%"Embed")
-            mbsimProject = root->getLastElementChild();
-          else
-            mbsimProject = root;
-          checkEmbed(mbsimProject->getFirstElementChild(), MBSIM%"DynamicSystemSolver", true);
-          checkEmbed(mbsimProject->getLastElementChild(), MBSIM%"Solver", true);
-        }
-
-        // create parameter override ParamSet
-        auto eval=preprocess.getEvaluator();
-        auto param = make_shared<Preprocess::ParamSet>();
-        for(auto &pa : paramArg) {
-          auto pos = pa.find('=');
-          (*param)[pa.substr(0, pos)]=eval->eval(pa.substr(pos+1));
-        }
-        auto overrideParam(*param);
-        preprocess.setParam(param);
-
-        // validate the project file with mbsimxml.xsd
-        auto mainXMLDoc = preprocess.processAndGetDocument();
+        auto start=chrono::steady_clock::now();
 
+        // load MBSim modules (before preprocessing since the loaded module libraries are part of the cache key)
+        set<bfs::path> moduleLibs;
         if(!ONLYPP) {
-          // load MBSim modules
-          MBSimXML::loadModules(searchDirs);
+          moduleLibs=MBSimXML::loadModules(searchDirs);
           // check for errors during ObjectFactory
           string errorMsg3(ObjectFactory::getAndClearErrorMsg());
           if(!errorMsg3.empty()) {
@@ -317,7 +290,73 @@ int main(int argc, char *argv[]) {
             cerr<<"Exiting now."<<endl;
             return 1;
           }
+        }
+        auto endModules=chrono::steady_clock::now();
+
+        // use the cached flat document if no input has changed since the last run
+        ModelCache modelCache(MBSIMPRJ, paramArg, searchDirs, moduleLibs);
+        shared_ptr<xercesc::DOMDocument> mainXMLDoc;
+        if(useCache && !ONLYPP)
+          mainXMLDoc=modelCache.load();
+        bool cached=mainXMLDoc!=nullptr;
+        unique_ptr<Preprocess> preprocessPtr;
+        if(cached) {
+          fmatvec::Atom::msgStatic(fmatvec::Atom::Info)<<"Use cached preprocessed project file"<<endl;
+          dependencies=modelCache.getDependencies();
+        }
+        else {
+          // run preprocessor
+
+          // validate the project file with mbsimxml.xsd
+          if(!xmlCatalogDoc)
+            xmlCatalogDoc=MBSim::getMBSimXMLCatalog(searchDirs);
+          preprocessPtr=make_unique<Preprocess>(MBSIMPRJ, xmlCatalogDoc->getDocumentElement(), AUTORELOADTIME>0 || useCache);
+          auto &preprocess=*preprocessPtr;
 
+          // check Embed elements
+          {
+            auto checkEmbed = [](xercesc::DOMElement *e, const FQN &eleName, bool allowHref) {
+              if(E(e)->getTagName()==PV%"Embed") {
+                if(E(e)->hasAttribute("counterName") || E(e)->hasAttribute("count") ||
+                   (E(e)->hasAttribute("onlyif") && E(e)->getAttribute("onlyif")!="1"))
+                  throw runtime_error("A Embed element on "+eleName.second+" level is not allowed to have a counterName, count or onlyif attribute.");
+                if(!allowHref && E(e)->hasAttribute("href"))
+                  throw runtime_error("A Embed element on "+eleName.second+" level is not allowed to have a href attribute.");
+              }
+            };
+
+            auto root = preprocess.getDOMDocument()->getDocumentElement();
+            xercesc::DOMElement *mbsimProject;
+            checkEmbed(root, PV%"MBSimProject", false);
+            if(E(root)->getTagName()==PV%"Embed")
+              mbsimProject = root->getLastElementChild();
+            else
+              mbsimProject = root;
+            checkEmbed(mbsimProject->getFirstElementChild(), MBSIM%"DynamicSystemSolver", true);
+            checkEmbed(mbsimProject->getLastElementChild(), MBSIM%"Solver", true);
+          }
+
+          // create parameter override ParamSet
+          auto eval=preprocess.getEvaluator();
+          auto param = make_shared<Preprocess::ParamSet>();
+          for(auto &pa : paramArg) {
+            auto pos = pa.find('=');
+            (*param)[pa.substr(0, pos)]=eval->eval(pa.substr(pos+1));
+          }
+          auto overrideParam(*param);
+          preprocess.setParam(param);
+
+          // validate the project file with mbsimxml.xsd
+          mainXMLDoc = preprocess.processAndGetDocument();
+
+          if(useCache)
+            modelCache.save(mainXMLDoc, preprocess.getDependencies());
+          if(AUTORELOADTIME>0)
+            dependencies = preprocess.getDependencies();
+        }
+        auto endPP=chrono::steady_clock::now();
+
+        if(!ONLYPP) {
           auto e=mainXMLDoc->getDocumentElement();
           // create object for DynamicSystemSolver and check correct type
           e=E(e)->getFirstElementChildNamed(MBSIM%"DynamicSystemSolver");
@@ -328,16 +367,21 @@ int main(int argc, char *argv[]) {
           fmatvec::Atom::msgStatic(fmatvec::Atom::Info)<<"Instantiate Solver"<<endl;
           auto solver=unique_ptr<Solver>(ObjectFactory::createAndInit<Solver>(e->getNextElementSibling()));
 
+          auto endInstantiate=chrono::steady_clock::now();
+
           // init dss
           if(doNotIntegrate)
             dss->setTruncateSimulationFiles(false);
           dss->initialize();
+          auto endInit=chrono::steady_clock::now();
+          fmatvec::Atom::msgStatic(fmatvec::Atom::Info)<<"Startup wall clock times: module loading "
+            <<chrono::duration<double>(endModules-start).count()<<", preprocessing"<<(cached?" (cached)":"")<<" "
+            <<chrono::duration<double>(endPP-endModules).count()
+            <<", instantiation "<<chrono::duration<double>(endInstantiate-endPP).count()
+            <<", initialization "<<chrono::duration<double>(endInit-endInstantiate).count()<<endl;
 
           MBSimXML::main(solver, dss, doNotIntegrate, stopAfterFirstStep, savestatevector, savestatetable);
         }
-
-        if(AUTORELOADTIME>0)
-          dependencies = preprocess.getDependencies();
       }
       catch(const exception &ex) {
         fmatvec::Atom::msgStatic(fmatvec::Atom::Error)<<ex.what()<<endl;
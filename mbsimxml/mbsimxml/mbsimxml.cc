@@ -7,6 +7,11 @@
 #include <xercesc/dom/DOMDocument.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/algorithm/string.hpp>
+#include <iomanip>
+#include <cstdint>
+#include <sstream>
+#include <functional>
+#include <cstdlib>
 
 namespace bfs=boost::filesystem;
 using namespace std;
@@ -51,6 +56,27 @@ void initPython() {
   isInitialized=true;
 }
 
+// the given module search directories plus the default ones and the ones from the configuration file
+set<bfs::path> allModuleSearchDirs(const set<bfs::path> &searchDirs) {
+  set<bfs::path> allSearchDirs=searchDirs;
+  allSearchDirs.insert(installPath()/"share"/"mbsimmodules");
+  allSearchDirs.insert(bfs::current_path());
+  // add directories from configuration file
+#ifdef _WIN32
+  boost::filesystem::path modulePathConfigFile(
+    boost::filesystem::path(getenv("APPDATA")?getenv("APPDATA"):"")/"mbsim-env"/"mbsimxml.modulepath");
+#else
+  boost::filesystem::path modulePathConfigFile(
+    boost::filesystem::path(getenv("HOME")?getenv("HOME"):"")/".config"/"mbsim-env"/"mbsimxml.modulepath");
+#endif
+  if(boost::filesystem::exists(modulePathConfigFile)) {
+    boost::filesystem::ifstream modulePathConfig(modulePathConfigFile);
+    for(string line; getline(modulePathConfig, line);)
+      allSearchDirs.insert(line);
+  }
+  return allSearchDirs;
+}
+
 }
 
 namespace MBSim {
@@ -69,22 +95,7 @@ shared_ptr<DOMDocument> getMBSimXMLCatalog(const set<bfs::path> &searchDirs) {
   std::shared_ptr<DOMParser> parser;
   parser=DOMParser::create({MBXMLUTILSSCHEMA/"http___www_mbsim-env_de_MBSimModule"/"mbsimmoduleCatalog.xml"});
 
-  set<bfs::path> allSearchDirs=searchDirs;
-  allSearchDirs.insert(installPath()/"share"/"mbsimmodules");
-  allSearchDirs.insert(bfs::current_path());
-  // add directories from configuration file
-#ifdef _WIN32
-  boost::filesystem::path modulePathConfigFile(
-    boost::filesystem::path(getenv("APPDATA")?getenv("APPDATA"):"")/"mbsim-env"/"mbsimxml.modulepath");
-#else
-  boost::filesystem::path modulePathConfigFile(
-    boost::filesystem::path(getenv("HOME")?getenv("HOME"):"")/".config"/"mbsim-env"/"mbsimxml.modulepath");
-#endif
-  if(boost::filesystem::exists(modulePathConfigFile)) {
-    boost::filesystem::ifstream modulePathConfig(modulePathConfigFile);
-    for(string line; getline(modulePathConfig, line);)
-      allSearchDirs.insert(line);
-  }
+  set<bfs::path> allSearchDirs=allModuleSearchDirs(searchDirs);
 
   // read MBSim module schemas
   enum Stage { SearchPath, Loading }; // we load in two stages: first just add all search path then do the real load
@@ -156,4 +167,154 @@ shared_ptr<DOMDocument> getMBSimXMLCatalog(const set<bfs::path> &searchDirs) {
   return xmlCatalogDoc;
 }
 
+ModelCache::ModelCache(const bfs::path &mbsimprj_, set<string> paramArg_, set<bfs::path> searchDirs_, set<bfs::path> moduleLibs_) :
+  mbsimprj(bfs::absolute(mbsimprj_)), paramArg(std::move(paramArg_)), searchDirs(std::move(searchDirs_)), moduleLibs(std::move(moduleLibs_)) {
+  // user cache directory; nothing is written next to the project, which may be read-only or under version control
+#ifdef _WIN32
+  const char *base=getenv("LOCALAPPDATA");
+  bfs::path dir=base ? bfs::path(base)/"mbsim-env"/"cache"/"mbsimxml" : bfs::path();
+#else
+  const char *xdg=getenv("XDG_CACHE_HOME");
+  const char *home=getenv("HOME");
+  bfs::path dir=xdg && *xdg ? bfs::path(xdg)/"mbsim-env"/"mbsimxml" : home ? bfs::path(home)/".cache"/"mbsim-env"/"mbsimxml" : bfs::path();
+#endif
+  boost::system::error_code ec;
+  if(dir.empty() || (bfs::create_directories(dir, ec), ec)) {
+    fmatvec::Atom::msgStatic(fmatvec::Atom::Warn)<<"No user cache directory available, the model cache is not used"<<endl;
+    return;
+  }
+  // one cache per project file
+  ostringstream name;
+  name<<mbsimprj.filename().string()<<"-"<<hex<<setw(16)<<setfill('0')<<std::hash<string>()(mbsimprj.lexically_normal().string());
+  cacheFile=dir/(name.str()+".cache");
+  flatFile=dir/(name.str()+".flat.mbsx");
+}
+
+string ModelCache::hash(const vector<bfs::path> &deps) const {
+  // 64 bit FNV-1a hash; a new version of mbsimxml may preprocess differently, hence the version is hashed too
+  uint64_t h=14695981039346656037ull;
+  auto add=[&h](const string &str) {
+    for(unsigned char c : str) {
+      h^=c;
+      h*=1099511628211ull;
+    }
+    h^=0xff; // separator
+    h*=1099511628211ull;
+  };
+  // path, size and modification time of a file (a content hash would be too expensive for libraries)
+  auto addStat=[&add](const bfs::path &p) {
+    boost::system::error_code ec;
+    add(p.string());
+    add(to_string(bfs::file_size(p, ec)));
+    add(to_string(bfs::last_write_time(p, ec)));
+  };
+  add(PACKAGE_VERSION);
+  for(auto &p : paramArg)
+    add(p);
+
+  // the modules: search directories, module description files and module libraries
+  for(auto &dir : allModuleSearchDirs(searchDirs)) {
+    add(dir.string());
+    boost::system::error_code ec;
+    set<bfs::path> moduleFiles; // sorted, the order of the directory iterator is unspecified
+    for(auto it=bfs::directory_iterator(dir, ec); !ec && it!=bfs::directory_iterator(); it.increment(ec))
+      if(boost::algorithm::ends_with(it->path().string(), ".mbsimmodule.xml"))
+        moduleFiles.insert(it->path());
+    for(auto &moduleFile : moduleFiles) {
+      bfs::ifstream file(moduleFile, ios::binary);
+      add(moduleFile.string());
+      add(string(istreambuf_iterator<char>(file), istreambuf_iterator<char>()));
+    }
+  }
+  for(auto &lib : moduleLibs)
+    addStat(lib);
+
+  // the Python and Octave search paths used by the evaluators
+  for(auto var : {"PYTHONPATH", "PYTHONHOME", "OCTAVE_PATH", "OCTAVE_HOME"}) {
+    const char *value=getenv(var);
+    add(value?value:"");
+    if(!value)
+      continue;
+    vector<string> dirs;
+#ifdef _WIN32
+    boost::algorithm::split(dirs, value, boost::algorithm::is_any_of(";"));
+#else
+    boost::algorithm::split(dirs, value, boost::algorithm::is_any_of(":"));
+#endif
+    for(auto &dir : dirs) {
+      boost::system::error_code ec;
+      set<bfs::path> files;
+      for(auto it=bfs::directory_iterator(dir, ec); !ec && it!=bfs::directory_iterator(); it.increment(ec))
+        files.insert(it->path());
+      for(auto &f : files)
+        addStat(f);
+    }
+  }
+  {
+    boost::system::error_code ec;
+    set<bfs::path> files;
+    for(auto it=bfs::directory_iterator(installPath().parent_path()/"mbsim-env-python-site-packages", ec);
+        !ec && it!=bfs::directory_iterator(); it.increment(ec))
+      files.insert(it->path());
+    for(auto &f : files)
+      addStat(f);
+  }
+
+  for(auto &dep : deps) {
+    bfs::ifstream file(dep, ios::binary);
+    if(!file)
+      return "";
+    add(dep.string());
+    add(string(istreambuf_iterator<char>(file), istreambuf_iterator<char>()));
+  }
+  ostringstream str;
+  str<<hex<<setw(16)<<setfill('0')<<h;
+  return str.str();
+}
+
+shared_ptr<DOMDocument> ModelCache::load() {
+  if(cacheFile.empty())
+    return nullptr;
+  bfs::ifstream file(cacheFile);
+  string storedHash;
+  if(!getline(file, storedHash) || !bfs::exists(flatFile))
+    return nullptr;
+  vector<bfs::path> deps;
+  for(string line; getline(file, line);)
+    deps.emplace_back(line);
+  string h=hash(deps);
+  if(h.empty() || h!=storedHash)
+    return nullptr;
+  dependencies=deps;
+  parser=DOMParser::create();
+  auto doc=parser->parse(flatFile, nullptr, false);
+  // the flat document is stored in the cache directory, but relative paths in it refer to the project file
+  doc->setDocumentURI(X()%mbsimprj.string());
+  return doc;
+}
+
+void ModelCache::save(const shared_ptr<DOMDocument> &doc, const vector<bfs::path> &dependencies_) {
+  dependencies.clear();
+  dependencies.push_back(mbsimprj);
+  for(auto &dep : dependencies_)
+    if(bfs::absolute(dep)!=mbsimprj)
+      dependencies.push_back(bfs::absolute(dep));
+  if(cacheFile.empty())
+    return;
+  try {
+    // the hash is written last: a incomplete cache is never used
+    bfs::remove(cacheFile);
+    DOMParser::serialize(doc->getDocumentElement(), flatFile);
+    bfs::ofstream file(cacheFile);
+    file<<hash(dependencies)<<endl;
+    for(auto &dep : dependencies)
+      file<<dep.string()<<endl;
+    if(!file)
+      throw runtime_error("Cannot write "+cacheFile.string());
+  }
+  catch(const exception &ex) {
+    fmatvec::Atom::msgStatic(fmatvec::Atom::Warn)<<"Cannot save the model cache: "<<ex.what()<<endl;
+  }
+}
+
 }
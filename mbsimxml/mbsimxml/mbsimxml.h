@@ -3,11 +3,48 @@
 
 #include <boost/filesystem.hpp>
 #include <mbxmlutilshelper/dom.h>
+#include <set>
+#include <vector>
 
 namespace MBSim {
 
   std::shared_ptr<xercesc::DOMDocument> getMBSimXMLCatalog(const std::set<boost::filesystem::path> &searchDirs={}); //MISSING remove ={} if mbsimfmi supports searchDirs
 
+  /*! Cache of the preprocessed (flat) MBSim project file (only used with --cache).
+   * The flat document is saved as <prjfile>-<hash of the path>.flat.mbsx in the user cache directory
+   * ($XDG_CACHE_HOME/mbsim-env/mbsimxml, ~/.cache/mbsim-env/mbsimxml or %LOCALAPPDATA%\mbsim-env\cache\mbsimxml);
+   * when loaded, its document URI is set to the project file, such that relative paths are still valid. The file
+   * <prjfile>-<hash of the path>.cache stores a content hash of the project file, of all files the preprocessing
+   * depends on and of the parameter overrides, followed by the list of these dependencies.
+   * The flat document is only reused if the hash is unchanged.
+   * The hash also covers the environment of the preprocessor: the module search directories, the content of all
+   * *.mbsimmodule.xml files found there, the path, size and modification time of the loaded module libraries and
+   * the Python and Octave search paths (environment variables and the files directly in these directories).
+   * Files opened by Python/Octave parameter code (e.g. open(), load()) are not tracked; hence, the cache is opt-in. */
+  class ModelCache {
+    public:
+      ModelCache(const boost::filesystem::path &mbsimprj_, std::set<std::string> paramArg_,
+                 std::set<boost::filesystem::path> searchDirs_, std::set<boost::filesystem::path> moduleLibs_);
+
+      //! return the cached flat document or nullptr if the cache does not exist or is outdated
+      std::shared_ptr<xercesc::DOMDocument> load();
+
+      //! save the flat document doc created by preprocessing which depends on the files dependencies
+      void save(const std::shared_ptr<xercesc::DOMDocument> &doc, const std::vector<boost::filesystem::path> &dependencies_);
+
+      //! the dependencies of the cached or saved document
+      const std::vector<boost::filesystem::path>& getDependencies() const { return dependencies; }
+
+    private:
+      std::string hash(const std::vector<boost::filesystem::path> &deps) const;
+
+      boost::filesystem::path mbsimprj, cacheFile, flatFile;
+      std::set<std::string> paramArg;
+      std::set<boost::filesystem::path> searchDirs, moduleLibs;
+      std::vector<boost::filesystem::path> dependencies;
+      std::shared_ptr<MBXMLUtils::DOMParser> parser;
+  };
+
 }
 
 #endif
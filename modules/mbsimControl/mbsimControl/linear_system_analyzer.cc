@@ -24,8 +24,15 @@
 #include "mbsimControl/extern_signal_sink.h"
 #include "mbsim/dynamic_system_solver.h"
 #include "mbsim/utils/eps.h"
+#include "mbsim/utils/fork_utils.h"
 #include "fmatvec/linear_algebra_complex.h"
 #include "hdf5serie/simpledataset.h"
+#include <thread>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 using namespace fmatvec;
@@ -42,6 +49,89 @@ namespace MBSimControl {
     return y;
   }
 
+  // reduce A to upper Hessenberg form H=Q^T*A*Q by Householder reflections
+  void hessenberg(const SqrMat &A, SqrMat &H, SqrMat &Q) {
+    int n = A.size();
+    H <<= A;
+    Q <<= SqrMat(n,Eye());
+    Vec v(n,NONINIT);
+    // columns with a subdiagonal part below this tolerance are already reduced
+    double tol = 0;
+    for(int i=0; i<n; i++)
+      for(int j=0; j<n; j++)
+        tol = max(tol, fabs(A(i,j)));
+    tol *= macheps;
+    for(int k=0; k<n-2; k++) {
+      double alpha = 0;
+      for(int i=k+1; i<n; i++)
+        alpha += H(i,k)*H(i,k);
+      alpha = sqrt(alpha);
+      if(alpha<=tol)
+        continue;
+      if(H(k+1,k)>0)
+        alpha = -alpha;
+      // the sign of alpha avoids cancellation: v^T*v = 2*alpha*(alpha-H(k+1,k)) >= 2*alpha^2 > 0
+      double vv = 0;
+      for(int i=k+1; i<n; i++) {
+        v(i) = H(i,k);
+        if(i==k+1) v(i) -= alpha;
+        vv += v(i)*v(i);
+      }
+      // H = P*H*P and Q = Q*P with P = I - 2*v*v^T/(v^T*v)
+      for(int j=k; j<n; j++) {
+        double s = 0;
+        for(int i=k+1; i<n; i++)
+          s += v(i)*H(i,j);
+        s *= 2/vv;
+        for(int i=k+1; i<n; i++)
+          H(i,j) -= s*v(i);
+      }
+      for(int i=0; i<n; i++) {
+        double sH = 0, sQ = 0;
+        for(int j=k+1; j<n; j++) {
+          sH += H(i,j)*v(j);
+          sQ += Q(i,j)*v(j);
+        }
+        sH *= 2/vv;
+        sQ *= 2/vv;
+        for(int j=k+1; j<n; j++) {
+          H(i,j) -= sH*v(j);
+          Q(i,j) -= sQ*v(j);
+        }
+      }
+      for(int i=k+2; i<n; i++)
+        H(i,k) = 0;
+    }
+  }
+
+  // solve (s*I-H)*x = b for a upper Hessenberg matrix H with O(n^2) operations; x contains b on input and M is a
+  // workspace of size n, which is allocated once for all frequencies
+  void slvHessenberg(const SqrMat &H, complex<double> s, Vector<Ref,complex<double>> &x, SquareMatrix<Ref,complex<double>> &M) {
+    int n = H.size();
+    for(int j=0; j<n; j++) {
+      for(int i=0; i<=min(j+1,n-1); i++)
+        M(i,j) = -H(i,j);
+      M(j,j) += s;
+    }
+    // Gaussian elimination with partial pivoting; only one subdiagonal element per column
+    for(int k=0; k<n-1; k++) {
+      if(abs(M(k+1,k))>abs(M(k,k))) {
+        for(int j=k; j<n; j++)
+          swap(M(k,j),M(k+1,j));
+        swap(x(k),x(k+1));
+      }
+      complex<double> l = M(k+1,k)/M(k,k);
+      for(int j=k+1; j<n; j++)
+        M(k+1,j) -= l*M(k,j);
+      x(k+1) -= l*x(k);
+    }
+    for(int i=n-1; i>=0; i--) {
+      for(int j=i+1; j<n; j++)
+        x(i) -= M(i,j)*x(j);
+      x(i) /= M(i,i);
+    }
+  }
+
   MBSIM_OBJECTFACTORY_REGISTERCLASS(MBSIMCONTROL, LinearSystemAnalyzer)
 
   LinearSystemAnalyzer::~LinearSystemAnalyzer() {
@@ -123,51 +213,140 @@ namespace MBSimControl {
     system->computeInitialCondition();
     zEq = system->getState();
     Vec zd0 = system->evalzd();
-    Vec sigsi0(nsink), sigsi1(nsink);
-    int j=0;
-    for(auto & i : sink) {
-      sigsi0.set(RangeV(j,j+i->getSignalSize()-1), i->evalSignal());
-      j+=i->getSignalSize();
-    }
-    for(int i=0; i<system->getzSize(); i++) {
-      double ztmp = system->getState()(i);
-      system->getState()(i) += epsroot;
-      system->resetUpToDate();
-      Vec zd1 = system->evalzd();
-      A.set(i, (zd1 - zd0) / epsroot);
-      system->getState()(i) = ztmp;
-    }
+    Vec sigsi0(nsink), sigsi1(nsink), sigsi2(nsink);
+    auto evalSinks = [&sink](Vec &sigsi) {
+      int j=0;
+      for(auto & i : sink) {
+        sigsi.set(RangeV(j,j+i->getSignalSize()-1), i->evalSignal());
+        j+=i->getSignalSize();
+      }
+    };
+    evalSinks(sigsi0);
 
-    for(size_t i=0, l=0; i<source.size(); i++) {
+    // column j<nz of [A;C] and column j-nz of [B;D] by finite differences (one sided or central); A and C are build
+    // by the same perturbation of the state
+    double delta = central ? cbrt(macheps) : epsroot;
+    int nz = system->getzSize();
+    vector<pair<int,int>> inputIndex; // source and signal component of each input
+    for(size_t i=0; i<source.size(); i++)
+      for(int k=0; k<source[i]->getSignalSize(); k++)
+        inputIndex.emplace_back(i,k);
+    auto setInput = [&source, &inputIndex, this](int l, double d) {
+      int i = inputIndex[l].first;
+      int l0 = l-inputIndex[l].second;
       Vec sigso(source[i]->getSignalSize());
-      for(int k=0; k<source[i]->getSignalSize(); k++, l++) {
-	sigso(k) = u0(l) + epsroot;
-	source[i]->setSignal(sigso);
-	system->resetUpToDate();
-	Vec zd1 = system->evalzd();
-	B.set(l, (zd1 - zd0) / epsroot);
-	j=0;
-	for(auto & m : sink) {
-	  sigsi1.set(RangeV(j,j+m->getSignalSize()-1), m->evalSignal());
-	  j+=m->getSignalSize();
-	}
-	D.set(l, (sigsi1 - sigsi0) / epsroot);
-	sigso(k) = u0(l);
-	source[i]->setSignal(sigso);
+      for(int k=0; k<source[i]->getSignalSize(); k++)
+        sigso(k) = u0(l0+k);
+      sigso(inputIndex[l].second) += d;
+      source[i]->setSignal(sigso);
+    };
+    auto evalColumn = [&](int j, Vec &col) {
+      auto perturb = [&](double d) {
+        if(j<nz) {
+          system->getState()(j) = zEq(j) + d;
+          system->resetUpToDate();
+        }
+        else {
+          // a perturbation of the inputs does not change the state dependent quantities; if the kinematics depend on
+          // signals (e.g. kinematic excitations driven by signals) resetForcesUpToDate performs a full reset
+          setInput(j-nz, d);
+          system->resetForcesUpToDate();
+        }
+      };
+      perturb(delta);
+      Vec zd1 = system->evalzd();
+      evalSinks(sigsi1);
+      if(central) {
+        perturb(-delta);
+        Vec zd2 = system->evalzd();
+        evalSinks(sigsi2);
+        col.set(RangeV(0,nz-1), (zd1 - zd2) / (2*delta));
+        if(nsink) col.set(RangeV(nz,nz+nsink-1), (sigsi1 - sigsi2) / (2*delta));
+      }
+      else {
+        col.set(RangeV(0,nz-1), (zd1 - zd0) / delta);
+        if(nsink) col.set(RangeV(nz,nz+nsink-1), (sigsi1 - sigsi0) / delta);
+      }
+      if(j<nz)
+        system->getState()(j) = zEq(j);
+      else
+        setInput(j-nz, 0);
+    };
+    auto setColumn = [&](int j, const Vec &col) {
+      if(j<nz) {
+        A.set(j, col(RangeV(0,nz-1)));
+        if(nsink) C.set(j, col(RangeV(nz,nz+nsink-1)));
+      }
+      else {
+        B.set(j-nz, col(RangeV(0,nz-1)));
+        if(nsink) D.set(j-nz, col(RangeV(nz,nz+nsink-1)));
+      }
+    };
+
+    int nCol = nz+nsource;
+    int nProc = min(nProcesses>0 ? nProcesses : int(max(1u, thread::hardware_concurrency())), nCol);
+    Vec col(nz+nsink,NONINIT);
+    if(nProc<=1 or not ForkUtils::isAvailable()) {
+      for(int j=0; j<nCol; j++) {
+        evalColumn(j, col);
+        setColumn(j, col);
       }
     }
-    for(int i=0; i<system->getzSize(); i++) {
-      double ztmp = system->getState()(i);
-      system->getState()(i) += epsroot;
-      system->resetUpToDate();
-      j=0;
-      for(auto & k : sink) {
-	sigsi1.set(RangeV(j,j+k->getSignalSize()-1), k->evalSignal());
-	j+=k->getSignalSize();
+    else {
+#ifndef _WIN32
+      // the columns are evaluated in forked processes, which are independent copies of the system (see ForkUtils); the
+      // process p evaluates the columns p, p+nProc, ... and sends them through a pipe
+      if(not ForkUtils::isSingleThreaded())
+        throwError("(LinearSystemAnalyzer::execute): the process has more than one thread (e.g. an OpenMP thread pool) and can not be forked; set numberOfProcesses to 1 or OMP_NUM_THREADS=1");
+      ForkUtils::flushBeforeFork();
+      vector<pid_t> pid(nProc, -1);
+      vector<int> fd(nProc, -1);
+      for(int p=0; p<nProc; p++) {
+        int pfd[2];
+        if(pipe(pfd)!=0)
+          throwError("(LinearSystemAnalyzer::execute): cannot create pipe");
+        pid[p] = fork();
+        if(pid[p]<0)
+          throwError("(LinearSystemAnalyzer::execute): cannot fork");
+        if(pid[p]==0) {
+          close(pfd[0]);
+          bool ok = true;
+          try {
+            for(int j=p; j<nCol and ok; j+=nProc) {
+              evalColumn(j, col);
+              ok = ForkUtils::writeAll(pfd[1], reinterpret_cast<const char*>(col()), col.size()*sizeof(double));
+            }
+          }
+          catch(const exception &ex) {
+            msg(Error)<<"(LinearSystemAnalyzer::execute): perturbation failed: "<<ex.what()<<endl;
+            ok = false;
+          }
+          catch(...) {
+            ok = false;
+          }
+          close(pfd[1]);
+          _exit(ok ? 0 : 1);
+        }
+        close(pfd[1]);
+        fd[p] = pfd[0];
+      }
+      bool ok = true;
+      for(int p=0; p<nProc; p++) {
+        for(int j=p; j<nCol and ok; j+=nProc) {
+          ok = ForkUtils::readAll(fd[p], reinterpret_cast<char*>(col()), col.size()*sizeof(double));
+          if(ok)
+            setColumn(j, col);
+        }
+        close(fd[p]);
+        int status;
+        waitpid(pid[p], &status, 0);
+        ok = ok and WIFEXITED(status) and WEXITSTATUS(status)==0;
       }
-      C.set(i, (sigsi1 - sigsi0) / epsroot);
-      system->getState()(i) = ztmp;
+      if(not ok)
+        throwError("(LinearSystemAnalyzer::execute): evaluation of the system matrices failed");
+#endif
     }
+    system->resetUpToDate();
 
     SquareMatrix<Ref,complex<double>> V;
     Vector<Ref,complex<double>> w;
@@ -198,18 +377,41 @@ namespace MBSimControl {
       Yhna.set(i,yh);
     }
 
+    // A=Q*Hs*Q^T: each frequency of the response costs O(n^2) instead of a LU decomposition
+    SqrMat Hs, Q;
+    SquareMatrix<Ref,complex<double>> Ms;
+    Vector<Ref,complex<double>> cs;
+    if(fex.size() or fap.size()) {
+      hessenberg(A,Hs,Q);
+      Ms.resize(A.size(),NONINIT);
+      cs.resize(A.size(),NONINIT);
+    }
+    auto slvFrequencyResponse = [&Hs, &Q, &Ms, &cs](complex<double> iOm, const Vector<Ref,complex<double>> &b) {
+      int n = Q.size();
+      Vector<Ref,complex<double>> z(n);
+      for(int i=0; i<n; i++) {
+        cs(i) = 0;
+        for(int j=0; j<n; j++)
+          cs(i) += Q(j,i)*b(j);
+      }
+      slvHessenberg(Hs, iOm, cs, Ms);
+      for(int i=0; i<n; i++)
+        for(int j=0; j<n; j++)
+          z(i) += Q(i,j)*cs(j);
+      return z;
+    };
+
     Matrix<General,Ref,Ref,complex<double>> Zhex(system->getzSize(),fex.size(),NONINIT);
     Matrix<General,Ref,Ref,complex<double>> Yhex(nsink,fex.size(),NONINIT);
     Vector<Ref,complex<double>> u(nsource);
     for(int i=0; i<fex.size(); i++) {
       amp = (*Amp)(fex(i));
       if(Phi) phi = (*Phi)(fex(i));
-      SquareMatrix<Ref,complex<double>> H = SquareMatrix<Ref,complex<double>>(A.size(),Eye(),complex<double>(0,2*M_PI*fex(i))) - A;
       for(int j=0; j<nsource; j++) {
 	u(j).real(amp(j)*cos(phi(j)));
 	u(j).imag(-amp(j)*sin(phi(j)));
       }
-      Vector<Ref,complex<double>> zh = slvLU(H, B*u);
+      Vector<Ref,complex<double>> zh = slvFrequencyResponse(complex<double>(0,2*M_PI*fex(i)), B*u);
       Vector<Ref,complex<double>> yh = C*zh + D*u;
       Zhex.set(i,zh);
       Yhex.set(i,yh);
@@ -341,10 +543,9 @@ namespace MBSimControl {
       for(size_t i=0; i<fap.size(); i++) {
 	for(int j=0; j<fap[i].rows(); j++) {
 	  iOm.emplace_back(0,2*M_PI*fap[i](j,0));
-	  SquareMatrix<Ref,complex<double>> H = SquareMatrix<Ref,complex<double>>(A.size(),Eye(),iOm[iOm.size()-1]) - A;
 	  u(i).real(fap[i](j,1)*cos(fap[i](j,2)));
 	  u(i).imag(-fap[i](j,1)*sin(fap[i](j,2)));
-	  zh.push_back(slvLU(H, B*u));
+	  zh.push_back(slvFrequencyResponse(iOm[iOm.size()-1], B*u));
 	  szh += zh[zh.size()-1];
 	}
 	u(i) = complex<double>(0,0);
@@ -388,6 +589,10 @@ namespace MBSimControl {
     if(e) setInitialState(E(e)->getText<Vec>());
     e=E(element)->getFirstElementChildNamed(MBSIMCONTROL%"initialInput");
     if(e) setInitialInput(E(e)->getText<fmatvec::Vec>());
+    e=E(element)->getFirstElementChildNamed(MBSIMCONTROL%"centralDifferences");
+    if(e) setCentralDifferences(E(e)->getText<bool>());
+    e=E(element)->getFirstElementChildNamed(MBSIMCONTROL%"numberOfProcesses");
+    if(e) setNumberOfProcesses(E(e)->getText<int>());
     e=E(element)->getFirstElementChildNamed(MBSIMCONTROL%"minimumNaturalFrequency");
     if(e) setMinimumNaturalFrequency(E(e)->getText<double>());
     e=E(element)->getFirstElementChildNamed(MBSIMCONTROL%"maximumNaturalFrequency");
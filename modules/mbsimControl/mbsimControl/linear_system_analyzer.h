@@ -36,6 +36,12 @@ namespace MBSimControl {
 
   /*!
    * \brief Linear system analyzer
+   *
+   * The system matrices are computed by finite differences (one sided or central) in one pass over the states and
+   * the inputs. With numberOfProcesses>1 the columns are evaluated in forked processes, which are independent copies
+   * of the system (as the slices of the PararealIntegrator); this requires a single threaded process. Complex step
+   * differentiation is not available since the model is real valued. The eigenvalue problem is dense since all
+   * eigenvectors are needed for the output; a sparse shift-invert solver would only yield a few of them.
    * \author Martin Foerg
    */
   class LinearSystemAnalyzer : public MBSim::Solver {
@@ -46,6 +52,10 @@ namespace MBSimControl {
       void setInitialTime(double t0_) { t0 = t0_; }
       void setInitialState(const fmatvec::Vec &z0_) { z0 <<= z0_; }
       void setInitialInput(const fmatvec::Vec &u0_) { u0 <<= u0_; }
+      //! use central instead of one sided differences for the system matrices
+      void setCentralDifferences(bool central_) { central = central_; }
+      //! number of processes evaluating the columns of the system matrices; 0 means the number of hardware threads
+      void setNumberOfProcesses(int nProcesses_) { nProcesses = nProcesses_; }
       void setMinimumNaturalFrequency(double fmin_) { fmin = fmin_; }
       void setMaximumNaturalFrequency(double fmax_) { fmax = fmax_; }
       void setNormalModeScaleFactor(double modeScaleFactor_) { modeScaleFactor = modeScaleFactor_; }
@@ -82,6 +92,8 @@ namespace MBSimControl {
       bool frv{false};
       bool srv{false};
       bool its{true};
+      bool central{false};
+      int nProcesses{1};
       double tSpan{1};
       fmatvec::VecVI modes;
       fmatvec::Vec2 fRange;
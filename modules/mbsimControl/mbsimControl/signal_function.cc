@@ -17,11 +17,24 @@
 
 #include <config.h>
 #include "mbsimControl/signal_function.h"
+#include "mbsim/dynamic_system_solver.h"
+#include "mbsim/links/generalized_kinematic_excitation.h"
 
 using namespace fmatvec;
+using namespace MBSim;
 
 namespace MBSimControl {
 
+  void checkKinematicsDependency(Element *func, Signal *sig) {
+    Element *e=func->getParent();
+    while(dynamic_cast<FunctionBase*>(e))
+      e=e->getParent();
+    // signals used outside of links (e.g. body kinematics) or by kinematic excitations (which define rrel, vrel and
+    // wb by the signal) change quantities which are kept by DynamicSystemSolver::resetForcesUpToDate
+    if(not dynamic_cast<Link*>(e) or dynamic_cast<GeneralizedKinematicExcitation*>(e))
+      sig->getDynamicSystemSolver()->setKinematicsDependOnSignals(true);
+  }
+
   MBSIM_OBJECTFACTORY_REGISTERCLASS_AND_INSTANTIATE(MBSIMCONTROL, SignalFunction<double(double)>)
   MBSIM_OBJECTFACTORY_REGISTERCLASS_AND_INSTANTIATE(MBSIMCONTROL, SignalFunction<VecV(double)>)
   MBSIM_OBJECTFACTORY_REGISTERCLASS_AND_INSTANTIATE(MBSIMCONTROL, SignalFunction<VecV(VecV)>)
@@ -28,6 +28,11 @@
 
 namespace MBSimControl {
 
+  /*! \brief tell the solver if the signal function func is used outside of a link (e.g. in the kinematics of a body)
+   * or by a kinematic excitation (generalized position, velocity or acceleration excitation)
+   * Then state dependent quantities may depend on signals and a change of the inputs requires a full update. */
+  void checkKinematicsDependency(MBSim::Element *func, Signal *sig);
+
   //! A function which get its return value from a signal
   template<typename Sig>
   class SignalFunction;
@@ -77,6 +82,7 @@ namespace MBSimControl {
         setReturnSignal(this->template getByPath<Signal>(retString));
       if(not ret)
         MBSim::Element::throwError("Signal is not given!");
+      checkKinematicsDependency(this, ret);
       MBSim::Function<Ret(Arg)>::init(stage, config);
     }
     else
@@ -128,6 +134,7 @@ namespace MBSimControl {
         setReturnSignal(this->template getByPath<Signal>(retString));
       if(not ret)
         MBSim::Element::throwError("Signal is not given!");
+      checkKinematicsDependency(this, ret);
       MBSim::Function<Ret(Arg1,Arg2)>::init(stage, config);
     }
     else
@@ -26,6 +26,8 @@
 #include <mbsimFcl/fcl_mesh.h>
 
 #include <mbsimFcl/fclcontour_fclcontour.h>
+#include <mbsimFcl/fclmesh_fclplane.h>
+#include <mbsimFcl/fclmesh_fclsphere.h>
 
 using namespace std;
 using namespace fmatvec;
@@ -53,6 +55,12 @@ namespace MBSimFcl {
     else if ( contour0==typeid(FclMesh) && contour1==typeid(FclMesh) )
       return new ContactKinematicsContourContour(1);
 
+    else if ( contour0==typeid(FclMesh) && contour1==typeid(FclPlane) )
+      return new ContactKinematicsMeshPlane(4);
+
+    else if ( contour0==typeid(FclMesh) && contour1==typeid(FclSphere) )
+      return new ContactKinematicsMeshSphere;
+
 //    else if ( dynamic_cast<Contour*>(c0) && dynamic_cast<Contour*>(c1) )
 //      return new ContactKinematicsContourContour(1);
 
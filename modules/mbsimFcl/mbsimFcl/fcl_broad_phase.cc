@@ -0,0 +1,171 @@
+/* Copyright (C) 2004-2018 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h>
+#include "mbsimFcl/fcl_broad_phase.h"
+#include "mbsimFcl/fcl_contour.h"
+#include "mbsimFcl/fcl_utils.h"
+#include "mbsim/frames/frame.h"
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+#include "fcl/narrowphase/continuous_collision.h"
+#include "fcl/math/bv/AABB.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+using namespace fmatvec;
+using namespace MBSim;
+using namespace fcl;
+
+namespace {
+
+  pair<const CollisionObject<double>*, const CollisionObject<double>*> makePair(const CollisionObject<double> *o0, const CollisionObject<double> *o1) {
+    return o0<o1 ? make_pair(o0, o1) : make_pair(o1, o0);
+  }
+
+  // AABB of the collision object inflated by margin
+  AABBd inflatedAABB(const CollisionObject<double> *obj, double margin) {
+    AABBd aabb = obj->getAABB();
+    if(margin>0)
+      aabb.expand(Vector3d::Constant(margin));
+    return aabb;
+  }
+
+  // transform of the collision object after moving its frame with the current velocities over dt
+  Transform3d predictTransform(MBSimFcl::FclContour *contour, double dt) {
+    Frame *R = contour->getFrame();
+    Transform3d tf = contour->getCollisionObject()->getTransform();
+    tf.translation() += Vec3ToVector3d(R->evalVelocity()*dt);
+    const Vec3 &Om = R->evalAngularVelocity();
+    double om = nrm2(Om);
+    if(om*dt>1e-14)
+      tf.linear() = Eigen::AngleAxisd(om*dt, Vec3ToVector3d(Om/om)).toRotationMatrix()*tf.linear();
+    return tf;
+  }
+
+}
+
+namespace MBSimFcl {
+
+  void FclBroadPhase::registerContour(FclContour *contour_) {
+    contour.push_back(contour_);
+    manager.registerObject(contour_->getCollisionObject().get());
+    updSetup = true;
+    updPairs = true;
+  }
+
+  void FclBroadPhase::unregisterContour(FclContour *contour_) {
+    auto it = find(contour.begin(), contour.end(), contour_);
+    if(it!=contour.end()) {
+      manager.unregisterObject(contour_->getCollisionObject().get());
+      contour.erase(it);
+    }
+    updSetup = true;
+    updPairs = true;
+  }
+
+  bool FclBroadPhase::collectPair(CollisionObject<double> *o0, CollisionObject<double> *o1, void *data) {
+    static_cast<FclBroadPhase*>(data)->pair.insert(makePair(o0, o1));
+    return false;
+  }
+
+  void FclBroadPhase::updatePairs() {
+    for(auto & i : contour)
+      i->updateCollisionObject();
+    if(updSetup) {
+      manager.setup();
+      updSetup = false;
+    }
+    else
+      manager.update();
+    pair.clear();
+    result.clear();
+    distanceResult.clear();
+    manager.collide(this, &collectPair);
+    updPairs = false;
+  }
+
+  const CollisionResult<double>& FclBroadPhase::evalCollisionResult(FclContour *contour0, FclContour *contour1, int maxNumContacts) {
+    if(updPairs) updatePairs();
+    auto key = make_tuple(contour0, contour1, maxNumContacts);
+    auto it = result.find(key);
+    if(it!=result.end())
+      return it->second;
+    CollisionResult<double> &res = result[key];
+    CollisionObject<double> *obj0 = contour0->getCollisionObject().get();
+    CollisionObject<double> *obj1 = contour1->getCollisionObject().get();
+    if(pair.count(makePair(obj0, obj1))) {
+      CollisionRequest<double> request(maxNumContacts,true);
+      auto guess = gjkGuess.find(make_pair(contour0, contour1));
+      if(guess!=gjkGuess.end()) {
+        request.enable_cached_gjk_guess = true;
+        request.cached_gjk_guess = guess->second;
+      }
+      collide<double>(obj0, obj1, request, res);
+      gjkGuess[make_pair(contour0, contour1)] = res.cached_gjk_guess;
+    }
+    return res;
+  }
+
+  const DistanceResult<double>* FclBroadPhase::evalDistanceResult(FclContour *contour0, FclContour *contour1) {
+    if(updPairs) updatePairs();
+    CollisionObject<double> *obj0 = contour0->getCollisionObject().get();
+    CollisionObject<double> *obj1 = contour1->getCollisionObject().get();
+    // the distance query can be restricted to pairs near each other by a finite distance margin
+    double margin0 = contour0->getDistanceMargin();
+    double margin1 = contour1->getDistanceMargin();
+    if(isfinite(margin0) and isfinite(margin1) and not pair.count(makePair(obj0, obj1)) and
+       not inflatedAABB(obj0, margin0).overlap(inflatedAABB(obj1, margin1)))
+      return nullptr;
+    auto key = make_pair(contour0, contour1);
+    auto it = distanceResult.find(key);
+    if(it!=distanceResult.end())
+      return &it->second;
+    DistanceResult<double> &res = distanceResult[key];
+    DistanceRequest<double> request(true,true);
+    distance<double>(obj0, obj1, request, res);
+    return &res;
+  }
+
+  double FclBroadPhase::evalTimeOfImpact(FclContour *contour0, FclContour *contour1, double dt) {
+    if(updPairs) updatePairs();
+    // bounding boxes swept over the horizon: the bounding sphere of the geometry at the current and the predicted pose
+    Transform3d tf0 = predictTransform(contour0, dt);
+    Transform3d tf1 = predictTransform(contour1, dt);
+    auto sweptAABB = [](const CollisionObject<double> *obj, const Transform3d &tf) {
+      const CollisionGeometry<double> *cg = obj->collisionGeometry().get();
+      AABBd aabb = obj->getAABB();
+      Vector3d c = tf*cg->aabb_center;
+      Vector3d r = Vector3d::Constant(cg->aabb_radius);
+      aabb += AABBd(c-r, c+r);
+      return aabb;
+    };
+    if(not sweptAABB(contour0->getCollisionObject().get(), tf0).overlap(sweptAABB(contour1->getCollisionObject().get(), tf1)))
+      return numeric_limits<double>::infinity();
+    ContinuousCollisionRequest<double> request;
+    request.ccd_motion_type = CCDM_SCREW;
+    request.ccd_solver_type = CCDC_CONSERVATIVE_ADVANCEMENT;
+    ContinuousCollisionResult<double> res;
+    continuousCollide<double>(contour0->getCollisionObject().get(), tf0, contour1->getCollisionObject().get(), tf1, request, res);
+    return res.is_collide ? res.time_of_contact*dt : numeric_limits<double>::infinity();
+  }
+
+}
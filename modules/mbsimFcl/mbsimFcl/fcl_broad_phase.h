@@ -0,0 +1,98 @@
+/* Copyright (C) 2004-2018 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _MBSIMFCL_FCL_BROAD_PHASE_H_
+#define _MBSIMFCL_FCL_BROAD_PHASE_H_
+
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
+#include "fcl/narrowphase/collision_request.h"
+#include "fcl/narrowphase/collision_result.h"
+#include "fcl/narrowphase/distance_result.h"
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+#include <memory>
+
+namespace MBSimFcl {
+
+  class FclContour;
+
+  /**
+   * \brief broad phase of all FclContours of a dynamic system solver
+   *
+   * The broad phase is created by the first FclContour of the solver and shared by all others (see
+   * FclContour::init); there is no global registry.
+   *
+   * The collision objects of the contours are registered once in a dynamic AABB tree. After a change of
+   * the state the transforms of all objects are updated once and the pairs of overlapping bounding boxes
+   * are determined. The narrow phase is only called for these pairs and its result is shared by all
+   * contacts of the same contour pair. For separated pairs whose AABBs, inflated by the distance margins
+   * of the contours, overlap the signed distance with the nearest points is computed instead. The GJK search direction of the last collision query of each pair is kept as
+   * initial guess for the next one.
+   */
+  class FclBroadPhase {
+    public:
+      void registerContour(FclContour *contour_);
+      void unregisterContour(FclContour *contour_);
+
+      void resetUpToDate() { updPairs = true; }
+
+      /**
+       * \brief narrow phase of the contour pair (empty result if the bounding boxes do not overlap)
+       */
+      const fcl::CollisionResult<double>& evalCollisionResult(FclContour *contour0, FclContour *contour1, int maxNumContacts);
+
+      /**
+       * \brief signed distance and nearest points (in the world frame) of the contour pair
+       * \return nullptr if the AABBs of the pair inflated by the distance margins of the contours do not overlap
+       */
+      const fcl::DistanceResult<double>* evalDistanceResult(FclContour *contour0, FclContour *contour1);
+
+      /**
+       * \brief time of impact of the contour pair by conservative advancement
+       *
+       * The contours are moved with their current translational and angular velocities over the horizon dt.
+       * Conservative advancement is only called if the bounding boxes swept over the horizon overlap.
+       * \return time of impact in [0,dt] or infinity
+       */
+      double evalTimeOfImpact(FclContour *contour0, FclContour *contour1, double dt);
+
+      /**
+       * \return number of overlapping pairs of the current state
+       */
+      int evalNumberOfPairs() { if(updPairs) updatePairs(); return pair.size(); }
+
+    private:
+      void updatePairs();
+      static bool collectPair(fcl::CollisionObject<double> *o0, fcl::CollisionObject<double> *o1, void *data);
+
+      fcl::DynamicAABBTreeCollisionManager<double> manager;
+      std::vector<FclContour*> contour;
+      std::set<std::pair<const fcl::CollisionObject<double>*, const fcl::CollisionObject<double>*>> pair;
+      std::map<std::tuple<FclContour*, FclContour*, int>, fcl::CollisionResult<double>> result;
+      std::map<std::pair<FclContour*, FclContour*>, fcl::DistanceResult<double>> distanceResult;
+      std::map<std::pair<FclContour*, FclContour*>, fcl::Vector3d> gjkGuess;
+      bool updSetup{true};
+      bool updPairs{true};
+  };
+
+}
+
+#endif
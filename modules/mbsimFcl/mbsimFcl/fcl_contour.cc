@@ -20,6 +20,11 @@
 #include <config.h>
 #include "fcl_contour.h"
 #include "mbsimFcl/namespace.h"
+#include "mbsimFcl/fcl_broad_phase.h"
+#include "mbsimFcl/fcl_utils.h"
+#include "mbsim/frames/frame.h"
+#include "mbsim/dynamic_system_solver.h"
+#include "mbsim/objects/body.h"
 
 using namespace std;
 using namespace fmatvec;
@@ -30,16 +35,72 @@ using namespace fcl;
 
 namespace MBSimFcl {
 
+  // the broad phase of an other FclContour of sys (recursively, including the contours of the bodies)
+  shared_ptr<FclBroadPhase> FclContour::findBroadPhase(DynamicSystem *sys) const {
+    auto fromContours = [this](const vector<Contour*> &contours) -> shared_ptr<FclBroadPhase> {
+      for(auto *c : contours) {
+        auto *fc = dynamic_cast<FclContour*>(c);
+        if(fc and fc!=this and fc->broadPhase)
+          return fc->broadPhase;
+      }
+      return nullptr;
+    };
+    if(auto bp = fromContours(sys->getContours()))
+      return bp;
+    for(auto *o : sys->getObjects())
+      if(auto *body = dynamic_cast<Body*>(o))
+        if(auto bp = fromContours(body->getContours()))
+          return bp;
+    for(auto *ds : sys->getDynamicSystems())
+      if(auto bp = findBroadPhase(ds))
+        return bp;
+    return nullptr;
+  }
+
+  FclContour::~FclContour() {
+    if(broadPhase) broadPhase->unregisterContour(this);
+  }
+
   void FclContour::init(InitStage stage, const InitConfigSet &config) {
-    if(stage==preInit)
-      if(computeLocalAABB) cg->computeLocalAABB();
+    if(stage==preInit) {
+      // the AABB tree of the broad phase is built from the local AABB of each geometry
+      if(not computeLocalAABB) {
+        msg(Warn) << "The local AABB of " << getPath() << " is required by the broad phase and is computed anyway." << endl;
+        computeLocalAABB = true;
+      }
+      cg->computeLocalAABB();
+      obj = make_shared<CollisionObject<double>>(cg);
+      // the first FclContour of the solver creates the broad phase, all others share it; it lives as long as one of
+      // its contours
+      broadPhase = findBroadPhase(ds);
+      if(not broadPhase)
+        broadPhase = make_shared<FclBroadPhase>();
+      broadPhase->registerContour(this);
+    }
     RigidContour::init(stage, config);
   }
 
+  void FclContour::resetUpToDate() {
+    RigidContour::resetUpToDate();
+    if(broadPhase) broadPhase->resetUpToDate();
+  }
+
+  void FclContour::resetPositionsUpToDate() {
+    if(broadPhase) broadPhase->resetUpToDate();
+  }
+
+  void FclContour::updateCollisionObject() {
+    obj->setTranslation(Vec3ToVector3d(R->evalPosition()));
+    obj->setRotation(SqrMat3ToMatrix3d(R->getOrientation()));
+    obj->computeAABB();
+  }
+
   void FclContour::initializeUsingXML(DOMElement *element) {
     RigidContour::initializeUsingXML(element);
     DOMElement *e=E(element)->getFirstElementChildNamed(MBSIMFCL%"computeLocalAABB");
     if(e) setComputeLocalAABB(E(e)->getText<bool>());
+    e=E(element)->getFirstElementChildNamed(MBSIMFCL%"distanceMargin");
+    if(e) setDistanceMargin(E(e)->getText<double>());
   }
 
 }
@@ -23,9 +23,17 @@
 #include "mbsim/contours/rigid_contour.h"
 #include "mbsimFcl/contact_utils.h"
 #include "fcl/geometry/collision_geometry.h"
+#include "fcl/narrowphase/collision_object.h"
+#include <limits>
+
+namespace MBSim {
+  class DynamicSystem;
+}
 
 namespace MBSimFcl {
 
+  class FclBroadPhase;
+
   /**
    * \brief Contour
    */
@@ -37,22 +45,57 @@ namespace MBSimFcl {
        */
       FclContour(const std::string &name="", MBSim::Frame *R=nullptr) : MBSim::RigidContour(name,R) { }
 
+      ~FclContour() override;
+
       void init(InitStage stage, const MBSim::InitConfigSet &config) override;
       void initializeUsingXML(xercesc::DOMElement *element) override;
+      void resetUpToDate() override;
+      void resetPositionsUpToDate() override;
 
       std::shared_ptr<fcl::CollisionGeometry<double>> getCollisionGeometry() const { return cg; }
+      const std::shared_ptr<fcl::CollisionObject<double>>& getCollisionObject() const { return obj; }
+      FclBroadPhase* getBroadPhase() const { return broadPhase.get(); }
+
+      /**
+       * \brief set the transform and the AABB of the collision object to the current state
+       */
+      void updateCollisionObject();
 
+      /**
+       * \brief the local AABB is required by the broad phase; false is ignored with a warning
+       */
       void setComputeLocalAABB(bool computeLocalAABB_) { computeLocalAABB = computeLocalAABB_; }
 
+      /**
+       * \brief inflation of the AABB within which the signed distance to separated contours is computed
+       */
+      void setDistanceMargin(double distanceMargin_) { distanceMargin = distanceMargin_; }
+      double getDistanceMargin() const { return distanceMargin; }
+
       MBSim::ContactKinematics * findContactPairingWith(const std::type_info &type0, const std::type_info &type1) override { return findContactPairingFcl(type0, type1); }
 
     protected:
+      std::shared_ptr<FclBroadPhase> findBroadPhase(MBSim::DynamicSystem *sys) const;
+
       std::shared_ptr<fcl::CollisionGeometry<double>> cg;
 
       /**
-       * \brief compute local AABB
+       * \brief persistent collision object registered in the broad phase
+       */
+      std::shared_ptr<fcl::CollisionObject<double>> obj;
+
+      std::shared_ptr<FclBroadPhase> broadPhase;
+
+      /**
+       * \brief compute local AABB (required by the broad phase)
        */
       bool computeLocalAABB{true};
+
+      /**
+       * \brief the distance to separated contours is only computed if the AABBs inflated by this margin overlap
+       * (default: always)
+       */
+      double distanceMargin{std::numeric_limits<double>::infinity()};
   };
 }
 
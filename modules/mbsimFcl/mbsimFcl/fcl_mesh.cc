@@ -20,6 +20,7 @@
 #include <config.h>
 #include "fcl_mesh.h"
 #include "mbsimFcl/namespace.h"
+#include "mbsimFcl/fcl_broad_phase.h"
 #include "fcl/geometry/bvh/BVH_model.h"
 #include "fcl/math/bv/utility.h"
 #include <openmbvcppinterface/indexedfaceset.h>
@@ -31,6 +32,18 @@ using namespace MBXMLUtils;
 using namespace xercesc;
 using namespace fcl;
 
+namespace {
+
+  template <class BV>
+  void refitModel(CollisionGeometry<double> *cg, vector<Vector3d> &vertices) {
+    auto *model = static_cast<BVHModel<BV>*>(cg);
+    model->beginUpdateModel();
+    model->updateSubModel(vertices);
+    model->endUpdateModel(true, true);
+  }
+
+}
+
 namespace MBSimFcl {
 
   MBSIM_OBJECTFACTORY_REGISTERCLASS(MBSIMFCL, FclMesh)
@@ -95,6 +108,12 @@ namespace MBSimFcl {
       }
       else if(collisionStructure==unknown)
         throwError("(FclMesh::init): unknown collision structure");
+      vector<int> index(3*triangle.rows());
+      for(int i=0; i<triangle.rows(); i++)
+        for(int j=0; j<3; j++)
+          index[3*i+j] = triangle(i,j);
+      triangleMesh.setTriangles(index);
+      triangleMesh.setVertices(vertex);
     }
     else if (stage == plotting) {
       if(plotFeature[openMBV] && openMBVRigidBody) {
@@ -112,6 +131,36 @@ namespace MBSimFcl {
     FclContour::init(stage, config);
   }
 
+  void FclMesh::updateVertices(const MatVx3 &vertex_) {
+    if(vertex_.rows()!=vertex.rows())
+      throwError("(FclMesh::updateVertices): number of vertices must not change");
+    vertex <<= vertex_;
+    vector<Vector3d> vertices(vertex.rows());
+    for(int i=0; i<vertex.rows(); i++) {
+      for(int j=0; j<vertex.cols(); j++)
+        vertices[i](j) = vertex(i,j);
+    }
+    if(collisionStructure==AABB)
+      refitModel<fcl::AABB<double>>(cg.get(), vertices);
+    else if(collisionStructure==KDOP16)
+      refitModel<fcl::KDOP<double,16>>(cg.get(), vertices);
+    else if(collisionStructure==KDOP18)
+      refitModel<fcl::KDOP<double,18>>(cg.get(), vertices);
+    else if(collisionStructure==KDOP24)
+      refitModel<fcl::KDOP<double,24>>(cg.get(), vertices);
+    else if(collisionStructure==kIOS)
+      refitModel<fcl::kIOS<double>>(cg.get(), vertices);
+    else if(collisionStructure==OBB)
+      refitModel<fcl::OBB<double>>(cg.get(), vertices);
+    else if(collisionStructure==OBBRSS)
+      refitModel<fcl::OBBRSS<double>>(cg.get(), vertices);
+    else if(collisionStructure==RSS)
+      refitModel<fcl::RSS<double>>(cg.get(), vertices);
+    cg->computeLocalAABB();
+    triangleMesh.setVertices(vertex);
+    if(broadPhase) broadPhase->resetUpToDate();
+  }
+
   void FclMesh::initializeUsingXML(DOMElement *element) {
     FclContour::initializeUsingXML(element);
     DOMElement *e=E(element)->getFirstElementChildNamed(MBSIMFCL%"vertices");
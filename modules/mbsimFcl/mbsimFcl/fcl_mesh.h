@@ -21,6 +21,7 @@
 #define _MBSIMFCL_FCL_MESH_H_
 
 #include "mbsimFcl/fcl_contour.h"
+#include "mbsimFcl/triangle_mesh.h"
 #include "mbsim/utils/boost_parameters.h"
 #include <mbsim/utils/openmbv_utils.h>
 #include "mbsim/utils/index.h"
@@ -66,8 +67,18 @@ namespace MBSimFcl {
       void setVertices(const fmatvec::MatVx3 &vertex_) { vertex <<= vertex_; }
       void setTriangles(const fmatvec::Matrix<fmatvec::General, fmatvec::Var, fmatvec::Fixed<3>, MBSim::Index> &triangle_) { triangle <<= triangle_; }
       void setCollisionStructure(CollisionStructure collisionStructure_) { collisionStructure = collisionStructure_; }
+      const fmatvec::MatVx3& getVertices() const { return vertex; }
+      TriangleMesh& getTriangleMesh() { return triangleMesh; }
       /***************************************************/
 
+      /**
+       * \brief move the vertices of a deformable mesh after initialisation
+       *
+       * The bounding volume hierarchy and the blocks of the mesh-primitive narrow phase are refitted
+       * instead of rebuilt. The triangles remain unchanged.
+       */
+      void updateVertices(const fmatvec::MatVx3 &vertex_);
+
       BOOST_PARAMETER_MEMBER_FUNCTION( (void), enableOpenMBV, MBSim::tag, (optional (diffuseColor,(const fmatvec::Vec3&),"[-1;1;1]")(transparency,(double),0)(pointSize,(double),0)(lineWidth,(double),0))) {
         MBSim::OpenMBVColoredBody ombv(diffuseColor,transparency,pointSize,lineWidth);
         openMBVRigidBody=ombv.createOpenMBV<OpenMBV::IndexedFaceSet>();
@@ -88,6 +99,11 @@ namespace MBSimFcl {
        * \brief collision structure
        */
       CollisionStructure collisionStructure{AABB};
+
+      /**
+       * \brief mesh for the narrow phase with primitives
+       */
+      TriangleMesh triangleMesh;
   };
 }
 
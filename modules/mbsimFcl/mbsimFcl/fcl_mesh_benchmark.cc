@@ -0,0 +1,171 @@
+/* Copyright (C) 2004-2018 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+// comparison of the mesh-primitive narrow phase of TriangleMesh with fcl::collide/fcl::distance
+// usage: mbsimFclMeshBenchmark [<grid size n (2n^2 triangles)> [<number of poses>]]
+
+#include <config.h>
+#include "mbsimFcl/triangle_mesh.h"
+#include "fcl/geometry/bvh/BVH_model.h"
+#include "fcl/geometry/shape/plane.h"
+#include "fcl/geometry/shape/sphere.h"
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+
+using namespace std;
+using namespace fmatvec;
+using namespace fcl;
+using namespace MBSimFcl;
+
+namespace {
+
+  template <class F>
+  double measure(int n, F f) {
+    auto start = chrono::steady_clock::now();
+    for(int i=0; i<n; i++)
+      f(i);
+    return chrono::duration<double>(chrono::steady_clock::now()-start).count()/n*1e6;
+  }
+
+  void report(const string &name, double tFcl, double tMesh) {
+    cout << name << ": fcl " << tFcl << " us, TriangleMesh " << tMesh << " us, speedup " << tFcl/tMesh << endl;
+  }
+
+}
+
+int main(int argc, char *argv[]) {
+  int N = argc>1 ? atoi(argv[1]) : 300;
+  int M = argc>2 ? atoi(argv[2]) : 1000;
+
+  // wavy surface on [0,1]x[0,1]
+  MatVx3 vertex((N+1)*(N+1), NONINIT);
+  vector<Vector3d> vertices((N+1)*(N+1));
+  for(int i=0; i<=N; i++) {
+    for(int j=0; j<=N; j++) {
+      int k = i*(N+1)+j;
+      vertex(k,0) = double(i)/N;
+      vertex(k,1) = double(j)/N;
+      vertex(k,2) = 0.02*sin(10*vertex(k,0))*cos(7*vertex(k,1));
+      vertices[k] = Vector3d(vertex(k,0), vertex(k,1), vertex(k,2));
+    }
+  }
+  vector<int> index;
+  vector<Triangle> triangles;
+  for(int i=0; i<N; i++) {
+    for(int j=0; j<N; j++) {
+      int a = i*(N+1)+j, b = a+N+1;
+      index.insert(index.end(), {a, b, b+1, a, b+1, a+1});
+      triangles.emplace_back(a, b, b+1);
+      triangles.emplace_back(a, b+1, a+1);
+    }
+  }
+  cout << triangles.size() << " triangles, " << M << " poses" << endl;
+
+  auto model = make_shared<BVHModel<OBBRSS<double>>>();
+  model->beginModel();
+  model->addSubModel(vertices, triangles);
+  model->endModel();
+  CollisionObject<double> meshObj(model);
+
+  TriangleMesh mesh;
+  mesh.setTriangles(index);
+  mesh.setVertices(vertex);
+
+  mt19937 gen(0);
+  uniform_real_distribution<double> U(-1, 1);
+  vector<Vec3> n(M), c(M);
+  vector<double> d(M);
+  for(int k=0; k<M; k++) {
+    Vec3 nk;
+    nk(0) = 0.05*U(gen); nk(1) = 0.05*U(gen); nk(2) = 1;
+    n[k] = nk/nrm2(nk);
+    d[k] = 0.03*U(gen);
+    c[k](0) = 0.5+0.4*U(gen); c[k](1) = 0.5+0.4*U(gen); c[k](2) = 0.06*U(gen);
+  }
+
+  // plane: four deepest contacts
+  int numContacts = 4;
+  vector<int> vertexIndex;
+  vector<double> g;
+  vector<unique_ptr<CollisionObject<double>>> planeObj(M);
+  for(int k=0; k<M; k++)
+    planeObj[k].reset(new CollisionObject<double>(make_shared<Plane<double>>(Vector3d(n[k](0), n[k](1), n[k](2)), d[k])));
+  double tFcl = measure(M, [&](int k) {
+    CollisionRequest<double> request(numContacts, true);
+    CollisionResult<double> result;
+    collide<double>(&meshObj, planeObj[k].get(), request, result);
+  });
+  double tMesh = measure(M, [&](int k) {
+    mesh.computePlaneDistances(n[k], d[k], numContacts, vertexIndex, g);
+  });
+  report("mesh-plane contacts", tFcl, tMesh);
+
+  // sphere: signed distance
+  double r = 0.05;
+  auto sphere = make_shared<Sphere<double>>(r);
+  vector<double> distFcl(M), distMesh(M);
+  CollisionObject<double> sphereObj(sphere);
+  tFcl = measure(M, [&](int k) {
+    sphereObj.setTransform(Matrix3d::Identity(), Vector3d(c[k](0), c[k](1), c[k](2)));
+    DistanceRequest<double> request(true, true);
+    DistanceResult<double> result;
+    distance<double>(&meshObj, &sphereObj, request, result);
+    distFcl[k] = result.min_distance;
+  });
+  Vec3 p, nk;
+  tMesh = measure(M, [&](int k) {
+    distMesh[k] = mesh.computePointDistance(c[k], p, nk) - r;
+  });
+  report("mesh-sphere distance", tFcl, tMesh);
+  double errMax = 0;
+  for(int k=0; k<M; k++) {
+    if(distMesh[k]>0)
+      errMax = max(errMax, fabs(distMesh[k] - distFcl[k]));
+  }
+  cout << "  max deviation of separated distances " << errMax << endl;
+
+  // deformation: refit instead of rebuild
+  int R = max(1, M/100);
+  tFcl = measure(R, [&](int k) {
+    model->beginModel();
+    model->addSubModel(vertices, triangles);
+    model->endModel();
+  });
+  double tRefit = measure(R, [&](int k) {
+    for(auto &v : vertices)
+      v(2) += 1e-4;
+    model->beginUpdateModel();
+    model->updateSubModel(vertices);
+    model->endUpdateModel(true, true);
+  });
+  tMesh = measure(R, [&](int k) {
+    for(int i=0; i<vertex.rows(); i++)
+      vertex(i,2) += 1e-4;
+    mesh.setVertices(vertex);
+  });
+  cout << "deformation: fcl rebuild " << tFcl << " us, fcl refit " << tRefit << " us, TriangleMesh refit " << tMesh << " us" << endl;
+
+  return 0;
+}
@@ -47,6 +47,8 @@ namespace MBSimFcl {
       /* GETTER / SETTER */
       void setNormal(const fmatvec::Vec3 &normal_) { normal = normal_; }
       void setOffset(double offset_) { offset = offset_; }
+      const fmatvec::Vec3& getNormal() const { return normal; }
+      double getOffset() const { return offset; }
       /***************************************************/
 
       BOOST_PARAMETER_MEMBER_FUNCTION( (void), enableOpenMBV, MBSim::tag, (optional (length,(fmatvec::Vec2),fmatvec::Vec2(fmatvec::INIT,1))(diffuseColor,(const fmatvec::Vec3&),"[-1;1;1]")(transparency,(double),0)(pointSize,(double),0)(lineWidth,(double),0))) {
@@ -20,8 +20,10 @@
 #include <config.h> 
 #include "fclcontour_fclcontour.h"
 #include "mbsimFcl/fcl_contour.h"
+#include "mbsimFcl/fcl_broad_phase.h"
 #include "mbsimFcl/fcl_utils.h"
 #include "mbsim/utils/contact_utils.h"
+#include "mbsim/utils/eps.h"
 #include "mbsim/frames/contour_frame.h"
 #include "fcl/narrowphase/distance.h"
 
@@ -36,60 +38,64 @@ namespace MBSimFcl {
     icontour0 = 0; icontour1 = 1;
     contour0 = static_cast<FclContour*>(contour[0]);
     contour1 = static_cast<FclContour*>(contour[1]);
-    obj0 = shared_ptr<CollisionObject<double>>(new CollisionObject<double>(contour0->getCollisionGeometry()));
-    obj1 = shared_ptr<CollisionObject<double>>(new CollisionObject<double>(contour1->getCollisionGeometry()));
   }
 
-  void ContactKinematicsContourContour::updateg(vector<SingleContact> &contact) {
-    obj0->setTranslation(Vec3ToVector3d(contour0->getFrame()->evalPosition()));
-    obj0->setRotation(SqrMat3ToMatrix3d(contour0->getFrame()->getOrientation()));
-    obj1->setTranslation(Vec3ToVector3d(contour1->getFrame()->evalPosition()));
-    obj1->setRotation(SqrMat3ToMatrix3d(contour1->getFrame()->getOrientation()));
+  void ContactKinematicsContourContour::setContactFrames(SingleContact &contact, const Vec3 &n, const Vec3 &r0, const Vec3 &r1) {
+    Vec3 t1 = orthonormal(n);
+    Vec3 t2 = crossProduct(n,t1);
+    contact.getContourFrame(icontour0)->getOrientation(false).set(0, n);
+    contact.getContourFrame(icontour0)->getOrientation(false).set(1, t1);
+    contact.getContourFrame(icontour0)->getOrientation(false).set(2, t2);
+    contact.getContourFrame(icontour1)->getOrientation(false).set(0, -n);
+    contact.getContourFrame(icontour1)->getOrientation(false).set(1, -t1);
+    contact.getContourFrame(icontour1)->getOrientation(false).set(2, t2);
+    contact.getContourFrame(icontour0)->setPosition(r0);
+    contact.getContourFrame(icontour1)->setPosition(r1);
+  }
 
-    CollisionRequest<double> request(maxNumContacts,true);
-    CollisionResult<double> result;
-    collide<double>(obj0.get(), obj1.get(), request, result);
-//    cout << result.isCollision() << endl;
-//    cout << result.numContacts() << endl;
+  void ContactKinematicsContourContour::updateg(vector<SingleContact> &contact) {
+    FclBroadPhase *broadPhase = contour0->getBroadPhase();
+    // the transforms are updated and the narrow phase is called only once per state and contour pair
+    const CollisionResult<double> &result = broadPhase->evalCollisionResult(contour0, contour1, maxNumContacts);
+    int numContacts = 0;
     if(result.isCollision()) {
-//      cout << "numContacts = " << result.numContacts() << endl;
-      for(size_t i=0; i<result.numContacts(); i++) {
+      numContacts = result.numContacts();
+      for(int i=0; i<numContacts; i++) {
         Vec3 n = Vector3dToVec3(result.getContact(i).normal);
         Vec3 r = Vector3dToVec3(result.getContact(i).pos);
         double g = -result.getContact(i).penetration_depth;
-        Vec3 t1 = orthonormal(n);
-        Vec3 t2 = crossProduct(n,t1);
         contact[i].getGeneralizedRelativePosition(false)(0) = g;
-        contact[i].getContourFrame(icontour0)->getOrientation(false).set(0, n);
-        contact[i].getContourFrame(icontour0)->getOrientation(false).set(1, t1);
-        contact[i].getContourFrame(icontour0)->getOrientation(false).set(2, t2);
-        contact[i].getContourFrame(icontour1)->getOrientation(false).set(0, -n);
-        contact[i].getContourFrame(icontour1)->getOrientation(false).set(1, -t1);
-        contact[i].getContourFrame(icontour1)->getOrientation(false).set(2, t2);
-        contact[i].getContourFrame(icontour0)->setPosition(r + n*g/2.);
-        contact[i].getContourFrame(icontour1)->setPosition(r - n*g/2.);
+        setContactFrames(contact[i], n, r + n*g/2., r - n*g/2.);
       }
-      for(int i=result.numContacts(); i<maxNumContacts; i++) {
-        contact[i].getGeneralizedRelativePosition(false)(0) = 1;
-        contact[i].getContourFrame(icontour0)->setPosition(contour0->getFrame()->getPosition());
-        contact[i].getContourFrame(icontour0)->setOrientation(contour0->getFrame()->getOrientation());
-        contact[i].getContourFrame(icontour1)->setPosition(contour1->getFrame()->getPosition());
-        contact[i].getContourFrame(icontour1)->setOrientation(contour1->getFrame()->getOrientation());
+    }
+
+    const DistanceResult<double> *dist = numContacts==0 ? broadPhase->evalDistanceResult(contour0, contour1) : nullptr;
+    if(dist) {
+      // signed distance at the nearest points for the first contact, which gives the stop vector and the
+      // gap velocity for event detection and gap control
+      double g = dist->min_distance;
+      Vec3 r0 = Vector3dToVec3(dist->nearest_points[0]);
+      Vec3 r1 = Vector3dToVec3(dist->nearest_points[1]);
+      Vec3 n = r1 - r0;
+      double nrmn = nrm2(n);
+      if(nrmn>epsroot) {
+        n *= (g<0?-1:1)/nrmn;
+        contact[0].getGeneralizedRelativePosition(false)(0) = g;
+        setContactFrames(contact[0], n, r0, r1);
+        numContacts = 1;
       }
     }
-    else {
-//      DistanceRequest<double> request;
-//      DistanceResult<double> result;
-//      distance<double>(obj0.get(), obj1.get(), request, result);
-//      g = result.min_distance;
-      for(int i=0; i<maxNumContacts; i++) {
+    for(int i=numContacts; i<maxNumContacts; i++) {
       contact[i].getGeneralizedRelativePosition(false)(0) = 1;
       contact[i].getContourFrame(icontour0)->setPosition(contour0->getFrame()->getPosition());
       contact[i].getContourFrame(icontour0)->setOrientation(contour0->getFrame()->getOrientation());
       contact[i].getContourFrame(icontour1)->setPosition(contour1->getFrame()->getPosition());
       contact[i].getContourFrame(icontour1)->setOrientation(contour1->getFrame()->getOrientation());
-      }
     }
   }
 
+  double ContactKinematicsContourContour::evalTimeOfImpact(double dt) {
+    return contour0->getBroadPhase()->evalTimeOfImpact(contour0, contour1, dt);
+  }
+
 }
@@ -21,7 +21,6 @@
 #define _MBSIMFCL_CONTACT_KINEMATICS_FCLCONTOUR_FCLCONTOUR_H_
 
 #include "mbsim/contact_kinematics/contact_kinematics.h"
-#include "fcl/narrowphase/collision_object.h"
 
 namespace MBSimFcl {
 
@@ -37,9 +36,15 @@ namespace MBSimFcl {
       ContactKinematicsContourContour(int maxNumContacts=1) : MBSim::ContactKinematics(maxNumContacts) { }
       void assignContours(const std::vector<MBSim::Contour*> &contour) override;
       void updateg(std::vector<MBSim::SingleContact> &contact) override;
+      double evalTimeOfImpact(double dt) override;
       /***************************************************/
 
     protected:
+      /**
+       * \brief set the contact frames at the points r0 and r1 with normal n pointing from contour0 to contour1
+       */
+      void setContactFrames(MBSim::SingleContact &contact, const fmatvec::Vec3 &n, const fmatvec::Vec3 &r0, const fmatvec::Vec3 &r1);
+
       /**
        * \brief contour index
        */
@@ -49,8 +54,6 @@ namespace MBSimFcl {
        * \brief contour classes
        */
       FclContour *contour0, *contour1;
-
-      std::shared_ptr<fcl::CollisionObject<double>> obj0, obj1;
   };
 
 }
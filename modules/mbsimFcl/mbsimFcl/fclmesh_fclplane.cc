@@ -0,0 +1,84 @@
+/* Copyright (C) 2004-2018 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h> 
+#include "fclmesh_fclplane.h"
+#include "mbsimFcl/fcl_mesh.h"
+#include "mbsimFcl/fcl_plane.h"
+#include "mbsim/utils/contact_utils.h"
+#include "mbsim/frames/contour_frame.h"
+
+using namespace std;
+using namespace fmatvec;
+using namespace MBSim;
+
+namespace MBSimFcl {
+
+  void ContactKinematicsMeshPlane::assignContours(const vector<Contour*> &contour) {
+    ContactKinematics::assignContours(contour);
+    if(dynamic_cast<FclMesh*>(contour[0])) {
+      imesh = 0; iplane = 1;
+      mesh = static_cast<FclMesh*>(contour[0]);
+      plane = static_cast<FclPlane*>(contour[1]);
+    }
+    else {
+      imesh = 1; iplane = 0;
+      mesh = static_cast<FclMesh*>(contour[1]);
+      plane = static_cast<FclPlane*>(contour[0]);
+    }
+  }
+
+  void ContactKinematicsMeshPlane::updateg(vector<SingleContact> &contact) {
+    // plane n^T x = d in the world frame
+    const SqrMat3 &AP = plane->getFrame()->evalOrientation();
+    double nrmn = nrm2(plane->getNormal());
+    Vec3 Wn = AP*plane->getNormal()/nrmn;
+    double d = Wn.T()*plane->getFrame()->evalPosition() + plane->getOffset()/nrmn;
+
+    // and in the mesh frame
+    const SqrMat3 &AM = mesh->getFrame()->evalOrientation();
+    const Vec3 &WrM = mesh->getFrame()->evalPosition();
+    Vec3 Mn = AM.T()*Wn;
+    int num = mesh->getTriangleMesh().computePlaneDistances(Mn, d - Wn.T()*WrM, maxNumContacts, vertexIndex, g);
+
+    Vec3 t1 = orthonormal(Wn);
+    Vec3 t2 = crossProduct(Wn,t1);
+    const MatVx3 &vertex = mesh->getVertices();
+    for(int i=0; i<num; i++) {
+      Vec3 WrV = WrM + AM*vertex.row(vertexIndex[i]).T();
+      contact[i].getGeneralizedRelativePosition(false)(0) = g[i];
+      contact[i].getContourFrame(iplane)->getOrientation(false).set(0, Wn);
+      contact[i].getContourFrame(iplane)->getOrientation(false).set(1, t1);
+      contact[i].getContourFrame(iplane)->getOrientation(false).set(2, t2);
+      contact[i].getContourFrame(imesh)->getOrientation(false).set(0, -Wn);
+      contact[i].getContourFrame(imesh)->getOrientation(false).set(1, -t1);
+      contact[i].getContourFrame(imesh)->getOrientation(false).set(2, t2);
+      contact[i].getContourFrame(imesh)->setPosition(WrV);
+      contact[i].getContourFrame(iplane)->setPosition(WrV - Wn*g[i]);
+    }
+    for(int i=num; i<maxNumContacts; i++) {
+      contact[i].getGeneralizedRelativePosition(false)(0) = 1;
+      contact[i].getContourFrame(imesh)->setPosition(WrM);
+      contact[i].getContourFrame(imesh)->setOrientation(AM);
+      contact[i].getContourFrame(iplane)->setPosition(plane->getFrame()->getPosition());
+      contact[i].getContourFrame(iplane)->setOrientation(AP);
+    }
+  }
+
+}
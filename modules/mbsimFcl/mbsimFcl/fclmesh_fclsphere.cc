@@ -0,0 +1,79 @@
+/* Copyright (C) 2004-2018 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h> 
+#include "fclmesh_fclsphere.h"
+#include "mbsimFcl/fcl_mesh.h"
+#include "mbsimFcl/fcl_sphere.h"
+#include "mbsim/utils/contact_utils.h"
+#include "mbsim/utils/eps.h"
+#include "mbsim/frames/contour_frame.h"
+
+using namespace std;
+using namespace fmatvec;
+using namespace MBSim;
+
+namespace MBSimFcl {
+
+  void ContactKinematicsMeshSphere::assignContours(const vector<Contour*> &contour) {
+    ContactKinematics::assignContours(contour);
+    if(dynamic_cast<FclMesh*>(contour[0])) {
+      imesh = 0; isphere = 1;
+      mesh = static_cast<FclMesh*>(contour[0]);
+      sphere = static_cast<FclSphere*>(contour[1]);
+    }
+    else {
+      imesh = 1; isphere = 0;
+      mesh = static_cast<FclMesh*>(contour[1]);
+      sphere = static_cast<FclSphere*>(contour[0]);
+    }
+  }
+
+  void ContactKinematicsMeshSphere::updateg(SingleContact &contact, int i) {
+    const SqrMat3 &AM = mesh->getFrame()->evalOrientation();
+    const Vec3 &WrM = mesh->getFrame()->evalPosition();
+    const Vec3 &WrS = sphere->getFrame()->evalPosition();
+
+    // closest point of the mesh to the center of the sphere in the mesh frame
+    Vec3 MrP, Mn;
+    double dist = mesh->getTriangleMesh().computePointDistance(AM.T()*(WrS - WrM), MrP, Mn);
+    Vec3 WrP = WrM + AM*MrP;
+
+    // normal of the mesh pointing to the center of the sphere; the triangle normal if the center lies on the mesh
+    Vec3 Wn = WrS - WrP;
+    if(fabs(dist)>epsroot)
+      Wn /= dist;
+    else
+      Wn = AM*Mn;
+    double g = dist - sphere->getRadius();
+
+    Vec3 t1 = orthonormal(Wn);
+    Vec3 t2 = crossProduct(Wn,t1);
+    contact.getContourFrame(imesh)->getOrientation(false).set(0, Wn);
+    contact.getContourFrame(imesh)->getOrientation(false).set(1, t1);
+    contact.getContourFrame(imesh)->getOrientation(false).set(2, t2);
+    contact.getContourFrame(isphere)->getOrientation(false).set(0, -Wn);
+    contact.getContourFrame(isphere)->getOrientation(false).set(1, -t1);
+    contact.getContourFrame(isphere)->getOrientation(false).set(2, t2);
+    contact.getContourFrame(imesh)->setPosition(WrP);
+    contact.getContourFrame(isphere)->setPosition(WrS - Wn*sphere->getRadius());
+    contact.getGeneralizedRelativePosition(false)(0) = g;
+  }
+
+}
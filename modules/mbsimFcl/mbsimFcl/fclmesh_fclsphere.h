@@ -0,0 +1,59 @@
+/* Copyright (C) 2004-2018 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _MBSIMFCL_CONTACT_KINEMATICS_FCLMESH_FCLSPHERE_H_
+#define _MBSIMFCL_CONTACT_KINEMATICS_FCLMESH_FCLSPHERE_H_
+
+#include "mbsim/contact_kinematics/contact_kinematics.h"
+
+namespace MBSimFcl {
+
+  class FclMesh;
+  class FclSphere;
+
+  /** 
+   * \brief pairing mesh to sphere
+   *
+   * The contact is the point of the mesh surface closest to the center of the sphere, computed by the
+   * block wise narrow phase of TriangleMesh instead of a traversal of the bounding volume hierarchy.
+   */
+  class ContactKinematicsMeshSphere : public MBSim::ContactKinematics {
+    public:
+      /* INHERITED INTERFACE */
+      ContactKinematicsMeshSphere() : MBSim::ContactKinematics(1) { }
+      void assignContours(const std::vector<MBSim::Contour*> &contour) override;
+      void updateg(MBSim::SingleContact &contact, int i=0) override;
+      /***************************************************/
+
+    protected:
+      /**
+       * \brief contour index
+       */
+      int imesh, isphere;
+
+      /**
+       * \brief contour classes
+       */
+      FclMesh *mesh;
+      FclSphere *sphere;
+  };
+
+}
+
+#endif
@@ -0,0 +1,320 @@
+/* Copyright (C) 2004-2018 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h>
+#include "mbsimFcl/triangle_mesh.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+using namespace fmatvec;
+
+namespace MBSimFcl {
+
+  void TriangleMesh::setTriangles(const vector<int> &index_) {
+    index = index_;
+    int nt = index.size()/3;
+    for(auto v : {&ax, &ay, &az, &bx, &by, &bz, &cx, &cy, &cz, &e0x, &e0y, &e0z, &e1x, &e1y, &e1z, &e2x, &e2y, &e2z, &ie0, &ie1, &ie2, &nx, &ny, &nz, &in})
+      v->resize(nt);
+    // edge adjacency for the pseudo-normals of the edges
+    edgeNeighbour.assign(3*nt, -1);
+    map<pair<int,int>, int> edge;
+    for(int t=0; t<nt; t++) {
+      for(int k=0; k<3; k++) {
+        int v0 = index[3*t+k], v1 = index[3*t+(k+1)%3];
+        auto it = edge.emplace(make_pair(min(v0,v1), max(v0,v1)), 3*t+k);
+        if(not it.second) {
+          edgeNeighbour[3*t+k] = it.first->second/3;
+          edgeNeighbour[it.first->second] = t;
+        }
+      }
+    }
+    if(not x.empty()) {
+      updateTriangles();
+      updateBoxes();
+    }
+  }
+
+  void TriangleMesh::setVertices(const MatVx3 &vertex) {
+    int nv = vertex.rows();
+    x.resize(nv);
+    y.resize(nv);
+    z.resize(nv);
+    for(int i=0; i<nv; i++) {
+      x[i] = vertex(i,0);
+      y[i] = vertex(i,1);
+      z[i] = vertex(i,2);
+    }
+    updateTriangles();
+    updateBoxes();
+  }
+
+  void TriangleMesh::updateTriangles() {
+    int nv = x.size();
+    for(size_t t=0; t<ax.size(); t++) {
+      int a = index[3*t], b = index[3*t+1], c = index[3*t+2];
+      if(a<0 or a>=nv or b<0 or b>=nv or c<0 or c>=nv)
+        throw runtime_error("(TriangleMesh::updateTriangles): vertex index of triangle " + to_string(t) + " out of range");
+      ax[t] = x[a]; ay[t] = y[a]; az[t] = z[a];
+      bx[t] = x[b]; by[t] = y[b]; bz[t] = z[b];
+      cx[t] = x[c]; cy[t] = y[c]; cz[t] = z[c];
+      e0x[t] = bx[t]-ax[t]; e0y[t] = by[t]-ay[t]; e0z[t] = bz[t]-az[t];
+      e1x[t] = cx[t]-bx[t]; e1y[t] = cy[t]-by[t]; e1z[t] = cz[t]-bz[t];
+      e2x[t] = ax[t]-cx[t]; e2y[t] = ay[t]-cy[t]; e2z[t] = az[t]-cz[t];
+      double l0 = e0x[t]*e0x[t]+e0y[t]*e0y[t]+e0z[t]*e0z[t];
+      double l1 = e1x[t]*e1x[t]+e1y[t]*e1y[t]+e1z[t]*e1z[t];
+      double l2 = e2x[t]*e2x[t]+e2y[t]*e2y[t]+e2z[t]*e2z[t];
+      ie0[t] = l0>0 ? 1/l0 : 0;
+      ie1[t] = l1>0 ? 1/l1 : 0;
+      ie2[t] = l2>0 ? 1/l2 : 0;
+      // n = e0 x (c-a) = e2 x e0
+      nx[t] = e2y[t]*e0z[t]-e2z[t]*e0y[t];
+      ny[t] = e2z[t]*e0x[t]-e2x[t]*e0z[t];
+      nz[t] = e2x[t]*e0y[t]-e2y[t]*e0x[t];
+      double ln = nx[t]*nx[t]+ny[t]*ny[t]+nz[t]*nz[t];
+      in[t] = ln>0 ? 1/ln : 0;
+    }
+
+    // angle weighted pseudo-normals of the vertices
+    vnx.assign(nv, 0);
+    vny.assign(nv, 0);
+    vnz.assign(nv, 0);
+    for(size_t t=0; t<ax.size(); t++) {
+      double lnInv = sqrt(in[t]);
+      const double edge[3][3] = {{e0x[t],e0y[t],e0z[t]}, {e1x[t],e1y[t],e1z[t]}, {e2x[t],e2y[t],e2z[t]}};
+      const double ie[3] = {ie0[t], ie1[t], ie2[t]};
+      for(int k=0; k<3; k++) {
+        // angle at the corner k between the edge k and the reversed edge k-1
+        int l = (k+2)%3;
+        double cosAlpha = -(edge[k][0]*edge[l][0]+edge[k][1]*edge[l][1]+edge[k][2]*edge[l][2])*sqrt(ie[k]*ie[l]);
+        double alpha = acos(min(max(cosAlpha, -1.), 1.));
+        int v = index[3*t+k];
+        vnx[v] += alpha*nx[t]*lnInv;
+        vny[v] += alpha*ny[t]*lnInv;
+        vnz[v] += alpha*nz[t]*lnInv;
+      }
+    }
+  }
+
+  void TriangleMesh::updateBoxes() {
+    int nv = x.size();
+    int nb = (nv+blockSize-1)/blockSize;
+    vertexBoxMin.resize(nb);
+    vertexBoxMax.resize(nb);
+    for(int k=0; k<nb; k++) {
+      Vec3 &min_ = vertexBoxMin[k], &max_ = vertexBoxMax[k];
+      min_(0) = min_(1) = min_(2) = numeric_limits<double>::max();
+      max_(0) = max_(1) = max_(2) = -numeric_limits<double>::max();
+      for(int i=k*blockSize; i<min(nv,(k+1)*blockSize); i++) {
+        min_(0) = min(min_(0),x[i]); max_(0) = max(max_(0),x[i]);
+        min_(1) = min(min_(1),y[i]); max_(1) = max(max_(1),y[i]);
+        min_(2) = min(min_(2),z[i]); max_(2) = max(max_(2),z[i]);
+      }
+    }
+    int nt = ax.size();
+    nb = (nt+blockSize-1)/blockSize;
+    triangleBoxMin.resize(nb);
+    triangleBoxMax.resize(nb);
+    for(int k=0; k<nb; k++) {
+      Vec3 &min_ = triangleBoxMin[k], &max_ = triangleBoxMax[k];
+      min_(0) = min_(1) = min_(2) = numeric_limits<double>::max();
+      max_(0) = max_(1) = max_(2) = -numeric_limits<double>::max();
+      for(int t=k*blockSize; t<min(nt,(k+1)*blockSize); t++) {
+        min_(0) = min({min_(0),ax[t],bx[t],cx[t]}); max_(0) = max({max_(0),ax[t],bx[t],cx[t]});
+        min_(1) = min({min_(1),ay[t],by[t],cy[t]}); max_(1) = max({max_(1),ay[t],by[t],cy[t]});
+        min_(2) = min({min_(2),az[t],bz[t],cz[t]}); max_(2) = max({max_(2),az[t],bz[t],cz[t]});
+      }
+    }
+  }
+
+  int TriangleMesh::computePlaneDistances(const Vec3 &n, double d, int num, vector<int> &vertexIndex, vector<double> &g) {
+    const double n0 = n(0), n1 = n(1), n2 = n(2);
+    int nv = x.size();
+    int nb = vertexBoxMin.size();
+    // lower bound of n^T v - d within each box
+    order.resize(nb);
+    for(int k=0; k<nb; k++) {
+      double gc = 0, h = 0;
+      for(int i=0; i<3; i++) {
+        gc += n(i)*(vertexBoxMax[k](i)+vertexBoxMin[k](i))/2;
+        h += fabs(n(i))*(vertexBoxMax[k](i)-vertexBoxMin[k](i))/2;
+      }
+      order[k] = make_pair(gc-h-d, k);
+    }
+    sort(order.begin(), order.end());
+
+    // max heap of the num smallest distances
+    vector<pair<double,int>> best;
+    best.reserve(num+1);
+    work.resize(blockSize);
+    double *w = work.data();
+    for(const auto &o : order) {
+      if((int)best.size()==num and o.first>=best.front().first)
+        break;
+      int j0 = o.second*blockSize;
+      int m = min(blockSize, nv-j0);
+      const double *px = &x[j0], *py = &y[j0], *pz = &z[j0];
+#pragma omp simd
+      for(int j=0; j<m; j++)
+        w[j] = n0*px[j] + n1*py[j] + n2*pz[j] - d;
+      for(int j=0; j<m; j++) {
+        if((int)best.size()<num) {
+          best.emplace_back(w[j], j0+j);
+          push_heap(best.begin(), best.end());
+        }
+        else if(w[j]<best.front().first) {
+          pop_heap(best.begin(), best.end());
+          best.back() = make_pair(w[j], j0+j);
+          push_heap(best.begin(), best.end());
+        }
+      }
+    }
+    sort_heap(best.begin(), best.end());
+
+    vertexIndex.resize(best.size());
+    g.resize(best.size());
+    for(size_t i=0; i<best.size(); i++) {
+      g[i] = best[i].first;
+      vertexIndex[i] = best[i].second;
+    }
+    return best.size();
+  }
+
+  double TriangleMesh::computePointDistance(const Vec3 &c, Vec3 &p, Vec3 &n) {
+    const double c0 = c(0), c1 = c(1), c2 = c(2);
+    int nt = ax.size();
+    int nb = triangleBoxMin.size();
+    if(nt==0)
+      throw runtime_error("(TriangleMesh::computePointDistance): mesh without triangles");
+    // squared distance to each box
+    order.resize(nb);
+    for(int k=0; k<nb; k++) {
+      double dist = 0;
+      for(int i=0; i<3; i++) {
+        double e = max({triangleBoxMin[k](i)-c(i), 0., c(i)-triangleBoxMax[k](i)});
+        dist += e*e;
+      }
+      order[k] = make_pair(dist, k);
+    }
+    sort(order.begin(), order.end());
+
+    double best = numeric_limits<double>::max();
+    int t = -1;
+    work.resize(blockSize);
+    double *w = work.data();
+    for(const auto &o : order) {
+      if(o.first>=best)
+        break;
+      int j0 = o.second*blockSize;
+      int m = min(blockSize, nt-j0);
+#pragma omp simd
+      for(int j=j0; j<j0+m; j++) {
+        // c-a, c-b, c-c
+        double pax = c0-ax[j], pay = c1-ay[j], paz = c2-az[j];
+        double pbx = c0-bx[j], pby = c1-by[j], pbz = c2-bz[j];
+        double pcx = c0-cx[j], pcy = c1-cy[j], pcz = c2-cz[j];
+        // projection inside the triangle if c lies on the inner side of all edges
+        double s0 = (e0y[j]*paz-e0z[j]*pay)*nx[j] + (e0z[j]*pax-e0x[j]*paz)*ny[j] + (e0x[j]*pay-e0y[j]*pax)*nz[j];
+        double s1 = (e1y[j]*pbz-e1z[j]*pby)*nx[j] + (e1z[j]*pbx-e1x[j]*pbz)*ny[j] + (e1x[j]*pby-e1y[j]*pbx)*nz[j];
+        double s2 = (e2y[j]*pcz-e2z[j]*pcy)*nx[j] + (e2z[j]*pcx-e2x[j]*pcz)*ny[j] + (e2x[j]*pcy-e2y[j]*pcx)*nz[j];
+        double dn = pax*nx[j] + pay*ny[j] + paz*nz[j];
+        double dPlane = dn*dn*in[j];
+        // distances to the edges
+        double u0 = min(max((pax*e0x[j]+pay*e0y[j]+paz*e0z[j])*ie0[j], 0.), 1.);
+        double u1 = min(max((pbx*e1x[j]+pby*e1y[j]+pbz*e1z[j])*ie1[j], 0.), 1.);
+        double u2 = min(max((pcx*e2x[j]+pcy*e2y[j]+pcz*e2z[j])*ie2[j], 0.), 1.);
+        double q0x = pax-u0*e0x[j], q0y = pay-u0*e0y[j], q0z = paz-u0*e0z[j];
+        double q1x = pbx-u1*e1x[j], q1y = pby-u1*e1y[j], q1z = pbz-u1*e1z[j];
+        double q2x = pcx-u2*e2x[j], q2y = pcy-u2*e2y[j], q2z = pcz-u2*e2z[j];
+        double dEdge = min(min(q0x*q0x+q0y*q0y+q0z*q0z, q1x*q1x+q1y*q1y+q1z*q1z), q2x*q2x+q2y*q2y+q2z*q2z);
+        bool inside = s0>=0 and s1>=0 and s2>=0 and in[j]>0;
+        w[j-j0] = inside ? dPlane : dEdge;
+      }
+      for(int j=0; j<m; j++) {
+        if(w[j]<best) {
+          best = w[j];
+          t = j0+j;
+        }
+      }
+    }
+
+    // closest point of the best triangle
+    double lnInv = sqrt(in[t]);
+    n(0) = nx[t]*lnInv;
+    n(1) = ny[t]*lnInv;
+    n(2) = nz[t]*lnInv;
+    double dn = (c0-ax[t])*n(0) + (c1-ay[t])*n(1) + (c2-az[t])*n(2);
+    if(fabs(dn*dn-best)<=1e-12*max(best,1.)) {
+      // interior of the face: the face normal gives the sign
+      p(0) = c0-dn*n(0);
+      p(1) = c1-dn*n(1);
+      p(2) = c2-dn*n(2);
+      return (dn<0?-1:1)*sqrt(best);
+    }
+
+    // closest point on an edge or a vertex: the sign is given by the angle weighted pseudo-normal
+    const double corner[3][3] = {{ax[t],ay[t],az[t]}, {bx[t],by[t],bz[t]}, {cx[t],cy[t],cz[t]}};
+    const double edge[3][3] = {{e0x[t],e0y[t],e0z[t]}, {e1x[t],e1y[t],e1z[t]}, {e2x[t],e2y[t],e2z[t]}};
+    const double ie[3] = {ie0[t], ie1[t], ie2[t]};
+    double dmin = numeric_limits<double>::max();
+    int kmin = 0;
+    double umin = 0;
+    for(int k=0; k<3; k++) {
+      double u = 0;
+      for(int i=0; i<3; i++)
+        u += (c(i)-corner[k][i])*edge[k][i];
+      u = min(max(u*ie[k], 0.), 1.);
+      Vec3 q(NONINIT);
+      for(int i=0; i<3; i++)
+        q(i) = corner[k][i]+u*edge[k][i];
+      double dist = pow(nrm2(c-q),2);
+      if(dist<dmin) {
+        dmin = dist;
+        kmin = k;
+        umin = u;
+        p = q;
+      }
+    }
+    Vec3 N(NONINIT);
+    if(umin<=0 or umin>=1) {
+      int v = index[3*t+(umin<=0 ? kmin : (kmin+1)%3)];
+      N(0) = vnx[v];
+      N(1) = vny[v];
+      N(2) = vnz[v];
+    }
+    else {
+      N = n;
+      int t1 = edgeNeighbour[3*t+kmin];
+      if(t1>=0) {
+        double lnInv1 = sqrt(in[t1]);
+        N(0) += nx[t1]*lnInv1;
+        N(1) += ny[t1]*lnInv1;
+        N(2) += nz[t1]*lnInv1;
+      }
+    }
+    double nrmN = nrm2(N);
+    if(nrmN>0)
+      n = N/nrmN;
+    return ((c-p).T()*N<0?-1:1)*sqrt(best);
+  }
+
+}
@@ -0,0 +1,132 @@
+/* Copyright (C) 2004-2018 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or 
+ * modify it under the terms of the GNU Lesser General Public 
+ * License as published by the Free Software Foundation; either 
+ * version 2.1 of the License, or (at your option) any later version. 
+ *  
+ * This library is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+ * Lesser General Public License for more details. 
+ *  
+ * You should have received a copy of the GNU Lesser General Public 
+ * License along with this library; if not, write to the Free Software 
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _MBSIMFCL_TRIANGLE_MESH_H_
+#define _MBSIMFCL_TRIANGLE_MESH_H_
+
+#include "fmatvec/fmatvec.h"
+#include <vector>
+#include <utility>
+
+namespace MBSimFcl {
+
+  /**
+   * \brief triangle mesh in structure of arrays layout for the narrow phase between meshes and primitives
+   *
+   * Vertices and triangles are grouped into blocks of consecutive entries with an axis aligned bounding box
+   * each. The queries visit the blocks in the order of a lower bound of the distance and stop as soon as
+   * no remaining block can improve the result. Within a block all loops run branch free over contiguous
+   * arrays, so that they are vectorised by the compiler.
+   */
+  class TriangleMesh {
+    public:
+      /**
+       * \brief constructor
+       * \param blockSize number of vertices and triangles per bounding box
+       */
+      TriangleMesh(int blockSize_=64) : blockSize(blockSize_) { }
+
+      /**
+       * \brief set the triangles
+       * \param index three vertex indices per triangle (counterclockwise seen from outside)
+       */
+      void setTriangles(const std::vector<int> &index);
+
+      /**
+       * \brief set the vertex positions
+       *
+       * May be called again with moved vertices of a deformable mesh; then only the triangle data and the
+       * bounding boxes are refitted.
+       */
+      void setVertices(const fmatvec::MatVx3 &vertex);
+
+      int getNumberOfVertices() const { return x.size(); }
+      int getNumberOfTriangles() const { return ax.size(); }
+
+      /**
+       * \brief vertices closest to the plane n^T x = d
+       * \param n unit normal of the plane in the mesh frame
+       * \param d offset of the plane
+       * \param num maximum number of vertices
+       * \param vertexIndex indices of the vertices with the smallest distances (sorted)
+       * \param g signed distances g = n^T v - d of these vertices
+       * \return number of vertices found
+       */
+      int computePlaneDistances(const fmatvec::Vec3 &n, double d, int num, std::vector<int> &vertexIndex, std::vector<double> &g);
+
+      /**
+       * \brief closest point of the mesh surface to the point c (mesh frame)
+       *
+       * The sign is determined by the angle weighted pseudo-normal of the feature (face, edge or vertex) with
+       * the closest point, which is correct for closed meshes also if the closest point is on an edge or a vertex.
+       * \param c point
+       * \param p closest point on the mesh
+       * \param n unit (pseudo-)normal of the mesh at the closest point
+       * \return distance, negative if c is inside the mesh
+       */
+      double computePointDistance(const fmatvec::Vec3 &c, fmatvec::Vec3 &p, fmatvec::Vec3 &n);
+
+    private:
+      void updateTriangles();
+      void updateBoxes();
+
+      int blockSize;
+
+      /**
+       * \brief vertex coordinates
+       */
+      std::vector<double> x, y, z;
+
+      /**
+       * \brief vertex indices of the triangles
+       */
+      std::vector<int> index;
+
+      /**
+       * \brief triangle corners, edges b-a, c-b, a-c with inverse squared lengths and normal with inverse squared length
+       */
+      std::vector<double> ax, ay, az, bx, by, bz, cx, cy, cz;
+      std::vector<double> e0x, e0y, e0z, e1x, e1y, e1z, e2x, e2y, e2z, ie0, ie1, ie2;
+      std::vector<double> nx, ny, nz, in;
+
+      /**
+       * \brief triangle adjacent to each edge b-a, c-b, a-c of a triangle (-1 at the boundary of the mesh)
+       */
+      std::vector<int> edgeNeighbour;
+
+      /**
+       * \brief angle weighted pseudo-normals of the vertices (not normalised)
+       */
+      std::vector<double> vnx, vny, vnz;
+
+      /**
+       * \brief bounding boxes of the vertex blocks and the triangle blocks
+       */
+      std::vector<fmatvec::Vec3> vertexBoxMin, vertexBoxMax, triangleBoxMin, triangleBoxMax;
+
+      /**
+       * \brief work arrays
+       */
+      std::vector<std::pair<double,int>> order;
+      std::vector<double> work;
+  };
+
+}
+
+#endif
@@ -46,6 +46,35 @@ namespace MBSimFlexibleBody {
     setMaximumNumberOfContacts(nodes->getNodeNumbers().size());
   }
 
+  void ContactKinematicsNodesCylinder::updateg(vector<SingleContact> &contact) {
+    // the frame of the cylinder is evaluated before the parallel narrow phase
+    const Vec3 &WrC = cylinder->getFrame()->evalPosition();
+    const Vec3 Wez = cylinder->getFrame()->evalOrientation().col(2);
+
+    // broad phase: lower bound of the distance of all nodes in a bounding box
+    int nodesPerBox = nodes->getNodesPerBoundingBox();
+    candidates.clear();
+    for(int k=0; k<nodes->getNumberOfBoundingBoxes() and k*nodesPerBox<maxNumContacts; k++) {
+      const Vec3 &WrMin = nodes->evalBoundingBoxMin(k);
+      const Vec3 &WrMax = nodes->evalBoundingBoxMax(k);
+      Vec3 WrP = 0.5*(WrMin+WrMax) - WrC;
+      double g = nrm2(WrP - (Wez.T()*WrP)*Wez) - 0.5*nrm2(WrMax-WrMin) - cylinder->getRadius();
+      int end = min((k+1)*nodesPerBox, maxNumContacts);
+      for(int i=k*nodesPerBox; i<end; i++) {
+        // the bound is only used for clearly separated nodes, the exact gap is computed within the tolerance band
+        if(g>contact[i].getGeneralizedRelativePositionTolerance()+candidateMargin)
+          contact[i].getGeneralizedRelativePosition(false)(0) = g;
+        else
+          candidates.push_back(i);
+      }
+    }
+
+    // narrow phase
+#pragma omp parallel for schedule(static)
+    for(size_t j=0; j<candidates.size(); j++)
+      updateg(contact[candidates[j]], candidates[j]);
+  }
+
   void ContactKinematicsNodesCylinder::updateg(SingleContact &contact, int i) {
     const Vec3 &WrN = nodes->evalPosition(i);
     const Vec3 WrP = WrN - cylinder->getFrame()->evalPosition();
@@ -38,9 +38,17 @@ namespace MBSimFlexibleBody {
   class ContactKinematicsNodesCylinder : public MBSim::ContactKinematics {
     public:
       void assignContours(const std::vector<MBSim::Contour*> &contour) override;
+      void updateg(std::vector<MBSim::SingleContact> &contact) override;
       void updateg(MBSim::SingleContact &contact, int i=0) override;
       void updatewb(MBSim::SingleContact &contact, int i=0) override;
 
+      const std::vector<int>& getCandidates() const { return candidates; }
+
+      /**
+       * \brief additional safety margin of the lower bound of a bounding box: nodes with a bound below gTol+margin are evaluated exactly
+       */
+      void setCandidateMargin(double margin) { candidateMargin = margin; }
+
     protected:
       /**
        * \brief contour index
@@ -52,6 +60,13 @@ namespace MBSimFlexibleBody {
        */
       NodesContour *nodes;
       MBSim::Cylinder *cylinder;
+
+      /**
+       * \brief nodes of potentially active contacts found by the bounding box test
+       */
+      std::vector<int> candidates;
+
+      double candidateMargin{0};
   };
 
 }
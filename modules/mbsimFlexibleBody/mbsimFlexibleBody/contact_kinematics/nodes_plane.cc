@@ -45,6 +45,36 @@ namespace MBSimFlexibleBody {
     setMaximumNumberOfContacts(nodes->getNodeNumbers().size());
   }
 
+  void ContactKinematicsNodesPlane::updateg(vector<SingleContact> &contact) {
+    // the frame of the plane is evaluated before the parallel narrow phase
+    const Vec3 &WrP = plane->getFrame()->evalPosition();
+    const Vec3 Wn = plane->getFrame()->evalOrientation().col(0);
+
+    // broad phase: lower bound of the distance of all nodes in a bounding box
+    int nodesPerBox = nodes->getNodesPerBoundingBox();
+    candidates.clear();
+    for(int k=0; k<nodes->getNumberOfBoundingBoxes() and k*nodesPerBox<maxNumContacts; k++) {
+      const Vec3 &WrMin = nodes->evalBoundingBoxMin(k);
+      const Vec3 &WrMax = nodes->evalBoundingBoxMax(k);
+      double g = Wn.T()*(0.5*(WrMin+WrMax)-WrP);
+      for(int j=0; j<3; j++)
+        g -= 0.5*fabs(Wn(j))*(WrMax(j)-WrMin(j));
+      int end = min((k+1)*nodesPerBox, maxNumContacts);
+      for(int i=k*nodesPerBox; i<end; i++) {
+        // the bound is only used for clearly separated nodes, the exact gap is computed within the tolerance band
+        if(g>contact[i].getGeneralizedRelativePositionTolerance()+candidateMargin)
+          contact[i].getGeneralizedRelativePosition(false)(0) = g;
+        else
+          candidates.push_back(i);
+      }
+    }
+
+    // narrow phase
+#pragma omp parallel for schedule(static)
+    for(size_t j=0; j<candidates.size(); j++)
+      updateg(contact[candidates[j]], candidates[j]);
+  }
+
   void ContactKinematicsNodesPlane::updateg(SingleContact &contact, int i) {
     contact.getContourFrame(iplane)->setOrientation(plane->getFrame()->evalOrientation());
     contact.getContourFrame(inodes)->getOrientation(false).set(0, -plane->getFrame()->getOrientation().col(0));
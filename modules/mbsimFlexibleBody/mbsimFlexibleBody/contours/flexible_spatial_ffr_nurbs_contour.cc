@@ -55,16 +55,31 @@ namespace MBSimFlexibleBody {
     return zeta;
   }
 
-  void FlexibleSpatialFfrNurbsContour::updateHessianMatrix(const Vec2 &zeta_) {
-    Vec2 zeta = continueZeta(zeta_);
-    srfPos.deriveAtH(zeta(0),zeta(1),2,hessPos);
-    for(size_t i=0; i<srfPhi.size(); i++)
-      srfPhi[i].deriveAtH(zeta(0),zeta(1),2,hessPhi[i]);
-    zetaOld = zeta_;
+  void FlexibleSpatialFfrNurbsContour::updateHessianMatrix(const Vec2 &zeta_, int d) {
+    int dmin = 0;
+    if(hessOrder<0 or zetaChanged(zeta_)) {
+      // spans and basis functions are computed once per zeta for all derivative orders
+      Vec2 zeta = continueZeta(zeta_);
+      srfPos.dersBasisFunsAt(zeta(0),zeta(1),2,uSpan,vSpan,Nu,Nv);
+      zetaOld = zeta_;
+    }
+    else
+      dmin = hessOrder+1;
+    if(sharedKnots) {
+      srfPos.deriveAtH(uSpan,vSpan,Nu,Nv,d,hessPos,dmin);
+      NurbsSurface::deriveAtH(srfPhi,uSpan,vSpan,Nu,Nv,d,hessPhi,dmin);
+    }
+    else {
+      Vec2 zeta = continueZeta(zetaOld);
+      srfPos.deriveAtH(uSpan,vSpan,Nu,Nv,d,hessPos,dmin);
+      for(size_t i=0; i<srfPhi.size(); i++)
+        srfPhi[i].deriveAtH(zeta(0),zeta(1),d,hessPhi[i]);
+    }
+    hessOrder = d;
   }
 
   void FlexibleSpatialFfrNurbsContour::updateGlobalRelativePosition(const Vec2 &zeta) {
-    Vec3 KrPS = evalHessianMatrixPos(zeta)(0,0)(Range<Fixed<0>,Fixed<2>>());
+    Vec3 KrPS = evalHessianMatrixPos(zeta,0)(0,0)(Range<Fixed<0>,Fixed<2>>());
     for(size_t i=0; i<srfPhi.size(); i++)
       KrPS += hessPhi[i](0,0)(Range<Fixed<0>,Fixed<2>>())*static_cast<GenericFlexibleFfrBody*>(parent)->evalqERel()(i);
     WrPS = R->evalOrientation()*KrPS;
@@ -72,7 +87,7 @@ namespace MBSimFlexibleBody {
   }
 
   void FlexibleSpatialFfrNurbsContour::updateGlobalRelativeVelocity(const Vec2 &zeta) {
-    if(fabs(zeta(0)-zetaOld(0))>1e-13 or fabs(zeta(1)-zetaOld(1))>1e-13) updateHessianMatrix(zeta);
+    evalHessianMatrixPhi(zeta,0);
     Vec3 Kvrel;
     for(size_t i=0; i<srfPhi.size(); i++)
       Kvrel += hessPhi[i](0,0)(Range<Fixed<0>,Fixed<2>>())*static_cast<GenericFlexibleFfrBody*>(parent)->evalqdERel()(i);
@@ -87,7 +102,7 @@ namespace MBSimFlexibleBody {
   }
 
   Vec3 FlexibleSpatialFfrNurbsContour::evalKs_t(const Vec2 &zeta) {
-    if(fabs(zeta(0)-zetaOld(0))>1e-13 or fabs(zeta(1)-zetaOld(1))>1e-13) updateHessianMatrix(zeta);
+    evalHessianMatrixPhi(zeta,1);
     Vec3 s_t;
     for(size_t i=0; i<srfPhi.size(); i++)
       s_t += hessPhi[i](1,0)(Range<Fixed<0>,Fixed<2>>())*static_cast<GenericFlexibleFfrBody*>(parent)->evalqdERel()(i);
@@ -95,7 +110,7 @@ namespace MBSimFlexibleBody {
   }
 
   Vec3 FlexibleSpatialFfrNurbsContour::evalKt_t(const Vec2 &zeta) {
-    if(fabs(zeta(0)-zetaOld(0))>1e-13 or fabs(zeta(1)-zetaOld(1))>1e-13) updateHessianMatrix(zeta);
+    evalHessianMatrixPhi(zeta,1);
     Vec3 t_t;
     for(size_t i=0; i<srfPhi.size(); i++)
       t_t += hessPhi[i](0,1)(Range<Fixed<0>,Fixed<2>>())*static_cast<GenericFlexibleFfrBody*>(parent)->evalqdERel()(i);
@@ -113,21 +128,21 @@ namespace MBSimFlexibleBody {
   }
 
   Vec3 FlexibleSpatialFfrNurbsContour::evalKrPS(const Vec2 &zeta) {
-    Vec3 KrPS = evalHessianMatrixPos(zeta)(0,0)(Range<Fixed<0>,Fixed<2>>());
+    Vec3 KrPS = evalHessianMatrixPos(zeta,0)(0,0)(Range<Fixed<0>,Fixed<2>>());
     for(size_t i=0; i<srfPhi.size(); i++)
       KrPS += hessPhi[i](0,0)(Range<Fixed<0>,Fixed<2>>())*static_cast<GenericFlexibleFfrBody*>(parent)->evalqERel()(i);
     return KrPS;
   }
 
   Vec3 FlexibleSpatialFfrNurbsContour::evalKs(const Vec2 &zeta) {
-    Vec3 s = evalHessianMatrixPos(zeta)(1,0)(Range<Fixed<0>,Fixed<2>>());
+    Vec3 s = evalHessianMatrixPos(zeta,1)(1,0)(Range<Fixed<0>,Fixed<2>>());
     for(size_t i=0; i<srfPhi.size(); i++)
       s += hessPhi[i](1,0)(Range<Fixed<0>,Fixed<2>>())*static_cast<GenericFlexibleFfrBody*>(parent)->evalqERel()(i);
     return s;
   }
 
   Vec3 FlexibleSpatialFfrNurbsContour::evalKt(const Vec2 &zeta) {
-    Vec3 t = evalHessianMatrixPos(zeta)(0,1)(Range<Fixed<0>,Fixed<2>>());
+    Vec3 t = evalHessianMatrixPos(zeta,1)(0,1)(Range<Fixed<0>,Fixed<2>>());
     for(size_t i=0; i<srfPhi.size(); i++)
       t += hessPhi[i](0,1)(Range<Fixed<0>,Fixed<2>>())*static_cast<GenericFlexibleFfrBody*>(parent)->evalqERel()(i);
     return t;
@@ -316,7 +331,7 @@ namespace MBSimFlexibleBody {
   void FlexibleSpatialFfrNurbsContour::updateJacobians(Frame *frame, int j) {
     auto contourFrame = static_cast<ContourFrame*>(frame);
     assert(dynamic_cast<ContourFrame*>(frame));
-    if(fabs(contourFrame->evalZeta()(0)-zetaOld(0))>1e-13 or fabs(contourFrame->evalZeta()(1)-zetaOld(1))>1e-13) updateHessianMatrix(contourFrame->evalZeta());
+    evalHessianMatrixPhi(contourFrame->evalZeta(),0);
     Mat3xV Phi(srfPhi.size(),NONINIT);
     for(size_t i=0; i<srfPhi.size(); i++)
       Phi.set(i,hessPhi[i](0,0)(Range<Fixed<0>,Fixed<2>>()));
@@ -410,6 +425,13 @@ namespace MBSimFlexibleBody {
       }
 
       zetaOld.init(-1e10);
+      hessOrder = -1;
+      sharedKnots = true;
+      for(size_t k=0; k<srfPhi.size(); k++)
+        sharedKnots = sharedKnots and srfPos.hasSameKnots(srfPhi[k]);
+      hessPos.resize(3,3);
+      for(auto &hess : hessPhi)
+        hess.resize(3,3);
       etaNodes.resize(2);
       etaNodes[0] = srfPos.knotU()(srfPos.degreeU());
       etaNodes[1] = srfPos.knotU()(srfPos.knotU().size()-srfPos.degreeU()-1);
@@ -142,11 +142,16 @@ namespace MBSimFlexibleBody {
 
     protected:
       fmatvec::Vec2 continueZeta(const fmatvec::Vec2 &zeta_);
-      void updateHessianMatrix(const fmatvec::Vec2 &zeta);
+      void updateHessianMatrix(const fmatvec::Vec2 &zeta, int d=2);
       void updateGlobalRelativePosition(const fmatvec::Vec2 &zeta);
       void updateGlobalRelativeVelocity(const fmatvec::Vec2 &zeta);
-      const fmatvec::GeneralMatrix<fmatvec::Vec4>& evalHessianMatrixPos(const fmatvec::Vec2 &zeta) { if(fabs(zeta(0)-zetaOld(0))>1e-13 or fabs(zeta(1)-zetaOld(1))>1e-13) updateHessianMatrix(zeta); return hessPos; }
-      const std::vector<fmatvec::GeneralMatrix<fmatvec::Vec4>>& evalHessianMatrixPhi(const fmatvec::Vec2 &zeta) { if(fabs(zeta(0)-zetaOld(0))>1e-13 or fabs(zeta(1)-zetaOld(1))>1e-13) updateHessianMatrix(zeta); return hessPhi; }
+      bool zetaChanged(const fmatvec::Vec2 &zeta) const { return fabs(zeta(0)-zetaOld(0))>1e-13 or fabs(zeta(1)-zetaOld(1))>1e-13; }
+      /**
+       * \brief derivatives of the position and mode shape surfaces up to order d at zeta
+       * only the derivative orders not yet available at zeta are computed
+       */
+      const fmatvec::GeneralMatrix<fmatvec::Vec4>& evalHessianMatrixPos(const fmatvec::Vec2 &zeta, int d=2) { if(d>hessOrder or zetaChanged(zeta)) updateHessianMatrix(zeta,d); return hessPos; }
+      const std::vector<fmatvec::GeneralMatrix<fmatvec::Vec4>>& evalHessianMatrixPhi(const fmatvec::Vec2 &zeta, int d=2) { if(d>hessOrder or zetaChanged(zeta)) updateHessianMatrix(zeta,d); return hessPhi; }
       const fmatvec::Vec3& evalGlobalRelativePosition(const fmatvec::Vec2 &zeta) { if(updPos) updateGlobalRelativePosition(zeta); return WrPS; }
       const fmatvec::Vec3& evalGlobalRelativeVelocity(const fmatvec::Vec2 &zeta) { if(updVel) updateGlobalRelativeVelocity(zeta); return Wvrel; }
 
@@ -163,6 +168,10 @@ namespace MBSimFlexibleBody {
       fmatvec::Vec2 zetaOld;
       fmatvec::GeneralMatrix<fmatvec::Vec4> hessPos;
       std::vector<fmatvec::GeneralMatrix<fmatvec::Vec4>> hessPhi;
+      int hessOrder{-1}; // highest derivative order of hessPos and hessPhi available at zetaOld
+      bool sharedKnots{false}; // all mode shape surfaces share the knot vectors of srfPos
+      int uSpan{0}, vSpan{0}; // knot spans at zetaOld
+      fmatvec::Mat Nu, Nv; // derivatives of the basis functions at zetaOld
       fmatvec::Vec3 WrPS, Wvrel;
       bool updPos{true};
       bool updVel{true};
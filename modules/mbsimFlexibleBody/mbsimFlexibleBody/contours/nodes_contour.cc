@@ -40,6 +40,29 @@ namespace MBSimFlexibleBody {
     return static_cast<NodeBasedBody*>(parent)->evalNodalPosition(nodes(i));
   }
 
+  void NodesContour::updateBoundingBoxes() {
+    // the nodal positions are evaluated in serial as the body updates them lazily
+    for(int i=0; i<nodes.size(); i++)
+      evalPosition(i);
+    int nb = getNumberOfBoundingBoxes();
+    boxMin.resize(nb);
+    boxMax.resize(nb);
+#pragma omp parallel for schedule(static)
+    for(int k=0; k<nb; k++) {
+      int end = min((k+1)*nodesPerBox, nodes.size());
+      boxMin[k] = evalPosition(k*nodesPerBox);
+      boxMax[k] = boxMin[k];
+      for(int i=k*nodesPerBox+1; i<end; i++) {
+        const Vec3 &WrN = evalPosition(i);
+        for(int j=0; j<3; j++) {
+          boxMin[k](j) = min(boxMin[k](j), WrN(j));
+          boxMax[k](j) = max(boxMax[k](j), WrN(j));
+        }
+      }
+    }
+    updBox = false;
+  }
+
   void NodesContour::updatePositions(Frame *frame) {
     //frame->setVelocity(static_cast<NodeBasedBody*>(parent)->evalNodalPosition(nodes(frameMap[frame])));
     throwError("(NodesContour::updatePositions): not implemented");
@@ -55,6 +55,22 @@ namespace MBSimFlexibleBody {
 
       const fmatvec::Vec3& evalPosition(int i);
 
+      /*!
+       * \brief set the number of consecutive nodes enclosed by one bounding box for the contact candidate search
+       */
+      void setNodesPerBoundingBox(int n) { nodesPerBox = n; }
+      int getNodesPerBoundingBox() const { return nodesPerBox; }
+      int getNumberOfBoundingBoxes() const { return (nodes.size()+nodesPerBox-1)/nodesPerBox; }
+
+      /*!
+       * \brief axis aligned bounding box of the nodes [k*nodesPerBox,(k+1)*nodesPerBox), refitted once per time step
+       */
+      const fmatvec::Vec3& evalBoundingBoxMin(int k) { if(updBox) updateBoundingBoxes(); return boxMin[k]; }
+      const fmatvec::Vec3& evalBoundingBoxMax(int k) { if(updBox) updateBoundingBoxes(); return boxMax[k]; }
+      void updateBoundingBoxes();
+
+      void resetUpToDate() override { updBox = true; }
+
       void updatePositions(MBSim::Frame *frame) override;
       void updateVelocities(MBSim::Frame *frame) override;
       void updateAccelerations(MBSim::Frame *frame) override;
@@ -86,6 +102,10 @@ namespace MBSimFlexibleBody {
 
       int i{0};
 
+      int nodesPerBox{16};
+      std::vector<fmatvec::Vec3> boxMin, boxMax;
+      bool updBox{true};
+
       std::shared_ptr<OpenMBV::DynamicPointSet> openMBVBody;
   };
 
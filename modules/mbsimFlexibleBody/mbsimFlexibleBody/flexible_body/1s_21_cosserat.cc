@@ -23,6 +23,7 @@
 #include "mbsim/frames/fixed_contour_frame.h"
 #include "mbsimFlexibleBody/contours/nurbs_curve_1s.h"
 #include "mbsimFlexibleBody/utils/cardan.h"
+#include "mbsimFlexibleBody/utils/model_reduction.h"
 #include <mbsim/environment.h>
 #include "mbsim/utils/eps.h"
 #include "mbsim/utils/rotarymatrices.h"
@@ -36,7 +37,7 @@ using namespace H5;
 namespace MBSimFlexibleBody {
 
   FlexibleBody1s21Cosserat::FlexibleBody1s21Cosserat(const string &name, bool openStructure_) :
-      FlexibleBody1sCosserat(name, openStructure_), JInterp(false), PODreduced(false), U(), qFull(), uFull(), hFull() {
+      FlexibleBody1sCosserat(name, openStructure_), JInterp(false), PODreduced(false), U(), qFull(), uFull(), hFull(), ecswTol(0), krylovSize(0), krylovShift(0) {
   }
 
   FlexibleBody1s21Cosserat::~FlexibleBody1s21Cosserat() {
@@ -57,6 +58,11 @@ namespace MBSimFlexibleBody {
       qFull <<= q;
       uFull <<= u;
     }
+    gatherElements();
+    updEle = false;
+  }
+
+  void FlexibleBody1s21Cosserat::gatherElements() {
     /* translational elements */
     for (int i = 0; i < Elements; i++) {
       int j = 3 * i; // start index in entire beam coordinates
@@ -96,7 +102,6 @@ namespace MBSimFlexibleBody {
         uRotationElement[i] = uFull(RangeV(j - 1, j + 2));
       }
     }
-    updEle = false;
   }
 
   void FlexibleBody1s21Cosserat::GlobalVectorContribution(int n, const Vec& locVec, Vec& gloVec) {
@@ -225,24 +230,6 @@ namespace MBSimFlexibleBody {
     if (stage == preInit) {
       l0 = L / Elements;
 
-      if (PODreduced)
-        qSize = U.cols();
-      else
-        qSize = 3 * Elements;
-
-      uSize[0] = qSize;
-      uSize[1] = qSize; // TODO
-
-      if (PODreduced) {
-        //TODO: move into readz0
-        q0 <<= U.T() * q0;
-        u0 <<= U.T() * u0;
-        q <<= q0;
-        u <<= u0;
-      }
-
-      FlexibleBody1sCosserat::init(stage, config);
-
       // The example pearlchain_cosserat_2D_POD calls init(...) of this class which the instance of this class is not
       // part of a DynamicSystemSolver. This is not allowed!!!!! (It does this to get some kinematics prior the simulation)
       // The reenable this hack (ds is nullptr then) we use g = 0. This should be fixed by avoiding calling init(...) at all.
@@ -266,6 +253,31 @@ namespace MBSimFlexibleBody {
       }
 
       hFull.resize(3 * Elements);
+
+      // the elements are needed for the Krylov basis, which determines the size of the reduced coordinates
+      if (krylovSize > 0)
+        initKrylov();
+
+      if (PODreduced)
+        qSize = U.cols();
+      else
+        qSize = 3 * Elements;
+
+      uSize[0] = qSize;
+      uSize[1] = qSize; // TODO
+
+      if (PODreduced) {
+        //TODO: move into readz0
+        q0 <<= U.T() * q0;
+        u0 <<= U.T() * u0;
+        q <<= q0;
+        u <<= u0;
+      }
+
+      FlexibleBody1sCosserat::init(stage, config);
+
+      if (PODreduced && ecswTol > 0)
+        initHyperReduction();
     }
 
     else if (stage == unknownStage) {
@@ -302,6 +314,14 @@ namespace MBSimFlexibleBody {
   }
 
   void FlexibleBody1s21Cosserat::updateh(int k) {
+    if (hyperReduction) {
+      // hyper-reduction: only the coordinates of the sampled elements are reconstructed, evaluated and directly projected
+      h[k] = hyperReduction->computeh(q, u);
+      if (d_massproportional > 0)
+        h[k] -= d_massproportional * (M * u);
+      return;
+    }
+
     /* translational elements */
     hFull.init(0); //TODO: avoid this as values are overwritten in GlobalVectorContribution anyway?!
     for (int i = 0; i < (int) discretization.size(); i++)
@@ -339,36 +359,111 @@ namespace MBSimFlexibleBody {
   }
 
   void FlexibleBody1s21Cosserat::enablePOD(const string & h5Path, int reduceMode, int POMSize) {
-    // Set POD-Reduction true
-
-    Mat Snapshots = readPositionMatrix(h5Path, "q"); //TODO: which kind of "Job"...
-
-    int fullDOFs = 3 * Elements;
-    int nSnapshots = Snapshots.cols();
-
-    Mat SVD(fullDOFs, nSnapshots, NONINIT);
-    SqrMat POM(fullDOFs, NONINIT);
-    SqrMat POV(nSnapshots, NONINIT);
+    if (reduceMode == 1 && POMSize <= 0)
+      throwError("FlexibleBody1s21Cosserat::enablePOD(): No valid POMSize chosen -> Has to be positive!");
 
-    int info = svd(Snapshots, SVD, POM, POV, 1); //TODO: what is last parameter of svd for?
+    // snapshots of the positions of the full simulation: columns 1..3*Elements of the plot data
+    snapshotFile = h5Path;
+    U <<= computePODBasis(readSnapshots(h5Path, name, 1, 3 * Elements), reduceMode == 1 ? POMSize : 0);
 
-    if (info != 0) {
-      throwError("FlexibleBody1s21Cosserat::enablePOD(const string & h5Path, bool reduceEnergy): Single-Value-Decomposition was not succesfull");
-    }
+    PODreduced = true;
+  }
 
-    if (reduceMode == 1) {
-      if (POMSize <= 0)
-        throwError("FlexibleBody1s21Cosserat::enablePOD(): No valid POMSize chosen -> Has to be positive!");
-    }
-    else {
-      // k: Reduce Total Energy
-      POMSize = findPOMSize(POM, SVD);
+  void FlexibleBody1s21Cosserat::initHyperReduction() {
+    if (snapshotFile.empty())
+      throwError("FlexibleBody1s21Cosserat::initHyperReduction(): No plot file with the snapshots of the full simulation given!");
+    int fullDOFs = 3 * Elements;
+    int r = U.cols();
+    int nE = Elements + rotationalElements;
+
+    // rows of the basis belonging to each element; the modes are gathered like velocities
+    vector<Mat> UE(nE);
+    for (int i = 0; i < Elements; i++)
+      UE[i].resize(discretization[i]->getuSize(), r);
+    for (int i = 0; i < rotationalElements; i++)
+      UE[Elements + i].resize(rotationDiscretization[i]->getuSize(), r);
+    qFull.resize(fullDOFs, INIT, 0.);
+    for (int c = 0; c < r; c++) {
+      uFull <<= U.col(c);
+      gatherElements();
+      for (int i = 0; i < nE; i++) {
+        const Vec &uE = i < Elements ? uElement[i] : uRotationElement[i - Elements];
+        for (int l = 0; l < uE.size(); l++)
+          UE[i](l, c) = uE(l);
+      }
     }
 
-    U <<= POM(RangeV(0, fullDOFs - 1), RangeV(0, POMSize - 1));
+    hyperReduction = make_unique<HyperReduction>(move(UE), [this](int e, Vec &qE, Vec &uE) -> Vec {
+      if (e < Elements) {
+        discretization[e]->computeh(qE, uE);
+        return discretization[e]->geth();
+      }
+      int i = e - Elements;
+      if (i == 0) { // closing of the staggered grid (see gatherElements)
+        if (qE(3) < qE(0))
+          qE(0) -= 2. * M_PI;
+        else
+          qE(0) += 2. * M_PI;
+      }
+      rotationDiscretization[i]->computeh(qE, uE);
+      return rotationDiscretization[i]->geth();
+    });
+
+    // reduced coordinates of the snapshots of the full simulation
+    Mat Q = U.T() * readSnapshots(snapshotFile, name, 1, fullDOFs);
+    Mat V = U.T() * readSnapshots(snapshotFile, name, 1 + fullDOFs, fullDOFs);
+    if (not hyperReduction->train(Q, V, ecswTol))
+      msg(Warn) << "Hyper-reduction does not reach the tolerance " << ecswTol << endl;
+    msg(Info) << "Hyper-reduction samples " << hyperReduction->getElements().size() << " of " << nE << " elements" << endl;
+
+    updEle = true;
+  }
+
+  void FlexibleBody1s21Cosserat::initKrylov() {
+    int n = 3 * Elements;
+    if (q0.size() != n)
+      throwError("FlexibleBody1s21Cosserat::initKrylov(): The initial state has to be given in full coordinates!");
+
+    // mass matrix of the full beam
+    initM();
+
+    // tangent stiffness by finite differences of the forces at the initial configuration
+    qFull <<= q0;
+    uFull.resize(n, INIT, 0.);
+    gatherElements();
+    computehFull();
+    Vec h0 = hFull.copy();
+    SqrMat K(n, NONINIT);
+    for (int j = 0; j < n; j++) {
+      double dq = epsroot * (1 + fabs(q0(j)));
+      qFull(j) = q0(j) + dq;
+      gatherElements();
+      computehFull();
+      for (int i = 0; i < n; i++)
+        K(i, j) = -(hFull(i) - h0(i)) / dq;
+      qFull(j) = q0(j);
+    }
+
+    // the forces of the initial configuration load the beam
+    Mat F(n, 1, NONINIT);
+    F.set(0, h0);
+    U <<= computeKrylovBasis(MConst, K, F, krylovSize, krylovShift, q0);
+    msg(Info) << "Krylov basis with " << U.cols() << " vectors" << endl;
 
     PODreduced = true;
+    updEle = true;
+  }
 
+  void FlexibleBody1s21Cosserat::computehFull() {
+    hFull.init(0);
+    for (int i = 0; i < Elements; i++) {
+      discretization[i]->computeh(qElement[i], uElement[i]);
+      GlobalVectorContribution(i, discretization[i]->geth(), hFull);
+    }
+    for (int i = 0; i < rotationalElements; i++) {
+      rotationDiscretization[i]->computeh(qRotationElement[i], uRotationElement[i]);
+      GlobalVectorContributionRotation(i, rotationDiscretization[i]->geth(), hFull);
+    }
   }
 
   fmatvec::Vector<Fixed<6>, double> FlexibleBody1s21Cosserat::getPositions(double sGlobal) {
@@ -652,71 +747,4 @@ namespace MBSimFlexibleBody {
 //      setu0(u0Dummy);
 
   }
-
-  Mat FlexibleBody1s21Cosserat::readPositionMatrix(const string & h5File, const string & Job) {
-    H5::File file(h5File, H5::File::read);
-    auto *group = file.openChildObject<H5::Group>("objects")->openChildObject<H5::Group>(name);
-    auto *data = group->openChildObject<H5::VectorSerie<double>>("data");
-
-    int qsize = data->getColumns();
-    int tsize = data->getColumn(0).size();
-
-    int i;
-    int start;
-    int end;
-    Mat X_(tsize, qsize, INIT, 0.);
-
-    if (Job == "A") {
-      start = 0;
-      end = qsize;
-      X_.resize(tsize, end - start, INIT, 0.);
-    }
-    else if (Job == "q") {
-      start = 1;
-      end = (qsize - 1) / 2 + 1;
-      X_.resize(tsize, end - start, INIT, 0.);
-    }
-    else if (Job == "u") {
-      start = (qsize - 1) / 2 + 1;
-      end = qsize;
-      X_.resize(tsize, end - start, INIT, 0.);
-    }
-    else if (Job == "z") {
-      start = 1;
-      end = qsize;
-      X_.resize(tsize, end - start, INIT, 0.);
-    }
-    else {
-      start = 0;
-      end = qsize;
-      msg(Debug) << "---------------------------------------" << endl;
-      msg(Debug) << "no job has been selected: make job = A" << endl << endl;
-    }
-
-    for (i = start; i < end; i++) {
-      Vec tmp(data->getColumn(i));
-      X_.set(RangeV(0, tsize - 1), RangeV(i - start, i - start), tmp(RangeV(0, tsize - 1)));
-    }
-
-    return X_.T();
-  }
-
-  int FlexibleBody1s21Cosserat::findPOMSize(const Mat & POM, const Mat & SVD, double precission) {
-    double SVEnergy = 0;
-    double TmpSVEnergy = 0;
-    int m = POM.rows();
-    int i = 0;
-    for (i = 0; i < m - 1; i++) {
-      SVEnergy += SVD(i, i);
-    }
-
-    int n = 0;
-    while (TmpSVEnergy < precission * SVEnergy && n < m) {
-      TmpSVEnergy += SVD(n, n);
-      n++;
-    }
-    return n;
-
-  }
 }
-
@@ -27,7 +27,9 @@
 #include "mbsimFlexibleBody/contours/flexible_band.h"
 #include "mbsimFlexibleBody/flexible_body/fe/1s_21_cosserat_translation.h"
 #include "mbsimFlexibleBody/flexible_body/fe/1s_21_cosserat_rotation.h"
+#include "mbsimFlexibleBody/utils/model_reduction.h"
 #include <openmbvcppinterface/spineextrusion.h>
+#include <memory>
 
 namespace MBSimFlexibleBody {
 
@@ -141,6 +143,27 @@ namespace MBSimFlexibleBody {
        * \param  reduced mass matrix
        */
       void enablePOD(const std::string & h5Path, int reduceMode = 0, int POMSize = 0);
+
+      /* \brief Krylov basis of the beam linearised at the initial configuration
+       * \param size number of basis vectors
+       * \param sigma shift below the lowest elastic eigenvalue; a free beam needs sigma<0
+       *
+       * the basis spans the initial configuration, the static response to the forces of the initial configuration and
+       * the following Krylov vectors (see computeKrylovBasis); no snapshots are needed
+       */
+      void enableKrylov(int size, double sigma = 0) { krylovSize = size; krylovShift = sigma; }
+
+      /* \brief hyper-reduction of the element forces of the reduced beam (energy conserving sampling and weighting)
+       * \param tol relative tolerance of the reduced element forces of the snapshots
+       * \param h5Path plot file of the full simulation with the training snapshots (default: the file of enablePOD)
+       *
+       * only the sampled elements are evaluated during the reduced simulation
+       */
+      void enableHyperReduction(double tol = 1.e-2, const std::string &h5Path = "") {
+        ecswTol = tol;
+        if (not h5Path.empty())
+          snapshotFile = h5Path;
+      }
       /***************************************************/
 
       /**
@@ -193,12 +216,12 @@ namespace MBSimFlexibleBody {
       bool JInterp;
 
       /**
-       * \brief bool true: execute POD, false: without POD
+       * \brief bool true: reduced by the basis U (POD or Krylov), false: full model
        */
       bool PODreduced;
 
       /**
-       * \brief POM projection matrix
+       * \brief projection matrix (POM or Krylov basis)
        */
       fmatvec::Mat U;
 
@@ -217,6 +240,27 @@ namespace MBSimFlexibleBody {
        */
       fmatvec::Vec hFull;
 
+      /**
+       * \brief plot file of the full simulation with the snapshots
+       */
+      std::string snapshotFile;
+
+      /**
+       * \brief tolerance of the hyper-reduction (0: no hyper-reduction)
+       */
+      double ecswTol;
+
+      /**
+       * \brief number of Krylov vectors (0: no Krylov basis) and shift
+       */
+      int krylovSize;
+      double krylovShift;
+
+      /**
+       * \brief hyper-reduction of the translational elements (first) and the rotational elements
+       */
+      std::unique_ptr<HyperReduction> hyperReduction;
+
       FlexibleBody1s21Cosserat(); // standard constructor
       FlexibleBody1s21Cosserat(const FlexibleBody1s21Cosserat&); // copy constructor
       FlexibleBody1s21Cosserat& operator=(const FlexibleBody1s21Cosserat&); // assignment operator
@@ -242,19 +286,24 @@ namespace MBSimFlexibleBody {
       void GlobalVectorContributionRotation(int n, const fmatvec::Vec& locVec, fmatvec::Vec& gloVec) override;
 
       /*!
-       * \brief read position matrix of other simulation for POD-reduction
-       * \param h5File path to h5-file
-       * \param job    defines the matrix, that should be used for the reduction
+       * \brief copy the full coordinates qFull and uFull to the finite elements
+       */
+      void gatherElements();
+
+      /*!
+       * \brief select the sampled elements and their weights from the snapshots of the full simulation
+       */
+      void initHyperReduction();
+
+      /*!
+       * \brief compute the Krylov basis from the mass matrix and the tangent stiffness at the initial configuration
        */
-      fmatvec::Mat readPositionMatrix(const std::string & h5File, const std::string & job);
+      void initKrylov();
 
       /*!
-       * \brief find reduction order for POM
-       * \param POM        POM-Matrix (matrix of the different states)
-       * \param SVD        SVD-Matrix (single-valued decomposed matrix)
-       * \param precission value of how precise the reduction should be
+       * \brief assemble hFull from the element coordinates of gatherElements
        */
-      int findPOMSize(const fmatvec::Mat & POM, const fmatvec::Mat &SVD, double precission = 1 - 1.e-3);
+      void computehFull();
 
   }
   ;
@@ -27,6 +27,10 @@
 #include <mbsim/contours/sphere.h>
 #include <mbsim/frames/fixed_relative_frame.h>
 #include "mbsim/mbsim_event.h"
+#include "mbsimFlexibleBody/utils/text_data_file.h"
+#include "hdf5serie/file.h"
+#include "hdf5serie/simpledataset.h"
+#include <filesystem>
 
 #include "openmbvcppinterface/nurbsdisk.h"
 
@@ -123,19 +127,67 @@ namespace MBSimFlexibleBody {
     if (millimeterUnits)
       power = 1000;
 
-    /* read u0 */
-    ifstream u0Infile(inFilePath + "/u0.dat");
-    if (!u0Infile.is_open()) {
-      msg(Error) << "Can not open file " << inFilePath << "u0.dat" << endl;
-      throw 1;
+    // raw (unscaled) text data; a binary cache in the user cache directory is used if the text files are unchanged
+    vector<string> files = {"u0.dat", "mij.dat", "modeShapeMatrix.dat", "stiffnessMatrix.dat"};
+    vector<double> stamp;
+    for (auto &file : files) {
+      auto s = TextDataFile::getFileStamp(inFilePath + "/" + file);
+      if (s[0] < 0) {
+        msg(Error) << "Can not open file " << inFilePath << "/" << file << endl;
+        throw 1;
+      }
+      stamp.insert(stamp.end(), s.begin(), s.end());
     }
-    for (string s; getline(u0Infile, s);) {
-      fmatvec::Vec u0Line(3);
-      istringstream sin(s);
-      int i = 0;
-      for (double temp; sin >> temp; i++) {
-        u0Line(i) = temp;
+    string cacheFile = TextDataFile::getCacheFileName("femDataCache", inFilePath);
+    vector<vector<double>> u0Data, phiData, KData;
+    vector<double> mijData;
+    bool cached = false;
+    error_code ec;
+    if (not cacheFile.empty() and filesystem::exists(cacheFile, ec)) {
+      try {
+        H5::File file(cacheFile, H5::File::read);
+        if (file.openChildObject<H5::SimpleDataset<vector<double>>>("source file stamps")->read() == stamp) {
+          u0Data = file.openChildObject<H5::SimpleDataset<vector<vector<double>>>>("u0")->read();
+          mijData = file.openChildObject<H5::SimpleDataset<vector<double>>>("mij")->read();
+          phiData = file.openChildObject<H5::SimpleDataset<vector<vector<double>>>>("mode shape matrix")->read();
+          KData = file.openChildObject<H5::SimpleDataset<vector<vector<double>>>>("stiffness matrix entries")->read();
+          cached = true;
+          msg(Info) << "... from cache " << cacheFile << endl;
+        }
+      }
+      catch (...) {
+        msg(Warn) << "Can not read FEM data cache " << cacheFile << ", reading text files" << endl;
+      }
+    }
+    if (not cached) {
+      u0Data = TextDataFile(inFilePath + "/u0.dat").readTable();
+      mijData = TextDataFile(inFilePath + "/mij.dat").readVector();
+      phiData = TextDataFile(inFilePath + "/modeShapeMatrix.dat").readTable();
+      KData = TextDataFile(inFilePath + "/stiffnessMatrix.dat").readTable();
+      if (not cacheFile.empty()) {
+        try {
+          H5::File file(cacheFile, H5::File::write);
+          file.createChildObject<H5::SimpleDataset<vector<double>>>("source file stamps")(stamp.size())->write(stamp);
+          if (u0Data.size())
+            file.createChildObject<H5::SimpleDataset<vector<vector<double>>>>("u0")(u0Data.size(), u0Data[0].size())->write(u0Data);
+          if (mijData.size())
+            file.createChildObject<H5::SimpleDataset<vector<double>>>("mij")(mijData.size())->write(mijData);
+          if (phiData.size())
+            file.createChildObject<H5::SimpleDataset<vector<vector<double>>>>("mode shape matrix")(phiData.size(), phiData[0].size())->write(phiData);
+          if (KData.size())
+            file.createChildObject<H5::SimpleDataset<vector<vector<double>>>>("stiffness matrix entries")(KData.size(), KData[0].size())->write(KData);
+        }
+        catch (...) {
+          msg(Warn) << "Can not write FEM data cache " << cacheFile << endl;
+        }
       }
+    }
+
+    /* u0 */
+    for (auto &line : u0Data) {
+      fmatvec::Vec u0Line(3);
+      for (size_t i = 0; i < line.size() and i < 3; i++)
+        u0Line(i) = line[i];
       u0.emplace_back(u0Line / power);
     }
 
@@ -150,76 +202,35 @@ namespace MBSimFlexibleBody {
       }
     }
 
+    /* mij */
     mij.resize(nNodes, NONINIT);
-
-    /* read mij */
-    ifstream mijInfile(inFilePath + "/mij.dat");
-    if (!mijInfile.is_open()) {
-      msg(Error) << "Can not open file " << inFilePath << "mij.dat" << endl;
-      throw 1;
-    }
-
     double totalMass = 0;
-
-    int i = 0;
-    for (double a; mijInfile >> a; i++) {
-      mij(i) = a * power;
+    for (int i = 0; i < nNodes and i < (int)mijData.size(); i++) {
+      mij(i) = mijData[i] * power;
       totalMass += mij(i);
     }
 
     msg(Info) << "The total mass is " << totalMass << " [kg]" <<  endl;
 
-    
     if (output) {
       msg(Info) << "The lumped masses are: " << mij << endl;
     }
-    
+
     // get the number of mode shapes(nf) used to describe the deformation
-    ifstream phiInfile(inFilePath + "/modeShapeMatrix.dat");
-    if (!phiInfile.is_open()) {
-      msg(Error) << "Can not open file " << inFilePath << "modeShapeMatrix.dat" << endl;
-      throw 1;
-    }
-    string s1;
-    std::vector<double> phiLine;
-    getline(phiInfile, s1);
-    istringstream sin1(s1);
-    for (double temp; sin1 >> temp;)
-      phiLine.push_back(temp);
-    int nfFull = phiLine.size();
-    phiInfile.close();
-    
-    // read mode shape matrix
+    int nfFull = phiData.size() ? phiData[0].size() : 0;
+
+    // mode shape matrix
     phiFull.resize(3 * nNodes, nfFull, INIT, 0.0);
-    phiInfile.open((inFilePath + "/modeShapeMatrix.dat").c_str());
-    if (!phiInfile.is_open()) {
-      msg(Error) << "Can not open file " << inFilePath << "modeShapeMatrix.dat" << endl;
-      throw 1;
-    }
-    int row = 0;
-    for (string s; getline(phiInfile, s); row++) {
-      istringstream sin(s);  // TODO: use sin.clear() to avoid creating sin every time
-      int i = 0;
-      for (double temp; sin >> temp; i++)
-        phiFull(row, i) = temp;
+    for (size_t row = 0; row < phiData.size(); row++) {
+      for (size_t i = 0; i < phiData[row].size(); i++)
+        phiFull(row, i) = phiData[row][i];
     }
 
-    // read stiffness matrix
+    // stiffness matrix
     KFull.resize(3 * nNodes, INIT, 0.0);
-    ifstream KInfile(inFilePath + "/stiffnessMatrix.dat");
-    if (!KInfile.is_open()) {
-      msg(Error) << "Can not open file " << inFilePath << "stiffnessMatrix.dat" << endl;
-      throw 1;
-    }
-    for (string s; getline(KInfile, s);) {
-      std::vector<double> KLine;
-      istringstream sin(s);
-      for (string tempxx; getline(sin, tempxx, ',');) {
-        KLine.push_back(boost::lexical_cast<double>(boost::algorithm::trim_copy(tempxx)));  // atof()change char to double
-      }
+    for (auto &KLine : KData)
       KFull(3 * KLine[0] + KLine[1] - 4, 3 * KLine[2] + KLine[3] - 4) = KLine[4] * power;
-    }
-    
+
     if (msgAct(Debug)) {
 
       msg(Debug).precision(6);
@@ -0,0 +1,236 @@
+/* Copyright (C) 2004-2015 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h>
+#include "mbsimFlexibleBody/utils/model_reduction.h"
+#include <hdf5serie/file.h>
+#include <hdf5serie/vectorserie.h>
+#include <stdexcept>
+#include <algorithm>
+
+using namespace std;
+using namespace fmatvec;
+
+namespace MBSimFlexibleBody {
+
+  Mat readSnapshots(const string &h5File, const string &objectName, int start, int size) {
+    H5::File file(h5File, H5::File::read);
+    auto *data = file.openChildObject<H5::Group>("objects")->openChildObject<H5::Group>(objectName)->openChildObject<H5::VectorSerie<double>>("data");
+    if(start<0 or start+size>data->getColumns())
+      throw runtime_error("(readSnapshots): object " + objectName + " of " + h5File + " has only " + to_string(data->getColumns()) + " columns");
+    int tsize = data->getColumn(0).size();
+    Mat X(size, tsize, NONINIT);
+    for(int i=0; i<size; i++) {
+      vector<double> col = data->getColumn(start+i);
+      for(int j=0; j<tsize; j++)
+        X(i,j) = col[j];
+    }
+    return X;
+  }
+
+  Mat computePODBasis(const Mat &X, int size, double energy) {
+    int n = X.rows();
+    int m = X.cols();
+    Mat S(n, m, NONINIT);
+    SqrMat U(n, NONINIT);
+    SqrMat V(m, NONINIT);
+    if(svd(X, S, U, V, 1))
+      throw runtime_error("(computePODBasis): singular value decomposition failed");
+
+    int k = min(n, m);
+    if(size<=0) {
+      double sum = 0;
+      for(int i=0; i<k; i++)
+        sum += S(i,i);
+      double tmp = 0;
+      size = 0;
+      while(size<k and tmp<energy*sum) {
+        tmp += S(size,size);
+        size++;
+      }
+    }
+    else if(size>k)
+      throw runtime_error("(computePODBasis): " + to_string(size) + " modes requested but only " + to_string(k) + " available");
+
+    return U(RangeV(0, n - 1), RangeV(0, size - 1));
+  }
+
+  Mat computeKrylovBasis(const SymMat &M, const SqrMat &K, const Mat &F, int size, double sigma, const Vec &x0) {
+    int n = K.size();
+    if(size>n)
+      throw runtime_error("(computeKrylovBasis): " + to_string(size) + " vectors requested but the dimension is " + to_string(n));
+    SqrMat A(n, NONINIT);
+    for(int i=0; i<n; i++) {
+      for(int j=0; j<n; j++)
+        A(i,j) = K(i,j) - sigma*M(i,j);
+    }
+    VecInt ipiv(n, NONINIT);
+    SqrMat LU = facLU(A, ipiv);
+
+    Mat V(n, size, NONINIT);
+    int k = 0;
+    // append x orthonormalised if it is not in the span of the previous vectors
+    auto append = [&V, &k, n](Vec x) {
+      double nrmx = nrm2(x);
+      if(nrmx<=0)
+        return;
+      for(int pass=0; pass<2; pass++) {
+        for(int j=0; j<k; j++) {
+          Vec v = V.col(j);
+          x -= (v.T()*x)*v;
+        }
+      }
+      double nrm = nrm2(x);
+      if(nrm<=1e-10*nrmx)
+        return;
+      for(int i=0; i<n; i++)
+        V(i,k) = x(i)/nrm;
+      k++;
+    };
+    if(x0.size())
+      append(x0);
+    // block Krylov iteration; the next block is computed from the orthonormalised vectors of the last block
+    Mat B = slvLUFac(LU, F, ipiv);
+    while(k<size) {
+      int k0 = k;
+      for(int c=0; c<B.cols() and k<size; c++)
+        append(B.col(c));
+      if(k==k0)
+        break;
+      B <<= slvLUFac(LU, M * V(RangeV(0, n - 1), RangeV(k0, k - 1)), ipiv);
+    }
+    if(k<size)
+      throw runtime_error("(computeKrylovBasis): " + to_string(size) + " vectors requested but the Krylov space has only dimension " + to_string(k));
+    return V;
+  }
+
+  bool computeECSWWeights(const Mat &G, double tol, vector<int> &elements, vector<double> &weights, int maxIter) {
+    int m = G.rows();
+    int n = G.cols();
+    Vec b = G * Vec(n, INIT, 1.);
+    double nrmb = nrm2(b);
+    Vec x(n, INIT, 0.);
+    Vec r = b;
+    vector<int> P;
+    vector<bool> passive(n, false);
+    // elements removed from the passive set in the last iteration; selecting them again could cycle
+    vector<bool> removed(n, false);
+    if(maxIter<=0)
+      maxIter = 3*n;
+
+    int iter = 0;
+    bool converged = nrm2(r)<=tol*nrmb;
+    while(not converged and (int)P.size()<n and iter<maxIter) {
+      iter++;
+      // add the element with the largest gradient to the passive set
+      Vec w = G.T() * r;
+      int jmax = -1;
+      for(int j=0; j<n; j++) {
+        if(not passive[j] and not removed[j] and (jmax==-1 or w(j)>w(jmax)))
+          jmax = j;
+      }
+      if(jmax==-1 or w(jmax)<=0)
+        break;
+      fill(removed.begin(), removed.end(), false);
+      P.push_back(jmax);
+      passive[jmax] = true;
+
+      while(true) {
+        Mat GP(m, P.size(), NONINIT);
+        for(size_t k=0; k<P.size(); k++) {
+          for(int i=0; i<m; i++)
+            GP(i,k) = G(i,P[k]);
+        }
+        Vec z = slvLS(GP, b);
+        double alpha = 1;
+        bool feasible = true;
+        for(size_t k=0; k<P.size(); k++) {
+          if(z(k)<=0) {
+            alpha = min(alpha, x(P[k])/(x(P[k])-z(k)));
+            feasible = false;
+          }
+        }
+        if(feasible) {
+          for(size_t k=0; k<P.size(); k++)
+            x(P[k]) = z(k);
+          break;
+        }
+        for(size_t k=0; k<P.size(); k++)
+          x(P[k]) += alpha*(z(k)-x(P[k]));
+        // remove elements with vanishing weight from the passive set
+        for(size_t k=0; k<P.size();) {
+          if(x(P[k])<=1e-14) {
+            x(P[k]) = 0;
+            passive[P[k]] = false;
+            removed[P[k]] = true;
+            P.erase(P.begin()+k);
+          }
+          else
+            k++;
+        }
+        if(P.empty())
+          break;
+      }
+      r = b - G * x;
+      converged = nrm2(r)<=tol*nrmb;
+    }
+
+    elements.clear();
+    weights.clear();
+    for(int j=0; j<n; j++) {
+      if(x(j)>0) {
+        elements.push_back(j);
+        weights.push_back(x(j));
+      }
+    }
+    return converged;
+  }
+
+  bool HyperReduction::train(const Mat &Q, const Mat &V, double tol) {
+    int nE = UE.size();
+    int r = UE.empty() ? 0 : UE[0].cols();
+    int nS = Q.cols();
+    // column e holds the reduced forces of element e for all snapshots
+    Mat G(nS * r, nE, NONINIT);
+    for(int s = 0; s < nS; s++) {
+      Vec q = Q.col(s);
+      Vec u = V.col(s);
+      for(int e = 0; e < nE; e++) {
+        Vec qE = UE[e] * q;
+        Vec uE = UE[e] * u;
+        Vec g = UE[e].T() * h(e, qE, uE);
+        for(int l = 0; l < r; l++)
+          G(s * r + l, e) = g(l);
+      }
+    }
+    return computeECSWWeights(G, tol, elements, weights);
+  }
+
+  Vec HyperReduction::computeh(const Vec &q, const Vec &u) const {
+    Vec hr(q.size(), INIT, 0.);
+    for(size_t i = 0; i < elements.size(); i++) {
+      int e = elements[i];
+      Vec qE = UE[e] * q;
+      Vec uE = UE[e] * u;
+      hr += weights[i] * (UE[e].T() * h(e, qE, uE));
+    }
+    return hr;
+  }
+
+}
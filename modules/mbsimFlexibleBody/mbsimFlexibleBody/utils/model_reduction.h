@@ -0,0 +1,133 @@
+/* Copyright (C) 2004-2015 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _MBSIMFLEXIBLEBODY_MODEL_REDUCTION_H_
+#define _MBSIMFLEXIBLEBODY_MODEL_REDUCTION_H_
+
+#include <fmatvec/fmatvec.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace MBSimFlexibleBody {
+
+  /**
+   * \brief read the snapshots of an object from the plot file of a full simulation
+   * \param h5File plot file (*.mbsh5) of the full simulation
+   * \param objectName name of the object in the group "objects"
+   * \param start first column of the plot data series
+   * \param size number of columns
+   * \return snapshot matrix with one column per time step
+   */
+  fmatvec::Mat readSnapshots(const std::string &h5File, const std::string &objectName, int start, int size);
+
+  /**
+   * \brief proper orthogonal decomposition of a snapshot matrix
+   * \param X snapshot matrix with one column per time step
+   * \param size number of modes; if size<=0 the number of modes is chosen by energy
+   * \param energy fraction of the sum of the singular values captured by the basis
+   * \return orthonormal basis with one column per mode
+   */
+  fmatvec::Mat computePODBasis(const fmatvec::Mat &X, int size=0, double energy=1-1.e-3);
+
+  /**
+   * \brief Krylov basis of the linearised structure
+   *
+   * Spans x0 (if given, e.g. the reference configuration of absolute coordinates), the static response
+   * A^{-1} F with A=K-sigma M and the following block Krylov vectors (A^{-1} M)^k A^{-1} F. The vectors are
+   * orthonormalised by Gram-Schmidt with re-orthogonalisation, linearly dependent vectors are dropped. A
+   * structure with rigid body modes needs a shift sigma<0 below the lowest elastic eigenvalue.
+   * \param M mass matrix
+   * \param K tangent stiffness matrix
+   * \param F load vectors with one column per load
+   * \param size number of basis vectors
+   * \param sigma shift
+   * \param x0 first basis vector
+   * \return orthonormal basis with one column per vector
+   */
+  fmatvec::Mat computeKrylovBasis(const fmatvec::SymMat &M, const fmatvec::SqrMat &K, const fmatvec::Mat &F, int size, double sigma=0, const fmatvec::Vec &x0=fmatvec::Vec());
+
+  /**
+   * \brief energy conserving sampling and weighting (ECSW) of the finite elements
+   *
+   * Solves the non-negative least squares problem min ||G w - b|| with w>=0 by the active set method
+   * of Lawson and Hanson, which is stopped as soon as ||G w - b|| <= tol ||b||. Column e of G holds the
+   * reduced force contributions of element e for all training snapshots and b=G*1. Elements removed
+   * from the passive set are not selected again in the next iteration, and the number of iterations is
+   * limited; if the limit is reached the weights of the last iteration are returned.
+   * \param G training matrix
+   * \param tol relative tolerance of the residual
+   * \param elements indices of the sampled elements (nonzero weight)
+   * \param weights weights of the sampled elements
+   * \param maxIter maximum number of iterations (0: three times the number of elements)
+   * \return false if the maximum number of iterations is reached before the tolerance
+   */
+  bool computeECSWWeights(const fmatvec::Mat &G, double tol, std::vector<int> &elements, std::vector<double> &weights, int maxIter=0);
+
+  /**
+   * \brief hyper-reduction of the element forces of a reduced finite element body
+   *
+   * The reduced force U^T h(U q, U u) is approximated by the weighted sum over a sample of the elements
+   * sum_e w_e U_e^T h_e(U_e q, U_e u), where U_e are the rows of the basis U belonging to the coordinates
+   * of element e. The sample and the weights are trained by ECSW with reduced snapshots; the basis may
+   * be of any kind (POD, Krylov, ...).
+   */
+  class HyperReduction {
+    public:
+      /**
+       * \brief force of element e for the element coordinates qE and uE
+       *
+       * qE and uE may be modified, e.g. to resolve a periodic coordinate
+       */
+      using ElementForce = std::function<fmatvec::Vec(int e, fmatvec::Vec &qE, fmatvec::Vec &uE)>;
+
+      /**
+       * \param UE_ rows of the basis belonging to each element
+       * \param h_ element force
+       */
+      HyperReduction(std::vector<fmatvec::Mat> UE_, ElementForce h_) : UE(std::move(UE_)), h(std::move(h_)) { }
+
+      /**
+       * \brief select the elements and their weights
+       * \param Q reduced position snapshots with one column per time step
+       * \param V reduced velocity snapshots with one column per time step
+       * \param tol relative tolerance of the reduced element forces of the snapshots
+       * \return false if the ECSW iteration did not reach the tolerance
+       */
+      bool train(const fmatvec::Mat &Q, const fmatvec::Mat &V, double tol);
+
+      /**
+       * \brief hyper-reduced force for the reduced coordinates q and u
+       */
+      fmatvec::Vec computeh(const fmatvec::Vec &q, const fmatvec::Vec &u) const;
+
+      int getNumberOfElements() const { return UE.size(); }
+      const std::vector<int>& getElements() const { return elements; }
+      const std::vector<double>& getWeights() const { return weights; }
+
+    private:
+      std::vector<fmatvec::Mat> UE;
+      ElementForce h;
+      std::vector<int> elements;
+      std::vector<double> weights;
+  };
+
+}
+
+#endif /* _MBSIMFLEXIBLEBODY_MODEL_REDUCTION_H_ */
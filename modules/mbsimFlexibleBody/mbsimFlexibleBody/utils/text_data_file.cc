@@ -0,0 +1,190 @@
+/* Copyright (C) 2004-2015 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#include <config.h>
+#include "mbsimFlexibleBody/utils/text_data_file.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace MBSimFlexibleBody {
+
+  TextDataFile::TextDataFile(const string &fileName_) : fileName(fileName_) {
+#ifdef _WIN32
+    HANDLE fh = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(fh==INVALID_HANDLE_VALUE)
+      throw runtime_error("(TextDataFile::TextDataFile): can not open file " + fileName);
+    fileHandle = fh;
+    LARGE_INTEGER s;
+    GetFileSizeEx(fh, &s);
+    size = s.QuadPart;
+    if(size) {
+      mapHandle = CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if(mapHandle)
+        data = static_cast<const char*>(MapViewOfFile(mapHandle, FILE_MAP_READ, 0, 0, 0));
+      if(not data)
+        throw runtime_error("(TextDataFile::TextDataFile): can not map file " + fileName);
+    }
+#else
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if(fd==-1)
+      throw runtime_error("(TextDataFile::TextDataFile): can not open file " + fileName);
+    struct stat st;
+    fstat(fd, &st);
+    size = st.st_size;
+    if(size) {
+      void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if(p==MAP_FAILED) {
+        close(fd);
+        throw runtime_error("(TextDataFile::TextDataFile): can not map file " + fileName);
+      }
+      madvise(p, size, MADV_SEQUENTIAL);
+      data = static_cast<const char*>(p);
+    }
+    close(fd);
+#endif
+  }
+
+  TextDataFile::~TextDataFile() {
+#ifdef _WIN32
+    if(data) UnmapViewOfFile(data);
+    if(mapHandle) CloseHandle(mapHandle);
+    if(fileHandle) CloseHandle(fileHandle);
+#else
+    if(data) munmap(const_cast<char*>(data), size);
+#endif
+  }
+
+  bool TextDataFile::nextNumber(const char *&p, const char *e, double &x) {
+    while(p<e and (*p==' ' or *p=='\t' or *p=='\r' or *p=='\n' or *p==',' or *p==';' or (*p=='+' and p+1<e and *(p+1)!=' ')))
+      p++;
+    if(p==e)
+      return false;
+    auto res = from_chars(p, e, x);
+    if(res.ec!=errc())
+      throw runtime_error(string("(TextDataFile::nextNumber): invalid number near \"") + string(p, min<size_t>(e-p, 20)) + "\"");
+    p = res.ptr;
+    return true;
+  }
+
+  vector<vector<double>> TextDataFile::readTable() const {
+    vector<const char*> lines;
+    for(const char *p=begin(); p<end();) {
+      lines.push_back(p);
+      const char *n = static_cast<const char*>(memchr(p, '\n', end()-p));
+      p = n ? n+1 : end();
+    }
+    lines.push_back(end());
+    vector<vector<double>> table(lines.size()-1);
+    string error;
+#pragma omp parallel for schedule(static)
+    for(size_t i=0; i<table.size(); i++) {
+      try {
+        const char *p = lines[i];
+        for(double x; nextNumber(p, lines[i+1], x);)
+          table[i].push_back(x);
+      }
+      catch(const exception &ex) {
+#pragma omp critical
+        error = fileName + ":" + to_string(i+1) + ": " + ex.what();
+      }
+    }
+    if(not error.empty())
+      throw runtime_error(error);
+    // remove empty lines; all other lines must have the same number of columns
+    auto first = find_if(table.begin(), table.end(), [](const vector<double> &l) { return not l.empty(); });
+    size_t cols = first!=table.end() ? first->size() : 0;
+    size_t j = 0;
+    for(size_t i=0; i<table.size(); i++) {
+      if(not table[i].empty()) {
+        if(table[i].size()!=cols)
+          throw runtime_error(fileName + ":" + to_string(i+1) + ": " + to_string(table[i].size()) + " columns, but the table has " + to_string(cols) + " columns");
+        if(i!=j) table[j] = move(table[i]);
+        j++;
+      }
+    }
+    table.resize(j);
+    return table;
+  }
+
+  vector<double> TextDataFile::readVector() const {
+    vector<double> v;
+    const char *p = begin();
+    for(double x; nextNumber(p, end(), x);)
+      v.push_back(x);
+    return v;
+  }
+
+  vector<double> TextDataFile::getFileStamp(const string &fileName) {
+    error_code ec;
+    auto fileSize = filesystem::file_size(fileName, ec);
+    if(ec)
+      return {-1};
+    // the modification time has a resolution of one second on some file systems; hence, the content is hashed too
+    auto t = filesystem::last_write_time(fileName, ec).time_since_epoch();
+    auto sec = chrono::duration_cast<chrono::seconds>(t);
+    // 64 bit FNV-1a, stored as two 32 bit halves which are exact in a double
+    uint64_t h = 14695981039346656037ull;
+    TextDataFile file(fileName);
+    for(const char *p=file.begin(); p<file.end(); p++) {
+      h ^= static_cast<unsigned char>(*p);
+      h *= 1099511628211ull;
+    }
+    return {double(fileSize), double(sec.count()), double((t-sec).count()), double(h>>32), double(h&0xffffffff)};
+  }
+
+  string TextDataFile::getCacheFileName(const string &name, const string &source) {
+    // user cache directory; the directory of the source data may be read-only or shared with other users
+#ifdef _WIN32
+    const char *base = getenv("LOCALAPPDATA");
+    filesystem::path dir = base ? filesystem::path(base)/"mbsim-env"/"cache" : filesystem::path();
+#else
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+    filesystem::path dir = xdg and *xdg ? filesystem::path(xdg)/"mbsim-env" : home ? filesystem::path(home)/".cache"/"mbsim-env" : filesystem::path();
+#endif
+    if(dir.empty())
+      return {};
+    error_code ec;
+    filesystem::create_directories(dir, ec);
+    if(ec)
+      return {};
+    stringstream str;
+    str<<name<<"-"<<hex<<hash<string>()(filesystem::absolute(source, ec).lexically_normal().string())<<".h5";
+    return (dir/str.str()).string();
+  }
+
+}
@@ -0,0 +1,83 @@
+/* Copyright (C) 2004-2015 MBSim Development Team
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ *
+ * Contact: martin.o.foerg@googlemail.com
+ */
+
+#ifndef _TEXT_DATA_FILE_H_
+#define _TEXT_DATA_FILE_H_
+
+#include <string>
+#include <vector>
+
+namespace MBSimFlexibleBody {
+
+  /**
+   * \brief read-only memory mapped text file with numerical data (e.g. exported FE data)
+   *
+   * Numbers are separated by white space, commas or semicolons. The numbers are
+   * converted with std::from_chars directly from the mapped memory; tables are
+   * parsed in parallel chunks of lines (OpenMP). All non-empty lines of a table
+   * must have the same number of columns.
+   */
+  class TextDataFile {
+    public:
+      TextDataFile(const std::string &fileName_);
+      ~TextDataFile();
+      TextDataFile(const TextDataFile &) = delete;
+      TextDataFile& operator=(const TextDataFile &) = delete;
+
+      const char* begin() const { return data; }
+      const char* end() const { return data+size; }
+
+      /*! \return all numbers of the file line by line (empty lines are skipped) */
+      std::vector<std::vector<double>> readTable() const;
+      /*! \return all numbers of the file as one vector */
+      std::vector<double> readVector() const;
+
+      /**
+       * \brief parse the next number of [p,e) and advance p
+       * \return false if no further number is available
+       */
+      static bool nextNumber(const char *&p, const char *e, double &x);
+
+      /**
+       * \brief stamp of a file, used to validate data caches
+       * \return size, modification time (seconds and fraction) and content hash of the file; {-1} if it does not exist
+       */
+      static std::vector<double> getFileStamp(const std::string &fileName);
+
+      /**
+       * \brief file name of a binary data cache in the user cache directory
+       * \param name prefix of the file name
+       * \param source file or directory of the cached data (part of the file name)
+       * \return empty if no user cache directory is available
+       */
+      static std::string getCacheFileName(const std::string &name, const std::string &source);
+
+    private:
+      std::string fileName;
+      const char *data{nullptr};
+      size_t size{0};
+#ifdef _WIN32
+      void *fileHandle{nullptr};
+      void *mapHandle{nullptr};
+#endif
+  };
+
+}
+
+#endif
@@ -27,6 +27,8 @@
 #include "interface_messages.h"
 #include "mbsim_server.h"
 #include <fstream>
+#include <cstring>
+#include <cstdint>
 #include "mbsimControl/signal_.h"
 #include "mbsimControl/extern_signal_source.h"
 
@@ -75,8 +77,12 @@ namespace MBSimInterface {
     ee=e->getFirstElementChild();
     if (E(ee)->getTagName()==MBSIMINTERFACE%"MBSimTcpServer")
       setMBSimServer(new MBSimTcpServer(this));
+    else if (E(ee)->getTagName()==MBSIMINTERFACE%"MBSimAsyncTcpServer")
+      setMBSimServer(new MBSimAsyncTcpServer(this));
     else if (E(ee)->getTagName()==MBSIMINTERFACE%"MBSimUdpServer")
       setMBSimServer(new MBSimUdpServer(this));
+    else if (E(ee)->getTagName()==MBSIMINTERFACE%"MBSimShmServer")
+      setMBSimServer(new MBSimShmServer(this));
     mbsimServer->initializeUsingXML(ee);
   }
 
@@ -278,7 +284,11 @@ namespace MBSimInterface {
         dumpMemory(mbsim2interface, &system->getTime(), sizeof(double));
         break;
       case _SI_getTime_memoryAdress_SI_:
-        //TODO
+        {
+          double *p=getSharedBlock(0);
+          *p=system->getTime();
+          dumpOffset(mbsim2interface, p);
+        }
         break;
         // setTime
       case _SI_setTime_asciiString_SI_:
@@ -291,8 +301,9 @@ namespace MBSimInterface {
         break;
       case _SI_setTime_memoryDump_SI_:
         {
-          const double *d=(double*)(interface2mbsim);
-          setTime(*d);
+          double d;
+          memcpy(&d, interface2mbsim, sizeof(double));
+          setTime(d);
         }
         break;
 
@@ -320,7 +331,13 @@ namespace MBSimInterface {
         }
         break;
       case _SI_getStateVector_memoryAdress_SI_:
-        //TODO
+        {
+          double* p=nullptr;
+          getz(&p);
+          double *d=getSharedBlock(1);
+          memcpy(d, p, zSize*sizeof(double));
+          dumpOffset(mbsim2interface, d);
+        }
         break;
         // setStateVector
       case _SI_setStateVector_asciiString_SI_:
@@ -344,6 +361,15 @@ namespace MBSimInterface {
           }
         }
         break;
+      case _SI_setStateVector_memoryDump_SI_:
+        {
+          if (interface2mbsimLength!=zSize*sizeof(double))
+            throwError("wrong size of given vector z!");
+          double* p=nullptr;
+          getz(&p);
+          memcpy(p, interface2mbsim, zSize*sizeof(double));
+        }
+        break;
         // getTimeDerivativeOfStateVector
       case _SI_getTimeDerivativeOfStateVector_asciiString_SI_:
         {
@@ -360,7 +386,13 @@ namespace MBSimInterface {
         }
         break;
       case _SI_getTimeDerivativeOfStateVector_memoryAdress_SI_:
-        // TODO
+        {
+          double* p=nullptr;
+          getzdot(&p);
+          double *d=getSharedBlock(2);
+          memcpy(d, p, zSize*sizeof(double));
+          dumpOffset(mbsim2interface, d);
+        }
         break;
 
         // getStopVectorSize
@@ -386,18 +418,26 @@ namespace MBSimInterface {
         }
         break;
       case _SI_getStopVector_memoryAdress_SI_:
-        //TODO
+        {
+          double *p=nullptr;
+          getsv(&p);
+          double *d=getSharedBlock(3);
+          memcpy(d, p, svSize*sizeof(double));
+          dumpOffset(mbsim2interface, d);
+        }
         break;
 
         // different mbsim actions
       case _SI_plot_SI_:
         system->resetUpToDate();
         system->plot();
+        stepCount++;
         break;
       case _SI_shift_SI_:
         system->resetUpToDate();
         system->plot();
         system->shift();
+        stepCount++;
         break;
       case _SI_exitRequest_SI_:
         exitRequest=true;
@@ -408,21 +448,20 @@ namespace MBSimInterface {
         int2str(mbsim2interface, &outputSignalSize(0), outputSignalSize.size());
         break;
       case _SI_getOutputSignals_asciiString_SI_:
-        {
-          int index0=0, index1=0;
-          for (unsigned int i=0; i<outputSignal.size(); i++) {
-            index1=index0+outputSignalSize(i);
-            outputVector.set(RangeV(index0, index1), outputSignal[i]->getSignal());
-            index0=index1+1;
-          }
-          double2str(mbsim2interface, &outputVector(0), outputVector.size());
-        }
+        updateOutputVector();
+        double2str(mbsim2interface, &outputVector(0), outputVector.size());
         break;
       case _SI_getOutputSignals_memoryDump_SI_:
-        //TODO
+        updateOutputVector();
+        dumpMemory(mbsim2interface, &outputVector(0), outputVector.size()*sizeof(double));
         break;
       case _SI_getOutputSignals_memoryAdress_SI_:
-        //TODO
+        {
+          updateOutputVector();
+          double *d=getSharedBlock(4);
+          memcpy(d, &outputVector(0), outputVector.size()*sizeof(double));
+          dumpOffset(mbsim2interface, d);
+        }
         break;
       case _SI_getInputSignalsSize_asciiString_SI_:
         int2str(mbsim2interface, &inputSignalSize(0), inputSignalSize.size());
@@ -440,17 +479,18 @@ namespace MBSimInterface {
             throwError("wrong size of given vector z!");
           }
           inputVector=z_;
-          int index0=0, index1=0;
-          for (unsigned int i=0; i<inputSignal.size(); i++) {
-            index1=index0+inputSignalSize(i);
-            inputSignal[i]->setSignal(inputVector(RangeV(index0, index1)));
-            index0=index1+1;
-          }
+          updateInputSignals();
         }
         break;
       case _SI_setInputSignals_memoryDump_SI_:
+        if (interface2mbsimLength!=inputVector.size()*sizeof(double))
+          throwError("wrong size of given input vector!");
+        memcpy(&inputVector(0), interface2mbsim, inputVector.size()*sizeof(double));
+        updateInputSignals();
         break;
       case _SI_setInputSignals_memoryAdress_SI_:
+        memcpy(&inputVector(0), getSharedBlock(5), inputVector.size()*sizeof(double));
+        updateInputSignals();
         break;
 
         // usefull stuff
@@ -471,6 +511,9 @@ namespace MBSimInterface {
           (*mbsim2interface).precision(i);
         }
         break;
+      case _SI_batch_SI_:
+        batchCommunication(interface2mbsim, interface2mbsimLength, mbsim2interface);
+        break;
       default:
         msg(Info) << "Unknown IPC message!!!" << endl;
     }
@@ -487,16 +530,159 @@ namespace MBSimInterface {
   }
 
 
-  void InterfaceIntegrator::dumpMemory(ostringstream *out, void *p, unsigned int N) {
-    auto *c=(char*)p;
+  void InterfaceIntegrator::batchCommunication(const char* interface2mbsim, unsigned int interface2mbsimLength, std::ostringstream* mbsim2interface) {
+    ostringstream answer;
+    answer.precision(mbsim2interface->precision());
+    answer.flags(mbsim2interface->flags());
+    const char *p=interface2mbsim, *e=interface2mbsim+interface2mbsimLength;
+    while (p<e) {
+      uint32_t n;
+      if (e-p<5)
+        throwError("incomplete batch message!");
+      memcpy(&n, p+1, sizeof(uint32_t));
+      if (uint32_t(e-p-5)<n)
+        throwError("incomplete batch message!");
+      const string request(p+5, n); // terminated by '\0' for the asciiString requests
+      answer.str(string());
+      integratorCommunication(p, request.c_str(), n, &answer);
+      const string a=answer.str();
+      uint32_t m=a.length();
+      dumpMemory(mbsim2interface, &m, sizeof(uint32_t));
+      (*mbsim2interface) << a;
+      p+=5+n;
+    }
+  }
+
+  size_t InterfaceIntegrator::getSharedDataSize() const {
+    return (1+2*zSize+svSize+outputVector.size()+inputVector.size())*sizeof(double);
+  }
+
+  double* InterfaceIntegrator::getSharedBlock(int i) {
+    if (not sharedData)
+      throwError("memoryAdress requests are only available with a shared memory server!");
+    const int size[]={1, zSize, zSize, svSize, outputVector.size(), inputVector.size()};
+    auto *p=reinterpret_cast<double*>(sharedData);
+    for (int j=0; j<i; j++)
+      p+=size[j];
+    return p;
+  }
+
+  void InterfaceIntegrator::dumpOffset(ostringstream *out, const double *p) {
+    int offset=reinterpret_cast<const char*>(p)-sharedData;
+    dumpMemory(out, &offset, sizeof(int));
+  }
+
+  void InterfaceIntegrator::updateOutputVector() {
+    int index0=0;
+    for (unsigned int i=0; i<outputSignal.size(); i++) {
+      outputVector.set(RangeV(index0, index0+outputSignalSize(i)-1), outputSignal[i]->getSignal());
+      index0+=outputSignalSize(i);
+    }
+  }
+
+  void InterfaceIntegrator::updateInputSignals() {
+    int index0=0;
+    for (unsigned int i=0; i<inputSignal.size(); i++) {
+      inputSignal[i]->setSignal(inputVector(RangeV(index0, index0+inputSignalSize(i)-1)));
+      index0+=inputSignalSize(i);
+    }
+  }
+
+  void InterfaceIntegrator::getSnapshot(Snapshot &s) {
+    s.t=system->getTime();
+    const double *z=system->getState()();
+    s.z.assign(z, z+zSize);
+    updateOutputVector();
+    s.y.resize(outputVector.size());
+    for (int i=0; i<outputVector.size(); i++)
+      s.y[i]=outputVector(i);
+  }
+
+  bool InterfaceIntegrator::isReadOnlyRequest(char requestIdentifier) {
+    switch (requestIdentifier) {
+      case _SI_getSizeOfDoubleMemory_asciiString_SI_:
+      case _SI_getSizeOfFloatMemory_asciiString_SI_:
+      case _SI_getSizeOfIntegerMemory_asciiString_SI_:
+      case _SI_getSizeOfMemoryAdress_asciiString_SI_:
+      case _SI_getTime_asciiString_SI_:
+      case _SI_getTime_memoryDump_SI_:
+      case _SI_getStateVectorSize_asciiString_SI_:
+      case _SI_getStateVectorSize_memoryDump_SI_:
+      case _SI_getStateVector_asciiString_SI_:
+      case _SI_getStateVector_memoryDump_SI_:
+      case _SI_getOutputSignalsSize_asciiString_SI_:
+      case _SI_getOutputSignals_asciiString_SI_:
+      case _SI_getOutputSignals_memoryDump_SI_:
+      case _SI_getInputSignalsSize_asciiString_SI_:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  void InterfaceIntegrator::snapshotCommunication(const Snapshot &s, char requestIdentifier, std::ostringstream* mbsim2interface) {
+    // the sizes are constant during the integration, everything else is taken from s
+    switch (requestIdentifier) {
+      case _SI_getSizeOfDoubleMemory_asciiString_SI_:
+        (*mbsim2interface) << sizeof(double);
+        break;
+      case _SI_getSizeOfFloatMemory_asciiString_SI_:
+        (*mbsim2interface) << sizeof(float);
+        break;
+      case _SI_getSizeOfIntegerMemory_asciiString_SI_:
+        (*mbsim2interface) << sizeof(int);
+        break;
+      case _SI_getSizeOfMemoryAdress_asciiString_SI_:
+        (*mbsim2interface) << sizeof(char*);
+        break;
+      case _SI_getTime_asciiString_SI_:
+        double2str(mbsim2interface, &s.t, 1);
+        break;
+      case _SI_getTime_memoryDump_SI_:
+        dumpMemory(mbsim2interface, &s.t, sizeof(double));
+        break;
+      case _SI_getStateVectorSize_asciiString_SI_:
+        (*mbsim2interface) << zSize;
+        break;
+      case _SI_getStateVectorSize_memoryDump_SI_:
+        dumpMemory(mbsim2interface, &zSize, sizeof(int));
+        break;
+      case _SI_getStateVector_asciiString_SI_:
+        if (not s.z.empty())
+          double2str(mbsim2interface, s.z.data(), s.z.size());
+        break;
+      case _SI_getStateVector_memoryDump_SI_:
+        dumpMemory(mbsim2interface, s.z.data(), s.z.size()*sizeof(double));
+        break;
+      case _SI_getOutputSignalsSize_asciiString_SI_:
+        int2str(mbsim2interface, &outputSignalSize(0), outputSignalSize.size());
+        break;
+      case _SI_getOutputSignals_asciiString_SI_:
+        if (not s.y.empty())
+          double2str(mbsim2interface, s.y.data(), s.y.size());
+        break;
+      case _SI_getOutputSignals_memoryDump_SI_:
+        dumpMemory(mbsim2interface, s.y.data(), s.y.size()*sizeof(double));
+        break;
+      case _SI_getInputSignalsSize_asciiString_SI_:
+        int2str(mbsim2interface, &inputSignalSize(0), inputSignalSize.size());
+        break;
+      default:
+        break;
+    }
+    (*mbsim2interface) << ends;
+  }
+
+  void InterfaceIntegrator::dumpMemory(ostringstream *out, const void *p, unsigned int N) {
+    auto *c=(const char*)p;
     for (unsigned int i=0; i<N; i++) {
       (*out) << *c;
       c++;
     }
   }
 
-  void InterfaceIntegrator::double2str(std::ostringstream *out, double *p, unsigned int N) {
-    double *d=p;
+  void InterfaceIntegrator::double2str(std::ostringstream *out, const double *p, unsigned int N) {
+    const double *d=p;
     (*out) << "[";
     for (unsigned int i=0; i<(N-1); i++) {
       (*out) << *d << ";";
@@ -505,8 +691,8 @@ namespace MBSimInterface {
     (*out) << *d << "]";
   }
 
-  void InterfaceIntegrator::int2str(std::ostringstream *out, int *p, unsigned int N) {
-    int *d=p;
+  void InterfaceIntegrator::int2str(std::ostringstream *out, const int *p, unsigned int N) {
+    const int *d=p;
     (*out) << "[";
     for (unsigned int i=0; i<(N-1); i++) {
       (*out) << *d << ";";
@@ -54,6 +54,26 @@ namespace MBSimInterface {
 
       void integratorCommunication(const char* requestIdentifier, const char* interface2mbsim, unsigned int interface2mbsimLength, std::ostringstream* mbsim2interface);
       bool getExitRequest() {return exitRequest; }
+      /*! number of plot/shift requests, i.e. of the accepted steps of the external integrator */
+      unsigned long getStepCount() const {return stepCount; }
+
+      /*! size in bytes of the data block used by the memoryAdress requests:
+        time, state, its time derivative, stop vector, output and input signals */
+      size_t getSharedDataSize() const;
+      /*! set the data block (e.g. in shared memory) used by the memoryAdress requests */
+      void setSharedData(char *p) { sharedData=p; }
+
+      /** \brief copy of the data served to read-only clients */
+      struct Snapshot {
+        double t;
+        std::vector<double> z, y;
+      };
+      /*! copy time, state and output signals to s */
+      void getSnapshot(Snapshot &s);
+      /*! \return true if the request only reads time, state or output signals (or their sizes) */
+      static bool isReadOnlyRequest(char requestIdentifier);
+      /*! answer a read-only request using s; does not touch the system and may be called from any thread */
+      void snapshotCommunication(const Snapshot &s, char requestIdentifier, std::ostringstream* mbsim2interface);
 
     private:
       // get values
@@ -70,11 +90,19 @@ namespace MBSimInterface {
 
       bool printCommunication{true};
 
-      void dumpMemory(std::ostringstream *out, void *p, unsigned int N);
-      void double2str(std::ostringstream *out, double *p, unsigned int N);
-      void int2str(std::ostringstream *out, int *p, unsigned int N);
+      void dumpMemory(std::ostringstream *out, const void *p, unsigned int N);
+      void double2str(std::ostringstream *out, const double *p, unsigned int N);
+      void int2str(std::ostringstream *out, const int *p, unsigned int N);
+      double* getSharedBlock(int i);
+      void dumpOffset(std::ostringstream *out, const double *p);
+      void updateOutputVector();
+      void updateInputSignals();
+      void batchCommunication(const char* interface2mbsim, unsigned int interface2mbsimLength, std::ostringstream* mbsim2interface);
+
+      char *sharedData{nullptr};
 
       bool exitRequest{false};
+      unsigned long stepCount{0};
 
       MBSimServer* mbsimServer;
       std::vector<std::string> outputSignalRef, inputSignalRef, outputSignalName, inputSignalName;
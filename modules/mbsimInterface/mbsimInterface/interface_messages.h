@@ -80,5 +80,8 @@
 #define _SI_donotPrintCommunication_SI_ (char(181))
 #define _SI_setAsciiPrecision_asciiString_SI_ (char(186))
 
+// several requests in one message: [id][uint32 length][payload]... -> [uint32 length][answer]...
+#define _SI_batch_SI_ (char(191))
+
 #endif
 
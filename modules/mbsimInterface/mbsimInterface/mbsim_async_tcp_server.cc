@@ -0,0 +1,367 @@
+/* Copyright (C) 2004-2015 MBSim Development Team
+
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+ *
+ * Contact:
+ *   markus.ms.schneider@live.de
+ *
+ */
+
+#include <config.h>
+
+#include "mbsim_server.h"
+#include "interface_integrator.h"
+#include "mbsim/element.h"
+#include <sstream>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#ifdef HAVE_BOOST_ASIO_HPP
+#include <boost/asio.hpp>
+#endif
+
+using namespace std;
+using namespace MBXMLUtils;
+
+#ifdef HAVE_BOOST_ASIO_HPP
+namespace {
+
+  using boost::asio::ip::tcp;
+  using MBSimInterface::InterfaceIntegrator;
+
+  class Session;
+
+  // request of the authoritative client waiting for the integrator thread; a request without session is a
+  // warning of the network thread, which is written by the integrator thread
+  struct Request {
+    shared_ptr<Session> session;
+    string message; // [requestIdentifier][payload]
+  };
+
+  // state shared by the network thread (io_service) and the integrator thread
+  class Hub {
+    public:
+      Hub(boost::asio::io_service &io_, InterfaceIntegrator *ii_, unsigned short port, unsigned short observerPort, unsigned int precision_, uint32_t maxMessageSize_) :
+        io(io_), acceptor(io_, tcp::endpoint(tcp::v4(), port)), ii(ii_), precision(precision_), maxMessageSize(maxMessageSize_) {
+        if (observerPort)
+          observerAcceptor=make_unique<tcp::acceptor>(io_, tcp::endpoint(tcp::v4(), observerPort));
+      }
+
+      // the client connected to the port is authoritative, the clients connected to the observer port are read-only
+      void accept(tcp::acceptor &a, bool authoritative);
+      void accept() {
+        accept(acceptor, true);
+        if (observerAcceptor)
+          accept(*observerAcceptor, false);
+      }
+
+      // network thread: the warning is written by the integrator thread
+      void warn(string text) {
+        push({nullptr, move(text)});
+      }
+
+      // integrator thread: publish a new snapshot once per accepted step (plot/shift request) of the external
+      // integrator; the intermediate states of a step are never published and nothing is copied as long as no
+      // read-only client is connected
+      void publishIfRequired() {
+        if (readers.load(memory_order_relaxed)==0)
+          return;
+        if (ii->getStepCount()!=publishedStep)
+          publish();
+      }
+      // integrator thread: copy the current state to the back buffer and swap it with the front buffer
+      void publish() {
+        publishedStep=ii->getStepCount();
+        // the old front buffer may still be used by a reader; then a new one is allocated
+        if (not back or back.use_count()>1)
+          back=make_shared<InterfaceIntegrator::Snapshot>();
+        ii->getSnapshot(*back);
+        lock_guard<mutex> lock(snapshotMutex);
+        swap(front, back);
+      }
+      // network thread: the readers hold the snapshot of the last published step as long as they need it
+      shared_ptr<const InterfaceIntegrator::Snapshot> getSnapshot() {
+        lock_guard<mutex> lock(snapshotMutex);
+        return front;
+      }
+
+      void push(Request r) {
+        {
+          lock_guard<mutex> lock(queueMutex);
+          queue.push_back(move(r));
+        }
+        queueCond.notify_one();
+      }
+      // integrator thread: wait for the next request; false if the authoritative client is gone
+      bool pop(Request &r) {
+        unique_lock<mutex> lock(queueMutex);
+        queueCond.wait(lock, [this]() { return not queue.empty() or closed; });
+        if (queue.empty())
+          return false;
+        r=move(queue.front());
+        queue.pop_front();
+        return true;
+      }
+      void close() {
+        {
+          lock_guard<mutex> lock(queueMutex);
+          closed=true;
+        }
+        queueCond.notify_one();
+      }
+
+      boost::asio::io_service &io;
+      tcp::acceptor acceptor;
+      unique_ptr<tcp::acceptor> observerAcceptor;
+      InterfaceIntegrator *ii;
+      unsigned int precision;
+      uint32_t maxMessageSize;
+      atomic<int> readers{0}; // number of connected read-only clients
+      bool authoritativeConnected{false}; // network thread only
+      bool stopping{false}; // integrator thread only
+
+    private:
+      mutex queueMutex;
+      condition_variable queueCond;
+      deque<Request> queue;
+      bool closed{false};
+
+      mutex snapshotMutex;
+      shared_ptr<InterfaceIntegrator::Snapshot> front, back;
+      unsigned long publishedStep{0}; // integrator thread only
+  };
+
+  // one client connection; all members are used in the network thread only
+  class Session : public enable_shared_from_this<Session> {
+    public:
+      Session(Hub &hub_, bool authoritative_) : hub(hub_), socket(hub_.io), authoritative(authoritative_) { }
+      tcp::socket& getSocket() { return socket; }
+
+      void start() {
+        if (authoritative) {
+          // only one client controls the simulation; further connections to the port are refused
+          if (hub.authoritativeConnected) {
+            hub.warn("MBSimAsyncTcpServer: an authoritative client is already connected; connection refused");
+            boost::system::error_code ignored;
+            socket.close(ignored);
+            return;
+          }
+          hub.authoritativeConnected=true;
+        }
+        else
+          hub.readers++;
+        readHeader();
+      }
+
+      // queue the answer [uint32 length][answer]; the answers are sent in the order of the requests
+      // if last is set the event loop is stopped after the answer is sent
+      void send(const string &answer, bool last=false) {
+        stopAfterWrite=stopAfterWrite or last;
+        uint32_t n=answer.length();
+        string frame(reinterpret_cast<const char*>(&n), sizeof(uint32_t));
+        frame+=answer;
+        writeQueue.push_back(move(frame));
+        if (writeQueue.size()==1)
+          write();
+      }
+
+    private:
+      // requests are framed as [uint32 length][requestIdentifier][payload] and read one after the
+      // other without waiting for the answers (pipelining)
+      void readHeader() {
+        auto self(shared_from_this());
+        boost::asio::async_read(socket, boost::asio::buffer(&length, sizeof(uint32_t)), [this, self](const boost::system::error_code &error, size_t) {
+          if (error) {
+            disconnect();
+            return;
+          }
+          // the length is checked before any memory is allocated for the message
+          if (length>hub.maxMessageSize) {
+            hub.warn("MBSimAsyncTcpServer: message of "+to_string(length)+" bytes exceeds the maximum of "+
+                     to_string(hub.maxMessageSize)+" bytes; connection closed");
+            disconnect();
+            return;
+          }
+          message.resize(length);
+          readBody();
+        });
+      }
+
+      void readBody() {
+        auto self(shared_from_this());
+        boost::asio::async_read(socket, boost::asio::buffer(&message[0], length), [this, self](const boost::system::error_code &error, size_t) {
+          if (error) {
+            disconnect();
+            return;
+          }
+          handle();
+          readHeader();
+        });
+      }
+
+      void handle() {
+        if (message.empty())
+          send(string(1, '\0'));
+        else if (authoritative)
+          hub.push({shared_from_this(), message});
+        else if (InterfaceIntegrator::isReadOnlyRequest(message[0])) {
+          ostringstream mbsim2interface;
+          mbsim2interface.precision(hub.precision);
+          mbsim2interface.setf( std::ios::scientific );
+          hub.ii->snapshotCommunication(*hub.getSnapshot(), message[0], &mbsim2interface);
+          send(mbsim2interface.str());
+        }
+        else
+          send(string(1, '\0')); // requests changing the system are ignored for read-only clients
+      }
+
+      void write() {
+        auto self(shared_from_this());
+        boost::asio::async_write(socket, boost::asio::buffer(writeQueue.front()), [this, self](const boost::system::error_code &error, size_t) {
+          if (error) {
+            disconnect();
+            return;
+          }
+          writeQueue.pop_front();
+          if (not writeQueue.empty())
+            write();
+          else if (stopAfterWrite)
+            hub.io.stop(); // the answer to the exit request is sent
+        });
+      }
+
+      void disconnect() {
+        if (not socket.is_open())
+          return;
+        boost::system::error_code ignored;
+        socket.close(ignored);
+        if (authoritative)
+          hub.close();
+        else
+          hub.readers--;
+        if (stopAfterWrite)
+          hub.io.stop();
+      }
+
+      Hub &hub;
+      tcp::socket socket;
+      bool authoritative;
+      bool stopAfterWrite{false};
+      uint32_t length{0};
+      string message;
+      deque<string> writeQueue;
+  };
+
+  void Hub::accept(tcp::acceptor &a, bool authoritative) {
+    auto session=make_shared<Session>(*this, authoritative);
+    a.async_accept(session->getSocket(), [this, &a, authoritative, session](const boost::system::error_code &error) {
+      if (not error)
+        session->start();
+      if (a.is_open())
+        accept(a, authoritative);
+    });
+  }
+
+}
+#endif
+
+namespace MBSimInterface {
+
+  MBSimAsyncTcpServer::MBSimAsyncTcpServer(InterfaceIntegrator *ii_) : MBSimServer(ii_), port(0), observerPort(0), outputPrecision(18), maxMessageSize(16777216)
+  {
+  }
+
+  void MBSimAsyncTcpServer::start() {
+#ifdef HAVE_BOOST_ASIO_HPP
+    boost::asio::io_service io_service;
+    Hub hub(io_service, ii, port, observerPort, outputPrecision, maxMessageSize);
+    hub.publish();
+    hub.accept();
+
+    // the network thread serves all clients; the system is only touched by this (the integrator) thread
+    exception_ptr networkError;
+    thread network([&io_service, &networkError]() {
+      try {
+        io_service.run();
+      }
+      catch(...) {
+        networkError=current_exception();
+      }
+    });
+
+    ostringstream mbsim2interface;
+    mbsim2interface.precision(outputPrecision);
+    mbsim2interface.setf( std::ios::scientific );
+
+    try {
+      Request r;
+      while (hub.pop(r)) {
+        if (not r.session) {
+          ii->msg(fmatvec::Atom::Warn) << r.message << endl;
+          continue;
+        }
+        // std::string is terminated by '\0' as required by the asciiString requests
+        mbsim2interface.str(std::string());
+        ii->integratorCommunication(&r.message[0], &r.message[0]+1, r.message.length()-1, &mbsim2interface);
+        hub.publishIfRequired();
+
+        if (ii->getExitRequest())
+          hub.stopping=true;
+        io_service.post([session=move(r.session), answer=mbsim2interface.str(), last=hub.stopping]() { session->send(answer, last); });
+        if (hub.stopping)
+          break;
+      }
+    }
+    catch(...) {
+      io_service.stop();
+      network.join();
+      throw;
+    }
+
+    if (not hub.stopping)
+      io_service.stop(); // the authoritative client disconnected
+    network.join();
+    // the warnings of the network thread after the last request
+    hub.close();
+    Request r;
+    while (hub.pop(r))
+      if (not r.session)
+        ii->msg(fmatvec::Atom::Warn) << r.message << endl;
+    if (networkError)
+      rethrow_exception(networkError);
+#endif
+  }
+
+  void MBSimAsyncTcpServer::initializeUsingXML(xercesc::DOMElement *element) {
+    xercesc::DOMElement* e;
+    e=E(element)->getFirstElementChildNamed(MBSIMINTERFACE%"port");
+    setPort(E(e)->getText<int>());
+    e=E(element)->getFirstElementChildNamed(MBSIMINTERFACE%"observerPort");
+    if (e)
+      setObserverPort(E(e)->getText<int>());
+    e=E(element)->getFirstElementChildNamed(MBSIMINTERFACE%"outputPrecision");
+    if (e)
+      setOutputPrecision(E(e)->getText<int>());
+    e=E(element)->getFirstElementChildNamed(MBSIMINTERFACE%"maximumMessageSize");
+    if (e)
+      setMaximumMessageSize(E(e)->getText<int>());
+  }
+
+}
@@ -24,6 +24,7 @@
 #define _MBSIMSERVER_H_
 
 #include <mbxmlutilshelper/dom.h>
+#include <cstdint>
 
 namespace MBSimInterface {
 
@@ -54,6 +55,51 @@ namespace MBSimInterface {
       unsigned int outputPrecision;
   };
 
+  /** \brief event loop TCP server for several concurrent clients
+
+    The requests are framed as [uint32 length][requestIdentifier][payload], the answers as
+    [uint32 length][answer]. A client sending a message longer than the maximum message size is disconnected. A client may send further requests before the answers of the previous
+    ones are received. The client connected to the port is authoritative: its requests are processed by the
+    integrator in order; a second connection to the port is refused. The clients connected to the observer port
+    (if given) are read-only: time, state and output signals are answered by the network thread from a double
+    buffered copy of the state, which is published after each accepted step (plot/shift request) of the
+    authoritative client; all other requests are answered with an empty message. The server ends if the
+    authoritative client sends an exit request or disconnects. */
+  class MBSimAsyncTcpServer : public MBSimServer  {
+    public:
+      MBSimAsyncTcpServer(InterfaceIntegrator *ii);
+      void setPort(unsigned short port_) {port=port_; }
+      void setObserverPort(unsigned short port_) {observerPort=port_; }
+      void setOutputPrecision(unsigned int p) {outputPrecision=p; }
+      void setMaximumMessageSize(uint32_t n) {maxMessageSize=n; }
+      void initializeUsingXML(xercesc::DOMElement *element) override;
+      void start() override;
+    private:
+      unsigned int port;
+      unsigned int observerPort;
+      unsigned int outputPrecision;
+      uint32_t maxMessageSize;
+  };
+
+  /** \brief server using two message rings in POSIX shared memory with a local peer process
+
+    The requests are processed directly in the shared memory. The memoryAdress requests copy the
+    data to the data block of the segment and return its offset (int) relative to the block.
+    The segment is named /mbsimInterface-<pid> if no name is given; the name is printed at startup. */
+  class MBSimShmServer : public MBSimServer  {
+    public:
+      MBSimShmServer(InterfaceIntegrator *ii);
+      void setName(const std::string &name_) {name=name_; }
+      void setRingCapacity(size_t c) {ringCapacity=c; }
+      void setOutputPrecision(unsigned int p) {outputPrecision=p; }
+      void initializeUsingXML(xercesc::DOMElement *element) override;
+      void start() override;
+    private:
+      std::string name;
+      size_t ringCapacity;
+      unsigned int outputPrecision;
+  };
+
   class MBSimUdpServer : public MBSimServer  {
     public:
       MBSimUdpServer(InterfaceIntegrator *ii);
@@ -0,0 +1,171 @@
+/* Copyright (C) 2004-2015 MBSim Development Team
+
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+ *
+ * Contact:
+ *   markus.ms.schneider@live.de
+ *
+ */
+
+// latency and throughput benchmark for a running MBSimShmServer
+// usage: mbsimInterfaceShmBenchmark <shared memory name> [<number of iterations>]
+
+#include <config.h>
+
+#include "interface_messages.h"
+#include "shm_ring_buffer.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace MBSimInterface;
+
+namespace {
+
+  ShmRing request, response;
+
+  // send one request and return the answer (without the terminating '\0')
+  string call(char id, const void *payload=nullptr, uint32_t length=0) {
+    char *p=request.waitReserve(length+1);
+    p[0]=id;
+    if (length)
+      memcpy(p+1, payload, length);
+    request.commit();
+
+    uint32_t n;
+    const char *a=response.waitFront(n);
+    string answer(a, n>0 ? n-1 : 0);
+    response.pop();
+    return answer;
+  }
+
+  void appendRequest(string &batch, char id, const void *payload, uint32_t length) {
+    batch+=id;
+    batch.append(reinterpret_cast<const char*>(&length), sizeof(uint32_t));
+    batch.append(static_cast<const char*>(payload), length);
+  }
+
+  void report(const string &name, vector<double> &dt) {
+    sort(dt.begin(), dt.end());
+    double sum=0;
+    for (double d : dt)
+      sum+=d;
+    cout << name << ": mean " << sum/dt.size()*1e6 << " us, min " << dt.front()*1e6 << " us, median " << dt[dt.size()/2]*1e6
+         << " us, max " << dt.back()*1e6 << " us, " << dt.size()/sum << " evaluations/s" << endl;
+  }
+
+}
+
+int main(int argc, char *argv[]) {
+  if (argc<2) {
+    cerr << "usage: mbsimInterfaceShmBenchmark <shared memory name> [<number of iterations>]" << endl;
+    return 1;
+  }
+  string name=argv[1];
+  int N=argc>2 ? atoi(argv[2]) : 10000;
+
+  // wait for the server
+  int fd;
+  struct stat st;
+  while ((fd=shm_open(name.c_str(), O_RDWR, 0))==-1 or fstat(fd, &st)!=0 or st.st_size==0) {
+    if (fd!=-1)
+      close(fd);
+    usleep(10000);
+  }
+  void *segment=mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (segment==MAP_FAILED) {
+    cerr << "can not map shared memory " << name << endl;
+    return 1;
+  }
+  auto *control=static_cast<ShmControl*>(segment);
+  while (control->serverReady.load(memory_order_acquire)==0)
+    usleep(1000);
+  request.attach(static_cast<char*>(segment)+sizeof(ShmControl));
+  response.attach(static_cast<char*>(segment)+sizeof(ShmControl)+ShmRing::requiredSize(control->ringCapacity));
+  const char *data=static_cast<char*>(segment)+control->dataOffset;
+
+  call(_SI_donotPrintCommunication_SI_);
+  int zSize;
+  memcpy(&zSize, call(_SI_getStateVectorSize_memoryDump_SI_).data(), sizeof(int));
+  double t;
+  memcpy(&t, call(_SI_getTime_memoryDump_SI_).data(), sizeof(double));
+  vector<double> z(zSize), zd(zSize);
+  memcpy(z.data(), call(_SI_getStateVector_memoryDump_SI_).data(), zSize*sizeof(double));
+  cout << "state size " << zSize << ", " << N << " iterations" << endl;
+
+  vector<double> dt(N);
+
+  // one round trip per request
+  for (int i=0; i<N; i++) {
+    auto start=chrono::steady_clock::now();
+    call(_SI_setTime_memoryDump_SI_, &t, sizeof(double));
+    call(_SI_setStateVector_memoryDump_SI_, z.data(), zSize*sizeof(double));
+    memcpy(zd.data(), call(_SI_getTimeDerivativeOfStateVector_memoryDump_SI_).data(), zSize*sizeof(double));
+    dt[i]=chrono::duration<double>(chrono::steady_clock::now()-start).count();
+  }
+  report("single requests", dt);
+
+  // all requests in one round trip
+  string batch;
+  for (int i=0; i<N; i++) {
+    auto start=chrono::steady_clock::now();
+    batch.clear();
+    appendRequest(batch, _SI_setTime_memoryDump_SI_, &t, sizeof(double));
+    appendRequest(batch, _SI_setStateVector_memoryDump_SI_, z.data(), zSize*sizeof(double));
+    appendRequest(batch, _SI_getTimeDerivativeOfStateVector_memoryDump_SI_, nullptr, 0);
+    string answer=call(_SI_batch_SI_, batch.data(), batch.length());
+    // skip the (empty) answers of the set requests
+    const char *p=answer.data();
+    for (int j=0; j<2; j++) {
+      uint32_t n;
+      memcpy(&n, p, sizeof(uint32_t));
+      p+=sizeof(uint32_t)+n;
+    }
+    memcpy(zd.data(), p+sizeof(uint32_t), zSize*sizeof(double));
+    dt[i]=chrono::duration<double>(chrono::steady_clock::now()-start).count();
+  }
+  report("batched requests", dt);
+
+  // derivative read directly from the data block of the shared memory
+  for (int i=0; i<N; i++) {
+    auto start=chrono::steady_clock::now();
+    batch.clear();
+    appendRequest(batch, _SI_setTime_memoryDump_SI_, &t, sizeof(double));
+    appendRequest(batch, _SI_setStateVector_memoryDump_SI_, z.data(), zSize*sizeof(double));
+    appendRequest(batch, _SI_getTimeDerivativeOfStateVector_memoryAdress_SI_, nullptr, 0);
+    string answer=call(_SI_batch_SI_, batch.data(), batch.length());
+    int offset;
+    memcpy(&offset, answer.data()+answer.length()-sizeof(int)-1, sizeof(int));
+    const double *zdShared=reinterpret_cast<const double*>(data+offset);
+    zd.assign(zdShared, zdShared+zSize);
+    dt[i]=chrono::duration<double>(chrono::steady_clock::now()-start).count();
+  }
+  report("batched requests with shared data block", dt);
+
+  call(_SI_exitRequest_SI_);
+  munmap(segment, st.st_size);
+  return 0;
+}
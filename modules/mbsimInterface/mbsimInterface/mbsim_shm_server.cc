@@ -0,0 +1,141 @@
+/* Copyright (C) 2004-2015 MBSim Development Team
+
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+ *
+ * Contact:
+ *   markus.ms.schneider@live.de
+ *
+ */
+
+#include <config.h>
+
+#include "mbsim_server.h"
+#include "interface_integrator.h"
+#include "mbsim/element.h"
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+#include <new>
+#ifndef _WIN32
+#include "shm_ring_buffer.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace MBXMLUtils;
+
+namespace MBSimInterface {
+
+  MBSimShmServer::MBSimShmServer(InterfaceIntegrator *ii_) : MBSimServer(ii_), ringCapacity(1048576), outputPrecision(18)
+  {
+  }
+
+  void MBSimShmServer::start() {
+#ifndef _WIN32
+    // segment: [ShmControl][request ring][response ring][data block]
+    size_t ringSize=ShmRing::requiredSize(ringCapacity);
+    size_t dataOffset=sizeof(ShmControl)+2*ringSize;
+    size_t size=dataOffset+ii->getSharedDataSize();
+
+    // the segment name is unique per process if not given; an existing segment is never removed
+    if (name.empty())
+      name="/mbsimInterface-"+to_string(getpid());
+    int fd=shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd==-1)
+      throw runtime_error("(MBSimShmServer::start): can not create shared memory "+name+": "+strerror(errno));
+    if (ftruncate(fd, size)!=0) {
+      close(fd);
+      shm_unlink(name.c_str());
+      throw runtime_error("(MBSimShmServer::start): can not resize shared memory "+name);
+    }
+    void *segment=mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (segment==MAP_FAILED) {
+      shm_unlink(name.c_str());
+      throw runtime_error("(MBSimShmServer::start): can not map shared memory "+name);
+    }
+
+    auto *control=new(segment) ShmControl;
+    control->ringCapacity=ringCapacity;
+    control->dataOffset=dataOffset;
+    control->dataSize=ii->getSharedDataSize();
+    ShmRing request, response;
+    request.init(static_cast<char*>(segment)+sizeof(ShmControl), ringCapacity);
+    response.init(static_cast<char*>(segment)+sizeof(ShmControl)+ringSize, ringCapacity);
+    ii->setSharedData(static_cast<char*>(segment)+dataOffset);
+    control->serverReady.store(1, memory_order_release);
+    cout << "MBSimShmServer: shared memory segment " << name << endl;
+
+    ostringstream mbsim2interface;
+    mbsim2interface.precision(outputPrecision);
+    mbsim2interface.setf( std::ios::scientific );
+
+    try {
+      do
+      {
+        uint32_t length;
+        const char *data=request.waitFront(length);
+
+        // the request is processed directly in the shared memory
+        mbsim2interface.str(std::string());
+        ii->integratorCommunication(data, data+1, length-1, &mbsim2interface);
+        request.pop();
+
+        const string answer=mbsim2interface.str();
+        char *p=response.waitReserve(answer.length());
+        memcpy(p, answer.data(), answer.length());
+        response.commit();
+      } while(!ii->getExitRequest());
+    }
+    catch(...) {
+      ii->setSharedData(nullptr);
+      request.destroy();
+      response.destroy();
+      munmap(segment, size);
+      shm_unlink(name.c_str());
+      throw;
+    }
+
+    ii->setSharedData(nullptr);
+    request.destroy();
+    response.destroy();
+    munmap(segment, size);
+    shm_unlink(name.c_str());
+#else
+    throw runtime_error("(MBSimShmServer::start): shared memory communication is not available on Windows");
+#endif
+  }
+
+  void MBSimShmServer::initializeUsingXML(xercesc::DOMElement *element) {
+    xercesc::DOMElement* e;
+    e=E(element)->getFirstElementChildNamed(MBSIMINTERFACE%"name");
+    if (e) {
+      string str=E(e)->getText<string>();
+      setName(str.substr(1, str.length()-2));
+    }
+    e=E(element)->getFirstElementChildNamed(MBSIMINTERFACE%"ringCapacity");
+    if (e)
+      setRingCapacity(E(e)->getText<int>());
+    e=E(element)->getFirstElementChildNamed(MBSIMINTERFACE%"outputPrecision");
+    if (e)
+      setOutputPrecision(E(e)->getText<int>());
+  }
+
+}
@@ -0,0 +1,169 @@
+/* Copyright (C) 2004-2015 MBSim Development Team
+
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+
+ *
+ * Contact:
+ *   markus.ms.schneider@live.de
+ *
+ */
+
+#ifndef _SHM_RING_BUFFER_H_
+#define _SHM_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <cerrno>
+#include <semaphore.h>
+
+namespace MBSimInterface {
+
+  /** \brief single producer/single consumer message ring located in shared memory
+
+    Each message is stored contiguously as [uint32 length][length bytes]['\0'] aligned to 8 bytes.
+    A message which does not fit at the end of the buffer is preceded by a wrap marker and starts
+    at the beginning of the buffer. Hence the consumer can work directly on the shared memory
+    and releases the message after processing (no copy of the message).
+    The peer is blocked on process shared semaphores (number of committed messages and released space)
+    after a short spin phase. */
+  class ShmRing {
+    public:
+      struct Header {
+        std::atomic<uint64_t> head; // number of bytes written by the producer
+        std::atomic<uint64_t> tail; // number of bytes released by the consumer
+        uint64_t capacity;
+        sem_t messages; // posted by commit
+        sem_t space; // posted by pop
+      };
+      static_assert(std::atomic<uint64_t>::is_always_lock_free, "lock free 64 bit atomics are required for shared memory");
+
+      static size_t requiredSize(size_t capacity) { return sizeof(Header)+align(capacity); }
+
+      /*! use an already initialised ring at p */
+      void attach(void *p) {
+        h=static_cast<Header*>(p);
+        data=static_cast<char*>(p)+sizeof(Header);
+      }
+      /*! initialise a new ring at p */
+      void init(void *p, size_t capacity) {
+        attach(p);
+        h->head.store(0);
+        h->tail.store(0);
+        h->capacity=align(capacity);
+        if(sem_init(&h->messages, 1, 0)!=0 or sem_init(&h->space, 1, 0)!=0)
+          throw std::runtime_error("(ShmRing::init): can not create process shared semaphores");
+      }
+      /*! destroy the semaphores of a ring initialised by init */
+      void destroy() {
+        sem_destroy(&h->messages);
+        sem_destroy(&h->space);
+      }
+
+      /*! \return pointer to the payload of a new message of the given length or nullptr if the ring is full */
+      char* reserve(uint32_t length) {
+        uint64_t need=align(sizeof(uint32_t)+length+1);
+        if(need>h->capacity)
+          throw std::runtime_error("(ShmRing::reserve): message too large for shared memory ring");
+        uint64_t head=h->head.load(std::memory_order_relaxed);
+        uint64_t off=head%h->capacity;
+        skip=off+need>h->capacity ? h->capacity-off : 0;
+        if(head+skip+need-h->tail.load(std::memory_order_acquire)>h->capacity)
+          return nullptr;
+        if(skip)
+          *reinterpret_cast<uint32_t*>(data+off)=wrapMarker;
+        pos=(off+skip)%h->capacity;
+        *reinterpret_cast<uint32_t*>(data+pos)=length;
+        return data+pos+sizeof(uint32_t);
+      }
+      /*! publish the message returned by the last reserve */
+      void commit() {
+        uint32_t length=*reinterpret_cast<uint32_t*>(data+pos);
+        data[pos+sizeof(uint32_t)+length]='\0';
+        h->head.store(h->head.load(std::memory_order_relaxed)+skip+align(sizeof(uint32_t)+length+1), std::memory_order_release);
+        sem_post(&h->messages);
+      }
+      /*! reserve, blocks while the ring is full */
+      char* waitReserve(uint32_t length) {
+        while(true) {
+          // drop outdated notifications; a pop after this point is seen by reserve or wakes up the wait
+          while(sem_trywait(&h->space)==0);
+          char *p=reserve(length);
+          if(p)
+            return p;
+          wait(&h->space);
+        }
+      }
+
+      /*! \return pointer to the next message (terminated by '\0') or nullptr if the ring is empty */
+      const char* front(uint32_t &length) {
+        uint64_t tail=h->tail.load(std::memory_order_relaxed);
+        if(tail==h->head.load(std::memory_order_acquire))
+          return nullptr;
+        uint64_t off=tail%h->capacity;
+        skip=0;
+        if(*reinterpret_cast<uint32_t*>(data+off)==wrapMarker) {
+          skip=h->capacity-off;
+          off=0;
+        }
+        pos=off;
+        length=*reinterpret_cast<uint32_t*>(data+off);
+        return data+off+sizeof(uint32_t);
+      }
+      /*! front, blocks until a message is available */
+      const char* waitFront(uint32_t &length) {
+        // each committed message posts the semaphore once
+        wait(&h->messages);
+        return front(length);
+      }
+      /*! release the message returned by the last front */
+      void pop() {
+        uint32_t length=*reinterpret_cast<uint32_t*>(data+pos);
+        h->tail.store(h->tail.load(std::memory_order_relaxed)+skip+align(sizeof(uint32_t)+length+1), std::memory_order_release);
+        sem_post(&h->space);
+      }
+
+    private:
+      static uint64_t align(uint64_t n) { return (n+7)&~uint64_t(7); }
+      /*! short spin phase for low latency, then the thread sleeps on the semaphore */
+      static void wait(sem_t *sem) {
+        for(int n=0; n<spinCount; n++)
+          if(sem_trywait(sem)==0)
+            return;
+        while(sem_wait(sem)!=0)
+          if(errno!=EINTR)
+            throw std::runtime_error("(ShmRing::wait): waiting for the peer failed");
+      }
+      static constexpr int spinCount=1000;
+      static constexpr uint32_t wrapMarker=0xffffffff;
+      Header *h{nullptr};
+      char *data{nullptr};
+      uint64_t skip{0}, pos{0};
+  };
+
+  /** \brief layout of the shared memory segment of MBSimShmServer
+
+    [ShmControl][request ring][response ring][data block for the memoryAdress requests] */
+  struct ShmControl {
+    std::atomic<uint32_t> serverReady;
+    uint64_t ringCapacity;
+    uint64_t dataOffset;
+    uint64_t dataSize;
+  };
+
+}
+
+#endif